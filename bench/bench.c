@@ -0,0 +1,671 @@
+#define _GNU_SOURCE
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* Most operations per sample tried by the calibration */
+#define MAX_ITERS (1ull << 40)
+
+volatile uint64_t bench_sink;
+
+/* ========================================================================
+ * Clocks
+ * ======================================================================== */
+
+double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+void bench_fill(uint8_t *buffer, size_t len, uint64_t seed) {
+    uint64_t x = seed * 0x9E3779B97F4A7C15ull + 1;
+    for (size_t i = 0; i < len; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        buffer[i] = (uint8_t)(x >> 24);
+    }
+}
+
+/* ========================================================================
+ * Settings
+ * ======================================================================== */
+
+void bench_config_default(bench_config_t *config) {
+    config->warmup = 5;
+    config->reps = 31;
+    config->min_sample_ms = 2.0;
+    config->filter = NULL;
+    config->json_path = NULL;
+    config->perf = 0;
+}
+
+int bench_parse_args(int argc, char **argv, bench_config_t *config) {
+    int opt;
+    while ((opt = getopt(argc, argv, "w:r:m:f:j:pq")) != -1) {
+        switch (opt) {
+        case 'w':
+            config->warmup = (unsigned)atoi(optarg);
+            break;
+        case 'r':
+            config->reps = (unsigned)atoi(optarg);
+            break;
+        case 'm':
+            config->min_sample_ms = atof(optarg);
+            break;
+        case 'f':
+            config->filter = optarg;
+            break;
+        case 'j':
+            config->json_path = optarg;
+            break;
+        case 'p':
+            config->perf = 1;
+            break;
+        case 'q':
+            config->warmup = 1;
+            config->reps = 7;
+            config->min_sample_ms = 0.5;
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    if (config->reps == 0 || config->reps > BENCH_MAX_REPS ||
+        !(config->min_sample_ms > 0.0)) {
+        return -1;
+    }
+    return optind;
+}
+
+int bench_selected(const bench_config_t *config, const char *name) {
+    return config->filter == NULL || strstr(name, config->filter) != NULL;
+}
+
+/* ========================================================================
+ * Hardware Counters
+ * ======================================================================== */
+
+static const char *const perf_names[BENCH_PERF_COUNT] = {
+    [BENCH_PERF_CYCLES]        = "cycles",
+    [BENCH_PERF_INSTRUCTIONS]  = "instructions",
+    [BENCH_PERF_L1D_MISSES]    = "l1d_misses",
+    [BENCH_PERF_LLC_MISSES]    = "llc_misses",
+    [BENCH_PERF_BRANCH_MISSES] = "branch_misses",
+};
+
+const char *bench_perf_name(bench_perf_event_t event) {
+    if ((int)event < 0 || event >= BENCH_PERF_COUNT) {
+        return "unknown";
+    }
+    return perf_names[event];
+}
+
+#ifdef __linux__
+/* 0 = not opened yet, 1 = open, -1 = unavailable */
+static int perf_state;
+static int perf_fd[BENCH_PERF_COUNT];
+
+/* One event as read with TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING */
+typedef struct {
+    uint64_t value;
+    uint64_t enabled;
+    uint64_t running;
+} perf_reading_t;
+
+static int perf_open_event(bench_perf_event_t event, int group) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = (group == -1);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    const uint64_t read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    switch (event) {
+    case BENCH_PERF_CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case BENCH_PERF_INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case BENCH_PERF_L1D_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1D | read_miss;
+        break;
+    case BENCH_PERF_LLC_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_LL | read_miss;
+        break;
+    case BENCH_PERF_BRANCH_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    default:
+        return -1;
+    }
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+/**
+ * Open the events once, cycles leading the group. Returns 0 if at least
+ * cycles could be opened; otherwise says why, once, and returns -1.
+ */
+static int perf_open(void) {
+    if (perf_state != 0) {
+        return perf_state > 0 ? 0 : -1;
+    }
+
+    perf_fd[BENCH_PERF_CYCLES] = perf_open_event(BENCH_PERF_CYCLES, -1);
+    if (perf_fd[BENCH_PERF_CYCLES] < 0) {
+        int error = errno;
+        fprintf(stderr, "bench: hardware counters unavailable (%s)%s\n",
+                strerror(error),
+                (error == EACCES || error == EPERM)
+                    ? "; see /proc/sys/kernel/perf_event_paranoid" : "");
+        perf_state = -1;
+        return -1;
+    }
+
+    // The others are optional: not every PMU has every cache event
+    for (int e = BENCH_PERF_CYCLES + 1; e < BENCH_PERF_COUNT; e++) {
+        perf_fd[e] = perf_open_event((bench_perf_event_t)e,
+                                     perf_fd[BENCH_PERF_CYCLES]);
+    }
+    perf_state = 1;
+    return 0;
+}
+
+static void perf_read(perf_reading_t reading[BENCH_PERF_COUNT]) {
+    for (int e = 0; e < BENCH_PERF_COUNT; e++) {
+        if (perf_fd[e] < 0 ||
+            read(perf_fd[e], &reading[e], sizeof(perf_reading_t)) !=
+                (ssize_t)sizeof(perf_reading_t)) {
+            memset(&reading[e], 0, sizeof(perf_reading_t));
+        }
+    }
+}
+
+/**
+ * Add the counts between two readings, scaled up for the time the kernel
+ * had an event multiplexed out
+ */
+static void perf_accumulate(const perf_reading_t before[BENCH_PERF_COUNT],
+                            const perf_reading_t after[BENCH_PERF_COUNT],
+                            double total[BENCH_PERF_COUNT]) {
+    for (int e = 0; e < BENCH_PERF_COUNT; e++) {
+        uint64_t running = after[e].running - before[e].running;
+        if (running == 0) {
+            continue;
+        }
+        uint64_t enabled = after[e].enabled - before[e].enabled;
+        total[e] += (double)(after[e].value - before[e].value) *
+                    ((double)enabled / (double)running);
+    }
+}
+#endif
+
+/**
+ * Time the samples of a benchmark. With config->perf, count hardware
+ * events across them too; the counters are switched on and off outside
+ * the timed region of each sample.
+ */
+static void run_samples(const bench_config_t *config, bench_fn fn, void *arg,
+                        uint64_t iters, double *ns, double *cycles,
+                        bench_result_t *result) {
+    for (int e = 0; e < BENCH_PERF_COUNT; e++) {
+        result->perf[e] = -1.0;
+    }
+
+#ifdef __linux__
+    int counting = config->perf && perf_open() == 0;
+    int leader = counting ? perf_fd[BENCH_PERF_CYCLES] : -1;
+    double total[BENCH_PERF_COUNT] = {0};
+    int counted[BENCH_PERF_COUNT] = {0};
+    perf_reading_t before[BENCH_PERF_COUNT];
+    perf_reading_t after[BENCH_PERF_COUNT];
+#endif
+
+    for (unsigned r = 0; r < config->reps; r++) {
+#ifdef __linux__
+        if (counting) {
+            perf_read(before);
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+        uint64_t c0 = bench_cycles();
+        double t0 = bench_now_ns();
+        fn(arg, iters);
+        double t1 = bench_now_ns();
+        uint64_t c1 = bench_cycles();
+#ifdef __linux__
+        if (counting) {
+            ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            perf_read(after);
+            perf_accumulate(before, after, total);
+            for (int e = 0; e < BENCH_PERF_COUNT; e++) {
+                counted[e] |= (after[e].running > before[e].running);
+            }
+        }
+#endif
+        ns[r] = (t1 - t0) / (double)iters;
+        cycles[r] = (double)(c1 - c0) / (double)iters;
+    }
+
+#ifdef __linux__
+    double ops = (double)config->reps * (double)iters;
+    for (int e = 0; e < BENCH_PERF_COUNT; e++) {
+        if (counting && counted[e]) {
+            result->perf[e] = total[e] / ops;
+        }
+    }
+#else
+    (void)config;
+#endif
+}
+
+/* ========================================================================
+ * Measurement
+ * ======================================================================== */
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Nearest-rank percentile of sorted samples
+ */
+static double percentile(const double *sorted, unsigned count, double q) {
+    double exact = q * count;
+    unsigned rank = (unsigned)exact;
+    if ((double)rank < exact) {
+        rank++;
+    }
+    if (rank < 1) {
+        rank = 1;
+    }
+    return sorted[(rank < count ? rank : count) - 1];
+}
+
+int bench_run(const bench_config_t *config, const char *name,
+              const char *params, size_t bytes, bench_fn fn, void *arg,
+              bench_result_t *result) {
+    if (config == NULL || name == NULL || fn == NULL || result == NULL ||
+        config->reps == 0 || config->reps > BENCH_MAX_REPS) {
+        return -1;
+    }
+
+    double cycles[BENCH_MAX_REPS];
+    double *ns = result->ns;
+
+    // Calibrate: double the operations until a sample is long enough
+    double min_ns = config->min_sample_ms * 1e6;
+    uint64_t iters = 1;
+    for (;;) {
+        double start = bench_now_ns();
+        fn(arg, iters);
+        double elapsed = bench_now_ns() - start;
+        if (elapsed >= min_ns || iters >= MAX_ITERS) {
+            break;
+        }
+        // Jump close to the target once the timing means something
+        if (elapsed > min_ns / 100) {
+            uint64_t scaled = (uint64_t)(iters * (min_ns * 1.1 / elapsed));
+            iters = (scaled > iters * 2) ? scaled : iters * 2;
+        } else {
+            iters *= 2;
+        }
+    }
+
+    for (unsigned w = 0; w < config->warmup; w++) {
+        fn(arg, iters);
+    }
+
+    run_samples(config, fn, arg, iters, ns, cycles, result);
+
+    qsort(ns, config->reps, sizeof(double), compare_double);
+    qsort(cycles, config->reps, sizeof(double), compare_double);
+
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    snprintf(result->params, sizeof(result->params), "%s",
+             params != NULL ? params : "");
+    result->bytes = bytes;
+    result->iters = iters;
+    result->samples = config->reps;
+    result->ns_min = ns[0];
+    result->ns_p50 = percentile(ns, config->reps, 0.50);
+    result->ns_p90 = percentile(ns, config->reps, 0.90);
+    result->ns_p99 = percentile(ns, config->reps, 0.99);
+    result->cycles_p50 = percentile(cycles, config->reps, 0.50);
+    result->items = 1.0;
+    result->allocs = -1.0;
+    return 0;
+}
+
+/* ========================================================================
+ * Report
+ * ======================================================================== */
+
+void bench_print_header(void) {
+    printf("%-24s %-20s %10s %10s %10s %10s %10s %9s %8s\n", "benchmark",
+           "params", "p50 ns", "p90 ns", "p99 ns", "min ns", "Mops/s",
+           "cyc/op", "cyc/B");
+}
+
+void bench_print_result(const bench_result_t *result) {
+    char per_op[16] = "-";
+    char per_byte[16] = "-";
+
+    if (result->cycles_p50 > 0.0) {
+        snprintf(per_op, sizeof(per_op), "%.1f", result->cycles_p50);
+        if (result->bytes > 0) {
+            snprintf(per_byte, sizeof(per_byte), "%.2f",
+                     result->cycles_p50 / (double)result->bytes);
+        }
+    }
+
+    printf("%-24s %-20s %10.1f %10.1f %10.1f %10.1f %10.2f %9s %8s\n",
+           result->name, result->params, result->ns_p50, result->ns_p90,
+           result->ns_p99, result->ns_min, 1e3 / result->ns_p50, per_op,
+           per_byte);
+    fflush(stdout);
+}
+
+void bench_print_perf(const bench_result_t *result) {
+    const double *perf = result->perf;
+    if (perf[BENCH_PERF_CYCLES] < 0.0) {
+        return;
+    }
+
+    char ipc[16] = "-";
+    if (perf[BENCH_PERF_INSTRUCTIONS] >= 0.0 && perf[BENCH_PERF_CYCLES] > 0.0) {
+        snprintf(ipc, sizeof(ipc), "%.2f",
+                 perf[BENCH_PERF_INSTRUCTIONS] / perf[BENCH_PERF_CYCLES]);
+    }
+
+    char misses[BENCH_PERF_COUNT][16];
+    for (int e = 0; e < BENCH_PERF_COUNT; e++) {
+        if (perf[e] < 0.0) {
+            snprintf(misses[e], sizeof(misses[e]), "-");
+        } else {
+            snprintf(misses[e], sizeof(misses[e]), "%.3g", perf[e]);
+        }
+    }
+
+    printf("    %.1f cyc/op  IPC %s  L1D miss/op %s  LLC miss/op %s  "
+           "branch miss/op %s\n", perf[BENCH_PERF_CYCLES], ipc,
+           misses[BENCH_PERF_L1D_MISSES], misses[BENCH_PERF_LLC_MISSES],
+           misses[BENCH_PERF_BRANCH_MISSES]);
+    fflush(stdout);
+}
+
+/* ========================================================================
+ * JSON Report
+ * ======================================================================== */
+
+/* Flags that matter to the field and sharing kernels */
+static const char *const interesting_flags[] = {
+    "sse2", "ssse3", "sse4_1", "sse4_2", "avx", "avx2", "avx512f",
+    "avx512bw", "bmi2", "aes", "pclmulqdq", "vpclmulqdq", "gfni",
+    "asimd", "pmull", "sve"
+};
+
+static FILE *json_file;
+static unsigned json_results;
+static int json_error;
+
+static void json_string(const char *text) {
+    fputc('"', json_file);
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(json_file, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(json_file, "\\u%04x", *c);
+        } else {
+            fputc(*c, json_file);
+        }
+    }
+    fputc('"', json_file);
+}
+
+static void json_field(const char *key, const char *value, int last) {
+    fprintf(json_file, "    ");
+    json_string(key);
+    fprintf(json_file, ": ");
+    json_string(value);
+    fprintf(json_file, last ? "\n" : ",\n");
+}
+
+/**
+ * Value of a "key : value" line of /proc/cpuinfo (Linux only)
+ */
+static int cpuinfo_line(const char *key, char *value, size_t size) {
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (f == NULL) {
+        return -1;
+    }
+
+    char line[4096];
+    int found = -1;
+    size_t key_len = strlen(key);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *colon = strchr(line, ':');
+        if (strncmp(line, key, key_len) != 0 || colon == NULL) {
+            continue;
+        }
+        colon++;
+        while (*colon == ' ') {
+            colon++;
+        }
+        colon[strcspn(colon, "\n")] = '\0';
+        snprintf(value, size, "%s", colon);
+        found = 0;
+        break;
+    }
+    fclose(f);
+    return found;
+}
+
+static void cpu_model(char *model, size_t size) {
+    snprintf(model, size, "unknown");
+#ifdef __APPLE__
+    size_t len = size;
+    if (sysctlbyname("machdep.cpu.brand_string", model, &len, NULL, 0) != 0) {
+        snprintf(model, size, "unknown");
+    }
+#else
+    cpuinfo_line("model name", model, size);
+#endif
+}
+
+/**
+ * Write the interesting CPU flags as a JSON array: from /proc/cpuinfo
+ * where there is one, otherwise those the compiler was allowed to use
+ */
+static void json_cpu_flags(void) {
+    char flags[4096] = "";
+    if (cpuinfo_line("flags", flags, sizeof(flags)) != 0) {
+        cpuinfo_line("Features", flags, sizeof(flags));
+    }
+    if (flags[0] == '\0') {
+#if defined(__AVX2__)
+        strcat(flags, " avx2");
+#endif
+#if defined(__SSE2__)
+        strcat(flags, " sse2");
+#endif
+#if defined(__ARM_NEON)
+        strcat(flags, " asimd");
+#endif
+    }
+
+    fprintf(json_file, "    \"cpu_flags\": [");
+    int first = 1;
+    for (size_t i = 0; i < sizeof(interesting_flags) / sizeof(char *); i++) {
+        // Whole words only: "avx" must not match "avx2"
+        size_t len = strlen(interesting_flags[i]);
+        for (const char *p = strstr(flags, interesting_flags[i]); p != NULL;
+             p = strstr(p + 1, interesting_flags[i])) {
+            if ((p == flags || p[-1] == ' ') &&
+                (p[len] == ' ' || p[len] == '\0')) {
+                fprintf(json_file, first ? "" : ", ");
+                json_string(interesting_flags[i]);
+                first = 0;
+                break;
+            }
+        }
+    }
+    fprintf(json_file, "],\n");
+}
+
+int bench_json_begin(const bench_config_t *config, const char *suite) {
+    if (config == NULL || config->json_path == NULL) {
+        return 0;
+    }
+
+    json_file = fopen(config->json_path, "w");
+    if (json_file == NULL) {
+        return -1;
+    }
+    json_results = 0;
+    json_error = 0;
+
+    struct utsname uts;
+    char os[256] = "unknown";
+    char machine[128] = "unknown";
+    char host[128] = "unknown";
+    if (uname(&uts) == 0) {
+        snprintf(os, sizeof(os), "%s %s", uts.sysname, uts.release);
+        snprintf(machine, sizeof(machine), "%s", uts.machine);
+        snprintf(host, sizeof(host), "%s", uts.nodename);
+    }
+
+    char cpu[256];
+    cpu_model(cpu, sizeof(cpu));
+
+    char cpus[16];
+    snprintf(cpus, sizeof(cpus), "%ld", sysconf(_SC_NPROCESSORS_ONLN));
+
+    char timestamp[32];
+    time_t now = time(NULL);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ",
+             gmtime(&now));
+
+    fprintf(json_file, "{\n  \"suite\": ");
+    json_string(suite != NULL ? suite : "");
+    fprintf(json_file, ",\n  \"environment\": {\n");
+    json_field("os", os, 0);
+    json_field("machine", machine, 0);
+    json_field("host", host, 0);
+    json_field("cpu", cpu, 0);
+    json_field("cpus", cpus, 0);
+    json_cpu_flags();
+    json_field("dispatch", "portable", 0);
+#if defined(__clang__)
+    json_field("compiler", "clang " __clang_version__, 0);
+#elif defined(__GNUC__)
+    json_field("compiler", "gcc " __VERSION__, 0);
+#else
+    json_field("compiler", "unknown", 0);
+#endif
+#ifdef __OPTIMIZE__
+    json_field("build", "optimized", 0);
+#else
+    json_field("build", "unoptimized", 0);
+#endif
+    json_field("timestamp", timestamp, 1);
+    fprintf(json_file, "  },\n");
+    fprintf(json_file,
+            "  \"config\": {\"warmup\": %u, \"reps\": %u, "
+            "\"min_sample_ms\": %g},\n",
+            config->warmup, config->reps, config->min_sample_ms);
+    fprintf(json_file, "  \"results\": [");
+    return ferror(json_file) ? -1 : 0;
+}
+
+void bench_json_result(const bench_result_t *result) {
+    if (json_file == NULL || result == NULL) {
+        return;
+    }
+
+    fprintf(json_file, json_results++ ? ",\n    {" : "\n    {");
+    fprintf(json_file, "\"name\": ");
+    json_string(result->name);
+    fprintf(json_file, ", \"params\": ");
+    json_string(result->params);
+    fprintf(json_file,
+            ", \"bytes\": %zu, \"iters\": %llu, \"items\": %g, "
+            "\"allocs\": %g,\n     \"ns_min\": %.3f, \"ns_p50\": %.3f, "
+            "\"ns_p90\": %.3f, \"ns_p99\": %.3f, \"cycles_p50\": %.3f,\n"
+            "     \"samples_ns\": [",
+            result->bytes, (unsigned long long)result->iters, result->items,
+            result->allocs, result->ns_min, result->ns_p50, result->ns_p90,
+            result->ns_p99, result->cycles_p50);
+    for (unsigned i = 0; i < result->samples && i < BENCH_MAX_REPS; i++) {
+        fprintf(json_file, i ? ", %.3f" : "%.3f", result->ns[i]);
+    }
+    fprintf(json_file, "]");
+    if (result->perf[BENCH_PERF_CYCLES] >= 0.0) {
+        fprintf(json_file, ",\n     \"perf\": {");
+        for (int e = 0; e < BENCH_PERF_COUNT; e++) {
+            fprintf(json_file, "%s\"%s\": ", e ? ", " : "", perf_names[e]);
+            if (result->perf[e] < 0.0) {
+                fprintf(json_file, "null");
+            } else {
+                fprintf(json_file, "%.4f", result->perf[e]);
+            }
+        }
+        fprintf(json_file, "}");
+    }
+    fprintf(json_file, "}");
+    json_error |= ferror(json_file);
+}
+
+int bench_json_end(void) {
+    if (json_file == NULL) {
+        return 0;
+    }
+
+    fprintf(json_file, "\n  ]\n}\n");
+    json_error |= ferror(json_file);
+    json_error |= (fclose(json_file) != 0);
+    json_file = NULL;
+    return json_error ? -1 : 0;
+}
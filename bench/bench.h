@@ -0,0 +1,208 @@
+#ifndef SSS_BENCH_H
+#define SSS_BENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Benchmark Harness
+ *
+ * Shared by the benchmark executables. A benchmark is a function that
+ * runs the measured operation a given number of times. The harness:
+ *
+ * 1. Calibrates that number so one sample takes at least min_sample_ms,
+ *    which keeps timer overhead and resolution out of the result.
+ * 2. Runs warmup untimed samples (caches, branch predictors, frequency).
+ * 3. Times reps samples and reports per-operation statistics over them:
+ *    median, percentiles and minimum, in nanoseconds and, where a cycle
+ *    counter is available, in cycles per operation and per byte.
+ *
+ * Results that a benchmark computes must reach bench_sink, so the
+ * compiler cannot drop the work.
+ * ======================================================================== */
+
+/* Most timed samples per benchmark */
+#define BENCH_MAX_REPS 255
+
+/* Hardware events counted with -p (Linux perf events) */
+typedef enum {
+    BENCH_PERF_CYCLES,
+    BENCH_PERF_INSTRUCTIONS,
+    BENCH_PERF_L1D_MISSES,      // L1 data cache read misses
+    BENCH_PERF_LLC_MISSES,      // Last-level cache read misses
+    BENCH_PERF_BRANCH_MISSES,
+    BENCH_PERF_COUNT
+} bench_perf_event_t;
+
+/* Harness settings, shared by every benchmark of a run */
+typedef struct {
+    unsigned warmup;            // Untimed samples
+    unsigned reps;              // Timed samples
+    double min_sample_ms;       // Shortest sample
+    const char *filter;         // Run only names containing this (or NULL)
+    const char *json_path;      // Also write results here as JSON (or NULL)
+    int perf;                   // Count hardware events around samples
+} bench_config_t;
+
+/* Statistics of one benchmark, per operation */
+typedef struct {
+    char name[48];
+    char params[48];
+    size_t bytes;               // Bytes processed per operation (0 = n/a)
+    uint64_t iters;             // Operations per sample
+    unsigned samples;
+    double ns_min;
+    double ns_p50;
+    double ns_p90;
+    double ns_p99;
+    double cycles_p50;          // Median cycles (0 if no cycle counter)
+    double items;               // Values per operation, for throughput (1)
+    double allocs;              // Allocations per value (-1 = not counted)
+    double perf[BENCH_PERF_COUNT]; // Events per operation (-1 = not counted)
+    double ns[BENCH_MAX_REPS];  // Time per operation of each sample, sorted
+} bench_result_t;
+
+/**
+ * Benchmark body: run the operation iters times.
+ */
+typedef void (*bench_fn)(void *arg, uint64_t iters);
+
+/* Results go here so they stay observable */
+extern volatile uint64_t bench_sink;
+
+/**
+ * Default settings (5 warmup samples, 31 timed samples of at least 2 ms).
+ */
+void bench_config_default(bench_config_t *config);
+
+/**
+ * Read the common options into config:
+ *   -w warmup  -r reps  -m min_sample_ms  -f filter  -j json_path
+ *   -p (hardware counters)  -q (quick: 1 warmup, 7 samples of 0.5 ms)
+ *
+ * @return Index of the first non-option argument, or -1 on a bad option
+ */
+int bench_parse_args(int argc, char **argv, bench_config_t *config);
+
+/**
+ * Whether a benchmark is selected by the filter.
+ */
+int bench_selected(const bench_config_t *config, const char *name);
+
+/**
+ * Calibrate, warm up and time a benchmark.
+ *
+ * @param config  Harness settings
+ * @param name    Benchmark name (e.g. "gf256_mul")
+ * @param params  Parameters, for the report (e.g. "t=3 n=5 len=32")
+ * @param bytes   Bytes processed per operation, for cycles per byte
+ * @param fn      Benchmark body
+ * @param arg     Argument passed to fn
+ * @param result  Output: statistics
+ * @return 0 on success, -1 on failure
+ */
+int bench_run(const bench_config_t *config, const char *name,
+              const char *params, size_t bytes, bench_fn fn, void *arg,
+              bench_result_t *result);
+
+/**
+ * Print the table header and one row per result.
+ */
+void bench_print_header(void);
+void bench_print_result(const bench_result_t *result);
+
+/**
+ * Print the hardware counters of a result as an extra line: IPC and
+ * misses per operation. Prints nothing if no event was counted.
+ */
+void bench_print_perf(const bench_result_t *result);
+
+/* ========================================================================
+ * Hardware Counters
+ *
+ * With -p, cycles, instructions, L1D and LLC read misses and branch
+ * misses are counted (user space only) across the timed samples, and
+ * reported per operation. A slowdown then comes with its reason: IPC
+ * dropped, or LLC misses doubled.
+ *
+ * The events are opened with perf_event_open() as one group, scaled if
+ * the kernel multiplexed them. Where they cannot be opened (not Linux,
+ * containers without CAP_PERFMON, perf_event_paranoid too high, virtual
+ * machines without a PMU), the run goes on without them after a single
+ * notice on stderr, and every event reads as -1.
+ * ======================================================================== */
+
+/**
+ * Name of an event, as used in the JSON report (e.g. "llc_misses").
+ */
+const char *bench_perf_name(bench_perf_event_t event);
+
+/* ========================================================================
+ * JSON Report
+ *
+ * With -j, a run is also written as one JSON document for the
+ * comparator (bench_compare):
+ *
+ *   {"suite": "sss_bench",
+ *    "environment": {"os", "machine", "cpu", "cpu_flags", "dispatch",
+ *                    "compiler", "build", "timestamp", ...},
+ *    "config": {"warmup", "reps", "min_sample_ms"},
+ *    "results": [{"name", "params", "bytes", "iters", "items", "allocs",
+ *                 "ns_min", "ns_p50", "ns_p90", "ns_p99", "cycles_p50",
+ *                 "samples_ns": [...], "perf": {"cycles", ...}}, ...]}
+ *
+ * The raw samples are kept so regressions can be tested for
+ * significance rather than read off two medians. "perf" holds the
+ * hardware events per operation and is only present with -p when some
+ * could be counted (null for the others). "dispatch" names the
+ * field arithmetic implementation that was measured; the library has a
+ * single portable one, so it is always "portable".
+ *
+ * All three calls do nothing when config->json_path is NULL.
+ * ======================================================================== */
+
+/**
+ * Open the report and write the environment.
+ *
+ * @param config  Harness settings
+ * @param suite   Name of the benchmark executable
+ * @return 0 on success, -1 if the file cannot be written
+ */
+int bench_json_begin(const bench_config_t *config, const char *suite);
+
+/**
+ * Append one result to the report.
+ */
+void bench_json_result(const bench_result_t *result);
+
+/**
+ * Close the report.
+ *
+ * @return 0 on success, -1 if writing failed at any point
+ */
+int bench_json_end(void);
+
+/**
+ * Monotonic time in nanoseconds.
+ */
+double bench_now_ns(void);
+
+/**
+ * Cycle counter (the TSC on x86), or 0 where there is none.
+ */
+uint64_t bench_cycles(void);
+
+/**
+ * Fill a buffer with deterministic pseudo-random bytes.
+ */
+void bench_fill(uint8_t *buffer, size_t len, uint64_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_BENCH_H */
@@ -0,0 +1,703 @@
+/**
+ * Benchmark Regression Comparator
+ *
+ * Compares two JSON reports written by sss_bench or mpc_bench (-j) and
+ * flags the benchmarks whose median moved by more than a threshold,
+ * provided the move is statistically significant.
+ *
+ * Significance comes from a two-sided Mann-Whitney U test on the raw
+ * samples of the two runs: exact when neither run has more than 20
+ * samples, otherwise the normal approximation corrected for ties.
+ * The test compares ranks rather than means, so the odd sample slowed
+ * down by an interrupt cannot fake or hide a change the way it would
+ * in a t-test.
+ *
+ * A benchmark is a regression when its median grew by more than the
+ * threshold and p < alpha, and an improvement in the mirror case.
+ * Everything else is reported as unchanged ("~").
+ *
+ * When both reports carry hardware counters (-p), a changed benchmark
+ * also gets the counters that moved: "IPC 2.10->1.43" when instructions
+ * per cycle shifted by more than 10 %, "llc_misses x2.3" when misses
+ * per operation at least doubled or halved.
+ *
+ * Usage:
+ *   bench_compare [-t threshold_pct] [-a alpha] [-q] baseline.json
+ *                 candidate.json
+ *   (defaults: 5 % and 0.01; -q: only print changed benchmarks)
+ *
+ * Exit status: 0 if no regression, 1 if any, 2 on bad input.
+ */
+
+#define _GNU_SOURCE
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Deepest nesting accepted in a report */
+#define MAX_DEPTH 32
+
+/* Largest sample count per run for which p-values are computed exactly */
+#define EXACT_MAX_SAMPLES 20
+
+/* ========================================================================
+ * JSON Reader
+ *
+ * Just enough JSON for the reports: the whole document is read into a
+ * tree of values. Strings keep ASCII escapes; other \u escapes become
+ * '?', which no field of a report depends on.
+ * ======================================================================== */
+
+typedef enum {
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+} json_type_t;
+
+typedef struct json_value {
+    json_type_t type;
+    double number;
+    char *string;
+    struct json_value *items;       // Array elements or object members
+    char **keys;                    // Object member names
+    size_t count;
+} json_value_t;
+
+typedef struct {
+    const char *p;
+    int depth;
+} json_parser_t;
+
+static int json_parse_value(json_parser_t *parser, json_value_t *value);
+
+static void json_free(json_value_t *value) {
+    for (size_t i = 0; i < value->count; i++) {
+        json_free(&value->items[i]);
+        if (value->keys != NULL) {
+            free(value->keys[i]);
+        }
+    }
+    free(value->items);
+    free(value->keys);
+    free(value->string);
+    memset(value, 0, sizeof(json_value_t));
+}
+
+static void json_skip_space(json_parser_t *parser) {
+    while (*parser->p == ' ' || *parser->p == '\t' || *parser->p == '\n' ||
+           *parser->p == '\r') {
+        parser->p++;
+    }
+}
+
+static char *json_parse_string(json_parser_t *parser) {
+    if (*parser->p != '"') {
+        return NULL;
+    }
+    parser->p++;
+
+    // Escapes only shrink the text, so its raw length is enough
+    const char *end = parser->p;
+    while (*end != '\0' && *end != '"') {
+        end += (*end == '\\' && end[1] != '\0') ? 2 : 1;
+    }
+    if (*end != '"') {
+        return NULL;
+    }
+
+    char *out = malloc((size_t)(end - parser->p) + 1);
+    if (out == NULL) {
+        return NULL;
+    }
+    size_t len = 0;
+    while (parser->p < end) {
+        char c = *parser->p++;
+        if (c != '\\') {
+            out[len++] = c;
+            continue;
+        }
+        c = *parser->p++;
+        switch (c) {
+        case 'b': out[len++] = '\b'; break;
+        case 'f': out[len++] = '\f'; break;
+        case 'n': out[len++] = '\n'; break;
+        case 'r': out[len++] = '\r'; break;
+        case 't': out[len++] = '\t'; break;
+        case 'u': {
+            unsigned code = 0;
+            if (sscanf(parser->p, "%4x", &code) != 1 || end - parser->p < 4) {
+                free(out);
+                return NULL;
+            }
+            parser->p += 4;
+            out[len++] = (code < 0x80) ? (char)code : '?';
+            break;
+        }
+        default:
+            out[len++] = c;         // \" \\ \/
+            break;
+        }
+    }
+    out[len] = '\0';
+    parser->p = end + 1;
+    return out;
+}
+
+static int json_append(json_value_t *container, json_value_t *item,
+                       char *key) {
+    json_value_t *items = realloc(container->items,
+                                  (container->count + 1) * sizeof(*items));
+    if (items == NULL) {
+        return -1;
+    }
+    container->items = items;
+    if (container->type == JSON_OBJECT) {
+        char **keys = realloc(container->keys,
+                              (container->count + 1) * sizeof(char *));
+        if (keys == NULL) {
+            return -1;
+        }
+        container->keys = keys;
+        keys[container->count] = key;
+    }
+    items[container->count++] = *item;
+    return 0;
+}
+
+static int json_parse_container(json_parser_t *parser, json_value_t *value,
+                                json_type_t type, char close) {
+    value->type = type;
+    parser->p++;
+    if (++parser->depth > MAX_DEPTH) {
+        return -1;
+    }
+
+    json_skip_space(parser);
+    if (*parser->p == close) {
+        parser->p++;
+        parser->depth--;
+        return 0;
+    }
+
+    for (;;) {
+        char *key = NULL;
+        json_value_t item;
+        memset(&item, 0, sizeof(item));
+
+        json_skip_space(parser);
+        if (type == JSON_OBJECT) {
+            key = json_parse_string(parser);
+            json_skip_space(parser);
+            if (key == NULL || *parser->p != ':') {
+                free(key);
+                return -1;
+            }
+            parser->p++;
+        }
+        if (json_parse_value(parser, &item) != 0 ||
+            json_append(value, &item, key) != 0) {
+            json_free(&item);
+            free(key);
+            return -1;
+        }
+
+        json_skip_space(parser);
+        if (*parser->p == ',') {
+            parser->p++;
+        } else if (*parser->p == close) {
+            parser->p++;
+            parser->depth--;
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+}
+
+static int json_parse_value(json_parser_t *parser, json_value_t *value) {
+    json_skip_space(parser);
+    const char *p = parser->p;
+
+    if (*p == '{') {
+        return json_parse_container(parser, value, JSON_OBJECT, '}');
+    }
+    if (*p == '[') {
+        return json_parse_container(parser, value, JSON_ARRAY, ']');
+    }
+    if (*p == '"') {
+        value->type = JSON_STRING;
+        value->string = json_parse_string(parser);
+        return value->string != NULL ? 0 : -1;
+    }
+    if (strncmp(p, "true", 4) == 0 || strncmp(p, "false", 5) == 0) {
+        value->type = JSON_BOOL;
+        value->number = (*p == 't');
+        parser->p += (*p == 't') ? 4 : 5;
+        return 0;
+    }
+    if (strncmp(p, "null", 4) == 0) {
+        value->type = JSON_NULL;
+        parser->p += 4;
+        return 0;
+    }
+
+    char *end;
+    value->type = JSON_NUMBER;
+    value->number = strtod(p, &end);
+    if (end == p) {
+        return -1;
+    }
+    parser->p = end;
+    return 0;
+}
+
+static const json_value_t *json_get(const json_value_t *object,
+                                    const char *key) {
+    if (object == NULL || object->type != JSON_OBJECT) {
+        return NULL;
+    }
+    for (size_t i = 0; i < object->count; i++) {
+        if (strcmp(object->keys[i], key) == 0) {
+            return &object->items[i];
+        }
+    }
+    return NULL;
+}
+
+static const char *json_get_string(const json_value_t *object,
+                                   const char *key) {
+    const json_value_t *value = json_get(object, key);
+    return (value != NULL && value->type == JSON_STRING) ? value->string : "";
+}
+
+/* ========================================================================
+ * Reports
+ * ======================================================================== */
+
+typedef struct {
+    json_value_t root;
+    const json_value_t *environment;
+    const json_value_t *results;
+} report_t;
+
+static int load_report(const char *path, report_t *report) {
+    memset(report, 0, sizeof(report_t));
+
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "bench_compare: cannot open %s\n", path);
+        return -1;
+    }
+
+    size_t capacity = 1 << 16;
+    size_t len = 0;
+    char *text = malloc(capacity);
+    while (text != NULL) {
+        len += fread(text + len, 1, capacity - len - 1, f);
+        if (len < capacity - 1) {
+            break;
+        }
+        char *grown = realloc(text, capacity * 2);
+        if (grown == NULL) {
+            free(text);
+        }
+        text = grown;
+        capacity *= 2;
+    }
+    fclose(f);
+    if (text == NULL) {
+        return -1;
+    }
+    text[len] = '\0';
+
+    json_parser_t parser = {text, 0};
+    int status = json_parse_value(&parser, &report->root);
+    free(text);
+
+    report->environment = json_get(&report->root, "environment");
+    report->results = json_get(&report->root, "results");
+    if (status != 0 || report->results == NULL ||
+        report->results->type != JSON_ARRAY) {
+        fprintf(stderr, "bench_compare: %s is not a benchmark report\n",
+                path);
+        json_free(&report->root);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Result of a report with the given name and parameters, or NULL
+ */
+static const json_value_t *find_result(const report_t *report,
+                                       const char *name, const char *params) {
+    for (size_t i = 0; i < report->results->count; i++) {
+        const json_value_t *r = &report->results->items[i];
+        if (strcmp(json_get_string(r, "name"), name) == 0 &&
+            strcmp(json_get_string(r, "params"), params) == 0) {
+            return r;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Copy the samples of a result; returns their number (0 if none)
+ */
+static size_t get_samples(const json_value_t *result, double **samples) {
+    const json_value_t *array = json_get(result, "samples_ns");
+    *samples = NULL;
+    if (array == NULL || array->type != JSON_ARRAY || array->count == 0) {
+        return 0;
+    }
+
+    *samples = malloc(array->count * sizeof(double));
+    if (*samples == NULL) {
+        return 0;
+    }
+    for (size_t i = 0; i < array->count; i++) {
+        (*samples)[i] = array->items[i].number;
+    }
+    return array->count;
+}
+
+/**
+ * Hardware event per operation of a result (-1 if not counted)
+ */
+static double get_perf(const json_value_t *result, const char *event) {
+    const json_value_t *value = json_get(json_get(result, "perf"), event);
+    if (value == NULL || value->type != JSON_NUMBER) {
+        return -1.0;
+    }
+    return value->number;
+}
+
+/**
+ * Describe the hardware counters that moved between two results;
+ * leaves note empty if none did or either side has no counters
+ */
+static void explain_perf(const json_value_t *base, const json_value_t *cand,
+                         char *note, size_t size) {
+    static const char *const misses[] = {
+        "l1d_misses", "llc_misses", "branch_misses"
+    };
+    size_t used = 0;
+    note[0] = '\0';
+
+    double base_cycles = get_perf(base, "cycles");
+    double cand_cycles = get_perf(cand, "cycles");
+    double base_insns = get_perf(base, "instructions");
+    double cand_insns = get_perf(cand, "instructions");
+    if (base_cycles > 0.0 && cand_cycles > 0.0 && base_insns >= 0.0 &&
+        cand_insns >= 0.0) {
+        double base_ipc = base_insns / base_cycles;
+        double cand_ipc = cand_insns / cand_cycles;
+        if (base_ipc > 0.0 && fabs(cand_ipc / base_ipc - 1.0) > 0.10) {
+            used += (size_t)snprintf(note + used, size - used,
+                                     "  IPC %.2f->%.2f", base_ipc, cand_ipc);
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(misses) / sizeof(misses[0]); i++) {
+        double b = get_perf(base, misses[i]);
+        double c = get_perf(cand, misses[i]);
+        if (b <= 0.0 || c < 0.0 || used >= size) {
+            continue;
+        }
+        double ratio = c / b;
+        if (ratio >= 2.0 || ratio <= 0.5) {
+            used += (size_t)snprintf(note + used, size - used, "  %s x%.2g",
+                                     misses[i], ratio);
+        }
+    }
+}
+
+/* ========================================================================
+ * Statistics
+ * ======================================================================== */
+
+typedef struct {
+    double value;
+    int group;                      // 0 = baseline, 1 = candidate
+} ranked_t;
+
+static int compare_ranked(const void *a, const void *b) {
+    double x = ((const ranked_t *)a)->value;
+    double y = ((const ranked_t *)b)->value;
+    return (x > y) - (x < y);
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double *samples, size_t count) {
+    qsort(samples, count, sizeof(double), compare_double);
+    return (count % 2) ? samples[count / 2]
+                       : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+}
+
+/**
+ * Exact two-sided p-value of the rank-sum test.
+ *
+ * rank2 holds twice the (average) rank of every sample, so ties stay
+ * integers. Counts the ways to pick na of the n ranks with each sum and
+ * returns the share of picks at least as far from the mean as the
+ * observed sum of the baseline, i.e. the permutation distribution of U
+ * given the ties. Counts stay below C(40, 20) < 2^53, exact in a double.
+ */
+static double rank_sum_exact_p(const size_t *rank2, size_t n, size_t na,
+                               size_t observed) {
+    size_t max_sum = (size_t)n * (n + 1);
+    size_t width = max_sum + 1;
+    double *ways = calloc((na + 1) * width, sizeof(double));
+    if (ways == NULL) {
+        return 1.0;
+    }
+
+    // ways[k * width + s]: subsets of k ranks seen so far summing to s
+    ways[0] = 1.0;
+    for (size_t i = 0; i < n; i++) {
+        size_t top = (i + 1 < na) ? i + 1 : na;
+        for (size_t k = top; k >= 1; k--) {
+            for (size_t s = rank2[i]; s <= max_sum; s++) {
+                ways[k * width + s] += ways[(k - 1) * width + s - rank2[i]];
+            }
+        }
+    }
+
+    double mean = (double)na * (n + 1);
+    double distance = fabs((double)observed - mean);
+    double total = 0.0;
+    double extreme = 0.0;
+    for (size_t s = 0; s <= max_sum; s++) {
+        double count = ways[na * width + s];
+        total += count;
+        if (fabs((double)s - mean) >= distance) {
+            extreme += count;
+        }
+    }
+    free(ways);
+    return (total > 0.0) ? extreme / total : 1.0;
+}
+
+/**
+ * Two-sided p-value of the Mann-Whitney U test that a and b come from
+ * the same distribution
+ */
+static double mann_whitney_p(const double *a, size_t na, const double *b,
+                             size_t nb) {
+    size_t n = na + nb;
+    if (na == 0 || nb == 0) {
+        return 1.0;
+    }
+    ranked_t *all = malloc(n * sizeof(ranked_t));
+    size_t *rank2 = malloc(n * sizeof(size_t));
+    if (all == NULL || rank2 == NULL) {
+        free(all);
+        free(rank2);
+        return 1.0;
+    }
+    for (size_t i = 0; i < na; i++) {
+        all[i].value = a[i];
+        all[i].group = 0;
+    }
+    for (size_t i = 0; i < nb; i++) {
+        all[na + i].value = b[i];
+        all[na + i].group = 1;
+    }
+    qsort(all, n, sizeof(ranked_t), compare_ranked);
+
+    // Rank sum of the baseline; tied values share their average rank
+    size_t rank2_sum = 0;
+    double tie_term = 0.0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && all[j].value == all[i].value) {
+            j++;
+        }
+        for (size_t k = i; k < j; k++) {
+            rank2[k] = i + 1 + j;
+            if (all[k].group == 0) {
+                rank2_sum += rank2[k];
+            }
+        }
+        double t = (double)(j - i);
+        tie_term += t * t * t - t;
+        i = j;
+    }
+    free(all);
+
+    // The normal approximation is too coarse for small runs
+    if (na <= EXACT_MAX_SAMPLES && nb <= EXACT_MAX_SAMPLES) {
+        double p = rank_sum_exact_p(rank2, n, na, rank2_sum);
+        free(rank2);
+        return p;
+    }
+    free(rank2);
+
+    double rank_sum = (double)rank2_sum / 2.0;
+
+    double u = rank_sum - (double)na * (na + 1) / 2.0;
+    double mean = (double)na * nb / 2.0;
+    double variance = (double)na * nb / 12.0 *
+                      ((n + 1) - tie_term / ((double)n * (n - 1)));
+    if (variance <= 0.0) {
+        return 1.0;                 // All samples equal
+    }
+
+    // Continuity correction
+    double z = (fabs(u - mean) - 0.5) / sqrt(variance);
+    if (z < 0.0) {
+        z = 0.0;
+    }
+    return erfc(z / sqrt(2.0));
+}
+
+/* ========================================================================
+ * Main
+ * ======================================================================== */
+
+static void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-t threshold_pct] [-a alpha] [-q] "
+            "baseline.json candidate.json\n", program);
+}
+
+static void warn_if_different(const report_t *base, const report_t *cand,
+                              const char *key) {
+    const char *a = json_get_string(base->environment, key);
+    const char *b = json_get_string(cand->environment, key);
+    if (strcmp(a, b) != 0) {
+        printf("warning: %s differs: \"%s\" vs \"%s\"\n", key, a, b);
+    }
+}
+
+int main(int argc, char **argv) {
+    double threshold = 5.0;
+    double alpha = 0.01;
+    int quiet = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "t:a:q")) != -1) {
+        switch (opt) {
+        case 't':
+            threshold = atof(optarg);
+            break;
+        case 'a':
+            alpha = atof(optarg);
+            break;
+        case 'q':
+            quiet = 1;
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (argc - optind != 2 || threshold < 0.0 || !(alpha > 0.0)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    report_t base;
+    report_t cand;
+    if (load_report(argv[optind], &base) != 0) {
+        return 2;
+    }
+    if (load_report(argv[optind + 1], &cand) != 0) {
+        json_free(&base.root);
+        return 2;
+    }
+
+    // Numbers from different machines or builds are not comparable
+    warn_if_different(&base, &cand, "cpu");
+    warn_if_different(&base, &cand, "dispatch");
+    warn_if_different(&base, &cand, "compiler");
+    warn_if_different(&base, &cand, "build");
+
+    printf("%-24s %-24s %12s %12s %8s %8s  %s\n", "benchmark", "params",
+           "base p50", "cand p50", "change", "p", "verdict");
+
+    unsigned regressions = 0;
+    unsigned improvements = 0;
+    unsigned unchanged = 0;
+    unsigned unmatched = 0;
+
+    for (size_t i = 0; i < cand.results->count; i++) {
+        const json_value_t *c = &cand.results->items[i];
+        const char *name = json_get_string(c, "name");
+        const char *params = json_get_string(c, "params");
+        const json_value_t *b = find_result(&base, name, params);
+        if (b == NULL) {
+            printf("%-24s %-24s %12s  (new)\n", name, params, "-");
+            unmatched++;
+            continue;
+        }
+
+        double *xs;
+        double *ys;
+        size_t nx = get_samples(b, &xs);
+        size_t ny = get_samples(c, &ys);
+        if (nx == 0 || ny == 0) {
+            printf("%-24s %-24s  (no samples)\n", name, params);
+            free(xs);
+            free(ys);
+            unmatched++;
+            continue;
+        }
+
+        double p = mann_whitney_p(xs, nx, ys, ny);
+        double base_p50 = median(xs, nx);
+        double cand_p50 = median(ys, ny);
+        double change = (base_p50 > 0.0)
+                        ? (cand_p50 - base_p50) / base_p50 * 100.0 : 0.0;
+        free(xs);
+        free(ys);
+
+        const char *verdict = "~";
+        if (p < alpha && change > threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (p < alpha && change < -threshold) {
+            verdict = "improvement";
+            improvements++;
+        } else {
+            unchanged++;
+            if (quiet) {
+                continue;
+            }
+        }
+
+        char note[160] = "";
+        if (strcmp(verdict, "~") != 0) {
+            explain_perf(b, c, note, sizeof(note));
+        }
+        printf("%-24s %-24s %12.1f %12.1f %+7.1f%% %8.4f  %s%s\n", name,
+               params, base_p50, cand_p50, change, p, verdict, note);
+    }
+
+    for (size_t i = 0; i < base.results->count; i++) {
+        const json_value_t *b = &base.results->items[i];
+        if (find_result(&cand, json_get_string(b, "name"),
+                        json_get_string(b, "params")) == NULL) {
+            printf("%-24s %-24s  (missing)\n", json_get_string(b, "name"),
+                   json_get_string(b, "params"));
+            unmatched++;
+        }
+    }
+
+    printf("\n%u regressions, %u improvements, %u unchanged, %u unmatched "
+           "(threshold %.1f%%, alpha %g)\n", regressions, improvements,
+           unchanged, unmatched, threshold, alpha);
+
+    json_free(&base.root);
+    json_free(&cand.root);
+    return regressions > 0;
+}
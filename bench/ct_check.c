@@ -0,0 +1,346 @@
+/**
+ * Constant-Time Check
+ *
+ * Looks for secret-dependent timing in the field and interpolation
+ * kernels the way dudect does: time a kernel many times on two classes
+ * of secret input, one fixed and one random, interleaved at random, and
+ * run Welch's t-test on the two timing distributions. A kernel whose
+ * time does not depend on its inputs gives |t| near zero however many
+ * measurements are taken; a leak makes |t| grow with their number.
+ *
+ * Each kernel is also tested on its measurements cropped above several
+ * percentiles, since the tail is mostly interrupts and cache misses that
+ * can drown a small difference, and the largest |t| is reported:
+ *
+ *   |t| < 4.5   no leak detected
+ *   |t| >= 4.5  leak (class means differ with overwhelming confidence)
+ *
+ * Passing is evidence, not proof: a leak may need more measurements or
+ * another fixed input to show. Timing uses the cycle counter on x86 and
+ * the monotonic clock elsewhere, where each measurement times a batch
+ * of calls to rise above the clock resolution.
+ *
+ * The field has one implementation (the portable one), so there is one
+ * dispatch tier to test; it is named in the output so results of
+ * different builds are not confused.
+ *
+ * Usage:
+ *   ct_check [-n measurements] [-t threshold] [-f filter] [-q]
+ *   (defaults: 1000000 and 4.5; -q: 100000 measurements)
+ *
+ * Exit status: 0 if no kernel leaks, 1 if any does, 2 on bad arguments.
+ */
+
+#define _GNU_SOURCE
+#include "bench.h"
+#include "sss/field.h"
+#include "sss/polynomial.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Measurements prepared and timed at a time */
+#define CHUNK 4096
+
+/* Points of the interpolation kernel */
+#define INTERPOLATE_POINTS 3
+
+/* Cropping percentiles (0 = all measurements) */
+static const double crops[] = {0.0, 0.50, 0.75, 0.90, 0.95, 0.99};
+
+#define NUM_CROPS (sizeof(crops) / sizeof(crops[0]))
+
+#define COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+/* ========================================================================
+ * Kernels
+ * ======================================================================== */
+
+typedef struct {
+    const char *name;
+    size_t input_size;              // Secret bytes per call
+    unsigned calls;                 // Calls per measurement off x86
+    const char *fixed;              // What the fixed class is
+    void (*run)(const uint8_t *input, unsigned calls);
+} kernel_t;
+
+static void run_gf256_mul(const uint8_t *input, unsigned calls) {
+    uint8_t acc = 0;
+    for (unsigned i = 0; i < calls; i++) {
+        acc ^= gf256_mul(input[2 * i], input[2 * i + 1]);
+    }
+    bench_sink += acc;
+}
+
+static void run_gf256_inv(const uint8_t *input, unsigned calls) {
+    uint8_t acc = 0;
+    for (unsigned i = 0; i < calls; i++) {
+        acc ^= gf256_inv(input[i]);
+    }
+    bench_sink += acc;
+}
+
+static void run_interpolate(const uint8_t *input, unsigned calls) {
+    // Share indices are public; the share values are the secret
+    static const uint8_t x[INTERPOLATE_POINTS] = {1, 2, 3};
+    uint8_t acc = 0;
+    for (unsigned i = 0; i < calls; i++) {
+        acc ^= sss_polynomial_interpolate(x, input + i * INTERPOLATE_POINTS,
+                                          INTERPOLATE_POINTS);
+    }
+    bench_sink += acc;
+}
+
+static const kernel_t kernels[] = {
+    {"gf256_mul",   2,                  64, "a = b = 0", run_gf256_mul},
+    {"gf256_inv",   1,                  16, "a = 0",     run_gf256_inv},
+    {"interpolate", INTERPOLATE_POINTS, 4,  "y = 0",     run_interpolate},
+};
+
+/* ========================================================================
+ * Welch's t-test
+ * ======================================================================== */
+
+/* Running mean and variance of each class (Welford) */
+typedef struct {
+    double n[2];
+    double mean[2];
+    double m2[2];
+} welch_t;
+
+static void welch_push(welch_t *test, int cls, double x) {
+    test->n[cls] += 1.0;
+    double delta = x - test->mean[cls];
+    test->mean[cls] += delta / test->n[cls];
+    test->m2[cls] += delta * (x - test->mean[cls]);
+}
+
+static double welch_t_value(const welch_t *test) {
+    if (test->n[0] < 2.0 || test->n[1] < 2.0) {
+        return 0.0;
+    }
+    double var0 = test->m2[0] / (test->n[0] - 1.0);
+    double var1 = test->m2[1] / (test->n[1] - 1.0);
+    double se = sqrt(var0 / test->n[0] + var1 / test->n[1]);
+    return se > 0.0 ? (test->mean[0] - test->mean[1]) / se : 0.0;
+}
+
+/* ========================================================================
+ * Measurement
+ * ======================================================================== */
+
+static uint64_t rng_state;
+
+static uint64_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static uint64_t ticks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return bench_cycles();
+#else
+    return (uint64_t)bench_now_ns();
+#endif
+}
+
+static unsigned calls_per_measurement(const kernel_t *kernel) {
+#if defined(__x86_64__) || defined(__i386__)
+    (void)kernel;
+    return 1;
+#else
+    return kernel->calls;
+#endif
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    uint8_t *inputs;                // CHUNK measurements of input
+    uint8_t cls[CHUNK];             // 0 = fixed, 1 = random
+    double time[CHUNK];
+} chunk_t;
+
+/**
+ * Prepare and time one chunk of measurements. All inputs are drawn
+ * before any timing, so drawing them cannot leak into the times.
+ */
+static void measure_chunk(const kernel_t *kernel, unsigned calls,
+                          chunk_t *chunk) {
+    size_t stride = kernel->input_size * calls;
+
+    for (size_t m = 0; m < CHUNK; m++) {
+        uint8_t *input = chunk->inputs + m * stride;
+        chunk->cls[m] = (uint8_t)(rng_next() & 1);
+        if (chunk->cls[m] == 0) {
+            memset(input, 0, stride);
+        } else {
+            for (size_t i = 0; i < stride; i++) {
+                input[i] = (uint8_t)(rng_next() >> 32);
+            }
+        }
+    }
+
+    for (size_t m = 0; m < CHUNK; m++) {
+        const uint8_t *input = chunk->inputs + m * stride;
+        uint64_t start = ticks();
+        kernel->run(input, calls);
+        uint64_t end = ticks();
+        chunk->time[m] = (double)(end - start);
+    }
+}
+
+typedef struct {
+    double t;                       // Largest |t| over the crops
+    double crop;                    // Percentile it was found at
+    double mean[2];                 // Ticks per call of each class
+    unsigned long measurements;
+} verdict_t;
+
+static int check_kernel(const kernel_t *kernel, unsigned long measurements,
+                        verdict_t *verdict) {
+    unsigned calls = calls_per_measurement(kernel);
+    chunk_t *chunk = malloc(sizeof(chunk_t));
+    if (chunk == NULL) {
+        return -1;
+    }
+    chunk->inputs = malloc(CHUNK * kernel->input_size * calls);
+    if (chunk->inputs == NULL) {
+        free(chunk);
+        return -1;
+    }
+
+    // The first chunk warms up and sets the cropping thresholds
+    double limit[NUM_CROPS];
+    double sorted[CHUNK];
+    measure_chunk(kernel, calls, chunk);
+    memcpy(sorted, chunk->time, sizeof(sorted));
+    qsort(sorted, CHUNK, sizeof(double), compare_double);
+    for (size_t c = 0; c < NUM_CROPS; c++) {
+        limit[c] = (crops[c] > 0.0) ? sorted[(size_t)(crops[c] * CHUNK)]
+                                    : INFINITY;
+    }
+
+    welch_t tests[NUM_CROPS];
+    memset(tests, 0, sizeof(tests));
+    unsigned long done = 0;
+    while (done < measurements) {
+        measure_chunk(kernel, calls, chunk);
+        for (size_t m = 0; m < CHUNK; m++) {
+            for (size_t c = 0; c < NUM_CROPS; c++) {
+                if (chunk->time[m] <= limit[c]) {
+                    welch_push(&tests[c], chunk->cls[m], chunk->time[m]);
+                }
+            }
+        }
+        done += CHUNK;
+    }
+
+    verdict->t = 0.0;
+    verdict->crop = 0.0;
+    for (size_t c = 0; c < NUM_CROPS; c++) {
+        double t = fabs(welch_t_value(&tests[c]));
+        if (t > verdict->t) {
+            verdict->t = t;
+            verdict->crop = crops[c];
+        }
+    }
+    verdict->mean[0] = tests[0].mean[0] / calls;
+    verdict->mean[1] = tests[0].mean[1] / calls;
+    verdict->measurements = done;
+
+    free(chunk->inputs);
+    free(chunk);
+    return 0;
+}
+
+/* ========================================================================
+ * Main
+ * ======================================================================== */
+
+static void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-n measurements] [-t threshold] [-f filter] "
+            "[-q]\n", program);
+}
+
+int main(int argc, char **argv) {
+    unsigned long measurements = 1000000;
+    double threshold = 4.5;
+    const char *filter = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:f:q")) != -1) {
+        switch (opt) {
+        case 'n':
+            measurements = strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            threshold = atof(optarg);
+            break;
+        case 'f':
+            filter = optarg;
+            break;
+        case 'q':
+            measurements = 100000;
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (optind != argc || measurements == 0 || !(threshold > 0.0)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    rng_state = (uint64_t)bench_now_ns() | 1;
+
+    printf("ct_check: dispatch portable, %lu measurements per kernel, "
+           "%s, |t| threshold %.1f\n\n", measurements,
+#if defined(__x86_64__) || defined(__i386__)
+           "cycle counter",
+#else
+           "monotonic clock",
+#endif
+           threshold);
+    printf("%-12s %-10s %-10s %10s %10s %8s %6s  %s\n", "kernel", "tier",
+           "fixed", "fixed/call", "rand/call", "max |t|", "crop", "verdict");
+
+    int leaks = 0;
+    for (size_t k = 0; k < COUNT(kernels); k++) {
+        const kernel_t *kernel = &kernels[k];
+        if (filter != NULL && strstr(kernel->name, filter) == NULL) {
+            continue;
+        }
+
+        verdict_t verdict;
+        if (check_kernel(kernel, measurements, &verdict) != 0) {
+            printf("%-12s out of memory\n", kernel->name);
+            return 2;
+        }
+
+        char crop[8] = "all";
+        if (verdict.crop > 0.0) {
+            snprintf(crop, sizeof(crop), "p%.0f", verdict.crop * 100.0);
+        }
+
+        int leak = verdict.t >= threshold;
+        leaks += leak;
+        printf("%-12s %-10s %-10s %10.1f %10.1f %8.2f %6s  %s\n",
+               kernel->name, "portable", kernel->fixed, verdict.mean[0],
+               verdict.mean[1], verdict.t, crop,
+               leak ? "LEAK" : "no leak detected");
+        fflush(stdout);
+    }
+
+    printf("\n%d kernel(s) with secret-dependent timing\n", leaks);
+    return leaks > 0;
+}
@@ -0,0 +1,351 @@
+/**
+ * MPC Protocol Benchmarks
+ *
+ * Times the protocol entry points on share sets held in memory: secure
+ * add, sub, mul_const, mul, sum, average, max and reconstruct, across a
+ * (parties, threshold) grid, value sizes and batch sizes. A batch is
+ * the number of values one benchmark operation processes: a loop of
+ * calls for the element-wise operations, one mpc_secure_mul_batch call
+ * for mul, and num_values for the aggregates.
+ *
+ * Each row reports values per second, the median and p99 time of a
+ * batch and, on Linux, heap allocations per value (the allocator is
+ * wrapped at link time; "-" elsewhere).
+ *
+ * Usage:
+ *   mpc_bench [-w warmup] [-r reps] [-m min_sample_ms] [-f filter]
+ *           [-j results.json] [-p] [-q]
+ *   (-q: quick run; -f mul: only the multiplication benchmarks)
+ */
+
+#include "bench.h"
+#include "sss/mpc.h"
+#include "sss/secret_sharing.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* (parties, threshold) pairs; n >= 2t - 1 so products can be reduced */
+static const uint8_t party_grid[][2] = {
+    {3, 2}, {5, 2}, {5, 3}, {10, 5}, {20, 10}, {50, 25}
+};
+
+/* Bytes per value (shares hold at most 32) */
+static const size_t value_sizes[] = {1, SSS_SHARE_DATA_SIZE};
+
+/* Values per operation */
+static const size_t batch_sizes[] = {1, 64};
+
+#define MAX_BATCH 64
+
+#define COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+/* ========================================================================
+ * Allocation Counting
+ * ======================================================================== */
+
+#ifdef MPC_BENCH_COUNT_ALLOCS
+/*
+ * Linked with --wrap for each of these, so every allocation made by the
+ * library or the benchmark goes through a counter first.
+ */
+static uint64_t allocations;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__real_secure_malloc(size_t size);
+
+void *__wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+
+void *__wrap_secure_malloc(size_t size) {
+    allocations++;
+    return __real_secure_malloc(size);
+}
+#endif
+
+/* ========================================================================
+ * Operations
+ * ======================================================================== */
+
+typedef struct {
+    mpc_context_t ctx;
+    uint8_t n;
+    size_t batch;
+    mpc_share_t x[MAX_BATCH][SSS_MAX_SHARES];
+    mpc_share_t y[MAX_BATCH][SSS_MAX_SHARES];
+    mpc_share_t out[MAX_BATCH][SSS_MAX_SHARES];
+    const mpc_share_t *x_sets[MAX_BATCH];
+    const mpc_share_t *y_sets[MAX_BATCH];
+    mpc_share_t *out_sets[MAX_BATCH];
+    int failed;                     // Set when a call returns an error
+} protocol_args_t;
+
+static void bench_add(void *arg, uint64_t iters) {
+    protocol_args_t *p = arg;
+    for (uint64_t i = 0; i < iters; i++) {
+        for (size_t k = 0; k < p->batch; k++) {
+            if (mpc_secure_add(&p->ctx, p->x[k], p->y[k], p->out[k],
+                               p->n) != 0) {
+                p->failed = 1;
+                return;
+            }
+        }
+    }
+    bench_sink += p->out[0][0].share.data[0];
+}
+
+static void bench_sub(void *arg, uint64_t iters) {
+    protocol_args_t *p = arg;
+    for (uint64_t i = 0; i < iters; i++) {
+        for (size_t k = 0; k < p->batch; k++) {
+            if (mpc_secure_sub(&p->ctx, p->x[k], p->y[k], p->out[k],
+                               p->n) != 0) {
+                p->failed = 1;
+                return;
+            }
+        }
+    }
+    bench_sink += p->out[0][0].share.data[0];
+}
+
+static void bench_mul_const(void *arg, uint64_t iters) {
+    protocol_args_t *p = arg;
+    for (uint64_t i = 0; i < iters; i++) {
+        for (size_t k = 0; k < p->batch; k++) {
+            if (mpc_secure_mul_const(&p->ctx, p->x[k], (uint8_t)(i | 1),
+                                     p->out[k], p->n) != 0) {
+                p->failed = 1;
+                return;
+            }
+        }
+    }
+    bench_sink += p->out[0][0].share.data[0];
+}
+
+static void bench_mul(void *arg, uint64_t iters) {
+    protocol_args_t *p = arg;
+    for (uint64_t i = 0; i < iters; i++) {
+        if (mpc_secure_mul_batch(&p->ctx, p->x_sets, p->y_sets, p->out_sets,
+                                 p->batch, p->n) != 0) {
+            p->failed = 1;
+            return;
+        }
+    }
+    bench_sink += p->out[0][0].share.data[0];
+}
+
+static void bench_sum(void *arg, uint64_t iters) {
+    protocol_args_t *p = arg;
+    for (uint64_t i = 0; i < iters; i++) {
+        if (mpc_secure_sum(&p->ctx, p->x_sets, (uint8_t)p->batch, p->n,
+                           p->out[0]) != 0) {
+            p->failed = 1;
+            return;
+        }
+    }
+    bench_sink += p->out[0][0].share.data[0];
+}
+
+static void bench_average(void *arg, uint64_t iters) {
+    protocol_args_t *p = arg;
+    uint8_t average = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        if (mpc_secure_average(&p->ctx, p->x_sets, (uint8_t)p->batch, p->n,
+                               &average) != 0) {
+            p->failed = 1;
+            return;
+        }
+        bench_sink += average;
+    }
+}
+
+static void bench_max(void *arg, uint64_t iters) {
+    protocol_args_t *p = arg;
+    uint8_t maximum = 0;
+    uint8_t index = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        if (mpc_secure_max(&p->ctx, p->x_sets, (uint8_t)p->batch, p->n,
+                           &maximum, &index) != 0) {
+            p->failed = 1;
+            return;
+        }
+        bench_sink += maximum + index;
+    }
+}
+
+static void bench_reconstruct(void *arg, uint64_t iters) {
+    protocol_args_t *p = arg;
+    uint8_t value[SSS_SHARE_DATA_SIZE];
+    for (uint64_t i = 0; i < iters; i++) {
+        for (size_t k = 0; k < p->batch; k++) {
+            // Any threshold shares will do; take the first
+            if (mpc_reconstruct(&p->ctx, p->x[k], p->ctx.threshold,
+                                value) != 0) {
+                p->failed = 1;
+                return;
+            }
+            bench_sink += value[0];
+        }
+    }
+}
+
+typedef struct {
+    const char *name;
+    bench_fn fn;
+    int single_byte;                // Only defined for 1-byte values
+} operation_t;
+
+static const operation_t operations[] = {
+    {"mpc_add",         bench_add,         0},
+    {"mpc_sub",         bench_sub,         0},
+    {"mpc_mul_const",   bench_mul_const,   0},
+    {"mpc_mul",         bench_mul,         0},
+    {"mpc_sum",         bench_sum,         0},
+    {"mpc_average",     bench_average,     1},
+    {"mpc_max",         bench_max,         1},
+    {"mpc_reconstruct", bench_reconstruct, 0},
+};
+
+/* ========================================================================
+ * Main
+ * ======================================================================== */
+
+static void print_header(void) {
+    printf("%-16s %-24s %12s %12s %12s %10s\n", "benchmark", "params",
+           "values/s", "p50 ns", "p99 ns", "allocs/val");
+}
+
+static int run(const bench_config_t *config, const operation_t *op,
+               const char *params, protocol_args_t *args) {
+    if (!bench_selected(config, op->name)) {
+        return 0;
+    }
+
+    bench_result_t result;
+    if (bench_run(config, op->name, params, args->batch * args->ctx.value_size,
+                  op->fn, args, &result) != 0 || args->failed) {
+        printf("%-16s %-24s failed\n", op->name, params);
+        return -1;
+    }
+
+    char allocs[16] = "-";
+    result.items = (double)args->batch;
+#ifdef MPC_BENCH_COUNT_ALLOCS
+    // One more operation, outside the timed samples
+    uint64_t before = allocations;
+    op->fn(args, 1);
+    result.allocs = (double)(allocations - before) / (double)args->batch;
+    snprintf(allocs, sizeof(allocs), "%.2f", result.allocs);
+#endif
+
+    printf("%-16s %-24s %12.0f %12.1f %12.1f %10s\n", op->name, params,
+           (double)args->batch * 1e9 / result.ns_p50, result.ns_p50,
+           result.ns_p99, allocs);
+    fflush(stdout);
+    bench_print_perf(&result);
+    bench_json_result(&result);
+    return 0;
+}
+
+/**
+ * Share batch fresh pairs of values among the parties
+ */
+static int make_inputs(protocol_args_t *args, uint64_t seed) {
+    uint8_t value[SSS_SHARE_DATA_SIZE];
+    for (size_t k = 0; k < args->batch; k++) {
+        bench_fill(value, args->ctx.value_size, seed * 2 * MAX_BATCH + 2 * k);
+        if (mpc_create_shares(&args->ctx, value, args->x[k]) != 0) {
+            return -1;
+        }
+        bench_fill(value, args->ctx.value_size,
+                   seed * 2 * MAX_BATCH + 2 * k + 1);
+        if (mpc_create_shares(&args->ctx, value, args->y[k]) != 0) {
+            return -1;
+        }
+        args->x_sets[k] = args->x[k];
+        args->y_sets[k] = args->y[k];
+        args->out_sets[k] = args->out[k];
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    bench_config_default(&config);
+    if (bench_parse_args(argc, argv, &config) != argc) {
+        printf("Usage: %s [-w warmup] [-r reps] [-m min_sample_ms] "
+               "[-f filter] [-j results.json] [-p] [-q]\n", argv[0]);
+        return 1;
+    }
+
+    if (sss_init() != 0) {
+        printf("Failed to initialize library\n");
+        return 1;
+    }
+
+    printf("mpc_bench: %u warmup + %u samples of >= %.1f ms each\n\n",
+           config.warmup, config.reps, config.min_sample_ms);
+    if (bench_json_begin(&config, "mpc_bench") != 0) {
+        printf("Cannot write %s\n", config.json_path);
+        return 1;
+    }
+    print_header();
+
+    static protocol_args_t args;
+    int result = 0;
+    char params[48];
+
+    for (size_t g = 0; g < COUNT(party_grid); g++) {
+        for (size_t v = 0; v < COUNT(value_sizes); v++) {
+            for (size_t b = 0; b < COUNT(batch_sizes); b++) {
+                args.n = party_grid[g][0];
+                args.batch = batch_sizes[b];
+                if (mpc_init_context(&args.ctx, args.n, party_grid[g][1],
+                                     value_sizes[v]) != 0 ||
+                    make_inputs(&args, g * 16 + v * 4 + b) != 0) {
+                    printf("Failed to set up n=%u t=%u\n", party_grid[g][0],
+                           party_grid[g][1]);
+                    return 1;
+                }
+                snprintf(params, sizeof(params), "n=%u t=%u len=%zu b=%zu",
+                         args.n, args.ctx.threshold, args.ctx.value_size,
+                         args.batch);
+
+                for (size_t o = 0; o < COUNT(operations); o++) {
+                    if (operations[o].single_byte && args.ctx.value_size != 1) {
+                        continue;
+                    }
+                    result |= run(&config, &operations[o], params, &args);
+                }
+                mpc_cleanup_context(&args.ctx);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < MAX_BATCH; k++) {
+        for (size_t i = 0; i < SSS_MAX_SHARES; i++) {
+            mpc_wipe_share(&args.x[k][i]);
+            mpc_wipe_share(&args.y[k][i]);
+            mpc_wipe_share(&args.out[k][i]);
+        }
+    }
+    if (bench_json_end() != 0) {
+        printf("Failed to write %s\n", config.json_path);
+        result = -1;
+    }
+    return result != 0;
+}
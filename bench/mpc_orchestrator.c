@@ -0,0 +1,621 @@
+/**
+ * Multi-Process Party Orchestrator
+ *
+ * Runs an MPC workload end to end with every party in its own process,
+ * so the measured cost includes real system calls, socket buffers and
+ * scheduling between parties, which the in-process tests and examples
+ * never see.
+ *
+ * The orchestrator forks one process per party on this machine, connects
+ * them over AF_UNIX socketpairs or loopback TCP, pins party i to core i,
+ * and has every party run the workload for a number of repetitions. Each
+ * party times its own phases and reports back through a pipe; the
+ * orchestrator checks the results and prints per-party timings.
+ *
+ * Parties talk through a batch link (transport_batch.h), so a round
+ * costs one frame per peer for every MPC_BATCH_MAX_FRAME bytes. Each
+ * phase covers the whole vector in one protocol call; the socket
+ * backends read while they wait to write, so rounds may be larger than
+ * the socket buffers.
+ *
+ * Workloads (every party inputs a vector of values):
+ *   sum       Element-wise sum of all inputs (local additions, one open)
+ *   average   The sum divided by the number of parties after opening,
+ *             as mpc_secure_average() does
+ *   max       Element-wise maximum; like mpc_secure_max(), it opens the
+ *             inputs and compares them in the clear
+ *   mulchain  Element-wise product of all inputs (n - 1 multiplication
+ *             rounds, one open)
+ *
+ * Usage:
+ *   mpc_orchestrator [-n parties] [-t threshold] [-v values] [-r reps]
+ *                    [-T unix|tcp] [-p base_port] [-P] workload
+ *   (defaults: 5 parties, threshold max(2, (n + 1) / 2), 1000 values, 5 reps,
+ *    unix sockets, port 41000; -P disables core pinning)
+ */
+
+#define _GNU_SOURCE
+#include "sss/transport.h"
+#include "sss/transport_batch.h"
+#include "sss/mpc_net.h"
+#include "sss/mpc.h"
+#include "sss/field.h"
+#include "sss/secret_sharing.h"
+#include "utils/affinity.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_MAGENTA "\x1b[35m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_RESET   "\x1b[0m"
+
+#define MAX_PARTIES 64
+#define MAX_REPS 1000
+#define MAX_VALUES 100000
+
+/* Time allowed for a TCP group to connect */
+#define CONNECT_TIMEOUT_MS 10000
+
+void print_separator() {
+    printf(COLOR_CYAN "════════════════════════════════════════════════════════════════\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_MAGENTA "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+/* ========================================================================
+ * Configuration and Reports
+ * ======================================================================== */
+
+typedef enum {
+    WORKLOAD_SUM,
+    WORKLOAD_AVERAGE,
+    WORKLOAD_MAX,
+    WORKLOAD_MULCHAIN
+} workload_t;
+
+static const char *workload_names[] = {"sum", "average", "max", "mulchain"};
+
+typedef struct {
+    workload_t workload;
+    uint8_t parties;
+    uint8_t threshold;
+    size_t values;
+    int reps;
+    int use_tcp;
+    uint16_t port;
+    int pin;
+} config_t;
+
+/* Phase times of one repetition, in milliseconds */
+typedef struct {
+    double input_ms;            // Sharing every party's inputs
+    double compute_ms;          // Local operations and multiplication rounds
+    double open_ms;             // Revealing the results
+    double total_ms;
+} rep_timing_t;
+
+/* Sent by every party to the orchestrator when it is done */
+typedef struct {
+    int status;                 // 0 if every repetition succeeded
+    int pinned;
+    double connect_ms;
+    uint64_t bytes_sent;        // Over all repetitions
+    uint64_t rounds;
+    uint32_t checksum;          // Of the last repetition's results
+    rep_timing_t reps[MAX_REPS];
+} party_report_t;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+/**
+ * Input k of a party (the same function on every side, so the
+ * orchestrator can check the results)
+ */
+static uint8_t party_input(uint8_t party, size_t k) {
+    return (uint8_t)(party * 37 + k * 11 + 1);
+}
+
+static uint32_t checksum_add(uint32_t sum, uint8_t value) {
+    return sum * 31 + value;
+}
+
+/**
+ * Result checksum the parties should report
+ */
+static uint32_t expected_checksum(const config_t *config) {
+    uint32_t sum = 0;
+
+    for (size_t k = 0; k < config->values; k++) {
+        uint8_t acc = party_input(1, k);
+        for (uint8_t p = 2; p <= config->parties; p++) {
+            uint8_t x = party_input(p, k);
+            switch (config->workload) {
+            case WORKLOAD_SUM:
+            case WORKLOAD_AVERAGE:
+                acc = gf256_add(acc, x);
+                break;
+            case WORKLOAD_MAX:
+                acc = (x > acc) ? x : acc;
+                break;
+            case WORKLOAD_MULCHAIN:
+                acc = gf256_mul(acc, x);
+                break;
+            }
+        }
+        if (config->workload == WORKLOAD_AVERAGE) {
+            acc = acc / config->parties;
+        }
+        sum = checksum_add(sum, acc);
+    }
+    return sum;
+}
+
+/* ========================================================================
+ * Party Process
+ * ======================================================================== */
+
+/**
+ * Zero-byte message to and from every peer, so all parties start each
+ * repetition together
+ */
+static int party_barrier(mpc_transport_t *net) {
+    if (mpc_transport_broadcast(net, NULL, 0) != 0 ||
+        mpc_transport_flush(net) != 0) {
+        return -1;
+    }
+
+    for (uint8_t peer = 1; peer <= net->num_parties; peer++) {
+        size_t len = 0;
+        if (peer != net->party_id &&
+            mpc_transport_recv(net, peer, NULL, 0, &len) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * One repetition of the workload
+ *
+ * Shares of input k of party d are at inputs[(d - 1) * values + k].
+ */
+static int party_run(const config_t *config, const mpc_context_t *ctx,
+                     mpc_transport_t *net, const uint8_t *mine,
+                     mpc_share_t *inputs, mpc_share_t *results,
+                     uint8_t *opened, rep_timing_t *timing,
+                     uint32_t *checksum) {
+    uint8_t me = net->party_id;
+    uint8_t n = config->parties;
+    size_t v = config->values;
+
+    memset(timing, 0, sizeof(rep_timing_t));
+    uint32_t sum = 0;
+    double start = now_ms();
+
+    // Every party deals its values in turn
+    for (uint8_t dealer = 1; dealer <= n; dealer++) {
+        if (mpc_net_share_input(ctx, net, dealer,
+                                (dealer == me) ? mine : NULL,
+                                &inputs[(size_t)(dealer - 1) * v], v) != 0) {
+            return -1;
+        }
+    }
+    double t1 = now_ms();
+
+    // Results to open, and how many
+    size_t num_open = v;
+
+    switch (config->workload) {
+    case WORKLOAD_SUM:
+    case WORKLOAD_AVERAGE:
+        for (size_t k = 0; k < v; k++) {
+            const mpc_share_t *column[MAX_PARTIES];
+            for (uint8_t d = 0; d < n; d++) {
+                column[d] = &inputs[(size_t)d * v + k];
+            }
+            if (mpc_secure_sum(ctx, column, n, 1, &results[k]) != 0) {
+                return -1;
+            }
+        }
+        break;
+
+    case WORKLOAD_MAX:
+        // Compared in the clear, so every input is opened
+        memcpy(results, inputs, (size_t)n * v * sizeof(mpc_share_t));
+        num_open = (size_t)n * v;
+        break;
+
+    case WORKLOAD_MULCHAIN:
+        if (mpc_net_mul(ctx, net, inputs, &inputs[v], results, v) != 0) {
+            return -1;
+        }
+        for (uint8_t d = 2; d < n; d++) {
+            if (mpc_net_mul(ctx, net, results, &inputs[(size_t)d * v],
+                            results, v) != 0) {
+                return -1;
+            }
+        }
+        break;
+    }
+    double t2 = now_ms();
+
+    if (mpc_net_open(ctx, net, results, opened, num_open) != 0) {
+        return -1;
+    }
+
+    // Finish in the clear
+    for (size_t k = 0; k < v; k++) {
+        uint8_t value = opened[k];
+        if (config->workload == WORKLOAD_AVERAGE) {
+            value = value / n;
+        } else if (config->workload == WORKLOAD_MAX) {
+            for (uint8_t d = 1; d < n; d++) {
+                uint8_t x = opened[(size_t)d * v + k];
+                value = (x > value) ? x : value;
+            }
+        }
+        sum = checksum_add(sum, value);
+    }
+    double t3 = now_ms();
+
+    timing->input_ms = t1 - start;
+    timing->compute_ms = t2 - t1;
+    timing->open_ms = t3 - t2;
+    timing->total_ms = t3 - start;
+    *checksum = sum;
+    return 0;
+}
+
+/**
+ * Body of a party process: connect, run every repetition, report
+ */
+static void party_main(const config_t *config, const mpc_context_t *ctx,
+                       uint8_t me, mpc_transport_t *net, int report_fd) {
+    party_report_t *report = calloc(1, sizeof(party_report_t));
+    size_t v = config->values;
+    uint8_t *mine = malloc(v);
+    uint8_t *opened = malloc((size_t)config->parties * v);
+    mpc_share_t *inputs = malloc((size_t)config->parties * v *
+                                 sizeof(mpc_share_t));
+    mpc_share_t *results = malloc((size_t)config->parties * v *
+                                  sizeof(mpc_share_t));
+
+    if (report == NULL || mine == NULL || opened == NULL || inputs == NULL ||
+        results == NULL) {
+        _exit(1);
+    }
+    report->status = -1;
+    report->pinned = config->pin && sss_pin_thread(me - 1) == 0;
+
+    // Socketpair endpoints exist before the fork; TCP parties connect here
+    double start = now_ms();
+    if (net == NULL &&
+        mpc_transport_tcp_connect(me, config->parties, "127.0.0.1",
+                                  config->port, CONNECT_TIMEOUT_MS,
+                                  &net) != 0) {
+        net = NULL;
+    }
+    report->connect_ms = now_ms() - start;
+
+    // Each round goes out as one frame per peer
+    mpc_batch_link_t *link = (net != NULL) ? mpc_batch_link_create(net) : NULL;
+    mpc_transport_t *channel = (link != NULL)
+        ? mpc_batch_channel_open(link, &ctx->session_id)
+        : NULL;
+
+    if (channel != NULL) {
+        for (size_t k = 0; k < v; k++) {
+            mine[k] = party_input(me, k);
+        }
+
+        int result = 0;
+        for (int r = 0; r < config->reps && result == 0; r++) {
+            result = party_barrier(channel);
+            mpc_transport_reset_stats(net);
+            mpc_transport_reset_stats(channel);
+            if (result == 0) {
+                result = party_run(config, ctx, channel, mine, inputs, results,
+                                   opened, &report->reps[r],
+                                   &report->checksum);
+            }
+
+            // Bytes on the wire, rounds of the protocol
+            mpc_transport_stats_t wire, protocol;
+            mpc_transport_get_stats(net, &wire);
+            mpc_transport_get_stats(channel, &protocol);
+            report->bytes_sent += wire.bytes_sent;
+            report->rounds += protocol.rounds;
+        }
+        report->status = result;
+    }
+
+    mpc_transport_destroy(channel);
+    mpc_batch_link_destroy(link);
+    mpc_transport_destroy(net);
+
+    // Partial writes only happen on a broken pipe
+    int ok = write(report_fd, report, sizeof(party_report_t)) ==
+             (ssize_t)sizeof(party_report_t);
+    _exit((ok && report->status == 0) ? 0 : 1);
+}
+
+/* ========================================================================
+ * Orchestration
+ * ======================================================================== */
+
+static int read_report(int fd, party_report_t *report) {
+    uint8_t *out = (uint8_t *)report;
+    size_t got = 0;
+
+    while (got < sizeof(party_report_t)) {
+        ssize_t n = read(fd, out + got, sizeof(party_report_t) - got);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        got += (size_t)n;
+    }
+    return 0;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double *samples, int count) {
+    qsort(samples, (size_t)count, sizeof(double), compare_double);
+    return (count % 2 == 1) ? samples[count / 2]
+                            : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+}
+
+static void print_usage(const char *program) {
+    printf("Usage: %s [-n parties] [-t threshold] [-v values] [-r reps]\n"
+           "          [-T unix|tcp] [-p base_port] [-P] "
+           "sum|average|max|mulchain\n", program);
+}
+
+static int parse_args(int argc, char **argv, config_t *config) {
+    config->parties = 5;
+    config->threshold = 0;
+    config->values = 1000;
+    config->reps = 5;
+    config->use_tcp = 0;
+    config->port = 41000;
+    config->pin = 1;
+
+    long parties = 5, threshold = 0, values = 1000, reps = 5, port = 41000;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:v:r:T:p:P")) != -1) {
+        switch (opt) {
+        case 'n': parties = atol(optarg); break;
+        case 't': threshold = atol(optarg); break;
+        case 'v': values = atol(optarg); break;
+        case 'r': reps = atol(optarg); break;
+        case 'p': port = atol(optarg); break;
+        case 'P': config->pin = 0; break;
+        case 'T':
+            if (strcmp(optarg, "tcp") == 0) {
+                config->use_tcp = 1;
+            } else if (strcmp(optarg, "unix") != 0) {
+                return -1;
+            }
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    if (optind != argc - 1) {
+        return -1;
+    }
+    int found = 0;
+    for (int w = 0; w <= WORKLOAD_MULCHAIN; w++) {
+        if (strcmp(argv[optind], workload_names[w]) == 0) {
+            config->workload = (workload_t)w;
+            found = 1;
+        }
+    }
+
+    if (threshold == 0) {
+        threshold = (parties < 4) ? 2 : (parties + 1) / 2;
+    }
+    if (!found || parties < 2 || parties > MAX_PARTIES || threshold < 2 ||
+        threshold > parties || values < 1 || values > MAX_VALUES ||
+        reps < 1 || reps > MAX_REPS || port < 1 || port + parties > 65535) {
+        return -1;
+    }
+
+    config->parties = (uint8_t)parties;
+    config->threshold = (uint8_t)threshold;
+    config->values = (size_t)values;
+    config->reps = (int)reps;
+    config->port = (uint16_t)port;
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    config_t config;
+    if (parse_args(argc, argv, &config) != 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (config.workload == WORKLOAD_MULCHAIN &&
+        config.parties < 2 * config.threshold - 1) {
+        printf(COLOR_RED "mulchain needs parties >= 2 × threshold - 1\n"
+               COLOR_RESET);
+        return 1;
+    }
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "Failed to initialize library\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("MPC Orchestrator: One Process per Party");
+    printf("  • Workload:  %s, %zu values per party, %d repetitions\n",
+           workload_names[config.workload], config.values, config.reps);
+    printf("  • Parties:   %u (threshold %u) over %s, %s\n",
+           config.parties, config.threshold,
+           config.use_tcp ? "loopback TCP" : "unix sockets",
+           config.pin ? "pinned to cores" : "not pinned");
+
+    // Every party gets the same context, session id included
+    mpc_context_t ctx;
+    if (mpc_init_context(&ctx, config.parties, config.threshold, 1) != 0) {
+        printf(COLOR_RED "Invalid context\n" COLOR_RESET);
+        return 1;
+    }
+
+    mpc_transport_t *net[MAX_PARTIES] = {NULL};
+    if (!config.use_tcp &&
+        mpc_transport_socketpair_create(config.parties, net) != 0) {
+        printf(COLOR_RED "Failed to create sockets\n" COLOR_RESET);
+        return 1;
+    }
+
+    // ====================================================================
+    // Fork the parties
+    // ====================================================================
+    pid_t pids[MAX_PARTIES];
+    int report_fds[MAX_PARTIES];
+    fflush(stdout);
+
+    for (uint8_t i = 0; i < config.parties; i++) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            printf(COLOR_RED "pipe() failed\n" COLOR_RESET);
+            return 1;
+        }
+
+        pids[i] = fork();
+        if (pids[i] < 0) {
+            printf(COLOR_RED "fork() failed\n" COLOR_RESET);
+            return 1;
+        }
+
+        if (pids[i] == 0) {
+            // Keep only this party's endpoint and pipe
+            close(fds[0]);
+            for (uint8_t j = 0; j < i; j++) {
+                close(report_fds[j]);
+            }
+            for (uint8_t j = 0; j < config.parties; j++) {
+                if (j != i) {
+                    mpc_transport_destroy(net[j]);
+                }
+            }
+            party_main(&config, &ctx, i + 1, net[i], fds[1]);
+        }
+
+        close(fds[1]);
+        report_fds[i] = fds[0];
+    }
+
+    for (uint8_t i = 0; i < config.parties; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+
+    // ====================================================================
+    // Collect reports
+    // ====================================================================
+    party_report_t *reports = calloc(config.parties, sizeof(party_report_t));
+    if (reports == NULL) {
+        return 1;
+    }
+
+    uint32_t expected = expected_checksum(&config);
+    int ok = 1;
+    for (uint8_t i = 0; i < config.parties; i++) {
+        if (read_report(report_fds[i], &reports[i]) != 0) {
+            reports[i].status = -1;
+        }
+        close(report_fds[i]);
+
+        int wstatus = 0;
+        waitpid(pids[i], &wstatus, 0);
+        ok = ok && reports[i].status == 0 && WIFEXITED(wstatus) &&
+             WEXITSTATUS(wstatus) == 0 && reports[i].checksum == expected;
+    }
+
+    printf("\n" COLOR_YELLOW "📋 Per-party timing (median over repetitions):"
+           COLOR_RESET "\n");
+    printf("  %-6s %4s %9s %9s %9s %9s %9s %10s %7s\n", "Party", "Pin",
+           "Connect", "Input", "Compute", "Open", "Total", "Sent/rep",
+           "Rounds");
+
+    double samples[MAX_REPS];
+    for (uint8_t i = 0; i < config.parties; i++) {
+        const party_report_t *r = &reports[i];
+        if (r->status != 0) {
+            printf("  %-6u " COLOR_RED "failed" COLOR_RESET "\n", i + 1);
+            continue;
+        }
+
+        double phase[4];
+        for (int f = 0; f < 4; f++) {
+            for (int k = 0; k < config.reps; k++) {
+                const rep_timing_t *t = &r->reps[k];
+                samples[k] = (f == 0) ? t->input_ms : (f == 1) ? t->compute_ms
+                           : (f == 2) ? t->open_ms : t->total_ms;
+            }
+            phase[f] = median(samples, config.reps);
+        }
+
+        printf("  %-6u %4s %7.2fms %7.2fms %7.2fms %7.2fms %7.2fms %8.1fKB "
+               "%7.1f\n", i + 1, r->pinned ? "yes" : "no", r->connect_ms,
+               phase[0], phase[1], phase[2], phase[3],
+               r->bytes_sent / 1024.0 / config.reps,
+               (double)r->rounds / config.reps);
+    }
+
+    // A repetition lasts as long as its slowest party
+    if (ok) {
+        for (int k = 0; k < config.reps; k++) {
+            samples[k] = 0.0;
+            for (uint8_t i = 0; i < config.parties; i++) {
+                if (reports[i].reps[k].total_ms > samples[k]) {
+                    samples[k] = reports[i].reps[k].total_ms;
+                }
+            }
+        }
+        double wall = median(samples, config.reps);
+
+        print_separator();
+        printf(COLOR_GREEN "  End to end: %.2f ms per repetition, "
+               "%.0f values/s\n" COLOR_RESET, wall,
+               config.values * 1e3 / wall);
+        print_separator();
+        printf("  " COLOR_GREEN "✓ Every party computed the expected result"
+               COLOR_RESET "\n\n");
+    } else {
+        printf("\n  " COLOR_RED "✗ Some parties failed or disagreed"
+               COLOR_RESET "\n\n");
+    }
+
+    free(reports);
+    mpc_cleanup_context(&ctx);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,483 @@
+/**
+ * MPC Workload Drivers
+ *
+ * The scenarios of the examples (salary average, sealed-bid auction,
+ * private vote) at scale: N employees, N bidders, or N voters choosing
+ * among C candidates, with synthetic inputs. Each run takes every input
+ * through the whole pipeline: it is shared among the parties, the
+ * parties aggregate the shares, and the result is opened. The result is
+ * checked against the same computation on the plain inputs.
+ *
+ * Inputs stream through in blocks of up to 255, the most the aggregate
+ * functions take, so the share state in memory does not grow with N:
+ *
+ *   salary   Each salary (len bytes) is shared; block sums are folded
+ *            into a running total with mpc_secure_add, which is opened.
+ *   auction  Each bid is shared; mpc_secure_max finds the highest bid of
+ *            each block, and the highest of those wins (first bidder on
+ *            a tie).
+ *   voting   Each ballot holds one byte per candidate, 1 for the chosen
+ *            one; ballots are summed like salaries and the tally opened.
+ *
+ * As in the examples, sums are GF(256) sums (XOR): the salary total and
+ * the tallies are parities, not integers. The cost of the pipeline is
+ * the same either way.
+ *
+ * Each row reports inputs per second end to end, the time of a run and
+ * its split into sharing, aggregation and opening, and the peak resident
+ * memory of the process so far. With a library built with
+ * -DSSS_MEMORY_PROFILE=ON, each row is followed by the allocations and
+ * peak memory of every MPC operation the scenario called.
+ *
+ * Usage:
+ *   mpc_workload [-N inputs] [-n parties] [-t threshold] [-C candidates]
+ *                [-l salary_len] [-r reps] [-j results.json] [-q]
+ *                [salary|auction|voting ...]
+ *   (defaults: 1000000 inputs, 5 parties, threshold 3, 4 candidates,
+ *   4-byte salaries, 3 runs, all scenarios; -q: 10000 inputs)
+ */
+
+#define _GNU_SOURCE
+#include "bench.h"
+#include "sss/mpc.h"
+#include "sss/mem_profile.h"
+#include "sss/secret_sharing.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/* Inputs per block (the most num_values the aggregates accept) */
+#define BLOCK 255
+
+#define COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+/* ========================================================================
+ * Workloads
+ * ======================================================================== */
+
+typedef struct {
+    uint64_t inputs;
+    uint8_t parties;
+    uint8_t threshold;
+    uint8_t candidates;
+    size_t salary_len;
+} workload_t;
+
+/* Time of a run by phase, in nanoseconds */
+typedef struct {
+    double share;
+    double compute;
+    double open;
+} phases_t;
+
+/* Share state of a block: one share set per input */
+typedef struct {
+    mpc_share_t *shares;            // BLOCK x parties
+    const mpc_share_t *sets[BLOCK];
+} block_t;
+
+static int block_init(block_t *block, uint8_t parties) {
+    block->shares = calloc((size_t)BLOCK * parties, sizeof(mpc_share_t));
+    if (block->shares == NULL) {
+        return -1;
+    }
+    for (size_t k = 0; k < BLOCK; k++) {
+        block->sets[k] = block->shares + k * parties;
+    }
+    return 0;
+}
+
+static void block_free(block_t *block, uint8_t parties) {
+    for (size_t i = 0; i < (size_t)BLOCK * parties; i++) {
+        mpc_wipe_share(&block->shares[i]);
+    }
+    free(block->shares);
+}
+
+/**
+ * Share the inputs first..first+count-1 of a block
+ */
+static int share_block(const mpc_context_t *ctx, block_t *block,
+                       const uint8_t *inputs, size_t count, phases_t *phases) {
+    double start = bench_now_ns();
+    for (size_t k = 0; k < count; k++) {
+        if (mpc_create_shares(ctx, inputs + k * ctx->value_size,
+                              block->shares + k * ctx->num_parties) != 0) {
+            return -1;
+        }
+    }
+    phases->share += bench_now_ns() - start;
+    return 0;
+}
+
+/**
+ * Sum the inputs, a block at a time, and open the total. gen() writes the
+ * input with a given index; the plain total is accumulated alongside.
+ */
+static int run_sum(const workload_t *w, size_t value_size,
+                   void (*gen)(const workload_t *, uint64_t, uint8_t *),
+                   phases_t *phases) {
+    mpc_context_t ctx;
+    if (mpc_init_context(&ctx, w->parties, w->threshold, value_size) != 0) {
+        return -1;
+    }
+
+    block_t block;
+    if (block_init(&block, w->parties) != 0) {
+        mpc_cleanup_context(&ctx);
+        return -1;
+    }
+
+    uint8_t inputs[BLOCK * SSS_SHARE_DATA_SIZE];
+    uint8_t expected[SSS_SHARE_DATA_SIZE] = {0};
+    mpc_share_t total[SSS_MAX_SHARES];
+    mpc_share_t block_sum[SSS_MAX_SHARES];
+    mpc_share_t next[SSS_MAX_SHARES];
+    int status = 0;
+
+    for (uint64_t first = 0; first < w->inputs && status == 0;
+         first += BLOCK) {
+        size_t count = (w->inputs - first < BLOCK)
+                       ? (size_t)(w->inputs - first) : BLOCK;
+        for (size_t k = 0; k < count; k++) {
+            gen(w, first + k, inputs + k * value_size);
+            for (size_t b = 0; b < value_size; b++) {
+                expected[b] ^= inputs[k * value_size + b];
+            }
+        }
+        if (share_block(&ctx, &block, inputs, count, phases) != 0) {
+            status = -1;
+            break;
+        }
+
+        double start = bench_now_ns();
+        mpc_share_t *sum = (first == 0) ? total : block_sum;
+        if (mpc_secure_sum(&ctx, block.sets, (uint8_t)count, w->parties,
+                           sum) != 0) {
+            status = -1;
+        } else if (first > 0) {
+            // Fold the block into the running total
+            if (mpc_secure_add(&ctx, total, block_sum, next,
+                               w->parties) != 0) {
+                status = -1;
+            }
+            memcpy(total, next, w->parties * sizeof(mpc_share_t));
+        }
+        phases->compute += bench_now_ns() - start;
+    }
+
+    uint8_t opened[SSS_SHARE_DATA_SIZE];
+    if (status == 0) {
+        double start = bench_now_ns();
+        status = mpc_reconstruct(&ctx, total, w->threshold, opened);
+        phases->open += bench_now_ns() - start;
+    }
+    if (status == 0 && memcmp(opened, expected, value_size) != 0) {
+        status = -1;
+    }
+
+    for (uint8_t i = 0; i < w->parties; i++) {
+        mpc_wipe_share(&total[i]);
+        mpc_wipe_share(&block_sum[i]);
+        mpc_wipe_share(&next[i]);
+    }
+    block_free(&block, w->parties);
+    mpc_cleanup_context(&ctx);
+    return status;
+}
+
+static void gen_salary(const workload_t *w, uint64_t index, uint8_t *salary) {
+    bench_fill(salary, w->salary_len, index);
+}
+
+static void gen_ballot(const workload_t *w, uint64_t index, uint8_t *ballot) {
+    uint8_t choice;
+    bench_fill(&choice, 1, index);
+    memset(ballot, 0, w->candidates);
+    ballot[choice % w->candidates] = 1;
+}
+
+static int run_salary(const workload_t *w, phases_t *phases) {
+    return run_sum(w, w->salary_len, gen_salary, phases);
+}
+
+static int run_voting(const workload_t *w, phases_t *phases) {
+    return run_sum(w, w->candidates, gen_ballot, phases);
+}
+
+static int run_auction(const workload_t *w, phases_t *phases) {
+    mpc_context_t ctx;
+    if (mpc_init_context(&ctx, w->parties, w->threshold, 1) != 0) {
+        return -1;
+    }
+
+    block_t block;
+    if (block_init(&block, w->parties) != 0) {
+        mpc_cleanup_context(&ctx);
+        return -1;
+    }
+
+    uint8_t bids[BLOCK];
+    uint8_t expected_bid = 0;
+    uint64_t expected_winner = 0;
+    uint8_t best_bid = 0;
+    uint64_t winner = 0;
+    int status = 0;
+
+    for (uint64_t first = 0; first < w->inputs; first += BLOCK) {
+        size_t count = (w->inputs - first < BLOCK)
+                       ? (size_t)(w->inputs - first) : BLOCK;
+        for (size_t k = 0; k < count; k++) {
+            bench_fill(&bids[k], 1, first + k);
+            if ((first == 0 && k == 0) || bids[k] > expected_bid) {
+                expected_bid = bids[k];
+                expected_winner = first + k;
+            }
+        }
+        if (share_block(&ctx, &block, bids, count, phases) != 0) {
+            status = -1;
+            break;
+        }
+
+        uint8_t block_bid;
+        uint8_t block_index;
+        double start = bench_now_ns();
+        status = mpc_secure_max(&ctx, block.sets, (uint8_t)count, w->parties,
+                                &block_bid, &block_index);
+        phases->compute += bench_now_ns() - start;
+        if (status != 0) {
+            break;
+        }
+        if (first == 0 || block_bid > best_bid) {
+            best_bid = block_bid;
+            winner = first + block_index;
+        }
+    }
+
+    if (status == 0 && (best_bid != expected_bid ||
+                        winner != expected_winner)) {
+        status = -1;
+    }
+
+    block_free(&block, w->parties);
+    mpc_cleanup_context(&ctx);
+    return status;
+}
+
+typedef struct {
+    const char *name;
+    int (*run)(const workload_t *w, phases_t *phases);
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+    {"salary",  run_salary},
+    {"auction", run_auction},
+    {"voting",  run_voting},
+};
+
+/* ========================================================================
+ * Main
+ * ======================================================================== */
+
+/**
+ * Peak resident memory of the process in MiB
+ */
+static double peak_rss_mib(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+#ifdef __APPLE__
+    return (double)usage.ru_maxrss / (1024.0 * 1024.0);    // Bytes
+#else
+    return (double)usage.ru_maxrss / 1024.0;               // KiB
+#endif
+}
+
+/**
+ * Memory of every operation called since the last reset (profiled
+ * builds only)
+ */
+static void print_mem_profile(void) {
+    for (int op = 0; op < MPC_OP_COUNT; op++) {
+        mpc_mem_profile_t p;
+        if (mpc_get_mem_profile((mpc_op_t)op, &p) != 0 || p.calls == 0) {
+            continue;
+        }
+        printf("  %-16s %10llu calls %6.1f allocs %8.0f B/call  "
+               "peak %7llu B heap %6llu B stack %8llu B mapped\n",
+               mpc_op_name((mpc_op_t)op), (unsigned long long)p.calls,
+               (double)p.allocations / (double)p.calls,
+               (double)p.bytes_allocated / (double)p.calls,
+               (unsigned long long)p.peak_heap_bytes,
+               (unsigned long long)p.peak_stack_bytes,
+               (unsigned long long)p.peak_mapped_bytes);
+    }
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int run_scenario(const scenario_t *scenario, const workload_t *w,
+                        unsigned reps) {
+    char params[48];
+    if (strcmp(scenario->name, "voting") == 0) {
+        snprintf(params, sizeof(params), "N=%llu n=%u t=%u C=%u",
+                 (unsigned long long)w->inputs, w->parties, w->threshold,
+                 w->candidates);
+    } else if (strcmp(scenario->name, "salary") == 0) {
+        snprintf(params, sizeof(params), "N=%llu n=%u t=%u len=%zu",
+                 (unsigned long long)w->inputs, w->parties, w->threshold,
+                 w->salary_len);
+    } else {
+        snprintf(params, sizeof(params), "N=%llu n=%u t=%u",
+                 (unsigned long long)w->inputs, w->parties, w->threshold);
+    }
+
+    bench_result_t result;
+    memset(&result, 0, sizeof(result));
+    phases_t best = {0};
+    double best_total = 0.0;
+
+    mpc_reset_mem_profile();
+    for (unsigned r = 0; r < reps; r++) {
+        phases_t phases = {0};
+        double start = bench_now_ns();
+        if (scenario->run(w, &phases) != 0) {
+            printf("%-8s %-28s failed\n", scenario->name, params);
+            return -1;
+        }
+        double total = bench_now_ns() - start;
+        result.ns[r] = total / (double)w->inputs;
+        if (r == 0 || total < best_total) {
+            best_total = total;
+            best = phases;
+        }
+    }
+    qsort(result.ns, reps, sizeof(double), compare_double);
+
+    snprintf(result.name, sizeof(result.name), "workload_%s", scenario->name);
+    snprintf(result.params, sizeof(result.params), "%s", params);
+    result.iters = w->inputs;
+    result.samples = reps;
+    result.items = 1.0;
+    result.allocs = -1.0;
+    result.ns_min = result.ns[0];
+    result.ns_p50 = result.ns[reps / 2];
+    result.ns_p90 = result.ns[(reps * 9) / 10];
+    result.ns_p99 = result.ns[reps - 1];
+    for (int e = 0; e < BENCH_PERF_COUNT; e++) {
+        result.perf[e] = -1.0;
+    }
+
+    // Phases of the fastest run; input generation makes up the rest
+    printf("%-8s %-28s %12.0f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+           scenario->name, params, 1e9 / result.ns_p50, best_total / 1e6,
+           best.share / 1e6, best.compute / 1e6, best.open / 1e6,
+           peak_rss_mib());
+    print_mem_profile();
+    fflush(stdout);
+    bench_json_result(&result);
+    return 0;
+}
+
+static void usage(const char *program) {
+    printf("Usage: %s [-N inputs] [-n parties] [-t threshold] "
+           "[-C candidates] [-l salary_len] [-r reps] [-j results.json] "
+           "[-q] [salary|auction|voting ...]\n", program);
+}
+
+int main(int argc, char **argv) {
+    workload_t w = {1000000, 5, 3, 4, 4};
+    bench_config_t config;
+    bench_config_default(&config);
+    config.warmup = 0;
+    config.reps = 3;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "N:n:t:C:l:r:j:q")) != -1) {
+        switch (opt) {
+        case 'N':
+            w.inputs = strtoull(optarg, NULL, 10);
+            break;
+        case 'n':
+            w.parties = (uint8_t)atoi(optarg);
+            break;
+        case 't':
+            w.threshold = (uint8_t)atoi(optarg);
+            break;
+        case 'C':
+            w.candidates = (uint8_t)atoi(optarg);
+            break;
+        case 'l':
+            w.salary_len = (size_t)atoi(optarg);
+            break;
+        case 'r':
+            config.reps = (unsigned)atoi(optarg);
+            break;
+        case 'j':
+            config.json_path = optarg;
+            break;
+        case 'q':
+            w.inputs = 10000;
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (w.inputs == 0 || w.threshold < 2 || w.threshold > w.parties ||
+        w.candidates < 1 || w.candidates > SSS_SHARE_DATA_SIZE ||
+        w.salary_len < 1 || w.salary_len > SSS_SHARE_DATA_SIZE ||
+        config.reps == 0 || config.reps > BENCH_MAX_REPS) {
+        usage(argv[0]);
+        return 1;
+    }
+    for (int i = optind; i < argc; i++) {
+        size_t s = 0;
+        while (s < COUNT(scenarios) && strcmp(argv[i], scenarios[s].name)) {
+            s++;
+        }
+        if (s == COUNT(scenarios)) {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (sss_init() != 0) {
+        printf("Failed to initialize library\n");
+        return 1;
+    }
+
+    printf("mpc_workload: %u runs per scenario, phases of the fastest\n\n",
+           config.reps);
+    if (bench_json_begin(&config, "mpc_workload") != 0) {
+        printf("Cannot write %s\n", config.json_path);
+        return 1;
+    }
+    printf("%-8s %-28s %12s %10s %10s %10s %10s %10s\n", "workload",
+           "params", "inputs/s", "total ms", "share ms", "compute ms",
+           "open ms", "peak MiB");
+
+    int result = 0;
+    for (size_t s = 0; s < COUNT(scenarios); s++) {
+        int selected = (optind == argc);
+        for (int i = optind; i < argc; i++) {
+            selected |= (strcmp(argv[i], scenarios[s].name) == 0);
+        }
+        if (selected) {
+            result |= run_scenario(&scenarios[s], &w, config.reps);
+        }
+    }
+
+    if (bench_json_end() != 0) {
+        printf("Failed to write %s\n", config.json_path);
+        result = -1;
+    }
+    return result != 0;
+}
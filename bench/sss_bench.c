@@ -0,0 +1,308 @@
+/**
+ * Kernel Microbenchmarks
+ *
+ * Times the building blocks every protocol is made of: GF(256)
+ * arithmetic and matrix products, polynomial evaluation and interpolation, and splitting
+ * and combining secrets, the latter across (threshold, shares, secret
+ * length) grids.
+ *
+ * Usage:
+ *   sss_bench [-w warmup] [-r reps] [-m min_sample_ms] [-f filter]
+ *           [-j results.json] [-p] [-q]
+ *   (-q: quick run; -f gf256: only the field benchmarks; -p: hardware
+ *   counters, where perf events are available)
+ */
+
+#include "bench.h"
+#include "sss/field.h"
+#include "sss/polynomial.h"
+#include "sss/secret_sharing.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Operand table size (a power of two) */
+#define OPERANDS 4096
+
+/* (threshold, shares) pairs of the sharing grids */
+static const uint8_t share_grid[][2] = {
+    {2, 3}, {3, 5}, {5, 10}, {10, 20}, {32, 64}, {128, 255}
+};
+
+/* Secret lengths of the sharing grids (shares hold at most 32 bytes) */
+static const size_t secret_lengths[] = {1, 16, SSS_SHARE_DATA_SIZE};
+
+/* Thresholds of the polynomial benchmarks */
+static const uint8_t poly_thresholds[] = {2, 3, 5, 10, 32, 128, 255};
+
+#define COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+/* ========================================================================
+ * Field Arithmetic
+ * ======================================================================== */
+
+typedef struct {
+    uint8_t a[OPERANDS];
+    uint8_t b[OPERANDS];            // Never zero
+} field_operands_t;
+
+static void bench_gf256_mul(void *arg, uint64_t iters) {
+    const field_operands_t *ops = arg;
+    uint8_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        // Chained through acc, so iterations cannot overlap freely
+        acc ^= gf256_mul(ops->a[i & (OPERANDS - 1)] ^ acc,
+                         ops->b[i & (OPERANDS - 1)]);
+    }
+    bench_sink += acc;
+}
+
+static void bench_gf256_inv(void *arg, uint64_t iters) {
+    const field_operands_t *ops = arg;
+    uint8_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        acc ^= gf256_inv(ops->b[i & (OPERANDS - 1)]);
+    }
+    bench_sink += acc;
+}
+
+static void bench_gf256_inv_batch(void *arg, uint64_t iters) {
+    const field_operands_t *ops = arg;
+    static uint8_t inverses[OPERANDS];
+    for (uint64_t i = 0; i < iters; i++) {
+        gf256_inv_batch(ops->b, inverses, OPERANDS);
+        bench_sink += inverses[i & (OPERANDS - 1)];
+    }
+}
+
+static void bench_gf256_div(void *arg, uint64_t iters) {
+    const field_operands_t *ops = arg;
+    uint8_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        acc ^= gf256_div(ops->a[i & (OPERANDS - 1)] ^ acc,
+                         ops->b[i & (OPERANDS - 1)]);
+    }
+    bench_sink += acc;
+}
+
+/* Largest side of the matrix product benchmarks */
+#define GEMM_MAX 128
+
+/* Sides of the square matrix product benchmarks */
+static const size_t gemm_sizes[] = {8, 32, GEMM_MAX};
+
+typedef struct {
+    uint8_t a[GEMM_MAX * GEMM_MAX];
+    uint8_t b[GEMM_MAX * GEMM_MAX];
+    uint8_t c[GEMM_MAX * GEMM_MAX];
+    size_t n;
+} gemm_args_t;
+
+static void bench_gf256_gemm(void *arg, uint64_t iters) {
+    gemm_args_t *g = arg;
+    for (uint64_t i = 0; i < iters; i++) {
+        gf256_gemm(g->n, g->n, g->n, g->a, g->b, g->c);
+        g->a[0] ^= g->c[0];
+    }
+    bench_sink += g->c[0];
+}
+
+/* ========================================================================
+ * Polynomials
+ * ======================================================================== */
+
+typedef struct {
+    sss_polynomial_t poly;
+    uint8_t x[SSS_MAX_SHARES];
+    uint8_t y[SSS_MAX_SHARES];
+    uint8_t num_points;
+} poly_args_t;
+
+static void bench_poly_evaluate(void *arg, uint64_t iters) {
+    const poly_args_t *p = arg;
+    uint8_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        acc ^= sss_polynomial_evaluate(&p->poly, (uint8_t)(i % 255 + 1));
+    }
+    bench_sink += acc;
+}
+
+static void bench_poly_interpolate(void *arg, uint64_t iters) {
+    const poly_args_t *p = arg;
+    uint8_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        acc ^= sss_polynomial_interpolate(p->x, p->y, p->num_points);
+    }
+    bench_sink += acc;
+}
+
+/* ========================================================================
+ * Secret Sharing
+ * ======================================================================== */
+
+typedef struct {
+    uint8_t secret[SSS_SHARE_DATA_SIZE];
+    size_t secret_len;
+    uint8_t threshold;
+    uint8_t num_shares;
+    sss_share_t shares[SSS_MAX_SHARES];
+    int failed;                     // Set when a call returns an error
+} sharing_args_t;
+
+static void bench_create_shares(void *arg, uint64_t iters) {
+    sharing_args_t *s = arg;
+    for (uint64_t i = 0; i < iters; i++) {
+        if (sss_create_shares(s->secret, s->secret_len, s->threshold,
+                              s->num_shares, s->shares) != SSS_OK) {
+            s->failed = 1;
+            return;
+        }
+    }
+    bench_sink += s->shares[0].data[0];
+}
+
+static void bench_combine_shares(void *arg, uint64_t iters) {
+    sharing_args_t *s = arg;
+    uint8_t secret[SSS_SHARE_DATA_SIZE];
+    for (uint64_t i = 0; i < iters; i++) {
+        size_t len = sizeof(secret);
+        if (sss_combine_shares(s->shares, s->threshold, secret, &len) !=
+            SSS_OK) {
+            s->failed = 1;
+            return;
+        }
+        bench_sink += secret[0];
+    }
+}
+
+/* ========================================================================
+ * Main
+ * ======================================================================== */
+
+static int run(const bench_config_t *config, const char *name,
+               const char *params, size_t bytes, bench_fn fn, void *arg) {
+    if (!bench_selected(config, name)) {
+        return 0;
+    }
+
+    bench_result_t result;
+    if (bench_run(config, name, params, bytes, fn, arg, &result) != 0) {
+        printf("%-24s %-20s failed\n", name, params);
+        return -1;
+    }
+    bench_print_result(&result);
+    bench_print_perf(&result);
+    bench_json_result(&result);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    bench_config_default(&config);
+    if (bench_parse_args(argc, argv, &config) != argc) {
+        printf("Usage: %s [-w warmup] [-r reps] [-m min_sample_ms] "
+               "[-f filter] [-j results.json] [-p] [-q]\n", argv[0]);
+        return 1;
+    }
+
+    if (sss_init() != 0) {
+        printf("Failed to initialize library\n");
+        return 1;
+    }
+
+    printf("sss_bench: %u warmup + %u samples of >= %.1f ms each\n\n",
+           config.warmup, config.reps, config.min_sample_ms);
+    if (bench_json_begin(&config, "sss_bench") != 0) {
+        printf("Cannot write %s\n", config.json_path);
+        return 1;
+    }
+    bench_print_header();
+
+    int result = 0;
+    char params[48];
+
+    // Field arithmetic
+    static field_operands_t ops;
+    bench_fill(ops.a, OPERANDS, 1);
+    bench_fill(ops.b, OPERANDS, 2);
+    for (size_t i = 0; i < OPERANDS; i++) {
+        ops.b[i] |= (ops.b[i] == 0);
+    }
+    result |= run(&config, "gf256_mul", "", 1, bench_gf256_mul, &ops);
+    result |= run(&config, "gf256_inv", "", 1, bench_gf256_inv, &ops);
+    snprintf(params, sizeof(params), "n=%d", OPERANDS);
+    result |= run(&config, "gf256_inv_batch", params, OPERANDS,
+                  bench_gf256_inv_batch, &ops);
+    result |= run(&config, "gf256_div", "", 1, bench_gf256_div, &ops);
+
+    // Square matrix products; throughput counts multiply-adds
+    static gemm_args_t gemm;
+    bench_fill(gemm.a, sizeof(gemm.a), 3);
+    bench_fill(gemm.b, sizeof(gemm.b), 4);
+    for (size_t g = 0; g < COUNT(gemm_sizes); g++) {
+        gemm.n = gemm_sizes[g];
+        snprintf(params, sizeof(params), "n=%zu", gemm.n);
+        result |= run(&config, "gf256_gemm", params,
+                      gemm.n * gemm.n * gemm.n, bench_gf256_gemm, &gemm);
+    }
+
+    // Polynomials of degree t - 1
+    static poly_args_t poly;
+    for (size_t g = 0; g < COUNT(poly_thresholds); g++) {
+        uint8_t t = poly_thresholds[g];
+        snprintf(params, sizeof(params), "t=%u", t);
+
+        if (sss_polynomial_create(&poly.poly, 0x5A, t - 1) != 0) {
+            return 1;
+        }
+        for (uint8_t i = 0; i < t; i++) {
+            poly.x[i] = (uint8_t)(i + 1);
+        }
+        bench_fill(poly.y, t, t);
+        poly.num_points = t;
+
+        result |= run(&config, "polynomial_evaluate", params, 1,
+                      bench_poly_evaluate, &poly);
+        result |= run(&config, "polynomial_interpolate", params, 1,
+                      bench_poly_interpolate, &poly);
+    }
+    sss_polynomial_wipe(&poly.poly);
+
+    // Splitting and combining over the (t, n, len) grid
+    static sharing_args_t sharing;
+    for (size_t g = 0; g < COUNT(share_grid); g++) {
+        for (size_t l = 0; l < COUNT(secret_lengths); l++) {
+            sharing.threshold = share_grid[g][0];
+            sharing.num_shares = share_grid[g][1];
+            sharing.secret_len = secret_lengths[l];
+            bench_fill(sharing.secret, sharing.secret_len, g * 8 + l);
+            snprintf(params, sizeof(params), "t=%u n=%u len=%zu",
+                     sharing.threshold, sharing.num_shares,
+                     sharing.secret_len);
+
+            result |= run(&config, "create_shares", params,
+                          sharing.secret_len, bench_create_shares, &sharing);
+            // Fresh shares, in case create_shares was filtered out
+            if (sss_create_shares(sharing.secret, sharing.secret_len,
+                                  sharing.threshold, sharing.num_shares,
+                                  sharing.shares) != SSS_OK) {
+                return 1;
+            }
+            result |= run(&config, "combine_shares", params,
+                          sharing.secret_len, bench_combine_shares, &sharing);
+        }
+    }
+
+    if (sharing.failed) {
+        printf("\nA sharing call failed; its timings are meaningless\n");
+        result = -1;
+    }
+
+    for (size_t i = 0; i < SSS_MAX_SHARES; i++) {
+        sss_wipe_share(&sharing.shares[i]);
+    }
+    if (bench_json_end() != 0) {
+        printf("Failed to write %s\n", config.json_path);
+        result = -1;
+    }
+    return result != 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * Capacity Planning Example: MPC over a Wide-Area Network
+ *
+ * Scenario:
+ *   A group of parties plans to compute, over the internet, the sums of
+ *   their private input vectors and the products of the first two.
+ *   How long will it take on their network?
+ *
+ * Approach:
+ *   Run the real protocol on simulated links with the expected latency,
+ *   bandwidth and jitter. Everything runs locally in a fraction of the
+ *   simulated time, and each protocol step is reported with its rounds,
+ *   traffic and estimated wall-clock time.
+ *
+ * Usage:
+ *   wan_planner [latency_ms] [bandwidth_mbps] [jitter_ms] [parties] [values]
+ *   (defaults: 40 ms, 100 Mbit/s, 2 ms, 5 parties, 1000 values each)
+ */
+
+#include "sss/transport_sim.h"
+#include "sss/mpc_net.h"
+#include "sss/mpc.h"
+#include "sss/secret_sharing.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_MAGENTA "\x1b[35m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_RESET   "\x1b[0m"
+
+/* IPv4 + TCP headers per message */
+#define WIRE_OVERHEAD 40
+
+#define MAX_STEPS 4
+
+void print_separator() {
+    printf(COLOR_CYAN "════════════════════════════════════════════════════════\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_MAGENTA "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+typedef struct {
+    const mpc_context_t *ctx;
+    mpc_transport_t *transport;
+    size_t values;
+    int status;
+} party_t;
+
+/**
+ * One party: share the inputs, add them up, multiply the first two
+ * vectors and open the results
+ */
+static void *party_main(void *arg) {
+    party_t *party = arg;
+    const mpc_context_t *ctx = party->ctx;
+    mpc_transport_t *net = party->transport;
+    uint8_t me = net->party_id;
+    uint8_t n = ctx->num_parties;
+    size_t count = party->values;
+
+    uint8_t *inputs = malloc(count);
+    uint8_t *opened = malloc(2 * count);
+    mpc_share_t *shares = malloc((size_t)n * count * sizeof(mpc_share_t));
+    mpc_share_t *results = malloc(2 * count * sizeof(mpc_share_t));
+    party->status = -1;
+
+    if (inputs == NULL || opened == NULL || shares == NULL || results == NULL) {
+        goto cleanup;
+    }
+    for (size_t k = 0; k < count; k++) {
+        inputs[k] = (uint8_t)(me * 31 + k);
+    }
+
+    mpc_sim_step_begin(net, "share inputs");
+    for (uint8_t dealer = 1; dealer <= n; dealer++) {
+        if (mpc_net_share_input(ctx, net, dealer,
+                                (dealer == me) ? inputs : NULL,
+                                &shares[(size_t)(dealer - 1) * count],
+                                count) != 0) {
+            goto cleanup;
+        }
+    }
+
+    mpc_sim_step_begin(net, "add (local)");
+    for (size_t k = 0; k < count; k++) {
+        results[k] = shares[k];
+        for (uint8_t p = 1; p < n; p++) {
+            if (mpc_secure_add(ctx, &results[k], &shares[(size_t)p * count + k],
+                               &results[k], 1) != 0) {
+                goto cleanup;
+            }
+        }
+    }
+
+    mpc_sim_step_begin(net, "multiply");
+    if (mpc_net_mul(ctx, net, shares, shares + count, results + count,
+                    count) != 0) {
+        goto cleanup;
+    }
+
+    mpc_sim_step_begin(net, "open");
+    if (mpc_net_open(ctx, net, results, opened, 2 * count) != 0) {
+        goto cleanup;
+    }
+    mpc_sim_step_end(net);
+    party->status = 0;
+
+cleanup:
+    free(inputs);
+    free(opened);
+    free(shares);
+    free(results);
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    mpc_sim_config_t config = {{40.0, 2.0, 100.0}, NULL, WIRE_OVERHEAD, 1, 1};
+    int parties = 5;
+    long values = 1000;
+
+    if (argc > 1) config.link.latency_ms = atof(argv[1]);
+    if (argc > 2) config.link.bandwidth_mbps = atof(argv[2]);
+    if (argc > 3) config.link.jitter_ms = atof(argv[3]);
+    if (argc > 4) parties = atoi(argv[4]);
+    if (argc > 5) values = atol(argv[5]);
+
+    print_header("MPC Capacity Planning: Simulated WAN");
+
+    if (parties < 3 || parties > 64 || values < 1 || values > 100000) {
+        printf(COLOR_RED "  parties must be 3-64 and values 1-100000\n" COLOR_RESET);
+        return 1;
+    }
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "Failed to initialize library\n" COLOR_RESET);
+        return 1;
+    }
+
+    printf("\n" COLOR_CYAN "🌐 Network:" COLOR_RESET "\n");
+    printf("  • Latency:   %.1f ms one way (+ up to %.1f ms jitter)\n",
+           config.link.latency_ms, config.link.jitter_ms);
+    printf("  • Bandwidth: %.1f Mbit/s per link\n", config.link.bandwidth_mbps);
+    printf("  • %d parties, %ld values each\n", parties, values);
+
+    mpc_context_t ctx;
+    mpc_transport_t *net[64];
+    party_t party[64];
+    pthread_t threads[64];
+
+    mpc_init_context(&ctx, (uint8_t)parties, (uint8_t)((parties + 1) / 2), 1);
+    if (mpc_transport_sim_create((uint8_t)parties, &config, net) != 0) {
+        printf(COLOR_RED "  ✗ Invalid network model\n" COLOR_RESET);
+        return 1;
+    }
+
+    for (int i = 0; i < parties; i++) {
+        party[i].ctx = &ctx;
+        party[i].transport = net[i];
+        party[i].values = (size_t)values;
+        pthread_create(&threads[i], NULL, party_main, &party[i]);
+    }
+    for (int i = 0; i < parties; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    int ok = 1;
+    for (int i = 0; i < parties; i++) {
+        ok = ok && party[i].status == 0;
+    }
+    if (!ok) {
+        printf(COLOR_RED "  ✗ Protocol failed\n" COLOR_RESET);
+        return 1;
+    }
+
+    // Every party follows the same steps; report party 1
+    mpc_sim_step_t steps[MAX_STEPS];
+    size_t num_steps = mpc_sim_get_steps(net[0], steps, MAX_STEPS);
+
+    printf("\n" COLOR_YELLOW "📋 Estimate (party 1):" COLOR_RESET "\n");
+    printf("  %-14s %6s %10s %10s %10s %10s\n",
+           "Step", "Rounds", "Sent", "Received", "Compute", "Time");
+    for (size_t s = 0; s < num_steps && s < MAX_STEPS; s++) {
+        printf("  %-14s %6llu %8.1fKB %8.1fKB %8.2fms %8.1fms\n",
+               steps[s].name, (unsigned long long)steps[s].rounds,
+               steps[s].bytes_sent / 1024.0, steps[s].bytes_received / 1024.0,
+               steps[s].compute_ms, steps[s].elapsed_ms);
+    }
+    print_separator();
+    printf(COLOR_GREEN "  Estimated total: %.1f ms\n" COLOR_RESET,
+           mpc_sim_now_ms(net[0]));
+    print_separator();
+
+    printf("\n" COLOR_MAGENTA "🔑 Key Insight:" COLOR_RESET "\n");
+    printf("  ✓ Each round costs at least one network latency\n");
+    printf("  ✓ Batching values into the same round hides it\n");
+    printf("  ✓ Local steps (addition) are free on any network\n");
+
+    for (int i = 0; i < parties; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    printf("\n");
+    return 0;
+}
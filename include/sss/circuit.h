@@ -0,0 +1,317 @@
+#ifndef SSS_CIRCUIT_H
+#define SSS_CIRCUIT_H
+
+#include "sss/mpc.h"
+#include "sss/executor.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Arithmetic Circuits over GF(256)
+ *
+ * A circuit describes an MPC computation as a graph of gates instead of
+ * a hand-written sequence of mpc_secure_*() calls. Every gate produces
+ * one wire, and a wire is identified by the index of the gate that
+ * drives it.
+ *
+ * Gates may only read wires that already exist, so the order in which
+ * gates are added is always a valid topological order.
+ *
+ * Each gate records its multiplicative level: the number of MUL gates
+ * on the longest path from any input to it. The evaluator groups gates
+ * by level and runs all MUL gates of a level as one batched interactive
+ * step (see mpc_secure_mul_batch()). A circuit therefore costs as many
+ * rounds as its multiplicative depth, not as many as it has MUL gates.
+ *
+ * Example: (a × b) + (c × d)
+ *   mpc_circuit_t circ;
+ *   mpc_circuit_init(&circ);
+ *   mpc_wire_t a = mpc_circuit_input(&circ);
+ *   mpc_wire_t b = mpc_circuit_input(&circ);
+ *   mpc_wire_t c = mpc_circuit_input(&circ);
+ *   mpc_wire_t d = mpc_circuit_input(&circ);
+ *   mpc_wire_t ab = mpc_circuit_mul(&circ, a, b);
+ *   mpc_wire_t cd = mpc_circuit_mul(&circ, c, d);
+ *   mpc_circuit_output(&circ, mpc_circuit_add(&circ, ab, cd));
+ *   // Depth 1: both products are computed in a single round
+ * ======================================================================== */
+
+/* ========================================================================
+ * Data Structures
+ * ======================================================================== */
+
+/**
+ * Wire identifier (index of the gate driving the wire)
+ */
+typedef uint32_t mpc_wire_t;
+
+/* Returned by the builder functions on error */
+#define MPC_WIRE_INVALID UINT32_MAX
+
+/**
+ * Gate types
+ */
+typedef enum {
+    MPC_GATE_INPUT = 0,     // Shared input value (no operands)
+    MPC_GATE_ADD,           // in0 + in1 (local)
+    MPC_GATE_SUB,           // in0 - in1 (local)
+    MPC_GATE_MUL_CONST,     // in0 × public constant (local)
+    MPC_GATE_MUL,           // in0 × in1 (interactive)
+    MPC_GATE_OUTPUT,        // Exposes in0 as a circuit output
+    MPC_GATE_CONST          // Public constant in every byte (no operands)
+} mpc_gate_type_t;
+
+/**
+ * Single gate of a circuit
+ */
+typedef struct {
+    mpc_gate_type_t type;   // Gate type
+    mpc_wire_t in0;         // First operand (unused for INPUT)
+    mpc_wire_t in1;         // Second operand (ADD, SUB and MUL only)
+    uint8_t constant;       // Public constant (MUL_CONST and CONST only)
+    uint32_t slot;          // Input/output position (INPUT and OUTPUT only)
+    uint32_t level;         // Multiplicative level of this gate
+} mpc_gate_t;
+
+/**
+ * Arithmetic circuit
+ */
+typedef struct {
+    mpc_gate_t *gates;      // Gates in topological order
+    uint32_t num_gates;     // Number of gates in use
+    uint32_t capacity;      // Number of gates allocated
+    uint32_t num_inputs;    // Number of INPUT gates
+    uint32_t num_outputs;   // Number of OUTPUT gates
+    uint32_t depth;         // Multiplicative depth (highest gate level)
+} mpc_circuit_t;
+
+/**
+ * Evaluation statistics
+ */
+typedef struct {
+    uint32_t rounds;            // Interactive steps performed
+    uint32_t multiplications;   // MUL gates evaluated
+    uint32_t local_gates;       // ADD, SUB and MUL_CONST gates evaluated
+} mpc_circuit_stats_t;
+
+/* ========================================================================
+ * Circuit Construction
+ * ======================================================================== */
+
+/**
+ * Initialize an empty circuit.
+ *
+ * @param circuit  Circuit to initialize
+ * @return 0 on success, -1 on failure
+ */
+int mpc_circuit_init(mpc_circuit_t *circuit);
+
+/**
+ * Release all memory held by a circuit.
+ *
+ * @param circuit  Circuit to free (may be NULL)
+ */
+void mpc_circuit_free(mpc_circuit_t *circuit);
+
+/**
+ * Add an input gate.
+ *
+ * Inputs are numbered in the order they are added; the evaluator reads
+ * input number k from inputs[k].
+ *
+ * @param circuit  Circuit to extend
+ * @return Wire of the new input, or MPC_WIRE_INVALID on failure
+ */
+mpc_wire_t mpc_circuit_input(mpc_circuit_t *circuit);
+
+/**
+ * Add an addition gate (a + b).
+ *
+ * @return Wire of the sum, or MPC_WIRE_INVALID on failure
+ */
+mpc_wire_t mpc_circuit_add(mpc_circuit_t *circuit, mpc_wire_t a, mpc_wire_t b);
+
+/**
+ * Add a subtraction gate (a - b).
+ *
+ * @return Wire of the difference, or MPC_WIRE_INVALID on failure
+ */
+mpc_wire_t mpc_circuit_sub(mpc_circuit_t *circuit, mpc_wire_t a, mpc_wire_t b);
+
+/**
+ * Add a multiplication-by-public-constant gate (a × constant).
+ *
+ * @return Wire of the product, or MPC_WIRE_INVALID on failure
+ */
+mpc_wire_t mpc_circuit_mul_const(mpc_circuit_t *circuit, mpc_wire_t a,
+                                 uint8_t constant);
+
+/**
+ * Add a multiplication gate (a × b).
+ *
+ * This is the only gate that needs interaction between parties.
+ *
+ * @return Wire of the product, or MPC_WIRE_INVALID on failure
+ */
+mpc_wire_t mpc_circuit_mul(mpc_circuit_t *circuit, mpc_wire_t a, mpc_wire_t b);
+
+/**
+ * Add a public constant.
+ *
+ * Every party holds the constant itself as its share (a degree-0
+ * sharing), so constants cost nothing to evaluate. The constant is
+ * repeated in every byte of the value, like mpc_secure_mul_const().
+ *
+ * @return Wire of the constant, or MPC_WIRE_INVALID on failure
+ */
+mpc_wire_t mpc_circuit_const(mpc_circuit_t *circuit, uint8_t value);
+
+/**
+ * Add an output gate exposing wire a.
+ *
+ * Outputs are numbered in the order they are added; the evaluator writes
+ * output number k to outputs[k].
+ *
+ * @return Wire of the output gate, or MPC_WIRE_INVALID on failure
+ */
+mpc_wire_t mpc_circuit_output(mpc_circuit_t *circuit, mpc_wire_t a);
+
+/* ========================================================================
+ * Optimization
+ * ======================================================================== */
+
+/* Optimization passes for mpc_circuit_optimize() */
+#define MPC_OPT_FOLD     0x01   // Constant folding and algebraic identities
+#define MPC_OPT_CSE      0x02   // Common-subexpression elimination
+#define MPC_OPT_BALANCE  0x04   // Rebalance product chains into trees
+#define MPC_OPT_DCE      0x08   // Dead-gate removal
+#define MPC_OPT_ALL      0x0F
+
+/**
+ * Optimization statistics
+ */
+typedef struct {
+    uint32_t gates_before;      // Gates in the original circuit
+    uint32_t gates_after;       // Gates in the optimized circuit
+    uint32_t muls_before;       // MUL gates (Beaver triples) before
+    uint32_t muls_after;        // MUL gates (Beaver triples) after
+    uint32_t depth_before;      // Multiplicative depth (rounds) before
+    uint32_t depth_after;       // Multiplicative depth (rounds) after
+} mpc_circuit_opt_stats_t;
+
+/**
+ * Optimize a circuit before evaluation.
+ *
+ * Builds a new circuit computing the same outputs from the same inputs
+ * (inputs are never removed, so input numbering is preserved):
+ *
+ * - MPC_OPT_FOLD: evaluates gates whose operands are all public, and
+ *   applies identities such as x + 0 = x, x × 1 = x, x × 0 = 0 and
+ *   x - x = 0. A MUL by a public constant becomes a local MUL_CONST,
+ *   and nested MUL_CONST gates collapse into one.
+ * - MPC_OPT_CSE: reuses an existing gate when the same operation on the
+ *   same operands is requested again. ADD and MUL operands are ordered
+ *   canonically, and SUB is treated as ADD (both are XOR in GF(256)).
+ * - MPC_OPT_BALANCE: a chain of MUL gates whose intermediate products
+ *   are used nowhere else is rebuilt as a tree, always multiplying the
+ *   two shallowest factors first. x1 × x2 × ... × x8 drops from depth 7
+ *   to depth 3.
+ * - MPC_OPT_DCE: drops gates that do not contribute to any output.
+ *
+ * @param circuit    Circuit to optimize
+ * @param optimized  Output circuit (initialized by this function)
+ * @param passes     Bitmask of MPC_OPT_* passes to run
+ * @param stats      Optional optimization statistics (can be NULL)
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   mpc_circuit_t fast;
+ *   mpc_circuit_optimize(&circ, &fast, MPC_OPT_ALL, NULL);
+ *   mpc_circuit_evaluate(&ctx, &fast, inputs, outputs, 5, &stats);
+ *   mpc_circuit_free(&fast);
+ */
+int mpc_circuit_optimize(const mpc_circuit_t *circuit,
+                         mpc_circuit_t *optimized,
+                         unsigned passes,
+                         mpc_circuit_opt_stats_t *stats);
+
+/* ========================================================================
+ * Evaluation
+ * ======================================================================== */
+
+/**
+ * Evaluate a circuit on shared inputs.
+ *
+ * Gates are grouped into layers by multiplicative level. For each layer,
+ * all MUL gates are evaluated together with one call to
+ * mpc_secure_mul_batch(), then the local gates of that layer are
+ * evaluated in topological order.
+ *
+ * @param ctx         MPC context (inputs must belong to it)
+ * @param circuit     Circuit to evaluate
+ * @param inputs      Array of num_inputs share sets (num_shares each)
+ * @param outputs     Array of num_outputs share sets (num_shares each)
+ * @param num_shares  Number of shares per value (must not exceed
+ *                    num_parties; shares must be in party order)
+ * @param stats       Optional evaluation statistics (can be NULL)
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   const mpc_share_t *inputs[4] = {sa, sb, sc, sd};
+ *   mpc_share_t result[5];
+ *   mpc_share_t *outputs[1] = {result};
+ *   mpc_circuit_stats_t stats;
+ *   mpc_circuit_evaluate(&ctx, &circ, inputs, outputs, 5, &stats);
+ *   // stats.rounds == circ.depth
+ */
+int mpc_circuit_evaluate(const mpc_context_t *ctx,
+                         const mpc_circuit_t *circuit,
+                         const mpc_share_t *const *inputs,
+                         mpc_share_t *const *outputs,
+                         uint8_t num_shares,
+                         mpc_circuit_stats_t *stats);
+
+/**
+ * Evaluate a circuit on shared inputs using a work-stealing executor.
+ *
+ * Produces the same outputs and round count as mpc_circuit_evaluate().
+ * The MUL gates of each layer stay one batch: the workers form the local
+ * products and reshare the results in chunks, but the products of the
+ * whole layer are opened in a single step between the two, so a layer
+ * costs one degree-reduction round however many workers share it. The
+ * local gates of a layer are grouped by their dependency depth within
+ * the layer, and each group is evaluated as one parallel loop.
+ *
+ * @param ctx         MPC context (inputs must belong to it)
+ * @param circuit     Circuit to evaluate
+ * @param executor    Executor that runs the gates
+ * @param inputs      Array of num_inputs share sets (num_shares each)
+ * @param outputs     Array of num_outputs share sets (num_shares each)
+ * @param num_shares  Number of shares per value (must not exceed
+ *                    num_parties; shares must be in party order)
+ * @param stats       Optional evaluation statistics (can be NULL)
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   mpc_executor_t *ex = mpc_executor_create(0, MPC_EXECUTOR_PIN_THREADS);
+ *   mpc_circuit_evaluate_parallel(&ctx, &circ, ex, inputs, outputs, 5,
+ *                                 &stats);
+ *   mpc_executor_destroy(ex);
+ */
+int mpc_circuit_evaluate_parallel(const mpc_context_t *ctx,
+                                  const mpc_circuit_t *circuit,
+                                  mpc_executor_t *executor,
+                                  const mpc_share_t *const *inputs,
+                                  mpc_share_t *const *outputs,
+                                  uint8_t num_shares,
+                                  mpc_circuit_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_CIRCUIT_H */
@@ -0,0 +1,106 @@
+#ifndef SSS_EXECUTOR_H
+#define SSS_EXECUTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Work-Stealing Executor
+ *
+ * Runs data-parallel loops (such as the independent gates of a circuit
+ * layer) on a fixed pool of worker threads.
+ *
+ * Scheduling:
+ * - The index range is cut into chunks, and each worker starts on its
+ *   own contiguous slice of chunks. With pinned workers, the gates a
+ *   core touches first stay on that core (and on its NUMA node). The
+ *   caller puts every slice in its worker's deque before waking the
+ *   workers, so a worker that is slow to be scheduled cannot hold its
+ *   slice back from the others.
+ * - Each worker keeps its pending chunk ranges in a private lock-free
+ *   deque. It splits its current range in half, pushing the upper half,
+ *   until a single chunk remains, then runs that chunk.
+ * - An idle worker steals the largest pending range from the top of
+ *   another worker's deque, trying the nearest worker ids first.
+ *
+ * No lock is taken while a loop runs. A mutex and condition variable
+ * are used only to park idle workers between loops.
+ *
+ * The calling thread takes part as worker 0, so an executor created
+ * with N threads starts N - 1 extra threads.
+ * ======================================================================== */
+
+/* Default number of loop iterations per chunk */
+#define MPC_EXECUTOR_DEFAULT_CHUNK 64
+
+/* Executor creation flags */
+#define MPC_EXECUTOR_PIN_THREADS 0x01   // Pin worker i (i >= 1) to allowed CPU i
+
+/**
+ * Loop body called for each chunk.
+ *
+ * @param arg     User argument passed to mpc_executor_parallel_for()
+ * @param begin   First index of the chunk
+ * @param end     One past the last index of the chunk
+ * @param worker  Id of the worker running the chunk (0 to N-1)
+ */
+typedef void (*mpc_executor_fn)(void *arg, size_t begin, size_t end,
+                                unsigned worker);
+
+/* Opaque executor handle */
+typedef struct mpc_executor mpc_executor_t;
+
+/**
+ * Create an executor.
+ *
+ * @param num_threads  Number of workers including the caller
+ *                     (0 = one per CPU the process may use)
+ * @param flags        MPC_EXECUTOR_* flags
+ * @return New executor, or NULL on failure
+ *
+ * Example:
+ *   mpc_executor_t *ex = mpc_executor_create(0, MPC_EXECUTOR_PIN_THREADS);
+ *   mpc_circuit_evaluate_parallel(&ctx, &circ, ex, inputs, outputs, 5, NULL);
+ *   mpc_executor_destroy(ex);
+ */
+mpc_executor_t *mpc_executor_create(unsigned num_threads, unsigned flags);
+
+/**
+ * Stop all workers and free the executor.
+ *
+ * @param executor  Executor to destroy (may be NULL)
+ */
+void mpc_executor_destroy(mpc_executor_t *executor);
+
+/**
+ * Number of workers, including the calling thread.
+ */
+unsigned mpc_executor_num_threads(const mpc_executor_t *executor);
+
+/**
+ * Run fn over [0, count) in chunks of chunk_size indices.
+ *
+ * Returns once every chunk has run. Loops with a single chunk run
+ * directly on the calling thread. Only one loop may run at a time on
+ * an executor.
+ *
+ * @param executor    Executor to use
+ * @param count       Number of loop iterations
+ * @param chunk_size  Iterations per chunk (0 = MPC_EXECUTOR_DEFAULT_CHUNK)
+ * @param fn          Loop body
+ * @param arg         User argument passed to fn
+ * @return 0 on success, -1 on failure
+ */
+int mpc_executor_parallel_for(mpc_executor_t *executor, size_t count,
+                              size_t chunk_size, mpc_executor_fn fn,
+                              void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_EXECUTOR_H */
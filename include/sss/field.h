@@ -2,6 +2,7 @@
 #define SSS_FIELD_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -79,6 +80,19 @@ uint8_t gf256_div(uint8_t a, uint8_t b);
  */
 uint8_t gf256_inv(uint8_t a);
 
+/**
+ * Invert many elements of GF(256) at once
+ * 
+ * @param in     Elements to invert
+ * @param out    Output: out[i] = in[i]⁻¹, and 0 where in[i] is 0
+ *               (must not overlap in)
+ * @param count  Number of elements
+ * 
+ * Montgomery's trick: one gf256_inv() of the running product, then two
+ * multiplications per element, instead of one exponentiation each.
+ */
+void gf256_inv_batch(const uint8_t *in, uint8_t *out, size_t count);
+
 /**
  * Raise an element to a power in GF(256)
  * 
@@ -90,6 +104,24 @@ uint8_t gf256_inv(uint8_t a);
  */
 uint8_t gf256_pow(uint8_t base, uint8_t exp);
 
+/**
+ * Matrix product in GF(256): C = A × B
+ * 
+ * @param rows   Rows of A and C
+ * @param inner  Columns of A, rows of B
+ * @param cols   Columns of B and C
+ * @param a      A, rows × inner, row-major
+ * @param b      B, inner × cols, row-major
+ * @param c      Output: C, rows × cols, row-major (must not overlap A or B)
+ * 
+ * Each element of A is doubled once into its eight multiples x^k·a,
+ * which then scale a whole row of B with masks instead of branches, so
+ * the time does not depend on the values. The cost per product falls
+ * as cols grows.
+ */
+void gf256_gemm(size_t rows, size_t inner, size_t cols,
+                const uint8_t *a, const uint8_t *b, uint8_t *c);
+
 /**
  * Initialize lookup tables for fast multiplication
  * (Optional optimization - can be called once at startup)
@@ -0,0 +1,305 @@
+#ifndef SSS_FIXED_POINT_H
+#define SSS_FIXED_POINT_H
+
+#include "sss/mpc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Fixed-Point Arithmetic on Shares
+ *
+ * The GF(256) shares of mpc.h add by XOR, so they cannot hold sums of
+ * salaries or anything else that needs carries. This module shares
+ * signed fixed-point numbers over the prime field GF(2^127 - 1) instead:
+ * a value x is held as the integer round(x * 2^MPC_FX_FRAC_BITS), and
+ * negative integers wrap around the prime. Sums and public integer
+ * multiples are then exact and local, as with the byte shares.
+ *
+ * A product has 2 * MPC_FX_FRAC_BITS fractional bits and a share
+ * polynomial of degree 2(t-1). Multiplication therefore reduces the
+ * degree by resharing each party's local product (Gennaro, Rabin and
+ * Rabin), which reconstructs nothing, and then truncates the extra
+ * fractional bits with probabilistic truncation (Catrina and Saxena):
+ *
+ *   1. A dealer shares a random r = r1 * 2^m + r0 with r0 < 2^m, and
+ *      also r0 on its own.
+ *   2. The parties open c = a + 2^(K-1) + r. Here a has |a| < 2^(K-1),
+ *      where K is MPC_FX_VALUE_BITS, and r has MPC_FX_SECURITY_BITS more
+ *      bits than a, so c hides a statistically.
+ *   3. Each party computes (a - (c mod 2^m) + r0) / 2^m locally. The
+ *      result is floor(a / 2^m) or one more, rounded up with
+ *      probability (a mod 2^m) / 2^m.
+ *
+ * Division by a public integer d multiplies by round(2^m / d) and
+ * truncates m bits the same way. Averages, weighted means and variances
+ * use these steps, and their results stay shared until one final
+ * mpc_fx_reconstruct().
+ *
+ * Masks come from an internal dealer, the same trust model as the
+ * reconstructing multiplication of mpc.h. Shares hold the context's
+ * party ids and session id; its value_size is not used.
+ *
+ * Range: every intermediate value, including a product before it is
+ * truncated, must stay below 2^(K-1) in magnitude at its scale. With
+ * the defaults, values up to about 2^34 (over 10^10) can be divided,
+ * and products and sums of squared deviations can reach about 2^51.
+ * Out-of-range intermediates give wrong results, not errors, because
+ * they are secret.
+ * ======================================================================== */
+
+/* Fractional bits of every shared number */
+#define MPC_FX_FRAC_BITS 16
+
+/* Bound K on intermediate values: |a| < 2^(K-1) before truncation */
+#define MPC_FX_VALUE_BITS 84
+
+/* Statistical security of the truncation masks, in bits */
+#define MPC_FX_SECURITY_BITS 40
+
+/**
+ * Fixed-Point Share
+ *
+ * One party's share of one number: an element of GF(2^127 - 1).
+ */
+typedef struct {
+    uint8_t party_id;               // Party holding this share (1-255)
+    mpc_session_id_t session_id;    // Session this share belongs to
+    uint64_t value[2];              // Field element, low 64 bits first
+} mpc_fx_share_t;
+
+/* ========================================================================
+ * Sharing and Reconstruction
+ * ======================================================================== */
+
+/**
+ * Share a fixed-point number among all parties of a context.
+ *
+ * @param ctx     MPC context
+ * @param value   Number to share; |value| must be below 2^(62 - f)
+ * @param shares  Output: ctx->num_parties shares, one per party
+ * @return 0 on success, -1 on failure (including a value out of range)
+ */
+int mpc_fx_create_shares(const mpc_context_t *ctx, double value,
+                         mpc_fx_share_t *shares);
+
+/**
+ * Reconstruct a fixed-point number from at least threshold shares.
+ *
+ * @param ctx         MPC context
+ * @param shares      Shares of distinct parties
+ * @param num_shares  Number of shares (at least ctx->threshold)
+ * @param value       Output: the number
+ * @return 0 on success, -1 on failure
+ */
+int mpc_fx_reconstruct(const mpc_context_t *ctx,
+                       const mpc_fx_share_t *shares, uint8_t num_shares,
+                       double *value);
+
+/* ========================================================================
+ * Arithmetic
+ *
+ * Linear operations are local and write one output share per input
+ * share. Operations that truncate take one opening round. mpc_fx_mul
+ * also reshares, needs num_shares >= 2 * threshold - 1 (as
+ * mpc_secure_mul does), and writes ctx->num_parties output shares.
+ * ======================================================================== */
+
+/**
+ * Shares of x + y (local)
+ */
+int mpc_fx_add(const mpc_context_t *ctx, const mpc_fx_share_t *shares_x,
+               const mpc_fx_share_t *shares_y, mpc_fx_share_t *shares_sum,
+               uint8_t num_shares);
+
+/**
+ * Shares of x - y (local)
+ */
+int mpc_fx_sub(const mpc_context_t *ctx, const mpc_fx_share_t *shares_x,
+               const mpc_fx_share_t *shares_y, mpc_fx_share_t *shares_diff,
+               uint8_t num_shares);
+
+/**
+ * Shares of x * y: resharing and one truncation (two rounds).
+ *
+ * @param ctx          MPC context
+ * @param shares_x     Shares of x
+ * @param shares_y     Shares of y, of the same parties in the same order
+ * @param shares_prod  Output: ctx->num_parties shares of the product
+ * @param num_shares   Shares per operand (at least 2 * threshold - 1)
+ * @return 0 on success, -1 on failure
+ */
+int mpc_fx_mul(const mpc_context_t *ctx, const mpc_fx_share_t *shares_x,
+               const mpc_fx_share_t *shares_y, mpc_fx_share_t *shares_prod,
+               uint8_t num_shares);
+
+/**
+ * Shares of x * c for a public fixed-point c (one truncation round)
+ */
+int mpc_fx_mul_public(const mpc_context_t *ctx,
+                      const mpc_fx_share_t *shares_x, double constant,
+                      mpc_fx_share_t *shares_prod, uint8_t num_shares);
+
+/**
+ * Shares of x / d for a public integer d (one truncation round).
+ *
+ * The quotient has a relative error below 2^-(f + 16) plus the last
+ * bit of the truncation.
+ *
+ * @param divisor  Public divisor, 1 to 2^40
+ * @return 0 on success, -1 on failure
+ */
+int mpc_fx_div_public(const mpc_context_t *ctx,
+                      const mpc_fx_share_t *shares_x, uint64_t divisor,
+                      mpc_fx_share_t *shares_quot, uint8_t num_shares);
+
+/* ========================================================================
+ * Batched Truncation and Division
+ *
+ * The calls above deal their truncation mask when they run. For large
+ * vectors the masks can be dealt ahead of time instead: a preprocessing
+ * pool holds masks for one shift m, and a batch call takes one mask per
+ * value and opens all masked values of the vector in a single round.
+ * Each mask is used once; a pool that runs short makes the batch fail
+ * before any output is written.
+ * ======================================================================== */
+
+/* Shift for dividing by public integers below 2^bits with the
+ * precision of mpc_fx_div_public() */
+#define MPC_FX_DIV_SHIFT(bits) (MPC_FX_FRAC_BITS + (bits) + 16)
+
+/* Preprocessed truncation masks (opaque) */
+typedef struct mpc_fx_prep mpc_fx_prep_t;
+
+/**
+ * Deal truncation masks for a context.
+ *
+ * @param ctx    MPC context the masks are shared in
+ * @param count  Number of masks, one per value truncated later
+ * @param shift  Bits the masks truncate, 1 to MPC_FX_VALUE_BITS - 1
+ * @return The pool, or NULL on failure
+ *
+ * Example: divide a million shared sums by their counts
+ *   mpc_fx_prep_t *prep = mpc_fx_prep_create(&ctx, 1000000,
+ *                                            MPC_FX_DIV_SHIFT(20));
+ *   mpc_fx_div_public_batch(&ctx, prep, sums, counts, means, 1000000, 5);
+ *   mpc_fx_prep_destroy(prep);
+ */
+mpc_fx_prep_t *mpc_fx_prep_create(const mpc_context_t *ctx, size_t count,
+                                  unsigned shift);
+
+/**
+ * Masks not yet used
+ */
+size_t mpc_fx_prep_remaining(const mpc_fx_prep_t *prep);
+
+/**
+ * Wipe and free a pool (NULL is ignored)
+ */
+void mpc_fx_prep_destroy(mpc_fx_prep_t *prep);
+
+/**
+ * Shares of x[k] / 2^m for a vector of count values (one round).
+ *
+ * m is the shift of the pool. Each x[k] must be below 2^(K-1) in
+ * magnitude. Output sets may alias their own input sets.
+ *
+ * @param ctx         MPC context
+ * @param prep        Pool of the same context, with count masks left
+ * @param shares_x    Array of count share sets
+ * @param shares_out  Array of count output share sets
+ * @param count       Number of values
+ * @param num_shares  Shares per value (at least threshold)
+ * @return 0 on success, -1 on failure
+ */
+int mpc_fx_trunc_batch(const mpc_context_t *ctx, mpc_fx_prep_t *prep,
+                       const mpc_fx_share_t *const *shares_x,
+                       mpc_fx_share_t *const *shares_out, size_t count,
+                       uint8_t num_shares);
+
+/**
+ * Shares of x[k] / d[k] for a vector of count values (one round).
+ *
+ * Each value is multiplied by round(2^m / d[k]) and truncated m bits,
+ * where m is the shift of the pool. Divisors must be below
+ * 2^(m - MPC_FX_FRAC_BITS); a pool of MPC_FX_DIV_SHIFT(bits) gives
+ * divisors below 2^bits the precision of mpc_fx_div_public().
+ *
+ * @param divisors  count public divisors, each at least 1
+ * @return 0 on success, -1 on failure
+ */
+int mpc_fx_div_public_batch(const mpc_context_t *ctx, mpc_fx_prep_t *prep,
+                            const mpc_fx_share_t *const *shares_x,
+                            const uint64_t *divisors,
+                            mpc_fx_share_t *const *shares_out, size_t count,
+                            uint8_t num_shares);
+
+/* ========================================================================
+ * Statistics
+ *
+ * share_sets[i] holds num_shares shares of value i. All sets must come
+ * from the same parties in the same order. Any number of values can be
+ * aggregated, not just 255.
+ * ======================================================================== */
+
+/**
+ * Shares of the sum of num_values numbers (local, exact)
+ */
+int mpc_fx_sum(const mpc_context_t *ctx,
+               const mpc_fx_share_t *const *share_sets, size_t num_values,
+               uint8_t num_shares, mpc_fx_share_t *shares_sum);
+
+/**
+ * Shares of the mean of num_values numbers (one round)
+ *
+ * Example: average salary of 5000 employees, opened once
+ *   mpc_fx_share_t avg[5];
+ *   double result;
+ *   mpc_fx_average(&ctx, salaries, 5000, 5, avg);
+ *   mpc_fx_reconstruct(&ctx, avg, 5, &result);
+ */
+int mpc_fx_average(const mpc_context_t *ctx,
+                   const mpc_fx_share_t *const *share_sets,
+                   size_t num_values, uint8_t num_shares,
+                   mpc_fx_share_t *shares_avg);
+
+/**
+ * Shares of sum(w[i] * x[i]) / sum(w[i]) for public weights (two rounds)
+ *
+ * Weights are scaled so the largest is 2^f and rounded to integers; the
+ * weighted sum is divided by their sum on shares.
+ *
+ * @param weights  num_values public weights; their sum must not be 0
+ */
+int mpc_fx_weighted_mean(const mpc_context_t *ctx,
+                         const mpc_fx_share_t *const *share_sets,
+                         const double *weights, size_t num_values,
+                         uint8_t num_shares, mpc_fx_share_t *shares_mean);
+
+/**
+ * Shares of the population variance of num_values numbers.
+ *
+ * The squared deviations from the shared mean are summed from local
+ * products and reshared once, however many values there are. The call
+ * takes four rounds and writes ctx->num_parties shares. Needs
+ * num_shares >= 2 * threshold - 1, and num_values times the variance
+ * below about 2^51.
+ */
+int mpc_fx_variance(const mpc_context_t *ctx,
+                    const mpc_fx_share_t *const *share_sets,
+                    size_t num_values, uint8_t num_shares,
+                    mpc_fx_share_t *shares_var);
+
+/**
+ * Securely wipe a fixed-point share
+ */
+void mpc_fx_wipe_share(mpc_fx_share_t *share);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_FIXED_POINT_H */
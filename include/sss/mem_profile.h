@@ -0,0 +1,78 @@
+#ifndef SSS_MEM_PROFILE_H
+#define SSS_MEM_PROFILE_H
+
+#include "sss/mpc.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Memory Profiling
+ *
+ * A library configured with -DSSS_MEMORY_PROFILE=ON accounts for the
+ * memory each MPC operation uses: heap buffers from malloc() and
+ * secure_malloc(), and the variable-length and large fixed stack arrays
+ * of mpc.c and secret_sharing.c. Everything a call uses is attributed
+ * to the outermost operation on the thread, so the reconstructions inside
+ * mpc_secure_mul() count towards MPC_OP_MUL.
+ *
+ * Each secure_malloc() buffer is backed by whole pages plus guard pages
+ * (see sodium_malloc), which usually dwarfs the bytes requested. The
+ * mapped peak estimates that cost and is the figure to size a container
+ * or an mlock limit by.
+ *
+ * Profiles are process-wide and updated atomically when a call returns.
+ * Without the option nothing is recorded, and the functions below
+ * report that.
+ * ======================================================================== */
+
+/**
+ * Memory use of one operation, over all its calls since the last reset
+ */
+typedef struct {
+    uint64_t calls;               // Calls profiled
+    uint64_t allocations;         // Heap buffers, malloc() and secure_malloc()
+    uint64_t secure_allocations;  // Of which secure_malloc()
+    uint64_t bytes_allocated;     // Heap bytes requested, all calls together
+    uint64_t stack_frames;        // Stack arrays entered, all calls together
+    uint64_t peak_heap_bytes;     // Most heap bytes live within one call
+    uint64_t peak_stack_bytes;    // Most stack array bytes live within one call
+    uint64_t peak_bytes;          // Most heap and stack bytes live at once
+    uint64_t peak_mapped_bytes;   // Same, secure buffers counted in pages
+} mpc_mem_profile_t;
+
+/**
+ * Whether the library was built with memory profiling
+ *
+ * @return 1 if operations are profiled, 0 otherwise
+ */
+int mpc_mem_profile_enabled(void);
+
+/**
+ * Read the memory profile of one operation
+ *
+ * @param op       Operation
+ * @param profile  Output: its profile
+ * @return 0 on success, -1 if profiling is not built in or op is invalid
+ *
+ * Example:
+ *   mpc_mem_profile_t p;
+ *   if (mpc_get_mem_profile(MPC_OP_SUM, &p) == 0 && p.calls > 0) {
+ *       printf("sum: %llu allocations per call, peak %llu bytes\n",
+ *              p.allocations / p.calls, p.peak_bytes);
+ *   }
+ */
+int mpc_get_mem_profile(mpc_op_t op, mpc_mem_profile_t *profile);
+
+/**
+ * Set every profile back to zero (no-op if not built in)
+ */
+void mpc_reset_mem_profile(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_MEM_PROFILE_H */
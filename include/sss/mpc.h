@@ -44,6 +44,24 @@ extern "C" {
  * Data Structures
  * ======================================================================== */
 
+/* Size of a session identifier in bytes */
+#define MPC_SESSION_ID_SIZE 16
+
+/* Length of a session identifier in hex, including the terminating NUL */
+#define MPC_SESSION_ID_HEX_SIZE (2 * MPC_SESSION_ID_SIZE + 1)
+
+/**
+ * Session Identifier
+ * 
+ * Names one computation session. 128 random bits keep ids of concurrent
+ * sessions from colliding (the birthday bound is reached only after
+ * about 2^64 sessions), so shares and messages of many live sessions
+ * can be told apart.
+ */
+typedef struct {
+    uint8_t bytes[MPC_SESSION_ID_SIZE];
+} mpc_session_id_t;
+
 /**
  * MPC Share Structure
  * 
@@ -53,9 +71,12 @@ extern "C" {
 typedef struct {
     sss_share_t share;      // Underlying Shamir's Secret Sharing share
     uint8_t party_id;       // ID of the party holding this share (1-255)
-    uint8_t computation_id; // ID to track which computation this belongs to
+    mpc_session_id_t session_id; // Session this share belongs to
 } mpc_share_t;
 
+/* Per-context operation counters (opaque, see mpc_enable_stats) */
+struct mpc_counters;
+
 /**
  * MPC Context Structure
  * 
@@ -65,10 +86,51 @@ typedef struct {
 typedef struct {
     uint8_t num_parties;    // Total number of parties participating (2-255)
     uint8_t threshold;      // Minimum parties needed to reconstruct (2 to num_parties)
-    uint8_t computation_id; // Unique ID for this computation session
+    mpc_session_id_t session_id; // Unique ID for this computation session
     size_t value_size;      // Size of values being computed (in bytes, max 256)
+    struct mpc_counters *counters; // Operation counters, or NULL (see mpc_enable_stats)
 } mpc_context_t;
 
+/**
+ * Operations timed by the per-context statistics
+ */
+typedef enum {
+    MPC_OP_CREATE_SHARES,
+    MPC_OP_RECONSTRUCT,
+    MPC_OP_ADD,
+    MPC_OP_SUB,
+    MPC_OP_MUL_CONST,
+    MPC_OP_MUL,             // mpc_secure_mul() and mpc_secure_mul_batch()
+    MPC_OP_DOT,             // mpc_secure_dot() and mpc_secure_matmul()
+    MPC_OP_SUM,
+    MPC_OP_AVERAGE,
+    MPC_OP_MAX,
+    MPC_OP_GREATER,
+    MPC_OP_EQUAL,           // mpc_secure_equal() and mpc_secure_equal_batch()
+    MPC_OP_INV,             // mpc_secure_inv() and mpc_secure_inv_batch()
+    MPC_OP_NET_SHARE_INPUT,
+    MPC_OP_NET_OPEN,
+    MPC_OP_NET_MUL,
+    MPC_OP_COUNT
+} mpc_op_t;
+
+/**
+ * Statistics of one context (see mpc_get_stats)
+ */
+typedef struct {
+    uint64_t multiplications;       // Products computed
+    uint64_t reconstructions;       // Values reconstructed from shares
+    uint64_t values_shared;         // Values split into shares (any reason)
+    uint64_t reshares;              // Products reshared (degree reductions)
+    uint64_t rounds;                // Rounds of the mpc_net_*() protocols
+    uint64_t bytes_sent;            // Payload bytes sent by mpc_net_*()
+    uint64_t bytes_received;        // Payload bytes received by mpc_net_*()
+    uint64_t validation_failures;   // Shares rejected by mpc_validate_share()
+    uint64_t secure_allocations;    // Secure buffers allocated
+    uint64_t calls[MPC_OP_COUNT];   // Calls per operation
+    uint64_t time_ns[MPC_OP_COUNT]; // Wall time per operation
+} mpc_stats_t;
+
 /* ========================================================================
  * Context Management
  * ======================================================================== */
@@ -113,6 +175,142 @@ int mpc_init_context(mpc_context_t *ctx, uint8_t num_parties,
  */
 void mpc_cleanup_context(mpc_context_t *ctx);
 
+/**
+ * Copy a context, sharing its operation counters.
+ *
+ * The copy takes a reference to the counters of src, so the two contexts
+ * may be cleaned up in either order; the counters are freed with the
+ * last of them. Copy contexts with this rather than by assignment, which
+ * would not take the reference.
+ *
+ * @param dst  Output: the copy (cleanup with mpc_cleanup_context())
+ * @param src  Initialized context
+ * @return 0 on success, -1 on failure
+ */
+int mpc_copy_context(mpc_context_t *dst, const mpc_context_t *src);
+
+/* ========================================================================
+ * Operation Statistics
+ *
+ * A context can count what its operations do: multiplications,
+ * reconstructions, reshares, rounds and bytes of the networked protocols,
+ * rejected shares and secure allocations, plus calls and cumulative wall
+ * time per operation. When a job runs slow, this shows which primitive
+ * the time goes to without attaching a profiler.
+ *
+ * Counting is off by default and costs one pointer test per operation.
+ * When on, counters are updated atomically, so threads may share the
+ * context, and each operation reads the clock twice. Times include
+ * nested operations: mpc_secure_mul() time contains the reconstructions
+ * it performs, which are also counted under MPC_OP_RECONSTRUCT.
+ *
+ * Copies made with mpc_copy_context() share the counters of their
+ * original. The counters are reference counted: each context cleaned up
+ * releases one reference, and the last one frees them.
+ * ======================================================================== */
+
+/**
+ * Start counting operations on a context.
+ *
+ * Counters start at zero. Enabling counters that are already enabled
+ * leaves them as they are. mpc_cleanup_context() on this context and
+ * on every copy of it releases them.
+ *
+ * @param ctx  Initialized context
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   mpc_init_context(&ctx, 5, 3, 1);
+ *   mpc_enable_stats(&ctx);
+ *   // ... run the job ...
+ *   mpc_stats_t stats;
+ *   mpc_get_stats(&ctx, &stats);
+ *   printf("%llu products, %.1f ms\n", stats.multiplications,
+ *          stats.time_ns[MPC_OP_MUL] / 1e6);
+ */
+int mpc_enable_stats(mpc_context_t *ctx);
+
+/**
+ * Read the counters of a context.
+ *
+ * Each counter is read atomically, but not all of them at one instant:
+ * operations running concurrently may show up in some counters only.
+ *
+ * @param ctx    Context
+ * @param stats  Output: current values
+ * @return 0 on success, -1 if counting is not enabled
+ */
+int mpc_get_stats(const mpc_context_t *ctx, mpc_stats_t *stats);
+
+/**
+ * Set every counter of a context back to zero (no-op if not enabled).
+ */
+void mpc_reset_stats(const mpc_context_t *ctx);
+
+/**
+ * Name of an operation (e.g. "mul"), or "unknown".
+ */
+const char *mpc_op_name(mpc_op_t op);
+
+/* ========================================================================
+ * Session Identifiers
+ * ======================================================================== */
+
+/**
+ * Generate a random session identifier.
+ * 
+ * @param id  Output identifier
+ * @return 0 on success, -1 on failure
+ */
+int mpc_session_id_random(mpc_session_id_t *id);
+
+/**
+ * Derive the identifier of a sub-session from a base identifier.
+ * 
+ * XORs index into the last 8 bytes of base (little-endian), so parties
+ * that agreed on one random base id can name any number of
+ * computations without further coordination.
+ * 
+ * @param base   Agreed base identifier
+ * @param index  Sub-session number
+ * @param id     Output identifier (may alias base)
+ * 
+ * Example:
+ *   // Job k of a batch, on every party
+ *   mpc_session_id_derive(&batch_id, k, &job_id);
+ */
+void mpc_session_id_derive(const mpc_session_id_t *base, uint64_t index,
+                           mpc_session_id_t *id);
+
+/**
+ * Compare two session identifiers.
+ * 
+ * @return 1 if equal, 0 otherwise
+ */
+int mpc_session_id_equal(const mpc_session_id_t *a, const mpc_session_id_t *b);
+
+/**
+ * Format a session identifier as lowercase hex.
+ * 
+ * @param id   Identifier to format
+ * @param out  Output buffer of MPC_SESSION_ID_HEX_SIZE bytes
+ */
+void mpc_session_id_to_hex(const mpc_session_id_t *id, char *out);
+
+/**
+ * Join an existing session.
+ * 
+ * mpc_init_context() gives each context a fresh random session id.
+ * Parties running one computation in separate processes agree on one id
+ * (for example, generated by one party and sent to the others) and set
+ * it on their contexts.
+ * 
+ * @param ctx  Initialized context
+ * @param id   Session identifier
+ * @return 0 on success, -1 on failure
+ */
+int mpc_context_set_session(mpc_context_t *ctx, const mpc_session_id_t *id);
+
 /* ========================================================================
  * Share Distribution
  * ======================================================================== */
@@ -175,7 +373,7 @@ int mpc_create_shares(const mpc_context_t *ctx, const uint8_t *secret,
  * Security Note:
  *   - Only reconstruct when you want to reveal the result
  *   - Before reconstruction, the secret remains hidden
- *   - All shares must be from the same computation_id
+ *   - All shares must be from the same session_id
  */
 int mpc_reconstruct(const mpc_context_t *ctx, const mpc_share_t *shares,
                     uint8_t num_shares, uint8_t *reconstructed);
@@ -216,7 +414,7 @@ void mpc_wipe_share(mpc_share_t *share);
  * 
  * Validation checks:
  * - party_id is in valid range (1 to num_parties)
- * - computation_id matches context
+ * - session_id matches context
  * - data_len matches value_size
  * 
  * Example:
@@ -353,6 +551,91 @@ int mpc_secure_mul(const mpc_context_t *ctx, const mpc_share_t *shares_x,
                    const mpc_share_t *shares_y, mpc_share_t *shares_prod,
                    uint8_t num_shares);
 
+/**
+ * Securely multiply many pairs of shared secrets in one interactive step.
+ * Given count share sets of X and Y, compute shares of each X[k] × Y[k].
+ *
+ * All local products are formed first, then every degree-2 product in
+ * the batch is reduced in the same round. A batch therefore costs one
+ * communication round no matter how many multiplications it holds,
+ * which is what lets a circuit run in (multiplicative depth) rounds.
+ *
+ * Output sets may alias input sets: no output is written until every
+ * local product of the batch has been computed.
+ *
+ * @param ctx         MPC context
+ * @param shares_x    Array of count share sets of first operands
+ * @param shares_y    Array of count share sets of second operands
+ * @param shares_prod Array of count output share sets (num_parties each)
+ * @param count       Number of multiplications in the batch
+ * @param num_shares  Number of shares provided per operand
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   const mpc_share_t *xs[2] = {shares_a, shares_c};
+ *   const mpc_share_t *ys[2] = {shares_b, shares_d};
+ *   mpc_share_t *out[2] = {shares_ab, shares_cd};
+ *   mpc_secure_mul_batch(&ctx, xs, ys, out, 2, 5);  // a×b and c×d, 1 round
+ */
+int mpc_secure_mul_batch(const mpc_context_t *ctx,
+                         const mpc_share_t *const *shares_x,
+                         const mpc_share_t *const *shares_y,
+                         mpc_share_t *const *shares_prod,
+                         size_t count,
+                         uint8_t num_shares);
+
+/**
+ * Securely compute the inner product of two shared vectors.
+ * Given length share sets of X and Y, compute shares of Σ X[l] × Y[l].
+ *
+ * Each party multiplies its shares term by term and adds the products
+ * locally. The sum is still a degree-2 sharing, so it is reduced once,
+ * whatever the length: an inner product of 10⁴ terms costs one
+ * reconstruct-and-reshare instead of 10⁴. Like mpc_secure_mul(), this
+ * needs num_shares >= 2 × threshold - 1.
+ *
+ * @param ctx         MPC context
+ * @param shares_x    Array of length share sets of X
+ * @param shares_y    Array of length share sets of Y
+ * @param length      Number of terms
+ * @param shares_dot  Output: shares of the inner product (num_parties)
+ * @param num_shares  Number of shares provided per operand
+ * @return 0 on success, -1 on failure
+ */
+int mpc_secure_dot(const mpc_context_t *ctx,
+                   const mpc_share_t *const *shares_x,
+                   const mpc_share_t *const *shares_y,
+                   size_t length,
+                   mpc_share_t *shares_dot,
+                   uint8_t num_shares);
+
+/**
+ * Securely multiply two shared matrices: C = A × B.
+ *
+ * Matrices are arrays of share sets in row-major order. Each party
+ * forms its local product matrix with gf256_gemm() and each of the
+ * rows × cols outputs is reduced once, all in the same round.
+ *
+ * Output sets may alias input sets: no output is written until every
+ * local product has been computed.
+ *
+ * @param ctx         MPC context
+ * @param shares_a    rows × inner share sets of A
+ * @param shares_b    inner × cols share sets of B
+ * @param shares_c    Output: rows × cols share sets of C (num_parties each)
+ * @param rows        Rows of A and C
+ * @param inner       Columns of A, rows of B
+ * @param cols        Columns of B and C
+ * @param num_shares  Number of shares provided per operand
+ * @return 0 on success, -1 on failure
+ */
+int mpc_secure_matmul(const mpc_context_t *ctx,
+                      const mpc_share_t *const *shares_a,
+                      const mpc_share_t *const *shares_b,
+                      mpc_share_t *const *shares_c,
+                      size_t rows, size_t inner, size_t cols,
+                      uint8_t num_shares);
+
 /* ========================================================================
  * High-Level MPC Functions
  * 
@@ -387,6 +670,8 @@ int mpc_secure_sum(const mpc_context_t *ctx,
  * 
  * Note: Division is done in plaintext after summing.
  * For fully secure division, implement secure division protocol.
+ * mpc_fx_average() in sss/fixed_point.h divides on shares and opens
+ * only the result.
  * 
  * Example:
  *   5 employees compute average salary
@@ -453,6 +738,108 @@ int mpc_secure_greater(const mpc_context_t *ctx,
                        uint8_t num_shares,
                        uint8_t *result);
 
+/* Rounds of mpc_secure_equal_batch(), whatever the batch size */
+#define MPC_EQUAL_ROUNDS 8
+
+/**
+ * Securely test many pairs of shared secrets for equality.
+ * Given count share sets of X and Y, compute shares of [X[k] == Y[k]]:
+ * 1 where they are equal, 0 where they differ.
+ *
+ * Implementation:
+ *   By Fermat's little theorem, d^255 = 1 for every nonzero d in
+ *   GF(256), so [x == y] = 1 + (x - y)^255. The power is computed with
+ *   the chain d^(2^k - 1), d^(2^k) → d^(2^(k+1) - 1), d^(2^(k+1)), two
+ *   multiplications per step, and every multiplication of a step is
+ *   batched across the whole batch. The test therefore takes exactly
+ *   MPC_EQUAL_ROUNDS rounds of mpc_secure_mul_batch().
+ *
+ * Not a secure comparison (like mpc_secure_greater, for learning):
+ *   mpc_secure_mul_batch() reconstructs every product in the clear
+ *   before resharing it. The first product is d², and squaring is a
+ *   bijection of GF(256), so whoever runs the reduction learns
+ *   d = x - y, and with it whether the values are equal.
+ *   Production: degree reduction without opening (e.g. resharing of the
+ *   local products, or Beaver triples).
+ *
+ * Each byte of a value is compared on its own, as every operation here
+ * works byte by byte. For multi-byte ids, multiply the byte results.
+ * Like mpc_secure_mul(), this needs num_shares >= 2 × threshold - 1.
+ *
+ * Example: which of 1000 records carry category 7
+ *   mpc_secure_equal_batch(&ctx, categories, sevens, hits, 1000, 5);
+ *   // hits[k] shares 1 for the matching records, 0 for the others
+ *
+ * @param ctx         MPC context
+ * @param shares_x    Array of count share sets of X
+ * @param shares_y    Array of count share sets of Y
+ * @param shares_eq   Array of count output share sets (num_parties each)
+ * @param count       Number of comparisons in the batch
+ * @param num_shares  Number of shares provided per operand
+ * @return 0 on success, -1 on failure
+ */
+int mpc_secure_equal_batch(const mpc_context_t *ctx,
+                           const mpc_share_t *const *shares_x,
+                           const mpc_share_t *const *shares_y,
+                           mpc_share_t *const *shares_eq,
+                           size_t count,
+                           uint8_t num_shares);
+
+/**
+ * Securely test two shared secrets for equality: shares of [X == Y]
+ * (a batch of one, see mpc_secure_equal_batch)
+ */
+int mpc_secure_equal(const mpc_context_t *ctx,
+                     const mpc_share_t *shares_x,
+                     const mpc_share_t *shares_y,
+                     mpc_share_t *shares_eq,
+                     uint8_t num_shares);
+
+/**
+ * Securely invert many shared secrets (Bar-Ilan–Beaver inversion).
+ * Given count share sets of X, compute shares of X[k]⁻¹ in GF(256).
+ *
+ * Implementation:
+ *   1. Share a random nonzero mask r for every value
+ *   2. Each party multiplies its shares of x and r locally
+ *   3. Open c = x × r for the whole batch in one round
+ *   4. Invert every c at once with gf256_inv_batch()
+ *   5. Each party scales its share of r by the public c⁻¹:
+ *      r × (x r)⁻¹ = x⁻¹
+ *
+ * c is uniform over the nonzero bytes, so it reveals nothing about a
+ * nonzero x. A zero byte of x opens as zero: which bytes are zero is
+ * revealed, and their result is 0, as with gf256_inv().
+ * Like mpc_secure_mul(), opening x × r needs
+ * num_shares >= 2 × threshold - 1.
+ *
+ * Example: divide each share set by a shared total
+ *   mpc_secure_inv(&ctx, total, inverse, 5);
+ *   mpc_secure_mul(&ctx, part, inverse, fraction, 5);
+ *
+ * @param ctx         MPC context
+ * @param shares_x    Array of count share sets of X
+ * @param shares_inv  Array of count output share sets (num_parties each,
+ *                    may be the input sets)
+ * @param count       Number of values in the batch
+ * @param num_shares  Number of shares provided per value
+ * @return 0 on success, -1 on failure
+ */
+int mpc_secure_inv_batch(const mpc_context_t *ctx,
+                         const mpc_share_t *const *shares_x,
+                         mpc_share_t *const *shares_inv,
+                         size_t count,
+                         uint8_t num_shares);
+
+/**
+ * Securely invert one shared secret: shares of X⁻¹
+ * (a batch of one, see mpc_secure_inv_batch)
+ */
+int mpc_secure_inv(const mpc_context_t *ctx,
+                   const mpc_share_t *shares_x,
+                   mpc_share_t *shares_inv,
+                   uint8_t num_shares);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,98 @@
+#ifndef SSS_MPC_NET_H
+#define SSS_MPC_NET_H
+
+#include "sss/mpc.h"
+#include "sss/transport.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Networked MPC Protocols
+ *
+ * The functions in mpc.h hold every party's share in one array. The
+ * functions below are run by each party on its own, holding only its own
+ * share and exchanging messages with the other parties through an
+ * mpc_transport_t. The same code runs over in-process queues, socketpairs
+ * between forked processes, or TCP.
+ *
+ * Local operations need no messages: a party applies mpc_secure_add(),
+ * mpc_secure_sub() or mpc_secure_mul_const() to its own share with
+ * num_shares = 1.
+ *
+ * Every party must use a context with the same parameters and the same
+ * session_id (see mpc_context_set_session()), and call the same
+ * functions in the same order.
+ *
+ * Each value travels as its own message, and every function below ends
+ * with one mpc_transport_flush(), i.e. costs one round. Running them on
+ * a batch link channel (transport_batch.h) coalesces a round into one
+ * frame per peer.
+ * ======================================================================== */
+
+/**
+ * Distribute secrets from a dealer to all parties (1 round).
+ *
+ * @param ctx        MPC context
+ * @param transport  This party's endpoint
+ * @param dealer     Party id that holds the secrets
+ * @param secrets    count × value_size bytes (dealer only, else NULL)
+ * @param shares     Output: this party's share of each secret (count)
+ * @param count      Number of secrets
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   // Party 1 inputs its salary; every party gets its share
+ *   mpc_net_share_input(&ctx, net, 1, (me == 1) ? &salary : NULL, &s, 1);
+ */
+int mpc_net_share_input(const mpc_context_t *ctx, mpc_transport_t *transport,
+                        uint8_t dealer, const uint8_t *secrets,
+                        mpc_share_t *shares, size_t count);
+
+/**
+ * Reveal shared values to every party (1 round).
+ *
+ * Each party broadcasts its shares and reconstructs from all of them.
+ *
+ * @param ctx        MPC context
+ * @param transport  This party's endpoint
+ * @param shares     This party's shares (count)
+ * @param values     Output: count × value_size revealed bytes
+ * @param count      Number of values
+ * @return 0 on success, -1 on failure
+ */
+int mpc_net_open(const mpc_context_t *ctx, mpc_transport_t *transport,
+                 const mpc_share_t *shares, uint8_t *values, size_t count);
+
+/**
+ * Multiply shared values pairwise (1 round).
+ *
+ * Degree reduction by resharing: each party multiplies its shares
+ * locally, reshares the degree-2(t-1) product, and combines the
+ * sub-shares it receives with the Lagrange coefficients for x = 0.
+ * No party ever sees the product. Requires num_parties >= 2t - 1.
+ *
+ * @param ctx        MPC context
+ * @param transport  This party's endpoint
+ * @param shares_x   This party's shares of the first operands (count)
+ * @param shares_y   This party's shares of the second operands (count)
+ * @param shares_prod Output: shares of the products (may alias inputs)
+ * @param count      Number of multiplications
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   mpc_net_mul(&ctx, net, &a, &b, &ab, 1);
+ *   mpc_net_open(&ctx, net, &ab, &product, 1);
+ */
+int mpc_net_mul(const mpc_context_t *ctx, mpc_transport_t *transport,
+                const mpc_share_t *shares_x, const mpc_share_t *shares_y,
+                mpc_share_t *shares_prod, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_MPC_NET_H */
@@ -0,0 +1,305 @@
+#ifndef SSS_RUNTIME_H
+#define SSS_RUNTIME_H
+
+#include "sss/mpc.h"
+#include "sss/transport.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Asynchronous Party Runtime
+ *
+ * The mpc_net_* protocols block the calling thread until each round
+ * completes, so a party serving many small computations either runs
+ * them one after another or needs a thread per computation.
+ *
+ * The runtime instead drives any number of computations ("jobs") from
+ * one thread with an epoll event loop over non-blocking sockets:
+ *
+ * - A job is a resumable state machine: a step function that sends its
+ *   messages, returns MPC_JOB_PENDING while it waits for replies, and is
+ *   called again once a message for it arrives.
+ * - Each scheduling pass runs every job that became runnable. Their
+ *   messages are packed into one frame per peer, written without
+ *   blocking when the pass ends, so the rounds of all jobs in flight
+ *   share frames and system calls.
+ * - Each job is one session: messages are routed to jobs by session id
+ *   through a session table (session.h). A message for a job that has
+ *   not been submitted yet is kept until it is.
+ *
+ * The mpc_async_* functions below are the networked protocols of
+ * mpc_net.h written as such state machines.
+ *
+ * On the wire, a frame is the same as a batch link frame carried by a
+ * socket endpoint (transport_batch.h), the job's session id naming the
+ * channel.
+ *
+ * A runtime and its jobs must be used from a single thread.
+ * Available on Linux only.
+ * ======================================================================== */
+
+/* Result of a job step or an asynchronous protocol call */
+typedef enum {
+    MPC_JOB_FAILED = -1,    // Job failed; it is dropped
+    MPC_JOB_DONE = 0,       // Job (or protocol call) finished
+    MPC_JOB_PENDING = 1     // Waiting for messages; call again later
+} mpc_job_status_t;
+
+/* Opaque runtime and job handles */
+typedef struct mpc_runtime mpc_runtime_t;
+typedef struct mpc_job mpc_job_t;
+
+/**
+ * Job step function.
+ *
+ * Called once when the job is submitted, then each time messages for the
+ * job arrive, until it returns MPC_JOB_DONE or MPC_JOB_FAILED.
+ *
+ * @param job  The job being run
+ * @param arg  User argument passed to mpc_runtime_submit()
+ * @return Job status
+ */
+typedef mpc_job_status_t (*mpc_job_step_fn)(mpc_job_t *job, void *arg);
+
+/* Runtime counters */
+typedef struct {
+    uint64_t frames_sent;
+    uint64_t frames_received;
+    uint64_t bytes_sent;        // Wire bytes, including framing
+    uint64_t bytes_received;
+    uint64_t messages_sent;     // Job messages (records) sent to peers
+    uint64_t messages_received;
+    uint64_t passes;            // Scheduling passes that ran a job
+    uint64_t jobs_completed;
+    uint64_t jobs_failed;
+    uint64_t max_live_jobs;     // Most jobs submitted and not yet finished
+} mpc_runtime_stats_t;
+
+/* ========================================================================
+ * Runtime
+ * ======================================================================== */
+
+/**
+ * Create a runtime over a socket endpoint.
+ *
+ * The endpoint is borrowed: its sockets are switched to non-blocking
+ * mode until the runtime is destroyed, and the endpoint must not be used
+ * directly in between.
+ *
+ * @param endpoint  Endpoint from mpc_transport_socketpair_create(),
+ *                  mpc_transport_tcp_create(), mpc_transport_tcp_connect()
+ *                  or mpc_transport_socket_wrap()
+ * @return New runtime, or NULL on failure
+ *
+ * Example:
+ *   mpc_runtime_t *rt = mpc_runtime_create(net);
+ *   for (uint64_t k = 0; k < 1000; k++) {
+ *       mpc_session_id_derive(&batch_id, k, &jobs[k].session);
+ *       mpc_runtime_submit(rt, &jobs[k].session, my_step, &jobs[k]);
+ *   }
+ *   mpc_runtime_run(rt, -1);
+ *   mpc_runtime_destroy(rt);
+ */
+mpc_runtime_t *mpc_runtime_create(mpc_transport_t *endpoint);
+
+/**
+ * Destroy a runtime, dropping any unfinished jobs and restoring the
+ * endpoint's sockets to blocking mode.
+ *
+ * @param runtime  Runtime to destroy (may be NULL)
+ */
+void mpc_runtime_destroy(mpc_runtime_t *runtime);
+
+/**
+ * Add a job. It first runs on the next scheduling pass.
+ *
+ * Every party must submit the matching job under the same session id.
+ *
+ * @param runtime  Runtime
+ * @param session  Session id of the job (unique among unfinished jobs)
+ * @param step     Step function
+ * @param arg      User argument passed to step
+ * @return 0 on success, -1 on failure (including id in use)
+ */
+int mpc_runtime_submit(mpc_runtime_t *runtime, const mpc_session_id_t *session,
+                       mpc_job_step_fn step, void *arg);
+
+/**
+ * Run the event loop until every submitted job has finished and every
+ * frame has been written.
+ *
+ * A failed job does not notify the other parties, so their matching
+ * jobs wait for messages that never come; use a timeout to bound this.
+ *
+ * @param runtime     Runtime
+ * @param timeout_ms  Longest wait without any socket activity
+ *                    (-1 = no limit)
+ * @return 0 if every job completed, -1 if a job failed, a socket failed
+ *         or the timeout expired
+ */
+int mpc_runtime_run(mpc_runtime_t *runtime, int timeout_ms);
+
+/**
+ * Number of submitted jobs that have not finished.
+ */
+size_t mpc_runtime_live_jobs(const mpc_runtime_t *runtime);
+
+/**
+ * Drop messages held for sessions that have not been submitted and saw
+ * no traffic in the last idle_passes scheduling passes (for example,
+ * late messages for a job that already failed here).
+ *
+ * @param runtime      Runtime
+ * @param idle_passes  Passes a held session is kept
+ * @return Number of sessions dropped
+ */
+size_t mpc_runtime_expire(mpc_runtime_t *runtime, uint64_t idle_passes);
+
+/**
+ * Copy the runtime's counters.
+ */
+void mpc_runtime_get_stats(const mpc_runtime_t *runtime,
+                           mpc_runtime_stats_t *stats);
+
+/**
+ * Reset the runtime's counters to zero.
+ */
+void mpc_runtime_reset_stats(mpc_runtime_t *runtime);
+
+/* ========================================================================
+ * Job Messaging (for step functions)
+ * ======================================================================== */
+
+/**
+ * Session id the job was submitted under.
+ */
+const mpc_session_id_t *mpc_job_session(const mpc_job_t *job);
+
+/**
+ * This party's id and the number of parties.
+ */
+uint8_t mpc_job_party_id(const mpc_job_t *job);
+uint8_t mpc_job_num_parties(const mpc_job_t *job);
+
+/**
+ * Send a message to the matching job of another party.
+ *
+ * The data is copied into the peer's next frame, which is written at the
+ * end of the current scheduling pass. Sending to this party itself
+ * queues the message for the job directly.
+ *
+ * @param job   Sending job
+ * @param to    Receiving party id (1 to num_parties)
+ * @param data  Message payload
+ * @param len   Payload length (may be 0, at most 64 KiB - 20)
+ * @return 0 on success, -1 on failure
+ */
+int mpc_job_send(mpc_job_t *job, uint8_t to, const void *data, size_t len);
+
+/**
+ * Number of messages from a party waiting to be received by the job.
+ */
+size_t mpc_job_pending(const mpc_job_t *job, uint8_t from);
+
+/**
+ * Take the next message from a party, without blocking.
+ *
+ * @param job       Receiving job
+ * @param from      Sending party id (1 to num_parties)
+ * @param buffer    Output buffer
+ * @param capacity  Size of buffer
+ * @param len       Output: payload length
+ * @return 0 on success, -1 if no message is waiting or it does not fit
+ */
+int mpc_job_recv(mpc_job_t *job, uint8_t from, void *buffer,
+                 size_t capacity, size_t *len);
+
+/* ========================================================================
+ * Asynchronous Protocols
+ *
+ * Resumable versions of mpc_net_share_input(), mpc_net_open() and
+ * mpc_net_mul(). Each call either finishes (MPC_JOB_DONE), fails, or
+ * returns MPC_JOB_PENDING; the step function then returns
+ * MPC_JOB_PENDING itself and makes the same call, with the same
+ * arguments, when it is resumed.
+ *
+ * The progress of a call is kept in an mpc_async_op_t, which must start
+ * zeroed and is reset on MPC_JOB_DONE so it can serve the next call.
+ *
+ * Example step function (product of two inputs, then revealed):
+ *   switch (st->stage) {
+ *   case 0:
+ *       s = mpc_async_share_input(job, &st->op, &ctx, 1, st->a, &st->x, 1);
+ *       if (s != MPC_JOB_DONE) return s;
+ *       st->stage = 1;
+ *       // fall through
+ *   case 1:
+ *       ...
+ *   }
+ * ======================================================================== */
+
+/* Progress of an asynchronous protocol call */
+typedef struct {
+    int phase;
+} mpc_async_op_t;
+
+/**
+ * Distribute secrets from a dealer to all parties (1 round).
+ *
+ * @param job      Running job
+ * @param op       Call progress
+ * @param ctx      MPC context
+ * @param dealer   Party id that holds the secrets
+ * @param secrets  count × value_size bytes (dealer only, else NULL)
+ * @param shares   Output: this party's share of each secret (count)
+ * @param count    Number of secrets
+ * @return Call status
+ */
+mpc_job_status_t mpc_async_share_input(mpc_job_t *job, mpc_async_op_t *op,
+                                       const mpc_context_t *ctx,
+                                       uint8_t dealer, const uint8_t *secrets,
+                                       mpc_share_t *shares, size_t count);
+
+/**
+ * Reveal shared values to every party (1 round).
+ *
+ * @param job     Running job
+ * @param op      Call progress
+ * @param ctx     MPC context
+ * @param shares  This party's shares (count)
+ * @param values  Output: count × value_size revealed bytes
+ * @param count   Number of values
+ * @return Call status
+ */
+mpc_job_status_t mpc_async_open(mpc_job_t *job, mpc_async_op_t *op,
+                                const mpc_context_t *ctx,
+                                const mpc_share_t *shares, uint8_t *values,
+                                size_t count);
+
+/**
+ * Multiply shared values pairwise (1 round, requires num_parties >= 2t - 1).
+ *
+ * @param job          Running job
+ * @param op           Call progress
+ * @param ctx          MPC context
+ * @param shares_x     This party's shares of the first operands (count)
+ * @param shares_y     This party's shares of the second operands (count)
+ * @param shares_prod  Output: shares of the products (may alias inputs)
+ * @param count        Number of multiplications
+ * @return Call status
+ */
+mpc_job_status_t mpc_async_mul(mpc_job_t *job, mpc_async_op_t *op,
+                               const mpc_context_t *ctx,
+                               const mpc_share_t *shares_x,
+                               const mpc_share_t *shares_y,
+                               mpc_share_t *shares_prod, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_RUNTIME_H */
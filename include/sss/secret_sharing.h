@@ -81,6 +81,31 @@ void sss_wipe_share(sss_share_t *share);
 
 void sss_wipe_memory(void *data, size_t len);
 
+/* ========================================================================
+ * Differential Checking
+ * ======================================================================== */
+
+/**
+ * Set how often the kernels are checked against their references
+ *
+ * In a library built with -DSSS_DIFFERENTIAL_CHECK=ON, the GF(256),
+ * polynomial and sharing kernels recompute a sample of their results
+ * with independent reference implementations, and abort with a
+ * diagnostic on stderr if the two disagree. Secret values are never
+ * printed.
+ *
+ * @param every Check 1 call in every (1 = all calls, 0 = none). Until
+ *              this is called, the SSS_CHECK_EVERY environment variable
+ *              sets it, and it defaults to 1.
+ *
+ * @return 0 on success, -1 if the library was built without the checks
+ *
+ * Unchecked calls cost a thread-local decrement, so an interval of a
+ * few thousand stays within a few percent and can be left on in canary
+ * deployments of new kernels.
+ */
+int sss_set_check_interval(uint32_t every);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,153 @@
+#ifndef SSS_SESSION_H
+#define SSS_SESSION_H
+
+#include "sss/mpc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Session Table
+ *
+ * Maps session identifiers to the per-session state of one party, for
+ * code that multiplexes many live computations over one connection
+ * (batch links, the party runtime). Lookups, insertions and removals
+ * take O(1) expected time: the table is open-addressed with linear
+ * probing, kept at most half full, and uses backward-shift deletion, so
+ * it never fills up with tombstones however many sessions come and go.
+ *
+ * Lifecycle:
+ * - A session is PENDING while this party knows it only from messages
+ *   that other parties sent for it, and ACTIVE once this party has
+ *   opened it.
+ * - The owner records activity in last_active (with any clock, e.g.
+ *   seconds or event-loop passes) and removes the session when the
+ *   computation ends.
+ * - mpc_session_table_expire() drops sessions idle since before a given
+ *   time, such as messages for sessions this party will never open.
+ *
+ * Session entries stay at the same address until they are removed.
+ * A table must be used from a single thread.
+ * ======================================================================== */
+
+/* Session lifecycle states */
+typedef enum {
+    MPC_SESSION_PENDING = 0,    // Known only from messages received for it
+    MPC_SESSION_ACTIVE = 1      // Opened by this party
+} mpc_session_state_t;
+
+/* Table entry; id is fixed, the other fields belong to the owner */
+typedef struct {
+    mpc_session_id_t id;
+    mpc_session_state_t state;
+    uint64_t last_active;       // Owner's clock at the last activity
+    void *data;                 // Owner's per-session state
+} mpc_session_t;
+
+/* Table counters */
+typedef struct {
+    size_t live;                // Sessions in the table
+    size_t pending;             // Live sessions in the PENDING state
+    size_t max_live;            // Most sessions in the table at once
+    uint64_t added;
+    uint64_t removed;           // Including expired sessions
+    uint64_t expired;
+} mpc_session_table_stats_t;
+
+/* Opaque session table */
+typedef struct mpc_session_table mpc_session_table_t;
+
+/**
+ * Called for each session dropped by mpc_session_table_expire() or
+ * mpc_session_table_destroy(), just before it is freed.
+ *
+ * @param session  Session being dropped
+ * @param arg      User argument
+ */
+typedef void (*mpc_session_release_fn)(mpc_session_t *session, void *arg);
+
+/**
+ * Create an empty session table.
+ *
+ * @return New table, or NULL on failure
+ *
+ * Example:
+ *   mpc_session_table_t *sessions = mpc_session_table_create();
+ *   mpc_session_t *s = mpc_session_add(sessions, &ctx.session_id,
+ *                                      MPC_SESSION_ACTIVE, my_state);
+ *   // ... route messages with mpc_session_find() ...
+ *   mpc_session_remove(sessions, s);
+ */
+mpc_session_table_t *mpc_session_table_create(void);
+
+/**
+ * Free a table and every session still in it.
+ *
+ * @param table    Table to destroy (may be NULL)
+ * @param release  Called for each remaining session (may be NULL)
+ * @param arg      User argument passed to release
+ */
+void mpc_session_table_destroy(mpc_session_table_t *table,
+                               mpc_session_release_fn release, void *arg);
+
+/**
+ * Look up a session.
+ *
+ * @return The session, or NULL if there is none with this id
+ */
+mpc_session_t *mpc_session_find(const mpc_session_table_t *table,
+                                const mpc_session_id_t *id);
+
+/**
+ * Add a session.
+ *
+ * @param table  Session table
+ * @param id     Session identifier
+ * @param state  Initial state
+ * @param data   Owner's per-session state
+ * @return The new session (last_active 0), or NULL on failure
+ *         (including an id already in the table)
+ */
+mpc_session_t *mpc_session_add(mpc_session_table_t *table,
+                               const mpc_session_id_t *id,
+                               mpc_session_state_t state, void *data);
+
+/**
+ * Move a session to another state.
+ */
+void mpc_session_set_state(mpc_session_table_t *table, mpc_session_t *session,
+                           mpc_session_state_t state);
+
+/**
+ * Remove and free a session (its data is left to the owner).
+ */
+void mpc_session_remove(mpc_session_table_t *table, mpc_session_t *session);
+
+/**
+ * Drop every session in a state that has been idle since before a time.
+ *
+ * @param table    Session table
+ * @param state    State of the sessions to consider
+ * @param before   Sessions with last_active < before are dropped
+ * @param release  Called for each dropped session (may be NULL)
+ * @param arg      User argument passed to release
+ * @return Number of sessions dropped
+ */
+size_t mpc_session_table_expire(mpc_session_table_t *table,
+                                mpc_session_state_t state, uint64_t before,
+                                mpc_session_release_fn release, void *arg);
+
+/**
+ * Copy the table's counters.
+ */
+void mpc_session_table_get_stats(const mpc_session_table_t *table,
+                                 mpc_session_table_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_SESSION_H */
@@ -0,0 +1,65 @@
+#ifndef SSS_TRACE_H
+#define SSS_TRACE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Protocol Tracing
+ *
+ * A library configured with -DSSS_TRACE=ON records a span for each
+ * public MPC operation and for the phases inside it: validation, local
+ * computation, reconstruction, resharing and wiping. A span carries its
+ * name, the session id, the party (0 for operations that work on the
+ * shares of all parties at once) and the bytes of share data involved.
+ *
+ * Every thread writes its spans to a ring buffer of its own, without
+ * locks; the oldest events are overwritten once a ring is full. The rings
+ * can be dumped in the Chrome trace event format and opened in
+ * chrome://tracing or Perfetto, one process row per party and one thread
+ * row per thread.
+ *
+ * Without the option the hooks compile to nothing and the functions
+ * below do nothing.
+ * ======================================================================== */
+
+/* Events kept per thread */
+#define MPC_TRACE_RING_SIZE 16384
+
+/**
+ * Whether the library was built with tracing
+ *
+ * @return 1 if spans are recorded, 0 otherwise
+ */
+int mpc_trace_enabled(void);
+
+/**
+ * Write the recorded spans of all threads as a Chrome trace
+ *
+ * @param path File to write (JSON)
+ * @return 0 on success, -1 if tracing is not built in or the file cannot
+ *         be written
+ *
+ * Meant to be called once the traced computation has finished: events a
+ * thread writes while its ring is being dumped may come out garbled.
+ */
+int mpc_trace_dump(const char *path);
+
+/**
+ * Forget the spans recorded so far (the rings stay allocated)
+ */
+void mpc_trace_clear(void);
+
+/**
+ * Number of events lost to full rings since the last clear
+ */
+size_t mpc_trace_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_TRACE_H */
@@ -0,0 +1,315 @@
+#ifndef SSS_TRANSPORT_H
+#define SSS_TRANSPORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Party Transport
+ *
+ * A transport is one party's endpoint of a fully connected network of
+ * num_parties parties. Party ids are 1-based, matching mpc_share_t.
+ *
+ * Messages are delivered reliably and in order between every pair of
+ * parties. recv() blocks until the next message from the given peer
+ * arrives. flush() marks the end of a communication round: backends may
+ * buffer sends until then, and the number of flushes that carried at
+ * least one message is reported as the round count.
+ *
+ * A backend may keep referring to the data passed to send() until the
+ * next flush() (the batching layer and the socket backends send straight
+ * from it), so callers must leave it unchanged until then.
+ *
+ * A round may be larger than the kernel buffers between two parties.
+ * The socket backends queue sends and write them on flush(), reading
+ * from every peer while they wait to write, so parties that all send a
+ * round before receiving it keep draining each other. The data read
+ * early is held by the endpoint until recv() asks for it.
+ *
+ * An endpoint is owned by a single party thread; different endpoints
+ * of the same group may be used concurrently.
+ *
+ * Backends:
+ * - Memory:     in-process queues, for single-process tests
+ * - SPSC:       lock-free rings, for threads-as-parties load tests
+ * - Socketpair: AF_UNIX stream sockets, for forked party processes
+ * - TCP:        loopback or remote TCP connections
+ * ======================================================================== */
+
+/* Largest message accepted by the socket backends */
+#define MPC_TRANSPORT_MAX_MESSAGE (16u * 1024u * 1024u)
+
+/* Default ring size of the SPSC backend, per directed party pair */
+#define MPC_TRANSPORT_SPSC_DEFAULT_RING (64u * 1024u)
+
+/* One part of a message sent with mpc_transport_sendv() */
+typedef struct {
+    const void *base;
+    size_t len;
+} mpc_transport_iov_t;
+
+/* Traffic counters, maintained by the generic layer for every backend */
+typedef struct {
+    uint64_t bytes_sent;        // Payload bytes sent
+    uint64_t bytes_received;    // Payload bytes received
+    uint64_t messages_sent;
+    uint64_t messages_received;
+    uint64_t rounds;            // Flushes with at least one message sent
+} mpc_transport_stats_t;
+
+typedef struct mpc_transport mpc_transport_t;
+
+/**
+ * Backend operations.
+ *
+ * send, recv and destroy are required. sendv may be NULL, in which case
+ * the parts are gathered into one buffer and passed to send().
+ * broadcast may be NULL, in which case it is implemented with send().
+ * flush may be NULL for backends that never buffer.
+ */
+typedef struct {
+    const char *name;
+    int (*send)(mpc_transport_t *transport, uint8_t to,
+                const void *data, size_t len);
+    int (*sendv)(mpc_transport_t *transport, uint8_t to,
+                 const mpc_transport_iov_t *parts, size_t num_parts,
+                 size_t total_len);
+    int (*recv)(mpc_transport_t *transport, uint8_t from,
+                void *buffer, size_t capacity, size_t *len);
+    int (*broadcast)(mpc_transport_t *transport, const void *data, size_t len);
+    int (*flush)(mpc_transport_t *transport);
+    void (*destroy)(mpc_transport_t *transport);
+} mpc_transport_ops_t;
+
+struct mpc_transport {
+    const mpc_transport_ops_t *ops;
+    uint8_t party_id;               // This endpoint's party (1 to num_parties)
+    uint8_t num_parties;
+    int round_pending;              // Messages sent since the last flush
+    mpc_transport_stats_t stats;
+    void *impl;                     // Backend state
+};
+
+/* ========================================================================
+ * Generic Operations
+ * ======================================================================== */
+
+/**
+ * Send a message to another party.
+ *
+ * @param transport  Sending endpoint
+ * @param to         Receiving party id (1 to num_parties, not self)
+ * @param data       Message payload
+ * @param len        Payload length (may be 0)
+ * @return 0 on success, -1 on failure
+ */
+int mpc_transport_send(mpc_transport_t *transport, uint8_t to,
+                       const void *data, size_t len);
+
+/**
+ * Send one message made of several buffers, without joining them first.
+ *
+ * The receiver gets a single message holding the concatenation of the
+ * parts. Socket backends keep references to the parts and pass them
+ * straight to sendmsg() on flush; only a 4-byte frame header is copied.
+ *
+ * @param transport  Sending endpoint
+ * @param to         Receiving party id (1 to num_parties, not self)
+ * @param parts      Message parts, in order
+ * @param num_parts  Number of parts
+ * @return 0 on success, -1 on failure
+ */
+int mpc_transport_sendv(mpc_transport_t *transport, uint8_t to,
+                        const mpc_transport_iov_t *parts, size_t num_parts);
+
+/**
+ * Receive the next message from another party, blocking until it arrives.
+ *
+ * A message longer than capacity is discarded and reported as an error.
+ *
+ * @param transport  Receiving endpoint
+ * @param from       Sending party id (1 to num_parties, not self)
+ * @param buffer     Output buffer
+ * @param capacity   Size of buffer
+ * @param len        Output: payload length
+ * @return 0 on success, -1 on failure
+ */
+int mpc_transport_recv(mpc_transport_t *transport, uint8_t from,
+                       void *buffer, size_t capacity, size_t *len);
+
+/**
+ * Send the same message to every other party.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int mpc_transport_broadcast(mpc_transport_t *transport,
+                            const void *data, size_t len);
+
+/**
+ * End the current round, pushing out any buffered messages.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int mpc_transport_flush(mpc_transport_t *transport);
+
+/**
+ * Close an endpoint and free its resources (transport may be NULL).
+ */
+void mpc_transport_destroy(mpc_transport_t *transport);
+
+/**
+ * Copy the endpoint's traffic counters.
+ */
+void mpc_transport_get_stats(const mpc_transport_t *transport,
+                             mpc_transport_stats_t *stats);
+
+/**
+ * Reset the endpoint's traffic counters to zero.
+ */
+void mpc_transport_reset_stats(mpc_transport_t *transport);
+
+/**
+ * Allocate an endpoint for a backend (for use by backend implementations).
+ *
+ * @return New endpoint with zeroed stats, or NULL on failure
+ */
+mpc_transport_t *mpc_transport_alloc(const mpc_transport_ops_t *ops,
+                                     uint8_t party_id, uint8_t num_parties,
+                                     void *impl);
+
+/* ========================================================================
+ * Backends
+ *
+ * The group constructors create all num_parties endpoints at once and
+ * store the endpoint of party i at endpoints[i - 1]. Each endpoint must
+ * be destroyed separately.
+ * ======================================================================== */
+
+/**
+ * Create a group of endpoints connected by in-process message queues.
+ *
+ * @param num_parties  Number of parties (2-255)
+ * @param endpoints    Output array of num_parties endpoints
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   mpc_transport_t *net[5];
+ *   mpc_transport_memory_create(5, net);
+ *   // Run party i on its own thread with net[i - 1]
+ */
+int mpc_transport_memory_create(uint8_t num_parties,
+                                mpc_transport_t **endpoints);
+
+/**
+ * Create a group of endpoints connected by lock-free ring buffers.
+ *
+ * Every directed party pair gets its own single-producer/single-consumer
+ * ring, with the producer and consumer indices on separate cache lines.
+ * No lock is taken on send or recv. Sends are written into the ring but
+ * only published by mpc_transport_flush(), with one release store per
+ * peer per round (or early, when the ring fills up).
+ *
+ * A round may be larger than the rings: a party waiting for room
+ * publishes all its rings and moves what its peers have published to it
+ * into a per-peer backlog, which recv() serves first. The backlog grows
+ * to at most one round of a peer's messages and is freed on destroy.
+ *
+ * Meant for running each party as a thread; combine with
+ * sss_pin_thread() to keep each party on its own core.
+ *
+ * @param num_parties  Number of parties (2-255)
+ * @param ring_bytes   Ring size per pair, rounded up to a power of two
+ *                     (0 = MPC_TRANSPORT_SPSC_DEFAULT_RING). A message
+ *                     plus its 4-byte header must fit in the ring.
+ * @param endpoints    Output array of num_parties endpoints
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   mpc_transport_t *net[5];
+ *   mpc_transport_spsc_create(5, 0, net);
+ *   // On the thread of party i:
+ *   sss_pin_thread(i - 1);
+ *   mpc_net_mul(&ctx, net[i - 1], &a, &b, &ab, 1);
+ */
+int mpc_transport_spsc_create(uint8_t num_parties, size_t ring_bytes,
+                              mpc_transport_t **endpoints);
+
+/**
+ * Create a group of endpoints connected by AF_UNIX socketpairs.
+ *
+ * Endpoints survive fork(): a forked party keeps its own endpoint and
+ * destroys the others to close its copies of their sockets.
+ *
+ * @param num_parties  Number of parties (2-255)
+ * @param endpoints    Output array of num_parties endpoints
+ * @return 0 on success, -1 on failure
+ */
+int mpc_transport_socketpair_create(uint8_t num_parties,
+                                    mpc_transport_t **endpoints);
+
+/**
+ * Create a group of endpoints connected over TCP loopback (127.0.0.1).
+ *
+ * @param num_parties  Number of parties (2-255)
+ * @param endpoints    Output array of num_parties endpoints
+ * @return 0 on success, -1 on failure
+ */
+int mpc_transport_tcp_create(uint8_t num_parties, mpc_transport_t **endpoints);
+
+/**
+ * Join a TCP group as a single party (one process per party).
+ *
+ * Party p listens on base_port + p - 1, connects to every lower party
+ * and accepts a connection from every higher party. Connections are
+ * retried until timeout_ms has elapsed, so parties may start in any
+ * order.
+ *
+ * @param party_id     This party (1 to num_parties)
+ * @param num_parties  Number of parties (2-255)
+ * @param host         IPv4 address of all parties (e.g. "127.0.0.1")
+ * @param base_port    Port of party 1
+ * @param timeout_ms   Time allowed for the whole group to connect
+ * @param endpoint     Output: connected endpoint
+ * @return 0 on success, -1 on failure
+ */
+int mpc_transport_tcp_connect(uint8_t party_id, uint8_t num_parties,
+                              const char *host, uint16_t base_port,
+                              int timeout_ms, mpc_transport_t **endpoint);
+
+/**
+ * Wrap already connected stream sockets as an endpoint.
+ *
+ * Takes ownership of the sockets; they are closed by destroy().
+ *
+ * @param party_id     This party (1 to num_parties)
+ * @param num_parties  Number of parties (2-255)
+ * @param fds          Socket to party i at fds[i - 1] (-1 for self)
+ * @return New endpoint, or NULL on failure
+ */
+mpc_transport_t *mpc_transport_socket_wrap(uint8_t party_id,
+                                           uint8_t num_parties,
+                                           const int *fds);
+
+/**
+ * Socket connected to a peer, for callers that drive the sockets of an
+ * endpoint themselves (such as the party runtime in runtime.h).
+ *
+ * Only available between rounds: bytes the endpoint has queued for the
+ * peer or already read from it would be lost to such a caller.
+ *
+ * @param transport  Endpoint created by one of the socket backends
+ * @param peer       Party id (1 to num_parties)
+ * @return The socket, or -1 for self, an endpoint of another backend,
+ *         or an endpoint holding unflushed or unreceived data for peer
+ */
+int mpc_transport_socket_fd(const mpc_transport_t *transport, uint8_t peer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_TRANSPORT_H */
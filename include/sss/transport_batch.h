@@ -0,0 +1,97 @@
+#ifndef SSS_TRANSPORT_BATCH_H
+#define SSS_TRANSPORT_BATCH_H
+
+#include "sss/transport.h"
+#include "sss/mpc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Message Batching and Pipelining
+ *
+ * A batch link sits on top of one party endpoint and multiplexes any
+ * number of channels over it. Each channel is itself an mpc_transport_t,
+ * so the mpc_net_* protocols run on a channel unchanged. A channel is
+ * named by the session id of the computation it carries, and channels
+ * are kept in a session table (session.h).
+ *
+ * Batching: sends on a channel are not copied. The link records a
+ * reference to the caller's buffer, and on flush sends one frame per
+ * peer holding every pending message of every channel, gathered with
+ * mpc_transport_sendv() (sendmsg() on the socket backends). A round of
+ * count small messages to a peer thus costs one frame, not count.
+ *
+ * Pipelining: frames interleave messages of different channels, so the
+ * rounds of independent computations share frames and connections
+ * instead of waiting for one another. Messages that arrive for another
+ * channel are queued for it.
+ *
+ * Frame layout: a sequence of records, each a 20-byte header (16-byte
+ * session id, 4-byte little-endian payload length) followed by the
+ * payload.
+ *
+ * A link and its channels must be used from a single thread.
+ * ======================================================================== */
+
+/* Largest frame sent by a link; bigger rounds are split across frames */
+#define MPC_BATCH_MAX_FRAME (64u * 1024u)
+
+/* Opaque batch link */
+typedef struct mpc_batch_link mpc_batch_link_t;
+
+/**
+ * Create a batch link over an endpoint.
+ *
+ * The endpoint is borrowed: it must outlive the link and should not be
+ * used directly while the link exists. Its counters show the actual
+ * frames on the wire.
+ *
+ * @param inner  Endpoint to multiplex
+ * @return New link, or NULL on failure
+ *
+ * Example:
+ *   mpc_batch_link_t *link = mpc_batch_link_create(net);
+ *   mpc_transport_t *job_a = mpc_batch_channel_open(link, &ctx_a.session_id);
+ *   mpc_transport_t *job_b = mpc_batch_channel_open(link, &ctx_b.session_id);
+ *   mpc_net_open(&ctx_a, job_a, shares_a, values_a, 100);  // 1 frame per peer
+ */
+mpc_batch_link_t *mpc_batch_link_create(mpc_transport_t *inner);
+
+/**
+ * Destroy a link. Every channel must have been destroyed first.
+ */
+void mpc_batch_link_destroy(mpc_batch_link_t *link);
+
+/**
+ * Open a channel on a link.
+ *
+ * All parties must use the same session id for the same computation.
+ * Messages that arrived for the channel before it was opened are kept.
+ * Close the channel with mpc_transport_destroy().
+ *
+ * @param link     Batch link
+ * @param session  Session id of the computation (unique per open channel)
+ * @return Channel endpoint, or NULL on failure (including already open)
+ */
+mpc_transport_t *mpc_batch_channel_open(mpc_batch_link_t *link,
+                                        const mpc_session_id_t *session);
+
+/**
+ * Send every pending message of every channel (one frame per peer).
+ *
+ * Flushing any channel does the same; this is for callers that queue
+ * sends on several channels and want to close the round once.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int mpc_batch_link_flush(mpc_batch_link_t *link);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_TRANSPORT_BATCH_H */
@@ -0,0 +1,128 @@
+#ifndef SSS_TRANSPORT_SIM_H
+#define SSS_TRANSPORT_SIM_H
+
+#include "sss/transport.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Simulated Network
+ *
+ * A transport backend for estimating how a protocol behaves on a slower
+ * network (say, a 40 ms WAN) without leaving the machine. Messages are
+ * delivered at local speed through in-process queues, while each party
+ * keeps a simulated clock that advances as the modelled network would:
+ *
+ * - Every message waits for its directed link to be free, takes
+ *   (len + overhead) / bandwidth to transmit, then arrives latency plus
+ *   a random jitter later. Messages on a link arrive in order.
+ * - A receive moves the receiver's clock up to the arrival time of the
+ *   message, so waiting for a round costs what it would on the network.
+ * - Optionally, the CPU time a party spends between transport calls is
+ *   added to its clock, so local computation is accounted for too.
+ *
+ * Runs are therefore as fast as the memory backend, and with a fixed
+ * seed they give the same simulated times every time.
+ *
+ * Protocol steps are marked with mpc_sim_step_begin() on each party.
+ * For every step, the rounds, messages, bytes and simulated time are
+ * recorded and read back with mpc_sim_get_steps().
+ * ======================================================================== */
+
+/* Longest step name kept, including the terminating NUL */
+#define MPC_SIM_STEP_NAME_SIZE 32
+
+/* Model of one directed link */
+typedef struct {
+    double latency_ms;          // One-way propagation delay
+    double jitter_ms;           // Extra delay, uniform in [0, jitter_ms]
+    double bandwidth_mbps;      // Capacity in Mbit/s (0 = unlimited)
+} mpc_sim_link_t;
+
+/* Network model of a simulated group */
+typedef struct {
+    mpc_sim_link_t link;        // Model of every directed link...
+    const mpc_sim_link_t *links;// ...unless given per link: num_parties ×
+                                // num_parties, row = sender (may be NULL)
+    size_t overhead_bytes;      // Framing bytes added to every message
+    int count_compute;          // Add thread CPU time between calls
+    uint64_t seed;              // Jitter seed
+} mpc_sim_config_t;
+
+/* Traffic and simulated time of one protocol step on one party */
+typedef struct {
+    char name[MPC_SIM_STEP_NAME_SIZE];
+    uint64_t rounds;
+    uint64_t messages_sent;
+    uint64_t bytes_sent;
+    uint64_t bytes_received;
+    double elapsed_ms;          // Simulated time from begin to end
+    double compute_ms;          // Part of it spent computing locally
+} mpc_sim_step_t;
+
+/**
+ * Create a group of endpoints connected by a simulated network.
+ *
+ * @param num_parties  Number of parties (2-255)
+ * @param config       Network model (copied)
+ * @param endpoints    Output array of num_parties endpoints
+ * @return 0 on success, -1 on failure
+ *
+ * Example:
+ *   mpc_sim_config_t wan = {{40.0, 2.0, 100.0}, NULL, 44, 1, 1};
+ *   mpc_transport_t *net[5];
+ *   mpc_transport_sim_create(5, &wan, net);
+ *   // On the thread of each party:
+ *   mpc_sim_step_begin(net[i - 1], "inputs");
+ *   mpc_net_share_input(&ctx, net[i - 1], i, &x, &s[i - 1], 1);
+ *   mpc_sim_step_begin(net[i - 1], "multiply");
+ *   mpc_net_mul(&ctx, net[i - 1], &s[0], &s[1], &prod, 1);
+ *   mpc_sim_step_end(net[i - 1]);
+ */
+int mpc_transport_sim_create(uint8_t num_parties,
+                             const mpc_sim_config_t *config,
+                             mpc_transport_t **endpoints);
+
+/**
+ * Simulated clock of an endpoint, in milliseconds since creation.
+ *
+ * @return The clock, or a negative value for a non-simulated endpoint
+ */
+double mpc_sim_now_ms(const mpc_transport_t *transport);
+
+/**
+ * Start a named protocol step, ending the current one (if any).
+ *
+ * @param transport  Simulated endpoint
+ * @param name       Step name (truncated to MPC_SIM_STEP_NAME_SIZE - 1)
+ * @return 0 on success, -1 on failure
+ */
+int mpc_sim_step_begin(mpc_transport_t *transport, const char *name);
+
+/**
+ * End the current protocol step.
+ *
+ * @return 0 on success, -1 if no step is running
+ */
+int mpc_sim_step_end(mpc_transport_t *transport);
+
+/**
+ * Read back the finished steps of an endpoint, in order.
+ *
+ * @param transport  Simulated endpoint
+ * @param steps      Output array (may be NULL to count only)
+ * @param max_steps  Capacity of steps
+ * @return Number of finished steps (may exceed max_steps)
+ */
+size_t mpc_sim_get_steps(const mpc_transport_t *transport,
+                         mpc_sim_step_t *steps, size_t max_steps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_TRANSPORT_SIM_H */
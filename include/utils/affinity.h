@@ -0,0 +1,42 @@
+#ifndef SSS_AFFINITY_H
+#define SSS_AFFINITY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CPU Affinity
+ *
+ * Used to pin executor workers and party threads or processes to cores,
+ * so benchmark numbers do not depend on scheduler migrations.
+ * ======================================================================== */
+
+/**
+ * Number of CPUs the calling process may run on.
+ *
+ * @return Size of the process affinity mask (at least 1)
+ */
+unsigned sss_num_cpus(void);
+
+/**
+ * Pin the calling thread to one CPU.
+ *
+ * CPUs are counted within the process affinity mask, and cpu wraps
+ * around, so any index is accepted: with 4 allowed CPUs, cpu 5 pins to
+ * the second of them.
+ *
+ * @param cpu  Index into the allowed CPUs
+ * @return 0 on success, -1 on failure (always, outside Linux)
+ *
+ * Example:
+ *   // Party i on core i
+ *   sss_pin_thread(party_id - 1);
+ */
+int sss_pin_thread(unsigned cpu);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_AFFINITY_H */
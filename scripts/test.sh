@@ -20,8 +20,23 @@ TESTS=(
     "mpc_arithmetic_test"
     "mpc_multiplication_test"
     "mpc_highlevel_test"
+    "mpc_circuit_test"
+    "mpc_parallel_test"
+    "mpc_transport_test"
+    "mpc_session_test"
+    "mpc_sim_test"
+    "mpc_stats_test"
+    "diff_check_test"
+    "mpc_trace_test"
+    "mpc_mem_profile_test"
+    "mpc_fixed_point_test"
 )
 
+# The party runtime is built on epoll
+if [ "$(uname -s)" = "Linux" ]; then
+    TESTS+=("mpc_runtime_test")
+fi
+
 PASSED=0
 FAILED=0
 
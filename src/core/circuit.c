@@ -0,0 +1,751 @@
+#include "sss/circuit.h"
+#include "sss/mpc.h"
+#include "core/mpc_mul_internal.h"
+#include "core/mpc_stats_internal.h"
+#include "utils/secure_memory.h"
+#include <stdatomic.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* Initial number of gate slots allocated by mpc_circuit_init() */
+#define CIRCUIT_INITIAL_CAPACITY 16
+
+/* Parallel evaluation: multiplications and local gates per chunk */
+#define CIRCUIT_MUL_CHUNK 16
+#define CIRCUIT_LOCAL_CHUNK 64
+
+/* ========================================================================
+ * Internal Helpers
+ * ======================================================================== */
+
+/**
+ * Append a gate, growing the gate array when needed.
+ * Computes the gate's multiplicative level from its operands.
+ */
+static mpc_wire_t circuit_append(mpc_circuit_t *circuit, mpc_gate_t gate) {
+    if (circuit == NULL || circuit->gates == NULL) {
+        return MPC_WIRE_INVALID;
+    }
+
+    // Wire ids must stay below MPC_WIRE_INVALID
+    if (circuit->num_gates >= MPC_WIRE_INVALID - 1) {
+        return MPC_WIRE_INVALID;
+    }
+
+    if (circuit->num_gates == circuit->capacity) {
+        uint32_t new_capacity = circuit->capacity * 2;
+        mpc_gate_t *grown = realloc(circuit->gates,
+                                    new_capacity * sizeof(mpc_gate_t));
+        if (grown == NULL) {
+            return MPC_WIRE_INVALID;
+        }
+        circuit->gates = grown;
+        circuit->capacity = new_capacity;
+    }
+
+    // Level = deepest operand, plus one for a multiplication
+    uint32_t level = 0;
+    if (gate.type != MPC_GATE_INPUT && gate.type != MPC_GATE_CONST) {
+        level = circuit->gates[gate.in0].level;
+    }
+    if (gate.type == MPC_GATE_ADD || gate.type == MPC_GATE_SUB ||
+        gate.type == MPC_GATE_MUL) {
+        if (circuit->gates[gate.in1].level > level) {
+            level = circuit->gates[gate.in1].level;
+        }
+    }
+    if (gate.type == MPC_GATE_MUL) {
+        level++;
+    }
+    gate.level = level;
+
+    if (level > circuit->depth) {
+        circuit->depth = level;
+    }
+
+    circuit->gates[circuit->num_gates] = gate;
+    return circuit->num_gates++;
+}
+
+/**
+ * Check that a wire exists and carries a value (output gates do not)
+ */
+static int circuit_wire_valid(const mpc_circuit_t *circuit, mpc_wire_t wire) {
+    if (circuit == NULL || wire >= circuit->num_gates) {
+        return 0;
+    }
+    return circuit->gates[wire].type != MPC_GATE_OUTPUT;
+}
+
+/**
+ * Build a binary gate after checking both operands
+ */
+static mpc_wire_t circuit_binary(mpc_circuit_t *circuit, mpc_gate_type_t type,
+                                 mpc_wire_t a, mpc_wire_t b) {
+    if (!circuit_wire_valid(circuit, a) || !circuit_wire_valid(circuit, b)) {
+        return MPC_WIRE_INVALID;
+    }
+
+    mpc_gate_t gate = {0};
+    gate.type = type;
+    gate.in0 = a;
+    gate.in1 = b;
+    return circuit_append(circuit, gate);
+}
+
+/* ========================================================================
+ * Circuit Construction
+ * ======================================================================== */
+
+int mpc_circuit_init(mpc_circuit_t *circuit) {
+    if (circuit == NULL) {
+        return -1;
+    }
+
+    memset(circuit, 0, sizeof(mpc_circuit_t));
+
+    circuit->gates = malloc(CIRCUIT_INITIAL_CAPACITY * sizeof(mpc_gate_t));
+    if (circuit->gates == NULL) {
+        return -1;
+    }
+    circuit->capacity = CIRCUIT_INITIAL_CAPACITY;
+
+    return 0;
+}
+
+void mpc_circuit_free(mpc_circuit_t *circuit) {
+    if (circuit == NULL) {
+        return;
+    }
+
+    free(circuit->gates);
+    memset(circuit, 0, sizeof(mpc_circuit_t));
+}
+
+mpc_wire_t mpc_circuit_input(mpc_circuit_t *circuit) {
+    if (circuit == NULL) {
+        return MPC_WIRE_INVALID;
+    }
+
+    mpc_gate_t gate = {0};
+    gate.type = MPC_GATE_INPUT;
+    gate.in0 = MPC_WIRE_INVALID;
+    gate.in1 = MPC_WIRE_INVALID;
+    gate.slot = circuit->num_inputs;
+
+    mpc_wire_t wire = circuit_append(circuit, gate);
+    if (wire != MPC_WIRE_INVALID) {
+        circuit->num_inputs++;
+    }
+    return wire;
+}
+
+mpc_wire_t mpc_circuit_add(mpc_circuit_t *circuit, mpc_wire_t a, mpc_wire_t b) {
+    return circuit_binary(circuit, MPC_GATE_ADD, a, b);
+}
+
+mpc_wire_t mpc_circuit_sub(mpc_circuit_t *circuit, mpc_wire_t a, mpc_wire_t b) {
+    return circuit_binary(circuit, MPC_GATE_SUB, a, b);
+}
+
+mpc_wire_t mpc_circuit_mul_const(mpc_circuit_t *circuit, mpc_wire_t a,
+                                 uint8_t constant) {
+    if (!circuit_wire_valid(circuit, a)) {
+        return MPC_WIRE_INVALID;
+    }
+
+    mpc_gate_t gate = {0};
+    gate.type = MPC_GATE_MUL_CONST;
+    gate.in0 = a;
+    gate.in1 = MPC_WIRE_INVALID;
+    gate.constant = constant;
+    return circuit_append(circuit, gate);
+}
+
+mpc_wire_t mpc_circuit_mul(mpc_circuit_t *circuit, mpc_wire_t a, mpc_wire_t b) {
+    return circuit_binary(circuit, MPC_GATE_MUL, a, b);
+}
+
+mpc_wire_t mpc_circuit_const(mpc_circuit_t *circuit, uint8_t value) {
+    if (circuit == NULL) {
+        return MPC_WIRE_INVALID;
+    }
+
+    mpc_gate_t gate = {0};
+    gate.type = MPC_GATE_CONST;
+    gate.in0 = MPC_WIRE_INVALID;
+    gate.in1 = MPC_WIRE_INVALID;
+    gate.constant = value;
+    return circuit_append(circuit, gate);
+}
+
+mpc_wire_t mpc_circuit_output(mpc_circuit_t *circuit, mpc_wire_t a) {
+    if (!circuit_wire_valid(circuit, a)) {
+        return MPC_WIRE_INVALID;
+    }
+
+    mpc_gate_t gate = {0};
+    gate.type = MPC_GATE_OUTPUT;
+    gate.in0 = a;
+    gate.in1 = MPC_WIRE_INVALID;
+    gate.slot = circuit->num_outputs;
+
+    mpc_wire_t wire = circuit_append(circuit, gate);
+    if (wire != MPC_WIRE_INVALID) {
+        circuit->num_outputs++;
+    }
+    return wire;
+}
+
+/* ========================================================================
+ * Evaluation
+ * ======================================================================== */
+
+/**
+ * Check whether a gate is a local linear operation (counted in
+ * mpc_circuit_stats_t.local_gates)
+ */
+static int circuit_gate_is_linear(const mpc_gate_t *gate) {
+    return gate->type == MPC_GATE_ADD || gate->type == MPC_GATE_SUB ||
+           gate->type == MPC_GATE_MUL_CONST;
+}
+
+/**
+ * Evaluate one non-multiplication gate into its wire.
+ * MUL gates are skipped; they are evaluated in batches by the caller.
+ */
+static int circuit_eval_local(const mpc_context_t *ctx,
+                              const mpc_circuit_t *circuit, uint32_t g,
+                              mpc_share_t *wires, size_t stride,
+                              const mpc_share_t *const *inputs,
+                              mpc_share_t *const *outputs,
+                              uint8_t num_shares) {
+    const mpc_gate_t *gate = &circuit->gates[g];
+    mpc_share_t *out = &wires[g * stride];
+
+    switch (gate->type) {
+        case MPC_GATE_INPUT:
+            if (inputs[gate->slot] == NULL) {
+                return -1;
+            }
+            memcpy(out, inputs[gate->slot], num_shares * sizeof(mpc_share_t));
+            return 0;
+
+        case MPC_GATE_CONST:
+            // Degree-0 sharing: every party holds the constant
+            if (ctx->value_size > SSS_SHARE_DATA_SIZE) {
+                return -1;
+            }
+            for (uint8_t i = 0; i < num_shares; i++) {
+                memset(&out[i], 0, sizeof(mpc_share_t));
+                out[i].party_id = i + 1;
+                out[i].session_id = ctx->session_id;
+                out[i].share.index = i + 1;
+                out[i].share.threshold = ctx->threshold;
+                out[i].share.data_len = ctx->value_size;
+                memset(out[i].share.data, gate->constant, ctx->value_size);
+            }
+            return 0;
+
+        case MPC_GATE_ADD:
+            return mpc_secure_add(ctx, &wires[gate->in0 * stride],
+                                  &wires[gate->in1 * stride],
+                                  out, num_shares) == 0 ? 0 : -1;
+
+        case MPC_GATE_SUB:
+            return mpc_secure_sub(ctx, &wires[gate->in0 * stride],
+                                  &wires[gate->in1 * stride],
+                                  out, num_shares) == 0 ? 0 : -1;
+
+        case MPC_GATE_MUL_CONST:
+            return mpc_secure_mul_const(ctx, &wires[gate->in0 * stride],
+                                        gate->constant, out,
+                                        num_shares) == 0 ? 0 : -1;
+
+        case MPC_GATE_OUTPUT:
+            if (outputs[gate->slot] == NULL) {
+                return -1;
+            }
+            memcpy(outputs[gate->slot], &wires[gate->in0 * stride],
+                   num_shares * sizeof(mpc_share_t));
+            return 0;
+
+        case MPC_GATE_MUL:
+            // Evaluated in a batched step by the caller
+            return 0;
+
+        default:
+            return -1;
+    }
+}
+
+int mpc_circuit_evaluate(const mpc_context_t *ctx,
+                         const mpc_circuit_t *circuit,
+                         const mpc_share_t *const *inputs,
+                         mpc_share_t *const *outputs,
+                         uint8_t num_shares,
+                         mpc_circuit_stats_t *stats) {
+    // Validate inputs
+    if (ctx == NULL || circuit == NULL || circuit->gates == NULL) {
+        return -1;
+    }
+
+    if (num_shares == 0 || num_shares > ctx->num_parties) {
+        return -1;
+    }
+
+    if ((circuit->num_inputs > 0 && inputs == NULL) ||
+        (circuit->num_outputs > 0 && outputs == NULL)) {
+        return -1;
+    }
+
+    if (circuit->num_gates == 0) {
+        if (stats != NULL) {
+            memset(stats, 0, sizeof(mpc_circuit_stats_t));
+        }
+        return 0;
+    }
+
+    uint32_t num_gates = circuit->num_gates;
+    uint32_t num_levels = circuit->depth + 1;
+
+    // Multiplications reshare to every party, so each wire holds a full
+    // set of num_parties shares even if only num_shares are used
+    size_t stride = ctx->num_parties;
+    size_t wires_size = (size_t)num_gates * stride * sizeof(mpc_share_t);
+
+    // ====================================================================
+    // Step 1: Layer the circuit by multiplicative level
+    // ====================================================================
+
+    // Counting sort of gate indices by level. Sorting is stable, so the
+    // gates of every layer stay in topological order.
+    uint32_t *layer_start = calloc(num_levels + 1, sizeof(uint32_t));
+    uint32_t *order = malloc(num_gates * sizeof(uint32_t));
+    const mpc_share_t **mul_x = malloc(num_gates * sizeof(mpc_share_t *));
+    const mpc_share_t **mul_y = malloc(num_gates * sizeof(mpc_share_t *));
+    mpc_share_t **mul_out = malloc(num_gates * sizeof(mpc_share_t *));
+    uint32_t *fill = calloc(num_levels, sizeof(uint32_t));
+    mpc_share_t *wires = mpc_secure_alloc(ctx, wires_size);
+
+    mpc_circuit_stats_t local_stats = {0};
+    int result = 0;
+
+    if (layer_start == NULL || order == NULL || mul_x == NULL ||
+        mul_y == NULL || mul_out == NULL || fill == NULL || wires == NULL) {
+        result = -1;
+        goto cleanup;
+    }
+    secure_lock(wires, wires_size);
+
+    for (uint32_t g = 0; g < num_gates; g++) {
+        layer_start[circuit->gates[g].level + 1]++;
+    }
+    for (uint32_t l = 0; l < num_levels; l++) {
+        layer_start[l + 1] += layer_start[l];
+    }
+    for (uint32_t g = 0; g < num_gates; g++) {
+        uint32_t level = circuit->gates[g].level;
+        order[layer_start[level] + fill[level]++] = g;
+    }
+
+    // ====================================================================
+    // Step 2: Evaluate layer by layer
+    // ====================================================================
+
+    for (uint32_t l = 0; l < num_levels && result == 0; l++) {
+        // All multiplications of this layer depend only on lower layers,
+        // so they are batched into one interactive step
+        size_t num_muls = 0;
+        for (uint32_t k = layer_start[l]; k < layer_start[l + 1]; k++) {
+            uint32_t g = order[k];
+            const mpc_gate_t *gate = &circuit->gates[g];
+            if (gate->type != MPC_GATE_MUL) {
+                continue;
+            }
+            mul_x[num_muls] = &wires[gate->in0 * stride];
+            mul_y[num_muls] = &wires[gate->in1 * stride];
+            mul_out[num_muls] = &wires[g * stride];
+            num_muls++;
+        }
+
+        if (num_muls > 0) {
+            if (mpc_secure_mul_batch(ctx, mul_x, mul_y, mul_out,
+                                     num_muls, num_shares) != 0) {
+                result = -1;
+                break;
+            }
+            local_stats.rounds++;
+            local_stats.multiplications += num_muls;
+        }
+
+        // Local gates of this layer, in topological order
+        for (uint32_t k = layer_start[l]; k < layer_start[l + 1]; k++) {
+            uint32_t g = order[k];
+            if (circuit_eval_local(ctx, circuit, g, wires, stride, inputs,
+                                   outputs, num_shares) != 0) {
+                result = -1;
+                break;
+            }
+            if (circuit_gate_is_linear(&circuit->gates[g])) {
+                local_stats.local_gates++;
+            }
+        }
+    }
+
+    if (result == 0 && stats != NULL) {
+        *stats = local_stats;
+    }
+
+cleanup:
+    if (wires != NULL) {
+        secure_wipe(wires, wires_size);
+        secure_unlock(wires, wires_size);
+        mpc_secure_release(wires, wires_size);
+    }
+    free(fill);
+    free(mul_out);
+    free(mul_y);
+    free(mul_x);
+    free(order);
+    free(layer_start);
+
+    return result;
+}
+
+/* ========================================================================
+ * Parallel Evaluation
+ * ======================================================================== */
+
+/* Position of a gate in the parallel schedule */
+typedef struct {
+    uint32_t level;     // Multiplicative level
+    uint32_t step;      // 0 for MUL, else dependency depth within the level
+    uint32_t gate;
+} schedule_entry_t;
+
+/* Shared state of one parallel loop */
+typedef struct {
+    const mpc_context_t *ctx;
+    const mpc_circuit_t *circuit;
+    const mpc_share_t *const *inputs;
+    mpc_share_t *const *outputs;
+    mpc_share_t *wires;
+    size_t stride;
+    uint8_t num_shares;
+
+    const schedule_entry_t *group;      // Local gates of the current step
+    const mpc_share_t **mul_x;          // Operands of the current MUL layer
+    const mpc_share_t **mul_y;
+    mpc_share_t **mul_out;
+    mpc_share_t *intermediate;          // Degree-2 products of the layer
+    uint8_t *products;                  // Opened products of the layer
+
+    atomic_int failed;
+} parallel_eval_t;
+
+static int schedule_compare(const void *a, const void *b) {
+    const schedule_entry_t *x = a;
+    const schedule_entry_t *y = b;
+
+    if (x->level != y->level) {
+        return (x->level < y->level) ? -1 : 1;
+    }
+    if (x->step != y->step) {
+        return (x->step < y->step) ? -1 : 1;
+    }
+    return (x->gate < y->gate) ? -1 : (x->gate > y->gate);
+}
+
+static void parallel_mul_local_chunk(void *arg, size_t begin, size_t end,
+                                     unsigned worker) {
+    parallel_eval_t *eval = arg;
+    (void)worker;
+
+    if (atomic_load_explicit(&eval->failed, memory_order_relaxed)) {
+        return;
+    }
+
+    if (mpc_mul_local_products(eval->ctx, eval->mul_x + begin,
+                               eval->mul_y + begin, eval->mul_out + begin,
+                               end - begin, eval->num_shares,
+                               &eval->intermediate[begin * eval->num_shares])
+        != 0) {
+        atomic_store_explicit(&eval->failed, 1, memory_order_relaxed);
+    }
+}
+
+static void parallel_mul_reshare_chunk(void *arg, size_t begin, size_t end,
+                                       unsigned worker) {
+    parallel_eval_t *eval = arg;
+    (void)worker;
+
+    if (atomic_load_explicit(&eval->failed, memory_order_relaxed)) {
+        return;
+    }
+
+    if (mpc_mul_reshare_products(eval->ctx,
+                                 &eval->products[begin * eval->ctx->value_size],
+                                 eval->mul_out + begin, end - begin) != 0) {
+        atomic_store_explicit(&eval->failed, 1, memory_order_relaxed);
+    }
+}
+
+/**
+ * Multiply the MUL gates of one layer: local products and resharing in
+ * chunks on the workers, with a single opening of the whole layer
+ * between them, so the layer costs one round however it is split
+ */
+static int parallel_mul_layer(parallel_eval_t *eval, mpc_executor_t *executor,
+                              size_t num_muls) {
+    const mpc_context_t *ctx = eval->ctx;
+    uint64_t start = mpc_stats_begin(ctx);
+
+    int result = mpc_executor_parallel_for(executor, num_muls,
+                                           CIRCUIT_MUL_CHUNK,
+                                           parallel_mul_local_chunk, eval);
+    if (result == 0 && !atomic_load(&eval->failed)) {
+        result = mpc_mul_open_products(ctx, eval->intermediate, num_muls,
+                                       eval->num_shares, eval->products);
+    }
+    if (result == 0 && !atomic_load(&eval->failed)) {
+        result = mpc_executor_parallel_for(executor, num_muls,
+                                           CIRCUIT_MUL_CHUNK,
+                                           parallel_mul_reshare_chunk, eval);
+    }
+    if (atomic_load(&eval->failed)) {
+        result = -1;
+    }
+
+    secure_wipe(eval->intermediate,
+                num_muls * eval->num_shares * sizeof(mpc_share_t));
+    secure_wipe(eval->products, num_muls * ctx->value_size);
+
+    if (result == 0) {
+        mpc_stats_add(ctx, MPC_COUNTER_MULTIPLICATIONS, num_muls);
+        mpc_stats_add(ctx, MPC_COUNTER_RESHARES, num_muls);
+    }
+    mpc_stats_end(ctx, MPC_OP_MUL, start);
+    return (result == 0) ? 0 : -1;
+}
+
+static void parallel_local_chunk(void *arg, size_t begin, size_t end,
+                                 unsigned worker) {
+    parallel_eval_t *eval = arg;
+    (void)worker;
+
+    for (size_t k = begin; k < end; k++) {
+        if (atomic_load_explicit(&eval->failed, memory_order_relaxed)) {
+            return;
+        }
+        if (circuit_eval_local(eval->ctx, eval->circuit, eval->group[k].gate,
+                               eval->wires, eval->stride, eval->inputs,
+                               eval->outputs, eval->num_shares) != 0) {
+            atomic_store_explicit(&eval->failed, 1, memory_order_relaxed);
+        }
+    }
+}
+
+int mpc_circuit_evaluate_parallel(const mpc_context_t *ctx,
+                                  const mpc_circuit_t *circuit,
+                                  mpc_executor_t *executor,
+                                  const mpc_share_t *const *inputs,
+                                  mpc_share_t *const *outputs,
+                                  uint8_t num_shares,
+                                  mpc_circuit_stats_t *stats) {
+    // Validate inputs
+    if (ctx == NULL || circuit == NULL || circuit->gates == NULL ||
+        executor == NULL) {
+        return -1;
+    }
+
+    if (num_shares == 0 || num_shares > ctx->num_parties) {
+        return -1;
+    }
+
+    if ((circuit->num_inputs > 0 && inputs == NULL) ||
+        (circuit->num_outputs > 0 && outputs == NULL)) {
+        return -1;
+    }
+
+    if (circuit->num_gates == 0) {
+        if (stats != NULL) {
+            memset(stats, 0, sizeof(mpc_circuit_stats_t));
+        }
+        return 0;
+    }
+
+    uint32_t num_gates = circuit->num_gates;
+    size_t stride = ctx->num_parties;
+    size_t wires_size = (size_t)num_gates * stride * sizeof(mpc_share_t);
+
+    schedule_entry_t *schedule = malloc(num_gates * sizeof(schedule_entry_t));
+    const mpc_share_t **mul_x = malloc(num_gates * sizeof(mpc_share_t *));
+    const mpc_share_t **mul_y = malloc(num_gates * sizeof(mpc_share_t *));
+    mpc_share_t **mul_out = malloc(num_gates * sizeof(mpc_share_t *));
+    mpc_share_t *wires = mpc_secure_alloc(ctx, wires_size);
+    mpc_share_t *intermediate = NULL;
+    uint8_t *products = NULL;
+    size_t intermediate_size = 0;
+    size_t products_size = 0;
+
+    mpc_circuit_stats_t local_stats = {0};
+    parallel_eval_t eval;
+    int result = 0;
+
+    if (schedule == NULL || mul_x == NULL || mul_y == NULL ||
+        mul_out == NULL || wires == NULL) {
+        result = -1;
+        goto cleanup;
+    }
+    secure_lock(wires, wires_size);
+
+    // ====================================================================
+    // Step 1: Schedule gates by (level, step)
+    // ====================================================================
+
+    // Within a level, a local gate runs one step after its deepest
+    // same-level operand; MUL gates (step 0) only read lower levels.
+    // Gates of one step are therefore independent of each other.
+    for (uint32_t g = 0; g < num_gates; g++) {
+        const mpc_gate_t *gate = &circuit->gates[g];
+        uint32_t step = 0;
+
+        if (gate->type != MPC_GATE_MUL) {
+            step = 1;
+            if (gate->type != MPC_GATE_INPUT && gate->type != MPC_GATE_CONST) {
+                const schedule_entry_t *a = &schedule[gate->in0];
+                if (a->level == gate->level && a->step + 1 > step) {
+                    step = a->step + 1;
+                }
+            }
+            if (gate->type == MPC_GATE_ADD || gate->type == MPC_GATE_SUB) {
+                const schedule_entry_t *b = &schedule[gate->in1];
+                if (b->level == gate->level && b->step + 1 > step) {
+                    step = b->step + 1;
+                }
+            }
+        }
+
+        schedule[g].level = gate->level;
+        schedule[g].step = step;
+        schedule[g].gate = g;
+
+        if (gate->type == MPC_GATE_MUL) {
+            local_stats.multiplications++;
+        } else if (circuit_gate_is_linear(gate)) {
+            local_stats.local_gates++;
+        }
+    }
+
+    // Operand lookups above index by gate id, so sort only afterwards
+    qsort(schedule, num_gates, sizeof(schedule_entry_t), schedule_compare);
+
+    // Room for the products of the widest MUL layer
+    size_t widest = 0;
+    for (uint32_t start = 0; start < num_gates; ) {
+        uint32_t end = start + 1;
+        while (end < num_gates &&
+               schedule[end].level == schedule[start].level &&
+               schedule[end].step == schedule[start].step) {
+            end++;
+        }
+        if (schedule[start].step == 0 && end - start > widest) {
+            widest = end - start;
+        }
+        start = end;
+    }
+    if (widest > 0) {
+        intermediate_size = widest * num_shares * sizeof(mpc_share_t);
+        products_size = widest * ctx->value_size;
+        intermediate = mpc_secure_alloc(ctx, intermediate_size);
+        products = mpc_secure_alloc(ctx, products_size);
+        if (intermediate == NULL || products == NULL) {
+            result = -1;
+            goto cleanup;
+        }
+        secure_lock(intermediate, intermediate_size);
+        secure_lock(products, products_size);
+    }
+
+    // ====================================================================
+    // Step 2: Evaluate one step group at a time
+    // ====================================================================
+
+    eval.ctx = ctx;
+    eval.circuit = circuit;
+    eval.inputs = inputs;
+    eval.outputs = outputs;
+    eval.wires = wires;
+    eval.stride = stride;
+    eval.num_shares = num_shares;
+    eval.group = NULL;
+    eval.mul_x = mul_x;
+    eval.mul_y = mul_y;
+    eval.mul_out = mul_out;
+    eval.intermediate = intermediate;
+    eval.products = products;
+    atomic_init(&eval.failed, 0);
+
+    for (uint32_t start = 0; start < num_gates && result == 0; ) {
+        uint32_t end = start + 1;
+        while (end < num_gates &&
+               schedule[end].level == schedule[start].level &&
+               schedule[end].step == schedule[start].step) {
+            end++;
+        }
+
+        if (schedule[start].step == 0) {
+            // MUL gates of this layer: one round, split across workers
+            size_t num_muls = end - start;
+            for (size_t k = 0; k < num_muls; k++) {
+                const mpc_gate_t *gate = &circuit->gates[schedule[start + k].gate];
+                mul_x[k] = &wires[gate->in0 * stride];
+                mul_y[k] = &wires[gate->in1 * stride];
+                mul_out[k] = &wires[schedule[start + k].gate * stride];
+            }
+
+            if (parallel_mul_layer(&eval, executor, num_muls) != 0) {
+                result = -1;
+            }
+            local_stats.rounds++;
+        } else {
+            eval.group = &schedule[start];
+            if (mpc_executor_parallel_for(executor, end - start,
+                                          CIRCUIT_LOCAL_CHUNK,
+                                          parallel_local_chunk, &eval) != 0) {
+                result = -1;
+            }
+        }
+
+        if (atomic_load(&eval.failed)) {
+            result = -1;
+        }
+        start = end;
+    }
+
+    if (result == 0 && stats != NULL) {
+        *stats = local_stats;
+    }
+
+cleanup:
+    if (products != NULL) {
+        secure_unlock(products, products_size);
+        mpc_secure_release(products, products_size);
+    }
+    if (intermediate != NULL) {
+        secure_unlock(intermediate, intermediate_size);
+        mpc_secure_release(intermediate, intermediate_size);
+    }
+    if (wires != NULL) {
+        secure_wipe(wires, wires_size);
+        secure_unlock(wires, wires_size);
+        mpc_secure_release(wires, wires_size);
+    }
+    free(mul_out);
+    free(mul_y);
+    free(mul_x);
+    free(schedule);
+
+    return result;
+}
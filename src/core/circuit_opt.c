@@ -0,0 +1,635 @@
+#include "sss/circuit.h"
+#include "sss/field.h"
+#include <string.h>
+#include <stdlib.h>
+
+/* Initial number of slots in the common-subexpression table */
+#define CSE_INITIAL_SLOTS 64
+
+/* ========================================================================
+ * Internal Types
+ * ======================================================================== */
+
+/**
+ * Entry of the common-subexpression table (open addressing)
+ */
+typedef struct {
+    mpc_gate_type_t type;
+    mpc_wire_t a;
+    mpc_wire_t b;
+    uint8_t constant;
+    mpc_wire_t wire;        // MPC_WIRE_INVALID marks an empty slot
+} cse_entry_t;
+
+/**
+ * State of the circuit being built
+ */
+typedef struct {
+    mpc_circuit_t *out;     // Circuit under construction
+    unsigned passes;        // Enabled MPC_OPT_* passes
+    cse_entry_t *table;     // Common-subexpression table
+    size_t num_slots;       // Table size (power of two)
+    size_t num_entries;     // Occupied slots
+} opt_builder_t;
+
+/* ========================================================================
+ * Common-Subexpression Table
+ * ======================================================================== */
+
+static size_t cse_hash(mpc_gate_type_t type, mpc_wire_t a, mpc_wire_t b,
+                       uint8_t constant) {
+    uint64_t h = (uint64_t)type;
+    h = h * 0x9E3779B97F4A7C15ULL + a;
+    h = h * 0x9E3779B97F4A7C15ULL + b;
+    h = h * 0x9E3779B97F4A7C15ULL + constant;
+    return (size_t)(h ^ (h >> 29));
+}
+
+static cse_entry_t *cse_slot(const opt_builder_t *builder, mpc_gate_type_t type,
+                             mpc_wire_t a, mpc_wire_t b, uint8_t constant) {
+    size_t mask = builder->num_slots - 1;
+    size_t i = cse_hash(type, a, b, constant) & mask;
+
+    while (builder->table[i].wire != MPC_WIRE_INVALID) {
+        const cse_entry_t *e = &builder->table[i];
+        if (e->type == type && e->a == a && e->b == b && e->constant == constant) {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    return &builder->table[i];
+}
+
+static int cse_resize(opt_builder_t *builder, size_t num_slots) {
+    cse_entry_t *old = builder->table;
+    size_t old_slots = builder->num_slots;
+
+    builder->table = malloc(num_slots * sizeof(cse_entry_t));
+    if (builder->table == NULL) {
+        builder->table = old;
+        return -1;
+    }
+    builder->num_slots = num_slots;
+    for (size_t i = 0; i < num_slots; i++) {
+        builder->table[i].wire = MPC_WIRE_INVALID;
+    }
+
+    for (size_t i = 0; i < old_slots; i++) {
+        if (old[i].wire != MPC_WIRE_INVALID) {
+            *cse_slot(builder, old[i].type, old[i].a, old[i].b,
+                      old[i].constant) = old[i];
+        }
+    }
+    free(old);
+    return 0;
+}
+
+/* ========================================================================
+ * Gate Emission
+ * ======================================================================== */
+
+static int is_const(const opt_builder_t *builder, mpc_wire_t wire,
+                    uint8_t *value) {
+    const mpc_gate_t *gate = &builder->out->gates[wire];
+    if (gate->type != MPC_GATE_CONST) {
+        return 0;
+    }
+    *value = gate->constant;
+    return 1;
+}
+
+/**
+ * Append a gate through the common-subexpression table
+ */
+static mpc_wire_t emit_raw(opt_builder_t *builder, mpc_gate_type_t type,
+                           mpc_wire_t a, mpc_wire_t b, uint8_t constant) {
+    mpc_circuit_t *out = builder->out;
+    cse_entry_t *slot = NULL;
+
+    if (builder->passes & MPC_OPT_CSE) {
+        // Keep the table at most half full
+        if (2 * (builder->num_entries + 1) > builder->num_slots &&
+            cse_resize(builder, builder->num_slots * 2) != 0) {
+            return MPC_WIRE_INVALID;
+        }
+        slot = cse_slot(builder, type, a, b, constant);
+        if (slot->wire != MPC_WIRE_INVALID) {
+            return slot->wire;
+        }
+    }
+
+    mpc_wire_t wire;
+    switch (type) {
+        case MPC_GATE_CONST:     wire = mpc_circuit_const(out, constant); break;
+        case MPC_GATE_ADD:       wire = mpc_circuit_add(out, a, b); break;
+        case MPC_GATE_SUB:       wire = mpc_circuit_sub(out, a, b); break;
+        case MPC_GATE_MUL_CONST: wire = mpc_circuit_mul_const(out, a, constant); break;
+        case MPC_GATE_MUL:       wire = mpc_circuit_mul(out, a, b); break;
+        default:                 wire = MPC_WIRE_INVALID; break;
+    }
+
+    if (slot != NULL && wire != MPC_WIRE_INVALID) {
+        slot->type = type;
+        slot->a = a;
+        slot->b = b;
+        slot->constant = constant;
+        slot->wire = wire;
+        builder->num_entries++;
+    }
+    return wire;
+}
+
+/**
+ * Emit a gate, applying constant folding and canonicalization first
+ */
+static mpc_wire_t emit(opt_builder_t *builder, mpc_gate_type_t type,
+                       mpc_wire_t a, mpc_wire_t b, uint8_t constant) {
+    if (a == MPC_WIRE_INVALID ||
+        ((type == MPC_GATE_ADD || type == MPC_GATE_SUB || type == MPC_GATE_MUL) &&
+         b == MPC_WIRE_INVALID)) {
+        return MPC_WIRE_INVALID;
+    }
+
+    if (builder->passes & MPC_OPT_FOLD) {
+        uint8_t va = 0, vb = 0;
+        int ca = is_const(builder, a, &va);
+        int cb = (type == MPC_GATE_MUL_CONST) ? 0 : is_const(builder, b, &vb);
+
+        switch (type) {
+            case MPC_GATE_ADD:
+            case MPC_GATE_SUB:
+                if (ca && cb) {
+                    return emit_raw(builder, MPC_GATE_CONST, MPC_WIRE_INVALID,
+                                    MPC_WIRE_INVALID, gf256_add(va, vb));
+                }
+                if (ca && va == 0) {
+                    return b;   // 0 ± b = b in GF(256)
+                }
+                if (cb && vb == 0) {
+                    return a;
+                }
+                if (a == b) {
+                    // x + x = x - x = 0 in characteristic 2
+                    return emit_raw(builder, MPC_GATE_CONST, MPC_WIRE_INVALID,
+                                    MPC_WIRE_INVALID, 0);
+                }
+                break;
+
+            case MPC_GATE_MUL_CONST: {
+                if (constant == 1) {
+                    return a;
+                }
+                if (constant == 0) {
+                    return emit_raw(builder, MPC_GATE_CONST, MPC_WIRE_INVALID,
+                                    MPC_WIRE_INVALID, 0);
+                }
+                if (ca) {
+                    return emit_raw(builder, MPC_GATE_CONST, MPC_WIRE_INVALID,
+                                    MPC_WIRE_INVALID, gf256_mul(va, constant));
+                }
+                // (x × c1) × c2 = x × (c1 × c2)
+                const mpc_gate_t *inner = &builder->out->gates[a];
+                if (inner->type == MPC_GATE_MUL_CONST) {
+                    return emit(builder, MPC_GATE_MUL_CONST, inner->in0,
+                                MPC_WIRE_INVALID,
+                                gf256_mul(inner->constant, constant));
+                }
+                break;
+            }
+
+            case MPC_GATE_MUL:
+                // A public factor turns an interactive MUL into a local one
+                if (ca) {
+                    return emit(builder, MPC_GATE_MUL_CONST, b,
+                                MPC_WIRE_INVALID, va);
+                }
+                if (cb) {
+                    return emit(builder, MPC_GATE_MUL_CONST, a,
+                                MPC_WIRE_INVALID, vb);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (builder->passes & MPC_OPT_CSE) {
+        // Subtraction is addition in GF(256)
+        if (type == MPC_GATE_SUB) {
+            type = MPC_GATE_ADD;
+        }
+        // Commutative operands in canonical order
+        if ((type == MPC_GATE_ADD || type == MPC_GATE_MUL) && a > b) {
+            mpc_wire_t tmp = a;
+            a = b;
+            b = tmp;
+        }
+    }
+
+    if (type == MPC_GATE_MUL_CONST) {
+        b = MPC_WIRE_INVALID;
+    }
+
+    return emit_raw(builder, type, a, b, constant);
+}
+
+/* ========================================================================
+ * Product Rebalancing
+ * ======================================================================== */
+
+typedef struct {
+    uint32_t level;
+    mpc_wire_t wire;
+} leaf_t;
+
+static int leaf_compare(const void *lhs, const void *rhs) {
+    const leaf_t *x = lhs;
+    const leaf_t *y = rhs;
+    if (x->level != y->level) {
+        return (x->level < y->level) ? -1 : 1;
+    }
+    if (x->wire != y->wire) {
+        return (x->wire < y->wire) ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Multiply leaves[0..count) together with minimal multiplicative depth.
+ *
+ * Leaves are sorted by level and combined Huffman-style: the two
+ * shallowest available factors are always multiplied first. Products
+ * are produced in non-decreasing level order, so a second FIFO queue
+ * holds them and no heap is needed.
+ */
+static mpc_wire_t emit_balanced_product(opt_builder_t *builder, leaf_t *leaves,
+                                        size_t count, leaf_t *queue) {
+    uint8_t scalar = 1;
+    size_t n = 0;
+
+    // Fold public factors into a single constant
+    for (size_t i = 0; i < count; i++) {
+        uint8_t value;
+        if ((builder->passes & MPC_OPT_FOLD) &&
+            is_const(builder, leaves[i].wire, &value)) {
+            scalar = gf256_mul(scalar, value);
+        } else {
+            leaves[n++] = leaves[i];
+        }
+    }
+
+    if (n == 0 || scalar == 0) {
+        return emit_raw(builder, MPC_GATE_CONST, MPC_WIRE_INVALID,
+                        MPC_WIRE_INVALID, scalar);
+    }
+
+    qsort(leaves, n, sizeof(leaf_t), leaf_compare);
+
+    size_t li = 0;                  // Next unused leaf
+    size_t qh = 0, qt = 0;          // Queue head and tail
+    size_t remaining = n;
+
+    while (remaining > 1) {
+        leaf_t pick[2];
+        for (int k = 0; k < 2; k++) {
+            if (qh < qt && (li >= n || queue[qh].level < leaves[li].level)) {
+                pick[k] = queue[qh++];
+            } else {
+                pick[k] = leaves[li++];
+            }
+        }
+
+        mpc_wire_t product = emit(builder, MPC_GATE_MUL, pick[0].wire,
+                                  pick[1].wire, 0);
+        if (product == MPC_WIRE_INVALID) {
+            return MPC_WIRE_INVALID;
+        }
+        queue[qt].wire = product;
+        queue[qt].level = builder->out->gates[product].level;
+        qt++;
+        remaining--;
+    }
+
+    mpc_wire_t result = (qh < qt) ? queue[qh].wire : leaves[li].wire;
+
+    if (scalar != 1) {
+        result = emit(builder, MPC_GATE_MUL_CONST, result, MPC_WIRE_INVALID,
+                      scalar);
+    }
+    return result;
+}
+
+/* ========================================================================
+ * Liveness
+ * ======================================================================== */
+
+/**
+ * Mark gates that contribute to an output. Inputs are always live so
+ * that input numbering survives optimization.
+ */
+static void mark_live(const mpc_circuit_t *circuit, uint8_t *live) {
+    for (uint32_t g = circuit->num_gates; g-- > 0;) {
+        const mpc_gate_t *gate = &circuit->gates[g];
+
+        if (gate->type == MPC_GATE_OUTPUT || gate->type == MPC_GATE_INPUT) {
+            live[g] = 1;
+        }
+        if (!live[g]) {
+            continue;
+        }
+
+        switch (gate->type) {
+            case MPC_GATE_ADD:
+            case MPC_GATE_SUB:
+            case MPC_GATE_MUL:
+                live[gate->in1] = 1;
+                live[gate->in0] = 1;
+                break;
+            case MPC_GATE_MUL_CONST:
+            case MPC_GATE_OUTPUT:
+                live[gate->in0] = 1;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * Copy only the live gates of a circuit
+ */
+static int compact_circuit(const mpc_circuit_t *circuit, mpc_circuit_t *out) {
+    uint32_t n = circuit->num_gates;
+    uint8_t *live = calloc(n + 1, 1);
+    mpc_wire_t *remap = malloc((n + 1) * sizeof(mpc_wire_t));
+    int result = 0;
+
+    if (live == NULL || remap == NULL || mpc_circuit_init(out) != 0) {
+        free(live);
+        free(remap);
+        return -1;
+    }
+
+    mark_live(circuit, live);
+
+    for (uint32_t g = 0; g < n && result == 0; g++) {
+        const mpc_gate_t *gate = &circuit->gates[g];
+        remap[g] = MPC_WIRE_INVALID;
+        if (!live[g]) {
+            continue;
+        }
+
+        switch (gate->type) {
+            case MPC_GATE_INPUT:
+                remap[g] = mpc_circuit_input(out);
+                break;
+            case MPC_GATE_CONST:
+                remap[g] = mpc_circuit_const(out, gate->constant);
+                break;
+            case MPC_GATE_ADD:
+                remap[g] = mpc_circuit_add(out, remap[gate->in0], remap[gate->in1]);
+                break;
+            case MPC_GATE_SUB:
+                remap[g] = mpc_circuit_sub(out, remap[gate->in0], remap[gate->in1]);
+                break;
+            case MPC_GATE_MUL_CONST:
+                remap[g] = mpc_circuit_mul_const(out, remap[gate->in0],
+                                                 gate->constant);
+                break;
+            case MPC_GATE_MUL:
+                remap[g] = mpc_circuit_mul(out, remap[gate->in0], remap[gate->in1]);
+                break;
+            case MPC_GATE_OUTPUT:
+                remap[g] = mpc_circuit_output(out, remap[gate->in0]);
+                break;
+        }
+
+        if (remap[g] == MPC_WIRE_INVALID) {
+            result = -1;
+        }
+    }
+
+    free(live);
+    free(remap);
+
+    if (result != 0) {
+        mpc_circuit_free(out);
+    }
+    return result;
+}
+
+static uint32_t count_muls(const mpc_circuit_t *circuit) {
+    uint32_t muls = 0;
+    for (uint32_t g = 0; g < circuit->num_gates; g++) {
+        if (circuit->gates[g].type == MPC_GATE_MUL) {
+            muls++;
+        }
+    }
+    return muls;
+}
+
+/* ========================================================================
+ * Optimizer
+ * ======================================================================== */
+
+int mpc_circuit_optimize(const mpc_circuit_t *circuit,
+                         mpc_circuit_t *optimized,
+                         unsigned passes,
+                         mpc_circuit_opt_stats_t *stats) {
+    // Validate inputs
+    if (circuit == NULL || circuit->gates == NULL || optimized == NULL) {
+        return -1;
+    }
+
+    uint32_t n = circuit->num_gates;
+
+    // Per-gate scratch (n + 1 so that empty circuits still allocate).
+    // A product tree reads two operands per MUL gate, so its factor
+    // list can hold up to twice as many entries as there are gates.
+    size_t max_factors = 2 * ((size_t)n + 1);
+    uint8_t *live = calloc(n + 1, 1);
+    uint32_t *uses = calloc(n + 1, sizeof(uint32_t));
+    uint32_t *mul_uses = calloc(n + 1, sizeof(uint32_t));
+    mpc_wire_t *remap = malloc((n + 1) * sizeof(mpc_wire_t));
+    mpc_wire_t *stack = malloc(max_factors * sizeof(mpc_wire_t));
+    leaf_t *leaves = malloc(max_factors * sizeof(leaf_t));
+    leaf_t *queue = malloc(max_factors * sizeof(leaf_t));
+
+    mpc_circuit_t built;
+    opt_builder_t builder = {0};
+    builder.out = &built;
+    builder.passes = passes;
+
+    int result = 0;
+    int built_ready = 0;
+
+    if (live == NULL || uses == NULL || mul_uses == NULL || remap == NULL ||
+        stack == NULL || leaves == NULL || queue == NULL ||
+        mpc_circuit_init(&built) != 0) {
+        result = -1;
+        goto cleanup;
+    }
+    built_ready = 1;
+
+    if ((passes & MPC_OPT_CSE) && cse_resize(&builder, CSE_INITIAL_SLOTS) != 0) {
+        result = -1;
+        goto cleanup;
+    }
+
+    // ====================================================================
+    // Step 1: Liveness and use counts on the original circuit
+    // ====================================================================
+
+    if (passes & MPC_OPT_DCE) {
+        mark_live(circuit, live);
+    } else {
+        memset(live, 1, n);
+    }
+
+    for (uint32_t g = 0; g < n; g++) {
+        const mpc_gate_t *gate = &circuit->gates[g];
+        if (!live[g]) {
+            continue;
+        }
+        switch (gate->type) {
+            case MPC_GATE_MUL:
+                mul_uses[gate->in0]++;
+                mul_uses[gate->in1]++;
+                uses[gate->in0]++;
+                uses[gate->in1]++;
+                break;
+            case MPC_GATE_ADD:
+            case MPC_GATE_SUB:
+                uses[gate->in1]++;
+                uses[gate->in0]++;
+                break;
+            case MPC_GATE_MUL_CONST:
+            case MPC_GATE_OUTPUT:
+                uses[gate->in0]++;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // ====================================================================
+    // Step 2: Rebuild with folding, CSE and rebalanced products
+    // ====================================================================
+
+    for (uint32_t g = 0; g < n && result == 0; g++) {
+        const mpc_gate_t *gate = &circuit->gates[g];
+        remap[g] = MPC_WIRE_INVALID;
+
+        if (!live[g]) {
+            continue;
+        }
+
+        // A product feeding exactly one other product is an interior
+        // node of a product tree; it is emitted as part of that tree
+        int interior = (passes & MPC_OPT_BALANCE) &&
+                       gate->type == MPC_GATE_MUL &&
+                       uses[g] == 1 && mul_uses[g] == 1;
+        if (interior) {
+            continue;
+        }
+
+        switch (gate->type) {
+            case MPC_GATE_INPUT:
+                remap[g] = mpc_circuit_input(&built);
+                break;
+
+            case MPC_GATE_CONST:
+                remap[g] = emit_raw(&builder, MPC_GATE_CONST, MPC_WIRE_INVALID,
+                                    MPC_WIRE_INVALID, gate->constant);
+                break;
+
+            case MPC_GATE_ADD:
+            case MPC_GATE_SUB:
+                remap[g] = emit(&builder, gate->type, remap[gate->in0],
+                                remap[gate->in1], 0);
+                break;
+
+            case MPC_GATE_MUL_CONST:
+                remap[g] = emit(&builder, MPC_GATE_MUL_CONST, remap[gate->in0],
+                                MPC_WIRE_INVALID, gate->constant);
+                break;
+
+            case MPC_GATE_MUL:
+                if (!(passes & MPC_OPT_BALANCE)) {
+                    remap[g] = emit(&builder, MPC_GATE_MUL, remap[gate->in0],
+                                    remap[gate->in1], 0);
+                    break;
+                }
+                {
+                    // Collect the factors of the product tree rooted here
+                    size_t top = 0, count = 0;
+                    stack[top++] = gate->in1;
+                    stack[top++] = gate->in0;
+                    while (top > 0) {
+                        mpc_wire_t w = stack[--top];
+                        const mpc_gate_t *op = &circuit->gates[w];
+                        if (op->type == MPC_GATE_MUL && uses[w] == 1 &&
+                            mul_uses[w] == 1) {
+                            stack[top++] = op->in1;
+                            stack[top++] = op->in0;
+                        } else {
+                            leaves[count].wire = remap[w];
+                            leaves[count].level = built.gates[remap[w]].level;
+                            count++;
+                        }
+                    }
+                    remap[g] = emit_balanced_product(&builder, leaves, count,
+                                                     queue);
+                }
+                break;
+
+            case MPC_GATE_OUTPUT:
+                remap[g] = mpc_circuit_output(&built, remap[gate->in0]);
+                break;
+        }
+
+        if (remap[g] == MPC_WIRE_INVALID) {
+            result = -1;
+        }
+    }
+
+    if (result != 0) {
+        goto cleanup;
+    }
+
+    // ====================================================================
+    // Step 3: Drop gates made dead by folding and CSE
+    // ====================================================================
+
+    if (passes & MPC_OPT_DCE) {
+        result = compact_circuit(&built, optimized);
+    } else {
+        *optimized = built;
+        built_ready = 0;    // Ownership moved to the caller
+    }
+
+    if (result == 0 && stats != NULL) {
+        stats->gates_before = circuit->num_gates;
+        stats->gates_after = optimized->num_gates;
+        stats->muls_before = count_muls(circuit);
+        stats->muls_after = count_muls(optimized);
+        stats->depth_before = circuit->depth;
+        stats->depth_after = optimized->depth;
+    }
+
+cleanup:
+    if (built_ready) {
+        mpc_circuit_free(&built);
+    }
+    free(builder.table);
+    free(queue);
+    free(leaves);
+    free(stack);
+    free(remap);
+    free(mul_uses);
+    free(uses);
+    free(live);
+
+    return result;
+}
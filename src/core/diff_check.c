@@ -0,0 +1,175 @@
+#define _GNU_SOURCE
+#include "core/diff_check_internal.h"
+#include "sss/secret_sharing.h"
+
+#ifdef SSS_DIFFERENTIAL_CHECK
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Check 1 call in this many (0 = off); read from SSS_CHECK_EVERY */
+static _Atomic uint32_t check_every = UINT32_MAX;
+
+/* Per-thread sampling state, so threads do not contend on a counter */
+_Thread_local uint32_t sss_check_countdown;
+static _Thread_local uint64_t check_rng;
+
+/* Calls between rereads of the interval while checking is off */
+#define IDLE_COUNTDOWN 65536
+
+/* ========================================================================
+ * Sampling
+ * ======================================================================== */
+
+static uint32_t interval(void) {
+    uint32_t every = atomic_load_explicit(&check_every, memory_order_relaxed);
+    if (every == UINT32_MAX) {
+        // Every call unless the environment says otherwise
+        const char *env = getenv("SSS_CHECK_EVERY");
+        every = (env != NULL) ? (uint32_t)strtoul(env, NULL, 10) : 1;
+        atomic_store_explicit(&check_every, every, memory_order_relaxed);
+    }
+    return every;
+}
+
+/**
+ * Next value of this thread's xorshift generator (sampling only, not
+ * for anything secret)
+ */
+static uint64_t check_random(void) {
+    if (check_rng == 0) {
+        check_rng = ((uint64_t)time(NULL) << 20) ^ (uintptr_t)&check_rng;
+        check_rng |= 1;
+    }
+    check_rng ^= check_rng << 13;
+    check_rng ^= check_rng >> 7;
+    check_rng ^= check_rng << 17;
+    return check_rng;
+}
+
+int sss_check_sample(void) {
+    uint32_t every = interval();
+    if (every <= 1) {
+        sss_check_countdown = (every == 0) ? IDLE_COUNTDOWN : 1;
+        return every == 1;
+    }
+
+    // The gap to the next check is drawn uniformly from 1..2*every-1, so
+    // checks average 1 in every calls but cannot fall into step with a
+    // kernel's calling pattern
+    uint64_t span = 2 * (uint64_t)every - 1;
+    sss_check_countdown = (uint32_t)(1 + check_random() % span);
+    return 1;
+}
+
+size_t sss_check_index(size_t count) {
+    return (count > 0) ? (size_t)(check_random() % count) : 0;
+}
+
+void sss_check_failed(const char *kernel, const char *detail) {
+    fprintf(stderr, "sss: differential check failed: %s disagrees with "
+            "its reference (%s)\n", kernel, detail);
+    abort();
+}
+
+/* ========================================================================
+ * Reference Implementations
+ * ======================================================================== */
+
+/**
+ * Carry-less product, then reduction by x^8 + x^4 + x^3 + x + 1
+ */
+uint8_t gf256_mul_reference(uint8_t a, uint8_t b) {
+    uint16_t product = 0;
+    for (int bit = 0; bit < 8; bit++) {
+        if ((b >> bit) & 1) {
+            product ^= (uint16_t)(a << bit);
+        }
+    }
+    for (int bit = 15; bit >= 8; bit--) {
+        if ((product >> bit) & 1) {
+            product ^= (uint16_t)(0x11B << (bit - 8));
+        }
+    }
+    return (uint8_t)product;
+}
+
+/**
+ * The element whose product with a is 1, by search (0 maps to 0)
+ */
+uint8_t gf256_inv_reference(uint8_t a) {
+    for (unsigned x = 1; x < 256; x++) {
+        if (gf256_mul_reference(a, (uint8_t)x) == 1) {
+            return (uint8_t)x;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Sum of row[l] * column[l * stride], one product at a time
+ */
+uint8_t gf256_dot_reference(const uint8_t *row, const uint8_t *column,
+                            size_t length, size_t stride) {
+    uint8_t sum = 0;
+    for (size_t l = 0; l < length; l++) {
+        sum ^= gf256_mul_reference(row[l], column[l * stride]);
+    }
+    return sum;
+}
+
+/**
+ * Sum of c_i * x^i, the powers of x built up term by term
+ */
+uint8_t polynomial_evaluate_reference(const uint8_t *coefficients,
+                                      uint8_t degree, uint8_t x) {
+    uint8_t sum = 0;
+    uint8_t power = 1;
+    for (unsigned i = 0; i <= degree; i++) {
+        sum ^= gf256_mul_reference(coefficients[i], power);
+        power = gf256_mul_reference(power, x);
+    }
+    return sum;
+}
+
+/**
+ * P(0) = sum of y_i * (prod x_j) / (prod (x_j - x_i)), one inversion per
+ * point
+ */
+uint8_t polynomial_interpolate_reference(const uint8_t *points_x,
+                                         const uint8_t *points_y,
+                                         uint8_t num_points) {
+    uint8_t secret = 0;
+    for (unsigned i = 0; i < num_points; i++) {
+        uint8_t numerator = 1;
+        uint8_t denominator = 1;
+        for (unsigned j = 0; j < num_points; j++) {
+            if (j != i) {
+                numerator = gf256_mul_reference(numerator, points_x[j]);
+                denominator = gf256_mul_reference(
+                    denominator, points_x[j] ^ points_x[i]);
+            }
+        }
+        uint8_t basis = gf256_mul_reference(
+            numerator, gf256_inv_reference(denominator));
+        secret ^= gf256_mul_reference(points_y[i], basis);
+    }
+    return secret;
+}
+#endif
+
+/* ========================================================================
+ * Public API
+ * ======================================================================== */
+
+int sss_set_check_interval(uint32_t every) {
+#ifdef SSS_DIFFERENTIAL_CHECK
+    atomic_store_explicit(&check_every, every == UINT32_MAX ? every - 1 : every,
+                          memory_order_relaxed);
+    return 0;
+#else
+    (void)every;
+    return -1;
+#endif
+}
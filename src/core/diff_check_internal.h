@@ -0,0 +1,84 @@
+#ifndef SSS_CORE_DIFF_CHECK_INTERNAL_H
+#define SSS_CORE_DIFF_CHECK_INTERNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Differential Checking
+ *
+ * In builds with SSS_DIFFERENTIAL_CHECK, the field, polynomial and
+ * sharing kernels compare a sample of their results with the reference
+ * implementations below and abort on a mismatch. The references are
+ * deliberately written differently from the kernels (textbook forms,
+ * no shared helpers), so a bug in one is not repeated in the other.
+ * Without the option, SSS_DIFF_CHECK compiles to nothing.
+ * ======================================================================== */
+
+#ifdef SSS_DIFFERENTIAL_CHECK
+
+/* Calls of this thread left until the next check */
+extern _Thread_local uint32_t sss_check_countdown;
+
+/**
+ * Start the next countdown; returns whether this call is checked
+ */
+int sss_check_sample(void);
+
+/**
+ * Whether this call should be checked (1 in the configured interval).
+ * Unchecked calls cost a thread-local decrement.
+ */
+static inline int sss_check_due(void) {
+    if (sss_check_countdown > 1) {
+        sss_check_countdown--;
+        return 0;
+    }
+    return sss_check_sample();
+}
+
+/**
+ * Index in [0, count) of the output element a checked call verifies,
+ * so that every element of a batch gets checked over time
+ */
+size_t sss_check_index(size_t count);
+
+/**
+ * Report a mismatch of kernel against its reference and abort. detail
+ * names public parameters only; secret operands are never printed.
+ */
+_Noreturn void sss_check_failed(const char *kernel, const char *detail);
+
+/* Reference implementations */
+uint8_t gf256_mul_reference(uint8_t a, uint8_t b);
+uint8_t gf256_inv_reference(uint8_t a);
+uint8_t gf256_dot_reference(const uint8_t *row, const uint8_t *column,
+                            size_t length, size_t stride);
+uint8_t polynomial_evaluate_reference(const uint8_t *coefficients,
+                                      uint8_t degree, uint8_t x);
+uint8_t polynomial_interpolate_reference(const uint8_t *points_x,
+                                         const uint8_t *points_y,
+                                         uint8_t num_points);
+
+#define SSS_DIFF_CHECK(kernel, agrees, detail)                              \
+    do {                                                                    \
+        if (sss_check_due() && !(agrees)) {                                 \
+            sss_check_failed(kernel, detail);                               \
+        }                                                                   \
+    } while (0)
+
+#else
+
+#define SSS_DIFF_CHECK(kernel, agrees, detail) ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_CORE_DIFF_CHECK_INTERNAL_H */
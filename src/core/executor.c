@@ -0,0 +1,368 @@
+#define _GNU_SOURCE
+#include "sss/executor.h"
+#include "utils/affinity.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* Size of a cache line; hot atomics get one each to avoid false sharing */
+#define CACHE_LINE_SIZE 64
+
+/*
+ * Deque slots per worker. Ranges are split in half before being pushed,
+ * so a deque never holds more than log2(number of chunks) + 1 entries.
+ */
+#define DEQUE_CAPACITY 64
+
+/* Sentinel for "no task" (a real task always has begin < end) */
+#define TASK_NONE UINT64_MAX
+
+/* ========================================================================
+ * Internal Types
+ * ======================================================================== */
+
+/**
+ * Chase-Lev work-stealing deque of chunk ranges.
+ *
+ * The owner pushes and pops at the bottom; thieves steal from the top.
+ * A task is a chunk range [begin, end) packed into one 64-bit word so
+ * that slots can be read atomically.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) _Atomic int64_t top;
+    _Alignas(CACHE_LINE_SIZE) _Atomic int64_t bottom;
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t tasks[DEQUE_CAPACITY];
+} work_deque_t;
+
+typedef struct {
+    mpc_executor_t *executor;
+    unsigned id;
+    pthread_t thread;
+} worker_t;
+
+struct mpc_executor {
+    unsigned num_threads;
+    unsigned flags;
+    work_deque_t *deques;           // One per worker
+    worker_t *workers;              // Workers 1 to N-1 (0 is the caller)
+    unsigned num_started;           // Threads successfully started
+
+    // Current loop (published under lock, read-only while it runs)
+    mpc_executor_fn fn;
+    void *arg;
+    size_t count;
+    size_t chunk_size;
+    size_t num_chunks;
+
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t remaining;  // Chunks not yet run
+    _Alignas(CACHE_LINE_SIZE) atomic_uint finished;     // Workers done with loop
+
+    // Parking of idle workers between loops
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    uint64_t generation;            // Incremented for every loop
+    int shutdown;
+};
+
+/* ========================================================================
+ * Task Encoding
+ * ======================================================================== */
+
+static inline uint64_t task_pack(uint32_t begin, uint32_t end) {
+    return ((uint64_t)begin << 32) | end;
+}
+
+static inline uint32_t task_begin(uint64_t task) {
+    return (uint32_t)(task >> 32);
+}
+
+static inline uint32_t task_end(uint64_t task) {
+    return (uint32_t)task;
+}
+
+/* ========================================================================
+ * Work-Stealing Deque
+ *
+ * Follows Lê, Pop, Cohen and Zappa Nardelli, "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ * ======================================================================== */
+
+static void deque_reset(work_deque_t *deque) {
+    atomic_store_explicit(&deque->top, 0, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, 0, memory_order_relaxed);
+}
+
+static void deque_push(work_deque_t *deque, uint64_t task) {
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    atomic_store_explicit(&deque->tasks[b % DEQUE_CAPACITY], task,
+                          memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+}
+
+static uint64_t deque_pop(work_deque_t *deque) {
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (t > b) {
+        // Empty
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+        return TASK_NONE;
+    }
+
+    uint64_t task = atomic_load_explicit(&deque->tasks[b % DEQUE_CAPACITY],
+                                         memory_order_relaxed);
+    if (t == b) {
+        // Last task: race against thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
+                                                     memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            task = TASK_NONE;
+        }
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+static uint64_t deque_steal(work_deque_t *deque) {
+    int64_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (t >= b) {
+        return TASK_NONE;
+    }
+
+    uint64_t task = atomic_load_explicit(&deque->tasks[t % DEQUE_CAPACITY],
+                                         memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return TASK_NONE;   // Lost the race; the caller simply retries
+    }
+    return task;
+}
+
+/* ========================================================================
+ * Workers
+ * ======================================================================== */
+
+/**
+ * Take part in the current loop until every chunk has run, starting on
+ * the slice seeded into this worker's deque
+ */
+static void run_worker(mpc_executor_t *ex, unsigned id) {
+    work_deque_t *own = &ex->deques[id];
+
+    for (;;) {
+        uint64_t task = deque_pop(own);
+
+        // Out of local work: steal, trying the nearest workers first
+        for (unsigned k = 1; task == TASK_NONE && k < ex->num_threads; k++) {
+            task = deque_steal(&ex->deques[(id + k) % ex->num_threads]);
+        }
+
+        if (task == TASK_NONE) {
+            if (atomic_load_explicit(&ex->remaining, memory_order_acquire) == 0) {
+                return;
+            }
+            sched_yield();
+            continue;
+        }
+
+        // Keep the first chunk, leave the rest stealable in halves
+        uint32_t begin = task_begin(task);
+        uint32_t end = task_end(task);
+        while (end - begin > 1) {
+            uint32_t mid = begin + (end - begin) / 2;
+            deque_push(own, task_pack(mid, end));
+            end = mid;
+        }
+
+        size_t first = (size_t)begin * ex->chunk_size;
+        size_t last = first + ex->chunk_size;
+        if (last > ex->count) {
+            last = ex->count;
+        }
+        ex->fn(ex->arg, first, last, id);
+
+        atomic_fetch_sub_explicit(&ex->remaining, 1, memory_order_acq_rel);
+    }
+}
+
+static void *worker_main(void *param) {
+    worker_t *worker = param;
+    mpc_executor_t *ex = worker->executor;
+    uint64_t seen = 0;
+
+    if (ex->flags & MPC_EXECUTOR_PIN_THREADS) {
+        sss_pin_thread(worker->id);
+    }
+
+    for (;;) {
+        pthread_mutex_lock(&ex->lock);
+        while (ex->generation == seen && !ex->shutdown) {
+            pthread_cond_wait(&ex->wake, &ex->lock);
+        }
+        if (ex->shutdown) {
+            pthread_mutex_unlock(&ex->lock);
+            break;
+        }
+        seen = ex->generation;
+        pthread_mutex_unlock(&ex->lock);
+
+        run_worker(ex, worker->id);
+        atomic_fetch_add_explicit(&ex->finished, 1, memory_order_release);
+    }
+
+    return NULL;
+}
+
+/* ========================================================================
+ * Public API
+ * ======================================================================== */
+
+mpc_executor_t *mpc_executor_create(unsigned num_threads, unsigned flags) {
+    if (num_threads == 0) {
+        num_threads = sss_num_cpus();
+    }
+
+    size_t ex_size = (sizeof(mpc_executor_t) + CACHE_LINE_SIZE - 1) /
+                     CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    mpc_executor_t *ex = aligned_alloc(CACHE_LINE_SIZE, ex_size);
+    if (ex == NULL) {
+        return NULL;
+    }
+    memset(ex, 0, sizeof(mpc_executor_t));
+
+    ex->num_threads = num_threads;
+    ex->flags = flags;
+    ex->deques = aligned_alloc(CACHE_LINE_SIZE,
+                               num_threads * sizeof(work_deque_t));
+    ex->workers = calloc(num_threads, sizeof(worker_t));
+
+    if (ex->deques == NULL || ex->workers == NULL ||
+        pthread_mutex_init(&ex->lock, NULL) != 0) {
+        free(ex->deques);
+        free(ex->workers);
+        free(ex);
+        return NULL;
+    }
+    if (pthread_cond_init(&ex->wake, NULL) != 0) {
+        pthread_mutex_destroy(&ex->lock);
+        free(ex->deques);
+        free(ex->workers);
+        free(ex);
+        return NULL;
+    }
+
+    for (unsigned i = 0; i < num_threads; i++) {
+        deque_reset(&ex->deques[i]);
+    }
+    atomic_init(&ex->remaining, 0);
+    atomic_init(&ex->finished, 0);
+
+    for (unsigned i = 1; i < num_threads; i++) {
+        ex->workers[i].executor = ex;
+        ex->workers[i].id = i;
+        if (pthread_create(&ex->workers[i].thread, NULL, worker_main,
+                           &ex->workers[i]) != 0) {
+            mpc_executor_destroy(ex);
+            return NULL;
+        }
+        ex->num_started++;
+    }
+
+    return ex;
+}
+
+void mpc_executor_destroy(mpc_executor_t *executor) {
+    if (executor == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&executor->lock);
+    executor->shutdown = 1;
+    pthread_cond_broadcast(&executor->wake);
+    pthread_mutex_unlock(&executor->lock);
+
+    for (unsigned i = 1; i <= executor->num_started; i++) {
+        pthread_join(executor->workers[i].thread, NULL);
+    }
+
+    pthread_cond_destroy(&executor->wake);
+    pthread_mutex_destroy(&executor->lock);
+    free(executor->deques);
+    free(executor->workers);
+    free(executor);
+}
+
+unsigned mpc_executor_num_threads(const mpc_executor_t *executor) {
+    return (executor != NULL) ? executor->num_threads : 0;
+}
+
+int mpc_executor_parallel_for(mpc_executor_t *executor, size_t count,
+                              size_t chunk_size, mpc_executor_fn fn,
+                              void *arg) {
+    if (executor == NULL || fn == NULL) {
+        return -1;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if (chunk_size == 0) {
+        chunk_size = MPC_EXECUTOR_DEFAULT_CHUNK;
+    }
+
+    size_t num_chunks = (count + chunk_size - 1) / chunk_size;
+    if (num_chunks >= UINT32_MAX) {
+        return -1;  // Chunk ids must fit in a packed task
+    }
+
+    // Not worth waking anybody
+    if (num_chunks == 1 || executor->num_started == 0) {
+        fn(arg, 0, count, 0);
+        return 0;
+    }
+
+    // Workers are parked, so the loop can be set up without atomics
+    executor->fn = fn;
+    executor->arg = arg;
+    executor->count = count;
+    executor->chunk_size = chunk_size;
+    executor->num_chunks = num_chunks;
+    // Seed every deque with its worker's contiguous slice of the chunk
+    // range, so that all of it is stealable before any worker wakes up
+    for (unsigned i = 0; i < executor->num_threads; i++) {
+        deque_reset(&executor->deques[i]);
+        uint32_t lo = (uint32_t)(num_chunks * i / executor->num_threads);
+        uint32_t hi = (uint32_t)(num_chunks * (i + 1) / executor->num_threads);
+        if (lo < hi) {
+            deque_push(&executor->deques[i], task_pack(lo, hi));
+        }
+    }
+    atomic_store_explicit(&executor->remaining, num_chunks, memory_order_relaxed);
+    atomic_store_explicit(&executor->finished, 0, memory_order_relaxed);
+
+    // Publish the loop (the mutex orders the setup above before it)
+    pthread_mutex_lock(&executor->lock);
+    executor->generation++;
+    pthread_cond_broadcast(&executor->wake);
+    pthread_mutex_unlock(&executor->lock);
+
+    run_worker(executor, 0);
+
+    // Wait until every worker has left the loop before it is reused
+    while (atomic_load_explicit(&executor->finished, memory_order_acquire) <
+           executor->num_started) {
+        sched_yield();
+    }
+
+    return 0;
+}
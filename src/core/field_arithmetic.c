@@ -1,4 +1,5 @@
 #include "sss/field.h"
+#include "core/diff_check_internal.h"
 #include <stddef.h>
 
 /* Irreducible polynomial for GF(256): x^8 + x^4 + x^3 + x + 1 */
@@ -8,7 +9,7 @@
  * GF(256) Multiplication
  * ======================================================================== */
 
-uint8_t gf256_mul(uint8_t a, uint8_t b) {
+static uint8_t mul_kernel(uint8_t a, uint8_t b) {
     uint8_t result = 0;
     uint8_t hi_bit_set;
     
@@ -30,11 +31,18 @@ uint8_t gf256_mul(uint8_t a, uint8_t b) {
     return result;
 }
 
+uint8_t gf256_mul(uint8_t a, uint8_t b) {
+    uint8_t result = mul_kernel(a, b);
+    SSS_DIFF_CHECK("gf256_mul", result == gf256_mul_reference(a, b),
+                   "operands not shown");
+    return result;
+}
+
 /* ========================================================================
  * GF(256) Multiplicative Inverse
  * ======================================================================== */
 
-uint8_t gf256_inv(uint8_t a) {
+static uint8_t inv_kernel(uint8_t a) {
     if (a == 0) {
         return 0;
     }
@@ -54,6 +62,53 @@ uint8_t gf256_inv(uint8_t a) {
     return result;
 }
 
+uint8_t gf256_inv(uint8_t a) {
+    uint8_t result = inv_kernel(a);
+    SSS_DIFF_CHECK("gf256_inv", result == gf256_inv_reference(a),
+                   "operand not shown");
+    return result;
+}
+
+#ifdef SSS_DIFFERENTIAL_CHECK
+/**
+ * Whether the inverse of a randomly chosen element matches the reference
+ */
+static int inv_batch_agrees(const uint8_t *in, const uint8_t *out,
+                            size_t count) {
+    size_t index = sss_check_index(count);
+    return out[index] == gf256_inv_reference(in[index]);
+}
+#endif
+
+void gf256_inv_batch(const uint8_t *in, uint8_t *out, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    
+    // out[i] = product of the nonzero in[0..i]
+    uint8_t running = 1;
+    for (size_t i = 0; i < count; i++) {
+        if (in[i] != 0) {
+            running = gf256_mul(running, in[i]);
+        }
+        out[i] = running;
+    }
+    
+    // Walk back, peeling one element at a time off the inverted product
+    uint8_t inverse = inv_kernel(running);
+    for (size_t i = count; i-- > 0;) {
+        if (in[i] == 0) {
+            out[i] = 0;
+            continue;
+        }
+        out[i] = gf256_mul(inverse, (i > 0) ? out[i - 1] : 1);
+        inverse = gf256_mul(inverse, in[i]);
+    }
+    
+    SSS_DIFF_CHECK("gf256_inv_batch", inv_batch_agrees(in, out, count),
+                   "operand not shown");
+}
+
 /* ========================================================================
  * GF(256) Division
  * ======================================================================== */
@@ -91,6 +146,67 @@ uint8_t gf256_pow(uint8_t base, uint8_t exp) {
     return result;
 }
 
+/* ========================================================================
+ * GF(256) Matrix Multiplication
+ * ======================================================================== */
+
+static void gemm_kernel(size_t rows, size_t inner, size_t cols,
+                        const uint8_t *a, const uint8_t *b, uint8_t *c) {
+    uint8_t multiples[8];
+
+    for (size_t i = 0; i < rows; i++) {
+        uint8_t *c_row = &c[i * cols];
+        for (size_t j = 0; j < cols; j++) {
+            c_row[j] = 0;
+        }
+
+        for (size_t l = 0; l < inner; l++) {
+            // x^k * a for k = 0..7, reduced without branching
+            uint8_t x = a[i * inner + l];
+            for (int k = 0; k < 8; k++) {
+                multiples[k] = x;
+                x = (uint8_t)((x << 1) ^ (0x1B & -(x >> 7)));
+            }
+
+            // c += a * b: select the multiples of the set bits of b
+            const uint8_t *b_row = &b[l * cols];
+            for (size_t j = 0; j < cols; j++) {
+                uint8_t y = b_row[j];
+                uint8_t sum = 0;
+                for (int k = 0; k < 8; k++) {
+                    sum ^= multiples[k] & (uint8_t)-((y >> k) & 1);
+                }
+                c_row[j] ^= sum;
+            }
+        }
+    }
+}
+
+#ifdef SSS_DIFFERENTIAL_CHECK
+/**
+ * Whether a randomly chosen element of c matches the reference dot
+ * product of its row of A and column of B
+ */
+static int gemm_agrees(size_t rows, size_t inner, size_t cols,
+                       const uint8_t *a, const uint8_t *b, const uint8_t *c) {
+    size_t index = sss_check_index(rows * cols);
+    size_t i = index / cols;
+    size_t j = index % cols;
+    return c[index] == gf256_dot_reference(&a[i * inner], &b[j], inner, cols);
+}
+#endif
+
+void gf256_gemm(size_t rows, size_t inner, size_t cols,
+                const uint8_t *a, const uint8_t *b, uint8_t *c) {
+    if (rows == 0 || cols == 0) {
+        return;
+    }
+    gemm_kernel(rows, inner, cols, a, b, c);
+
+    SSS_DIFF_CHECK("gf256_gemm", gemm_agrees(rows, inner, cols, a, b, c),
+                   "matrices not shown");
+}
+
 /* ========================================================================
  * Lookup Table Initialization (Optional Optimization)
  * ======================================================================== */
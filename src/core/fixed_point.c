@@ -0,0 +1,918 @@
+#include "sss/fixed_point.h"
+#include "utils/secure_memory.h"
+#include "utils/random.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================
+ * Field GF(2^127 - 1)
+ *
+ * Elements are kept fully reduced in an unsigned 128-bit integer.
+ * Reduction modulo a Mersenne prime needs no division: 2^127 = 1, so
+ * the bits above bit 126 are simply added back in.
+ * ======================================================================== */
+
+__extension__ typedef unsigned __int128 fe_t;
+__extension__ typedef __int128 fe_signed_t;
+
+#define FE_BITS 127
+#define FE_P ((((fe_t)1) << FE_BITS) - 1)
+#define FE_ONE ((fe_t)1)
+
+/* 2^f as a double, for encoding and decoding */
+#define FX_SCALE ((double)(1ull << MPC_FX_FRAC_BITS))
+
+/* Offset that makes every in-range value non-negative before masking */
+#define FX_OFFSET (FE_ONE << (MPC_FX_VALUE_BITS - 1))
+
+static fe_t fe_reduce(fe_t a) {
+    a = (a & FE_P) + (a >> FE_BITS);
+    return (a >= FE_P) ? a - FE_P : a;
+}
+
+static fe_t fe_add(fe_t a, fe_t b) {
+    return fe_reduce(a + b);
+}
+
+static fe_t fe_sub(fe_t a, fe_t b) {
+    return (a >= b) ? a - b : a + (FE_P - b);
+}
+
+static fe_t fe_mul(fe_t a, fe_t b) {
+    const fe_t mask = ((fe_t)1 << 64) - 1;
+    fe_t a0 = a & mask, a1 = a >> 64;
+    fe_t b0 = b & mask, b1 = b >> 64;
+
+    // 254-bit product as hi * 2^128 + lo; a1 and b1 are below 2^63
+    fe_t mid = a0 * b1 + a1 * b0;
+    fe_t p00 = a0 * b0;
+    fe_t lo = p00 + (mid << 64);
+    fe_t hi = a1 * b1 + (mid >> 64) + (lo < p00);
+
+    // 2^128 = 2 (mod p)
+    return fe_reduce((lo & FE_P) + (lo >> FE_BITS) + (hi << 1));
+}
+
+/**
+ * a * 2^k for 0 < k < 127: a rotation of the 127 bits of a
+ */
+static fe_t fe_mul_pow2(fe_t a, unsigned k) {
+    return ((a << k) | (a >> (FE_BITS - k))) & FE_P;
+}
+
+/**
+ * Inverse by Fermat's little theorem (0 for 0)
+ */
+static fe_t fe_inv(fe_t a) {
+    fe_t result = FE_ONE;
+    fe_t e = FE_P - 2;
+    while (e != 0) {
+        if (e & 1) {
+            result = fe_mul(result, a);
+        }
+        a = fe_mul(a, a);
+        e >>= 1;
+    }
+    return result;
+}
+
+static fe_t fe_from_signed(fe_signed_t v) {
+    return (v >= 0) ? (fe_t)v : FE_P - (fe_t)(-v);
+}
+
+static fe_signed_t fe_to_signed(fe_t a) {
+    return (a > FE_P / 2) ? -(fe_signed_t)(FE_P - a) : (fe_signed_t)a;
+}
+
+/**
+ * Uniform integer of the given number of bits (at most 127)
+ */
+static fe_t fe_random_bits(unsigned bits) {
+    uint8_t bytes[16];
+    sss_random_bytes(bytes, sizeof(bytes));
+    fe_t r = 0;
+    for (int i = 15; i >= 0; i--) {
+        r = (r << 8) | bytes[i];
+    }
+    secure_wipe(bytes, sizeof(bytes));
+    return (bits >= 128) ? r : r & ((FE_ONE << bits) - 1);
+}
+
+/**
+ * Uniform field element
+ */
+static fe_t fe_random(void) {
+    fe_t r;
+    do {
+        r = fe_random_bits(FE_BITS);
+    } while (r == FE_P);
+    return r;
+}
+
+static fe_t share_get(const mpc_fx_share_t *share) {
+    return ((fe_t)share->value[1] << 64) | share->value[0];
+}
+
+static void share_set(mpc_fx_share_t *share, uint8_t party_id,
+                      const mpc_session_id_t *session, fe_t value) {
+    share->party_id = party_id;
+    share->session_id = *session;
+    share->value[0] = (uint64_t)value;
+    share->value[1] = (uint64_t)(value >> 64);
+}
+
+/* ========================================================================
+ * Shamir Sharing over the Field
+ * ======================================================================== */
+
+/**
+ * Share secret with a fresh polynomial of degree threshold - 1;
+ * out[j] is the share of party j + 1
+ */
+static void fe_share(const mpc_context_t *ctx, fe_t secret, fe_t *out) {
+    fe_t coefficients[SSS_MAX_SHARES];
+    uint8_t degree = ctx->threshold - 1;
+
+    for (uint8_t k = 1; k <= degree; k++) {
+        coefficients[k] = fe_random();
+    }
+    coefficients[0] = secret;
+
+    for (unsigned party = 1; party <= ctx->num_parties; party++) {
+        // Horner's rule at x = party
+        fe_t y = coefficients[degree];
+        for (int k = degree - 1; k >= 0; k--) {
+            y = fe_add(fe_mul(y, party), coefficients[k]);
+        }
+        out[party - 1] = y;
+    }
+    secure_wipe(coefficients, (size_t)(degree + 1) * sizeof(fe_t));
+}
+
+/**
+ * Lagrange coefficients at 0 for the given distinct points
+ */
+static int lagrange_at_zero(const uint8_t *points, uint8_t count,
+                            fe_t *lambda) {
+    for (uint8_t i = 0; i < count; i++) {
+        fe_t num = FE_ONE;
+        fe_t den = FE_ONE;
+        for (uint8_t j = 0; j < count; j++) {
+            if (j == i) {
+                continue;
+            }
+            if (points[j] == points[i]) {
+                return -1;
+            }
+            num = fe_mul(num, points[j]);
+            den = fe_mul(den, fe_sub(points[j], points[i]));
+        }
+        lambda[i] = fe_mul(num, fe_inv(den));
+    }
+    return 0;
+}
+
+/* ========================================================================
+ * Validation
+ * ======================================================================== */
+
+static int check_shares(const mpc_context_t *ctx,
+                        const mpc_fx_share_t *shares, uint8_t num_shares) {
+    if (ctx == NULL || shares == NULL || num_shares == 0 ||
+        num_shares > ctx->num_parties) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        if (shares[i].party_id < 1 ||
+            shares[i].party_id > ctx->num_parties ||
+            !mpc_session_id_equal(&shares[i].session_id, &ctx->session_id)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Both sets valid and held by the same parties in the same order
+ */
+static int check_pair(const mpc_context_t *ctx, const mpc_fx_share_t *x,
+                      const mpc_fx_share_t *y, uint8_t num_shares) {
+    if (check_shares(ctx, x, num_shares) != 0 ||
+        check_shares(ctx, y, num_shares) != 0) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        if (x[i].party_id != y[i].party_id) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int check_sets(const mpc_context_t *ctx,
+                      const mpc_fx_share_t *const *share_sets,
+                      size_t num_values, uint8_t num_shares) {
+    if (share_sets == NULL || num_values == 0) {
+        return -1;
+    }
+    for (size_t v = 0; v < num_values; v++) {
+        if (share_sets[v] == NULL ||
+            check_pair(ctx, share_sets[0], share_sets[v], num_shares) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * round(value * 2^f), or -1 if value is not finite or |value| >= 2^(62 - f)
+ */
+static int encode(double value, fe_signed_t *raw) {
+    double scaled = value * FX_SCALE;
+    if (!isfinite(scaled) || scaled >= 0x1p62 || scaled <= -0x1p62) {
+        return -1;
+    }
+    *raw = (fe_signed_t)(scaled + (scaled >= 0 ? 0.5 : -0.5));
+    return 0;
+}
+
+/* ========================================================================
+ * Degree Reduction and Truncation
+ * ======================================================================== */
+
+/**
+ * Reduce count degree-2(t-1) sharings to degree t - 1 by resharing.
+ *
+ * local[k * num_shares + i] is the local value of party parties[i] for
+ * sharing k. Each party shares its local value, and every party combines
+ * the sub-shares it receives with the Lagrange coefficients of the input
+ * parties. out[k * num_parties + j] is the new share of party j + 1.
+ */
+static int reshare(const mpc_context_t *ctx, const fe_t *local,
+                   const uint8_t *parties, uint8_t num_shares, size_t count,
+                   fe_t *out) {
+    fe_t lambda[SSS_MAX_SHARES];
+    fe_t sub[SSS_MAX_SHARES];
+    uint8_t n = ctx->num_parties;
+
+    if (num_shares < 2 * ctx->threshold - 1 ||
+        lagrange_at_zero(parties, num_shares, lambda) != 0) {
+        return -1;
+    }
+
+    for (size_t k = 0; k < count; k++) {
+        fe_t *result = &out[k * n];
+        memset(result, 0, n * sizeof(fe_t));
+        for (uint8_t i = 0; i < num_shares; i++) {
+            fe_share(ctx, local[k * num_shares + i], sub);
+            for (uint8_t j = 0; j < n; j++) {
+                result[j] = fe_add(result[j], fe_mul(lambda[i], sub[j]));
+            }
+        }
+    }
+    secure_wipe(sub, sizeof(sub));
+    return 0;
+}
+
+/**
+ * Deal one truncation mask for shift m: shares of r = r1 * 2^m + r0 and
+ * of r0, where r0 < 2^m and r1 has K + kappa - m bits
+ */
+static void deal_mask(const mpc_context_t *ctx, unsigned m, fe_t *mask,
+                      fe_t *mask_low) {
+    fe_t r0 = fe_random_bits(m);
+    fe_t r1 = fe_random_bits(MPC_FX_VALUE_BITS + MPC_FX_SECURITY_BITS - m);
+    fe_share(ctx, (r1 << m) | r0, mask);
+    fe_share(ctx, r0, mask_low);
+}
+
+/**
+ * Probabilistic truncation of one sharing with a dealt mask.
+ *
+ * out = (a * mult) / 2^m, rounded down or up at random. a and out hold
+ * the values of the parties in parties[], lambda their Lagrange
+ * coefficients; mask and mask_low are indexed by party id - 1.
+ * a * mult must be below 2^(K-1) in magnitude.
+ */
+static void trunc_pr_masked(const fe_t *a, fe_t mult, unsigned m,
+                            const uint8_t *parties, const fe_t *lambda,
+                            uint8_t num_shares, const fe_t *mask,
+                            const fe_t *mask_low, fe_t *out) {
+    // Open c = a + 2^(K-1) + r
+    fe_t c = 0;
+    for (uint8_t i = 0; i < num_shares; i++) {
+        fe_t masked = fe_add(fe_add(fe_mul(a[i], mult), FX_OFFSET),
+                             mask[parties[i] - 1]);
+        c = fe_add(c, fe_mul(lambda[i], masked));
+    }
+    fe_t c_low = c & ((FE_ONE << m) - 1);
+
+    // (a - c mod 2^m + r0) / 2^m, locally
+    for (uint8_t i = 0; i < num_shares; i++) {
+        fe_t value = fe_add(fe_sub(fe_mul(a[i], mult), c_low),
+                            mask_low[parties[i] - 1]);
+        out[i] = fe_mul_pow2(value, FE_BITS - m);
+    }
+}
+
+/**
+ * Probabilistic truncation of one sharing (one opening round), with a
+ * mask dealt on the spot: out = (in * mult) / 2^shift
+ */
+static int trunc_pr(const mpc_context_t *ctx, const fe_t *in, fe_t mult,
+                    unsigned shift, const uint8_t *parties,
+                    uint8_t num_shares, fe_t *out) {
+    fe_t lambda[SSS_MAX_SHARES];
+    fe_t mask[SSS_MAX_SHARES];
+    fe_t mask_low[SSS_MAX_SHARES];
+
+    if (shift == 0 || shift >= MPC_FX_VALUE_BITS ||
+        num_shares < ctx->threshold ||
+        lagrange_at_zero(parties, num_shares, lambda) != 0) {
+        return -1;
+    }
+
+    deal_mask(ctx, shift, mask, mask_low);
+    trunc_pr_masked(in, mult, shift, parties, lambda, num_shares, mask,
+                    mask_low, out);
+    secure_wipe(mask, sizeof(mask));
+    secure_wipe(mask_low, sizeof(mask_low));
+    return 0;
+}
+
+/**
+ * Truncate one sharing held by shares[] into out[]
+ */
+static int trunc_pr_shares(const mpc_context_t *ctx,
+                           const mpc_fx_share_t *shares, fe_t mult,
+                           unsigned shift, mpc_fx_share_t *out,
+                           uint8_t num_shares) {
+    fe_t in[SSS_MAX_SHARES] = {0};
+    fe_t result[SSS_MAX_SHARES];
+    uint8_t parties[SSS_MAX_SHARES] = {0};
+
+    for (uint8_t i = 0; i < num_shares; i++) {
+        in[i] = share_get(&shares[i]);
+        parties[i] = shares[i].party_id;
+    }
+    int status = trunc_pr(ctx, in, mult, shift, parties, num_shares,
+                          result);
+    if (status == 0) {
+        for (uint8_t i = 0; i < num_shares; i++) {
+            share_set(&out[i], parties[i], &ctx->session_id, result[i]);
+        }
+    }
+    secure_wipe(in, sizeof(in));
+    secure_wipe(result, sizeof(result));
+    return status;
+}
+
+/**
+ * Multiplier and shift that divide by divisor: round(2^m / d) and m
+ */
+static int divisor_scale(uint64_t divisor, fe_t *mult, unsigned *shift) {
+    if (divisor == 0 || divisor > (1ull << 40)) {
+        return -1;
+    }
+    unsigned bits = 0;
+    while (bits < 64 && (divisor >> bits) != 0) {
+        bits++;
+    }
+    *shift = MPC_FX_DIV_SHIFT(bits);
+    *mult = ((FE_ONE << *shift) + divisor / 2) / divisor;
+    return 0;
+}
+
+/**
+ * out = in / (divisor * 2^pre_shift) for large inputs (two rounds).
+ *
+ * A single truncation would need in * 2^m / divisor below 2^(K-1). This
+ * first drops pre_shift + b bits, where 2^(b-1) <= divisor < 2^b, then
+ * multiplies by round(2^(m + b) / divisor) and drops m = 2f bits. The
+ * result is within two units of the last bit; inputs up to 2^(K-1) work
+ * as long as the quotient stays below 2^(K-2-2f).
+ */
+static int divide(const mpc_context_t *ctx, const fe_t *in,
+                  const uint8_t *parties, uint8_t num_shares,
+                  uint64_t divisor, unsigned pre_shift, fe_t *out) {
+    fe_t scaled[SSS_MAX_SHARES];
+
+    if (divisor == 0 || divisor > (1ull << 40)) {
+        return -1;
+    }
+    unsigned bits = 0;
+    while ((divisor >> bits) != 0) {
+        bits++;
+    }
+    unsigned first = pre_shift + bits;
+    unsigned second = 2 * MPC_FX_FRAC_BITS;
+    fe_t mult = ((FE_ONE << (second + bits)) + divisor / 2) / divisor;
+
+    int status = trunc_pr(ctx, in, FE_ONE, first, parties, num_shares,
+                          scaled);
+    if (status == 0) {
+        status = trunc_pr(ctx, scaled, mult, second, parties, num_shares,
+                          out);
+    }
+    secure_wipe(scaled, sizeof(scaled));
+    return status;
+}
+
+/* ========================================================================
+ * Sharing and Reconstruction
+ * ======================================================================== */
+
+int mpc_fx_create_shares(const mpc_context_t *ctx, double value,
+                         mpc_fx_share_t *shares) {
+    fe_t values[SSS_MAX_SHARES];
+    fe_signed_t raw;
+
+    if (ctx == NULL || shares == NULL || encode(value, &raw) != 0) {
+        return -1;
+    }
+
+    fe_share(ctx, fe_from_signed(raw), values);
+    for (uint8_t j = 0; j < ctx->num_parties; j++) {
+        share_set(&shares[j], j + 1, &ctx->session_id, values[j]);
+    }
+    secure_wipe(values, sizeof(values));
+    return 0;
+}
+
+int mpc_fx_reconstruct(const mpc_context_t *ctx,
+                       const mpc_fx_share_t *shares, uint8_t num_shares,
+                       double *value) {
+    fe_t lambda[SSS_MAX_SHARES];
+    uint8_t parties[SSS_MAX_SHARES];
+
+    if (value == NULL || check_shares(ctx, shares, num_shares) != 0 ||
+        num_shares < ctx->threshold) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        parties[i] = shares[i].party_id;
+    }
+    if (lagrange_at_zero(parties, num_shares, lambda) != 0) {
+        return -1;
+    }
+
+    fe_t secret = 0;
+    for (uint8_t i = 0; i < num_shares; i++) {
+        secret = fe_add(secret, fe_mul(lambda[i], share_get(&shares[i])));
+    }
+    *value = (double)fe_to_signed(secret) / FX_SCALE;
+    return 0;
+}
+
+void mpc_fx_wipe_share(mpc_fx_share_t *share) {
+    if (share != NULL) {
+        secure_wipe(share, sizeof(mpc_fx_share_t));
+    }
+}
+
+/* ========================================================================
+ * Arithmetic
+ * ======================================================================== */
+
+int mpc_fx_add(const mpc_context_t *ctx, const mpc_fx_share_t *shares_x,
+               const mpc_fx_share_t *shares_y, mpc_fx_share_t *shares_sum,
+               uint8_t num_shares) {
+    if (shares_sum == NULL ||
+        check_pair(ctx, shares_x, shares_y, num_shares) != 0) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        fe_t sum = fe_add(share_get(&shares_x[i]), share_get(&shares_y[i]));
+        share_set(&shares_sum[i], shares_x[i].party_id, &ctx->session_id,
+                  sum);
+    }
+    return 0;
+}
+
+int mpc_fx_sub(const mpc_context_t *ctx, const mpc_fx_share_t *shares_x,
+               const mpc_fx_share_t *shares_y, mpc_fx_share_t *shares_diff,
+               uint8_t num_shares) {
+    if (shares_diff == NULL ||
+        check_pair(ctx, shares_x, shares_y, num_shares) != 0) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        fe_t diff = fe_sub(share_get(&shares_x[i]), share_get(&shares_y[i]));
+        share_set(&shares_diff[i], shares_x[i].party_id, &ctx->session_id,
+                  diff);
+    }
+    return 0;
+}
+
+/**
+ * Reshare local products (degree 2(t-1)) of the parties of shares_x and
+ * truncate f bits; writes ctx->num_parties shares
+ */
+static int reduce_products(const mpc_context_t *ctx, const fe_t *local,
+                           const mpc_fx_share_t *shares_x,
+                           uint8_t num_shares, mpc_fx_share_t *out) {
+    fe_t reduced[SSS_MAX_SHARES];
+    fe_t result[SSS_MAX_SHARES];
+    uint8_t parties[SSS_MAX_SHARES];
+    uint8_t all[SSS_MAX_SHARES];
+
+    for (uint8_t i = 0; i < num_shares; i++) {
+        parties[i] = shares_x[i].party_id;
+    }
+    for (uint8_t j = 0; j < ctx->num_parties; j++) {
+        all[j] = j + 1;
+    }
+
+    int status = reshare(ctx, local, parties, num_shares, 1, reduced);
+    if (status == 0) {
+        status = trunc_pr(ctx, reduced, FE_ONE, MPC_FX_FRAC_BITS, all,
+                          ctx->num_parties, result);
+    }
+    if (status == 0) {
+        for (uint8_t j = 0; j < ctx->num_parties; j++) {
+            share_set(&out[j], all[j], &ctx->session_id, result[j]);
+        }
+    }
+    secure_wipe(reduced, sizeof(reduced));
+    secure_wipe(result, sizeof(result));
+    return status;
+}
+
+int mpc_fx_mul(const mpc_context_t *ctx, const mpc_fx_share_t *shares_x,
+               const mpc_fx_share_t *shares_y, mpc_fx_share_t *shares_prod,
+               uint8_t num_shares) {
+    fe_t local[SSS_MAX_SHARES];
+
+    if (shares_prod == NULL ||
+        check_pair(ctx, shares_x, shares_y, num_shares) != 0) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        local[i] = fe_mul(share_get(&shares_x[i]), share_get(&shares_y[i]));
+    }
+    int status = reduce_products(ctx, local, shares_x, num_shares,
+                                 shares_prod);
+    secure_wipe(local, sizeof(local));
+    return status;
+}
+
+int mpc_fx_mul_public(const mpc_context_t *ctx,
+                      const mpc_fx_share_t *shares_x, double constant,
+                      mpc_fx_share_t *shares_prod, uint8_t num_shares) {
+    fe_signed_t raw;
+
+    if (shares_prod == NULL || encode(constant, &raw) != 0 ||
+        check_shares(ctx, shares_x, num_shares) != 0) {
+        return -1;
+    }
+    return trunc_pr_shares(ctx, shares_x, fe_from_signed(raw),
+                           MPC_FX_FRAC_BITS, shares_prod, num_shares);
+}
+
+int mpc_fx_div_public(const mpc_context_t *ctx,
+                      const mpc_fx_share_t *shares_x, uint64_t divisor,
+                      mpc_fx_share_t *shares_quot, uint8_t num_shares) {
+    fe_t mult;
+    unsigned shift;
+
+    if (shares_quot == NULL || divisor_scale(divisor, &mult, &shift) != 0 ||
+        check_shares(ctx, shares_x, num_shares) != 0) {
+        return -1;
+    }
+    return trunc_pr_shares(ctx, shares_x, mult, shift, shares_quot,
+                           num_shares);
+}
+
+/* ========================================================================
+ * Batched Truncation and Division
+ * ======================================================================== */
+
+struct mpc_fx_prep {
+    uint8_t num_parties;
+    uint8_t threshold;
+    mpc_session_id_t session_id;
+    unsigned shift;
+    size_t count;
+    size_t used;
+    fe_t *masks;        // count * num_parties shares of r
+    fe_t *masks_low;    // count * num_parties shares of r mod 2^shift
+};
+
+mpc_fx_prep_t *mpc_fx_prep_create(const mpc_context_t *ctx, size_t count,
+                                  unsigned shift) {
+    if (ctx == NULL || ctx->num_parties == 0 || count == 0 ||
+        shift == 0 || shift >= MPC_FX_VALUE_BITS) {
+        return NULL;
+    }
+    size_t per_mask = ctx->num_parties * sizeof(fe_t);
+    if (count > SIZE_MAX / per_mask) {
+        return NULL;
+    }
+
+    mpc_fx_prep_t *prep = calloc(1, sizeof(mpc_fx_prep_t));
+    if (prep == NULL) {
+        return NULL;
+    }
+    prep->masks = malloc(count * per_mask);
+    prep->masks_low = malloc(count * per_mask);
+    if (prep->masks == NULL || prep->masks_low == NULL) {
+        free(prep->masks);
+        free(prep->masks_low);
+        free(prep);
+        return NULL;
+    }
+
+    prep->num_parties = ctx->num_parties;
+    prep->threshold = ctx->threshold;
+    prep->session_id = ctx->session_id;
+    prep->shift = shift;
+    prep->count = count;
+    for (size_t k = 0; k < count; k++) {
+        deal_mask(ctx, shift, &prep->masks[k * ctx->num_parties],
+                  &prep->masks_low[k * ctx->num_parties]);
+    }
+    return prep;
+}
+
+size_t mpc_fx_prep_remaining(const mpc_fx_prep_t *prep) {
+    return (prep != NULL) ? prep->count - prep->used : 0;
+}
+
+void mpc_fx_prep_destroy(mpc_fx_prep_t *prep) {
+    if (prep == NULL) {
+        return;
+    }
+    size_t size = prep->count * prep->num_parties * sizeof(fe_t);
+    secure_wipe(prep->masks, size);
+    secure_wipe(prep->masks_low, size);
+    free(prep->masks);
+    free(prep->masks_low);
+    secure_wipe(prep, sizeof(mpc_fx_prep_t));
+    free(prep);
+}
+
+/**
+ * Check a whole batch before any output is written
+ */
+static int check_batch(const mpc_context_t *ctx, const mpc_fx_prep_t *prep,
+                       const mpc_fx_share_t *const *shares_x,
+                       const uint64_t *divisors,
+                       mpc_fx_share_t *const *shares_out, size_t count,
+                       uint8_t num_shares) {
+    if (ctx == NULL || prep == NULL || shares_x == NULL ||
+        shares_out == NULL || count == 0 ||
+        prep->num_parties != ctx->num_parties ||
+        prep->threshold != ctx->threshold ||
+        !mpc_session_id_equal(&prep->session_id, &ctx->session_id) ||
+        count > prep->count - prep->used || num_shares < ctx->threshold ||
+        check_sets(ctx, shares_x, count, num_shares) != 0) {
+        return -1;
+    }
+
+    // Divisors below 2^(m - f) keep f bits of precision in round(2^m / d)
+    uint64_t limit = (prep->shift - MPC_FX_FRAC_BITS >= 64)
+                         ? UINT64_MAX
+                         : (1ull << (prep->shift - MPC_FX_FRAC_BITS));
+    for (size_t k = 0; k < count; k++) {
+        if (shares_out[k] == NULL) {
+            return -1;
+        }
+        if (divisors != NULL &&
+            (prep->shift <= MPC_FX_FRAC_BITS || divisors[k] == 0 ||
+             divisors[k] >= limit)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Truncate count sharings with masks of the pool (one opening round),
+ * each multiplied by round(2^m / divisors[k]) first if divisors is set
+ */
+static int trunc_batch(const mpc_context_t *ctx, mpc_fx_prep_t *prep,
+                       const mpc_fx_share_t *const *shares_x,
+                       const uint64_t *divisors,
+                       mpc_fx_share_t *const *shares_out, size_t count,
+                       uint8_t num_shares) {
+    fe_t lambda[SSS_MAX_SHARES];
+    fe_t in[SSS_MAX_SHARES];
+    fe_t result[SSS_MAX_SHARES];
+    uint8_t parties[SSS_MAX_SHARES];
+
+    if (check_batch(ctx, prep, shares_x, divisors, shares_out, count,
+                    num_shares) != 0) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        parties[i] = shares_x[0][i].party_id;
+    }
+    if (lagrange_at_zero(parties, num_shares, lambda) != 0) {
+        return -1;
+    }
+
+    unsigned m = prep->shift;
+    for (size_t k = 0; k < count; k++) {
+        fe_t mult = FE_ONE;
+        if (divisors != NULL) {
+            mult = ((FE_ONE << m) + divisors[k] / 2) / divisors[k];
+        }
+        for (uint8_t i = 0; i < num_shares; i++) {
+            in[i] = share_get(&shares_x[k][i]);
+        }
+        size_t mask = (prep->used + k) * prep->num_parties;
+        trunc_pr_masked(in, mult, m, parties, lambda, num_shares,
+                        &prep->masks[mask], &prep->masks_low[mask], result);
+        for (uint8_t i = 0; i < num_shares; i++) {
+            share_set(&shares_out[k][i], parties[i], &ctx->session_id,
+                      result[i]);
+        }
+    }
+
+    // Used masks are gone for good
+    size_t first = prep->used * prep->num_parties;
+    secure_wipe(&prep->masks[first], count * prep->num_parties * sizeof(fe_t));
+    secure_wipe(&prep->masks_low[first],
+                count * prep->num_parties * sizeof(fe_t));
+    prep->used += count;
+
+    secure_wipe(in, sizeof(in));
+    secure_wipe(result, sizeof(result));
+    return 0;
+}
+
+int mpc_fx_trunc_batch(const mpc_context_t *ctx, mpc_fx_prep_t *prep,
+                       const mpc_fx_share_t *const *shares_x,
+                       mpc_fx_share_t *const *shares_out, size_t count,
+                       uint8_t num_shares) {
+    return trunc_batch(ctx, prep, shares_x, NULL, shares_out, count,
+                       num_shares);
+}
+
+int mpc_fx_div_public_batch(const mpc_context_t *ctx, mpc_fx_prep_t *prep,
+                            const mpc_fx_share_t *const *shares_x,
+                            const uint64_t *divisors,
+                            mpc_fx_share_t *const *shares_out, size_t count,
+                            uint8_t num_shares) {
+    if (divisors == NULL) {
+        return -1;
+    }
+    return trunc_batch(ctx, prep, shares_x, divisors, shares_out, count,
+                       num_shares);
+}
+
+/* ========================================================================
+ * Statistics
+ * ======================================================================== */
+
+int mpc_fx_sum(const mpc_context_t *ctx,
+               const mpc_fx_share_t *const *share_sets, size_t num_values,
+               uint8_t num_shares, mpc_fx_share_t *shares_sum) {
+    if (shares_sum == NULL ||
+        check_sets(ctx, share_sets, num_values, num_shares) != 0) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        fe_t sum = 0;
+        for (size_t v = 0; v < num_values; v++) {
+            sum = fe_add(sum, share_get(&share_sets[v][i]));
+        }
+        share_set(&shares_sum[i], share_sets[0][i].party_id,
+                  &ctx->session_id, sum);
+    }
+    return 0;
+}
+
+int mpc_fx_average(const mpc_context_t *ctx,
+                   const mpc_fx_share_t *const *share_sets,
+                   size_t num_values, uint8_t num_shares,
+                   mpc_fx_share_t *shares_avg) {
+    mpc_fx_share_t sum[SSS_MAX_SHARES];
+
+    if (mpc_fx_sum(ctx, share_sets, num_values, num_shares, sum) != 0) {
+        return -1;
+    }
+    int status = mpc_fx_div_public(ctx, sum, num_values, shares_avg,
+                                   num_shares);
+    secure_wipe(sum, sizeof(sum));
+    return status;
+}
+
+int mpc_fx_weighted_mean(const mpc_context_t *ctx,
+                         const mpc_fx_share_t *const *share_sets,
+                         const double *weights, size_t num_values,
+                         uint8_t num_shares, mpc_fx_share_t *shares_mean) {
+    if (weights == NULL || shares_mean == NULL ||
+        check_sets(ctx, share_sets, num_values, num_shares) != 0) {
+        return -1;
+    }
+
+    // Integer weights, the largest scaled to 2^f
+    double largest = 0.0;
+    for (size_t v = 0; v < num_values; v++) {
+        if (!isfinite(weights[v])) {
+            return -1;
+        }
+        double magnitude = weights[v] < 0 ? -weights[v] : weights[v];
+        largest = (magnitude > largest) ? magnitude : largest;
+    }
+    if (largest == 0.0) {
+        return -1;
+    }
+
+    // Sum of x[v] * w[v] locally, divided by the sum of the weights
+    fe_t acc[SSS_MAX_SHARES] = {0};
+    fe_t result[SSS_MAX_SHARES];
+    uint8_t parties[SSS_MAX_SHARES];
+    fe_signed_t total = 0;
+    for (size_t v = 0; v < num_values; v++) {
+        double scaled = weights[v] / largest * FX_SCALE;
+        fe_signed_t w = (fe_signed_t)(scaled + (scaled >= 0 ? 0.5 : -0.5));
+        fe_t weight = fe_from_signed(w);
+        total += w;
+        for (uint8_t i = 0; i < num_shares; i++) {
+            acc[i] = fe_add(acc[i],
+                            fe_mul(share_get(&share_sets[v][i]), weight));
+        }
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        parties[i] = share_sets[0][i].party_id;
+
+        // A negative total flips the sign of the sum instead
+        if (total < 0) {
+            acc[i] = fe_sub(0, acc[i]);
+        }
+    }
+    total = (total < 0) ? -total : total;
+
+    int status = -1;
+    if (total != 0 && total <= ((fe_signed_t)1 << 40)) {
+        status = divide(ctx, acc, parties, num_shares, (uint64_t)total, 0,
+                        result);
+    }
+    if (status == 0) {
+        for (uint8_t i = 0; i < num_shares; i++) {
+            share_set(&shares_mean[i], parties[i], &ctx->session_id,
+                      result[i]);
+        }
+    }
+    secure_wipe(acc, sizeof(acc));
+    secure_wipe(result, sizeof(result));
+    return status;
+}
+
+int mpc_fx_variance(const mpc_context_t *ctx,
+                    const mpc_fx_share_t *const *share_sets,
+                    size_t num_values, uint8_t num_shares,
+                    mpc_fx_share_t *shares_var) {
+    fe_t local[SSS_MAX_SHARES] = {0};
+    fe_t sum_sq[SSS_MAX_SHARES];
+    fe_t result[SSS_MAX_SHARES];
+    uint8_t parties[SSS_MAX_SHARES];
+    uint8_t all[SSS_MAX_SHARES];
+    mpc_fx_share_t sum[SSS_MAX_SHARES];
+    mpc_fx_share_t mean[SSS_MAX_SHARES];
+
+    // Round 1: the mean
+    if (shares_var == NULL ||
+        mpc_fx_sum(ctx, share_sets, num_values, num_shares, sum) != 0 ||
+        mpc_fx_div_public(ctx, sum, num_values, mean, num_shares) != 0) {
+        secure_wipe(sum, sizeof(sum));
+        return -1;
+    }
+
+    // Round 2: the local sums of squared deviations, reshared once.
+    // Deviations keep the sum small and avoid cancellation.
+    for (size_t v = 0; v < num_values; v++) {
+        for (uint8_t i = 0; i < num_shares; i++) {
+            fe_t d = fe_sub(share_get(&share_sets[v][i]), share_get(&mean[i]));
+            local[i] = fe_add(local[i], fe_mul(d, d));
+        }
+    }
+    for (uint8_t i = 0; i < num_shares; i++) {
+        parties[i] = share_sets[0][i].party_id;
+    }
+    for (uint8_t j = 0; j < ctx->num_parties; j++) {
+        all[j] = j + 1;
+    }
+    int status = reshare(ctx, local, parties, num_shares, 1, sum_sq);
+
+    // Rounds 3 and 4: divide by n, and drop the extra f bits of the squares
+    if (status == 0) {
+        status = divide(ctx, sum_sq, all, ctx->num_parties, num_values,
+                        MPC_FX_FRAC_BITS, result);
+    }
+    if (status == 0) {
+        for (uint8_t j = 0; j < ctx->num_parties; j++) {
+            share_set(&shares_var[j], all[j], &ctx->session_id, result[j]);
+        }
+    }
+
+    secure_wipe(local, sizeof(local));
+    secure_wipe(sum_sq, sizeof(sum_sq));
+    secure_wipe(result, sizeof(result));
+    secure_wipe(sum, sizeof(sum));
+    secure_wipe(mean, sizeof(mean));
+    return status;
+}
@@ -0,0 +1,219 @@
+#define _GNU_SOURCE
+#include "core/mem_profile_internal.h"
+
+#ifdef SSS_MEMORY_PROFILE
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Bytes libsodium puts before a secure buffer, inside its pages */
+#define SODIUM_CANARY_SIZE 16
+
+/*
+ * Memory of the operation running on this thread. Only the outermost
+ * operation has a scope; nested operations add to it.
+ */
+typedef struct {
+    unsigned depth;
+    mpc_op_t op;
+    uint64_t allocations;
+    uint64_t secure_allocations;
+    uint64_t bytes_allocated;
+    uint64_t stack_frames;
+    uint64_t heap;                  // Live now
+    uint64_t stack;
+    uint64_t mapped;
+    uint64_t peak_heap;             // Most live so far
+    uint64_t peak_stack;
+    uint64_t peak;
+    uint64_t peak_mapped;
+} mem_scope_t;
+
+typedef struct {
+    _Atomic uint64_t calls;
+    _Atomic uint64_t allocations;
+    _Atomic uint64_t secure_allocations;
+    _Atomic uint64_t bytes_allocated;
+    _Atomic uint64_t stack_frames;
+    _Atomic uint64_t peak_heap_bytes;
+    _Atomic uint64_t peak_stack_bytes;
+    _Atomic uint64_t peak_bytes;
+    _Atomic uint64_t peak_mapped_bytes;
+} op_profile_t;
+
+static _Thread_local mem_scope_t scope;
+static op_profile_t profiles[MPC_OP_COUNT];
+static _Atomic size_t page_size;
+
+/* ========================================================================
+ * Accounting
+ * ======================================================================== */
+
+/**
+ * Bytes sodium_malloc() maps for a buffer of size: the buffer and its
+ * canary rounded up to pages, plus a header page and two guard pages
+ */
+static uint64_t secure_mapped_size(size_t size) {
+    size_t page = atomic_load_explicit(&page_size, memory_order_relaxed);
+    if (page == 0) {
+        long queried = sysconf(_SC_PAGESIZE);
+        page = queried > 0 ? (size_t)queried : 4096;
+        atomic_store_explicit(&page_size, page, memory_order_relaxed);
+    }
+    size_t unprotected = (size + SODIUM_CANARY_SIZE + page - 1) / page * page;
+    return (uint64_t)unprotected + 3 * (uint64_t)page;
+}
+
+static void update_peaks(void) {
+    if (scope.heap > scope.peak_heap) {
+        scope.peak_heap = scope.heap;
+    }
+    if (scope.stack > scope.peak_stack) {
+        scope.peak_stack = scope.stack;
+    }
+    if (scope.heap + scope.stack > scope.peak) {
+        scope.peak = scope.heap + scope.stack;
+    }
+    if (scope.mapped + scope.stack > scope.peak_mapped) {
+        scope.peak_mapped = scope.mapped + scope.stack;
+    }
+}
+
+static void atomic_max(_Atomic uint64_t *target, uint64_t value) {
+    uint64_t current = atomic_load_explicit(target, memory_order_relaxed);
+    while (value > current &&
+           !atomic_compare_exchange_weak_explicit(target, &current, value,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+void mpc_mem_begin(mpc_op_t op) {
+    if (scope.depth++ == 0) {
+        memset(&scope, 0, sizeof(scope));
+        scope.depth = 1;
+        scope.op = op;
+    }
+}
+
+void mpc_mem_end(void) {
+    if (scope.depth == 0 || --scope.depth > 0) {
+        return;
+    }
+
+    op_profile_t *p = &profiles[scope.op];
+    atomic_fetch_add_explicit(&p->calls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&p->allocations, scope.allocations,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&p->secure_allocations,
+                              scope.secure_allocations, memory_order_relaxed);
+    atomic_fetch_add_explicit(&p->bytes_allocated, scope.bytes_allocated,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&p->stack_frames, scope.stack_frames,
+                              memory_order_relaxed);
+    atomic_max(&p->peak_heap_bytes, scope.peak_heap);
+    atomic_max(&p->peak_stack_bytes, scope.peak_stack);
+    atomic_max(&p->peak_bytes, scope.peak);
+    atomic_max(&p->peak_mapped_bytes, scope.peak_mapped);
+}
+
+void mpc_mem_alloc(size_t size, int secure) {
+    if (scope.depth == 0) {
+        return;
+    }
+    scope.allocations++;
+    scope.bytes_allocated += size;
+    scope.heap += size;
+    if (secure) {
+        scope.secure_allocations++;
+        scope.mapped += secure_mapped_size(size);
+    } else {
+        scope.mapped += size;
+    }
+    update_peaks();
+}
+
+void mpc_mem_release(size_t size, int secure) {
+    if (scope.depth == 0) {
+        return;
+    }
+    uint64_t mapped = secure ? secure_mapped_size(size) : size;
+
+    // A buffer allocated before the operation started was never counted
+    scope.heap -= (size <= scope.heap) ? size : scope.heap;
+    scope.mapped -= (mapped <= scope.mapped) ? mapped : scope.mapped;
+}
+
+void mpc_mem_stack(size_t size, int push) {
+    if (scope.depth == 0) {
+        return;
+    }
+    if (push) {
+        scope.stack_frames++;
+        scope.stack += size;
+        update_peaks();
+    } else {
+        scope.stack -= (size <= scope.stack) ? size : scope.stack;
+    }
+}
+
+/* ========================================================================
+ * Reporting
+ * ======================================================================== */
+
+int mpc_mem_profile_enabled(void) {
+    return 1;
+}
+
+int mpc_get_mem_profile(mpc_op_t op, mpc_mem_profile_t *profile) {
+    if (profile == NULL || (unsigned)op >= MPC_OP_COUNT) {
+        return -1;
+    }
+    const op_profile_t *p = &profiles[op];
+    profile->calls = atomic_load(&p->calls);
+    profile->allocations = atomic_load(&p->allocations);
+    profile->secure_allocations = atomic_load(&p->secure_allocations);
+    profile->bytes_allocated = atomic_load(&p->bytes_allocated);
+    profile->stack_frames = atomic_load(&p->stack_frames);
+    profile->peak_heap_bytes = atomic_load(&p->peak_heap_bytes);
+    profile->peak_stack_bytes = atomic_load(&p->peak_stack_bytes);
+    profile->peak_bytes = atomic_load(&p->peak_bytes);
+    profile->peak_mapped_bytes = atomic_load(&p->peak_mapped_bytes);
+    return 0;
+}
+
+void mpc_reset_mem_profile(void) {
+    for (int op = 0; op < MPC_OP_COUNT; op++) {
+        op_profile_t *p = &profiles[op];
+        atomic_store(&p->calls, 0);
+        atomic_store(&p->allocations, 0);
+        atomic_store(&p->secure_allocations, 0);
+        atomic_store(&p->bytes_allocated, 0);
+        atomic_store(&p->stack_frames, 0);
+        atomic_store(&p->peak_heap_bytes, 0);
+        atomic_store(&p->peak_stack_bytes, 0);
+        atomic_store(&p->peak_bytes, 0);
+        atomic_store(&p->peak_mapped_bytes, 0);
+    }
+}
+
+#else
+
+/* ========================================================================
+ * Profiling Not Built In
+ * ======================================================================== */
+
+int mpc_mem_profile_enabled(void) {
+    return 0;
+}
+
+int mpc_get_mem_profile(mpc_op_t op, mpc_mem_profile_t *profile) {
+    (void)op;
+    (void)profile;
+    return -1;
+}
+
+void mpc_reset_mem_profile(void) {
+}
+
+#endif
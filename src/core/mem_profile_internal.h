@@ -0,0 +1,75 @@
+#ifndef SSS_CORE_MEM_PROFILE_INTERNAL_H
+#define SSS_CORE_MEM_PROFILE_INTERNAL_H
+
+#include "sss/mem_profile.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Memory Profiling Hooks
+ *
+ * MPC_MEM_BEGIN and MPC_MEM_END bracket a public operation; hooks
+ * outside any operation record nothing. Heap buffers are accounted by
+ * size, so every allocation must be released with the size it was
+ * allocated with. Stack arrays are pushed where they are declared and
+ * popped before they go out of scope. Without SSS_MEMORY_PROFILE the
+ * hooks compile to nothing.
+ * ======================================================================== */
+
+#ifdef SSS_MEMORY_PROFILE
+
+void mpc_mem_begin(mpc_op_t op);
+void mpc_mem_end(void);
+void mpc_mem_alloc(size_t size, int secure);
+void mpc_mem_release(size_t size, int secure);
+void mpc_mem_stack(size_t size, int push);
+
+#define MPC_MEM_BEGIN(op) mpc_mem_begin(op)
+#define MPC_MEM_END() mpc_mem_end()
+#define MPC_MEM_ALLOC(size, secure) mpc_mem_alloc((size), (secure))
+#define MPC_MEM_RELEASE(size, secure) mpc_mem_release((size), (secure))
+#define MPC_MEM_STACK_PUSH(size) mpc_mem_stack((size), 1)
+#define MPC_MEM_STACK_POP(size) mpc_mem_stack((size), 0)
+
+#else
+
+#define MPC_MEM_BEGIN(op) ((void)0)
+#define MPC_MEM_END() ((void)0)
+#define MPC_MEM_ALLOC(size, secure) ((void)0)
+#define MPC_MEM_RELEASE(size, secure) ((void)0)
+#define MPC_MEM_STACK_PUSH(size) ((void)0)
+#define MPC_MEM_STACK_POP(size) ((void)0)
+
+#endif
+
+/**
+ * malloc(), accounted to the running operation
+ */
+static inline void *mpc_mem_malloc(size_t size) {
+    void *ptr = malloc(size);
+    if (ptr != NULL) {
+        MPC_MEM_ALLOC(size, 0);
+    }
+    return ptr;
+}
+
+/**
+ * free() of a buffer from mpc_mem_malloc(size)
+ */
+static inline void mpc_mem_free(void *ptr, size_t size) {
+    (void)size;
+    if (ptr != NULL) {
+        MPC_MEM_RELEASE(size, 0);
+    }
+    free(ptr);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_CORE_MEM_PROFILE_INTERNAL_H */
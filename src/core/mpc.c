@@ -4,8 +4,12 @@
 #include "utils/secure_memory.h"
 #include "utils/error.h"
 #include "utils/random.h"
+#include "core/mpc_mul_internal.h"
+#include "core/mpc_stats_internal.h"
+#include "core/trace_internal.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 /* ========================================================================
  * Context Management Functions
@@ -18,6 +22,9 @@ int mpc_init_context(mpc_context_t *ctx, uint8_t num_parties,
         return -1;
     }
     
+    // Start from a clean context, so cleanup after a failure is safe
+    memset(ctx, 0, sizeof(mpc_context_t));
+    
     if (num_parties < 2 || num_parties > 255) {
         return -1;
     }
@@ -35,8 +42,10 @@ int mpc_init_context(mpc_context_t *ctx, uint8_t num_parties,
     ctx->threshold = threshold;
     ctx->value_size = value_size;
     
-    // Generate a random computation ID
-    ctx->computation_id = sss_random_byte();
+    // Generate a random session ID
+    if (mpc_session_id_random(&ctx->session_id) != 0) {
+        return -1;
+    }
     
     return 0;
 }
@@ -46,34 +55,104 @@ void mpc_cleanup_context(mpc_context_t *ctx) {
         return;
     }
     
-    // Wipe sensitive data using secure_wipe()
+    // Drop this context's reference to the counters, then wipe sensitive
+    // data using secure_wipe()
+    mpc_counters_release(ctx->counters);
     secure_wipe(ctx, sizeof(mpc_context_t));
 }
 
+int mpc_copy_context(mpc_context_t *dst, const mpc_context_t *src) {
+    if (dst == NULL || src == NULL) {
+        return -1;
+    }
+    
+    memmove(dst, src, sizeof(mpc_context_t));
+    mpc_counters_retain(dst->counters);
+    return 0;
+}
+
+/* ========================================================================
+ * Session Identifier Functions
+ * ======================================================================== */
+
+int mpc_session_id_random(mpc_session_id_t *id) {
+    if (id == NULL) {
+        return -1;
+    }
+    
+    return sss_random_bytes(id->bytes, MPC_SESSION_ID_SIZE) == 0 ? 0 : -1;
+}
+
+void mpc_session_id_derive(const mpc_session_id_t *base, uint64_t index,
+                           mpc_session_id_t *id) {
+    if (base == NULL || id == NULL) {
+        return;
+    }
+    
+    *id = *base;
+    for (int i = 0; i < 8; i++) {
+        id->bytes[MPC_SESSION_ID_SIZE - 8 + i] ^= (uint8_t)(index >> (8 * i));
+    }
+}
+
+int mpc_session_id_equal(const mpc_session_id_t *a, const mpc_session_id_t *b) {
+    if (a == NULL || b == NULL) {
+        return 0;
+    }
+    
+    return memcmp(a->bytes, b->bytes, MPC_SESSION_ID_SIZE) == 0;
+}
+
+void mpc_session_id_to_hex(const mpc_session_id_t *id, char *out) {
+    static const char digits[] = "0123456789abcdef";
+    
+    if (id == NULL || out == NULL) {
+        return;
+    }
+    
+    for (int i = 0; i < MPC_SESSION_ID_SIZE; i++) {
+        out[2 * i] = digits[id->bytes[i] >> 4];
+        out[2 * i + 1] = digits[id->bytes[i] & 0x0F];
+    }
+    out[2 * MPC_SESSION_ID_SIZE] = '\0';
+}
+
+int mpc_context_set_session(mpc_context_t *ctx, const mpc_session_id_t *id) {
+    if (ctx == NULL || id == NULL) {
+        return -1;
+    }
+    
+    ctx->session_id = *id;
+    return 0;
+}
+
 /* ========================================================================
  * Share Distribution Functions
  * ======================================================================== */
 
-int mpc_create_shares(const mpc_context_t *ctx, const uint8_t *secret,
-                      mpc_share_t *shares) {
+static int create_shares(const mpc_context_t *ctx, const uint8_t *secret,
+                         mpc_share_t *shares) {
     // Validate inputs
     if (ctx == NULL || secret == NULL || shares == NULL) {
         return -1;
     }
     
     // Create temporary array for SSS shares
-    sss_share_t *sss_shares = (sss_share_t *)malloc(ctx->num_parties * sizeof(sss_share_t));
+    sss_share_t *sss_shares =
+        (sss_share_t *)mpc_mem_malloc(ctx->num_parties * sizeof(sss_share_t));
     if (sss_shares == NULL) {
         return -1;
     }
     
     // Use SSS to create shares
+    MPC_TRACE_BEGIN(ctx, "compute", 0, mpc_trace_share_bytes(ctx, 1));
     int result = sss_create_shares(secret, ctx->value_size,
                                    ctx->threshold, ctx->num_parties,
                                    sss_shares);
+    MPC_TRACE_END(ctx, "compute", 0, mpc_trace_share_bytes(ctx, 1));
     if (result != SSS_OK) {
         secure_wipe(sss_shares, ctx->num_parties * sizeof(sss_share_t));
-        free(sss_shares);
+        mpc_mem_free(sss_shares, ctx->num_parties * sizeof(sss_share_t));
         return -1;
     }
     
@@ -81,17 +160,36 @@ int mpc_create_shares(const mpc_context_t *ctx, const uint8_t *secret,
     for (uint8_t i = 0; i < ctx->num_parties; i++) {
         shares[i].share = sss_shares[i];
         shares[i].party_id = i + 1;  // Party IDs are 1-based
-        shares[i].computation_id = ctx->computation_id;
+        shares[i].session_id = ctx->session_id;
     }
     
     // Clean up
+    MPC_TRACE_BEGIN(ctx, "wipe", 0, ctx->num_parties * sizeof(sss_share_t));
     secure_wipe(sss_shares, ctx->num_parties * sizeof(sss_share_t));
-    free(sss_shares);
+    mpc_mem_free(sss_shares, ctx->num_parties * sizeof(sss_share_t));
+    MPC_TRACE_END(ctx, "wipe", 0, ctx->num_parties * sizeof(sss_share_t));
     return 0;
 }
 
-int mpc_reconstruct(const mpc_context_t *ctx, const mpc_share_t *shares,
-                    uint8_t num_shares, uint8_t *reconstructed) {
+int mpc_create_shares(const mpc_context_t *ctx, const uint8_t *secret,
+                      mpc_share_t *shares) {
+    MPC_TRACE_BEGIN(ctx, "mpc_create_shares", 0,
+                    mpc_trace_share_bytes(ctx, 1));
+    MPC_MEM_BEGIN(MPC_OP_CREATE_SHARES);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = create_shares(ctx, secret, shares);
+    if (result == 0) {
+        mpc_stats_add(ctx, MPC_COUNTER_VALUES_SHARED, 1);
+    }
+    mpc_stats_end(ctx, MPC_OP_CREATE_SHARES, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_create_shares", 0,
+                  mpc_trace_share_bytes(ctx, 1));
+    return result;
+}
+
+static int reconstruct(const mpc_context_t *ctx, const mpc_share_t *shares,
+                       uint8_t num_shares, uint8_t *reconstructed) {
     // Validate inputs
     if (ctx == NULL || shares == NULL || reconstructed == NULL) {
         return -1;
@@ -102,33 +200,65 @@ int mpc_reconstruct(const mpc_context_t *ctx, const mpc_share_t *shares,
     }
     
     // Extract SSS shares from MPC shares
-    sss_share_t *sss_shares = (sss_share_t *)malloc(num_shares * sizeof(sss_share_t));
+    sss_share_t *sss_shares =
+        (sss_share_t *)mpc_mem_malloc(num_shares * sizeof(sss_share_t));
     if (sss_shares == NULL) {
         return -1;
     }
     
+    MPC_TRACE_BEGIN(ctx, "validate", 0,
+                    mpc_trace_share_bytes(ctx, num_shares));
+    int valid = 1;
     for (uint8_t i = 0; i < num_shares; i++) {
         // Validate each share
         if (mpc_validate_share(ctx, &shares[i]) != 0) {
-            secure_wipe(sss_shares, num_shares * sizeof(sss_share_t));
-            free(sss_shares);
-            return -1;
+            valid = 0;
+            break;
         }
         sss_shares[i] = shares[i].share;
     }
+    MPC_TRACE_END(ctx, "validate", 0, mpc_trace_share_bytes(ctx, num_shares));
+    if (!valid) {
+        secure_wipe(sss_shares, num_shares * sizeof(sss_share_t));
+        mpc_mem_free(sss_shares, num_shares * sizeof(sss_share_t));
+        return -1;
+    }
     
     // Use SSS to reconstruct
+    MPC_TRACE_BEGIN(ctx, "reconstruct", 0,
+                    mpc_trace_share_bytes(ctx, num_shares));
     size_t reconstructed_len = ctx->value_size;
     int result = sss_combine_shares(sss_shares, num_shares,
                                     reconstructed, &reconstructed_len);
+    MPC_TRACE_END(ctx, "reconstruct", 0,
+                  mpc_trace_share_bytes(ctx, num_shares));
     
     // Clean up
+    MPC_TRACE_BEGIN(ctx, "wipe", 0, num_shares * sizeof(sss_share_t));
     secure_wipe(sss_shares, num_shares * sizeof(sss_share_t));
-    free(sss_shares);
+    mpc_mem_free(sss_shares, num_shares * sizeof(sss_share_t));
+    MPC_TRACE_END(ctx, "wipe", 0, num_shares * sizeof(sss_share_t));
     
     return (result == SSS_OK) ? 0 : -1;
 }
 
+int mpc_reconstruct(const mpc_context_t *ctx, const mpc_share_t *shares,
+                    uint8_t num_shares, uint8_t *reconstructed) {
+    MPC_TRACE_BEGIN(ctx, "mpc_reconstruct", 0,
+                    mpc_trace_share_bytes(ctx, num_shares));
+    MPC_MEM_BEGIN(MPC_OP_RECONSTRUCT);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = reconstruct(ctx, shares, num_shares, reconstructed);
+    if (result == 0) {
+        mpc_stats_add(ctx, MPC_COUNTER_RECONSTRUCTIONS, 1);
+    }
+    mpc_stats_end(ctx, MPC_OP_RECONSTRUCT, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_reconstruct", 0,
+                  mpc_trace_share_bytes(ctx, num_shares));
+    return result;
+}
+
 /* ========================================================================
  * Utility Functions
  * ======================================================================== */
@@ -145,7 +275,7 @@ void mpc_wipe_share(mpc_share_t *share) {
     secure_wipe(share, sizeof(mpc_share_t));
 }
 
-int mpc_validate_share(const mpc_context_t *ctx, const mpc_share_t *share) {
+static int validate_share(const mpc_context_t *ctx, const mpc_share_t *share) {
     if (ctx == NULL || share == NULL) {
         return -1;
     }
@@ -155,8 +285,8 @@ int mpc_validate_share(const mpc_context_t *ctx, const mpc_share_t *share) {
         return -1;
     }
     
-    // Check computation_id matches
-    if (share->computation_id != ctx->computation_id) {
+    // Check session_id matches
+    if (!mpc_session_id_equal(&share->session_id, &ctx->session_id)) {
         return -1;
     }
     
@@ -168,13 +298,21 @@ int mpc_validate_share(const mpc_context_t *ctx, const mpc_share_t *share) {
     return 0;
 }
 
+int mpc_validate_share(const mpc_context_t *ctx, const mpc_share_t *share) {
+    if (validate_share(ctx, share) != 0) {
+        mpc_stats_add(ctx, MPC_COUNTER_VALIDATION_FAILURES, 1);
+        return -1;
+    }
+    return 0;
+}
+
 /* ========================================================================
  * Secure Arithmetic Operations
  * ======================================================================== */
 
-int mpc_secure_add(const mpc_context_t *ctx, const mpc_share_t *shares_x,
-                   const mpc_share_t *shares_y, mpc_share_t *shares_sum,
-                   uint8_t num_shares) {
+static int add_shares(const mpc_context_t *ctx, const mpc_share_t *shares_x,
+                      const mpc_share_t *shares_y, mpc_share_t *shares_sum,
+                      uint8_t num_shares) {
     // Validate inputs
     if (ctx == NULL || shares_x == NULL || shares_y == NULL || 
         shares_sum == NULL) {
@@ -207,7 +345,7 @@ int mpc_secure_add(const mpc_context_t *ctx, const mpc_share_t *shares_x,
         
         // Initialize output share
         shares_sum[i].party_id = shares_x[i].party_id;
-        shares_sum[i].computation_id = ctx->computation_id;
+        shares_sum[i].session_id = ctx->session_id;
         shares_sum[i].share.index = shares_x[i].share.index;
         shares_sum[i].share.data_len = shares_x[i].share.data_len;
         shares_sum[i].share.threshold = shares_x[i].share.threshold;
@@ -224,9 +362,24 @@ int mpc_secure_add(const mpc_context_t *ctx, const mpc_share_t *shares_x,
     return 0;
 }
 
-int mpc_secure_sub(const mpc_context_t *ctx, const mpc_share_t *shares_x,
-                   const mpc_share_t *shares_y, mpc_share_t *shares_diff,
+int mpc_secure_add(const mpc_context_t *ctx, const mpc_share_t *shares_x,
+                   const mpc_share_t *shares_y, mpc_share_t *shares_sum,
                    uint8_t num_shares) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_add", 0,
+                    mpc_trace_share_bytes(ctx, 2 * (size_t)num_shares));
+    MPC_MEM_BEGIN(MPC_OP_ADD);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = add_shares(ctx, shares_x, shares_y, shares_sum, num_shares);
+    mpc_stats_end(ctx, MPC_OP_ADD, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_add", 0,
+                  mpc_trace_share_bytes(ctx, 2 * (size_t)num_shares));
+    return result;
+}
+
+static int sub_shares(const mpc_context_t *ctx, const mpc_share_t *shares_x,
+                      const mpc_share_t *shares_y, mpc_share_t *shares_diff,
+                      uint8_t num_shares) {
     // Validate inputs
     if (ctx == NULL || shares_x == NULL || shares_y == NULL || 
         shares_diff == NULL) {
@@ -259,7 +412,7 @@ int mpc_secure_sub(const mpc_context_t *ctx, const mpc_share_t *shares_x,
         
         // Initialize output share
         shares_diff[i].party_id = shares_x[i].party_id;
-        shares_diff[i].computation_id = ctx->computation_id;
+        shares_diff[i].session_id = ctx->session_id;
         shares_diff[i].share.index = shares_x[i].share.index;
         shares_diff[i].share.data_len = shares_x[i].share.data_len;
         shares_diff[i].share.threshold = shares_x[i].share.threshold;
@@ -276,9 +429,24 @@ int mpc_secure_sub(const mpc_context_t *ctx, const mpc_share_t *shares_x,
     return 0;
 }
 
-int mpc_secure_mul_const(const mpc_context_t *ctx, const mpc_share_t *shares_x,
-                         uint8_t constant, mpc_share_t *shares_prod,
-                         uint8_t num_shares) {
+int mpc_secure_sub(const mpc_context_t *ctx, const mpc_share_t *shares_x,
+                   const mpc_share_t *shares_y, mpc_share_t *shares_diff,
+                   uint8_t num_shares) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_sub", 0,
+                    mpc_trace_share_bytes(ctx, 2 * (size_t)num_shares));
+    MPC_MEM_BEGIN(MPC_OP_SUB);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = sub_shares(ctx, shares_x, shares_y, shares_diff, num_shares);
+    mpc_stats_end(ctx, MPC_OP_SUB, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_sub", 0,
+                  mpc_trace_share_bytes(ctx, 2 * (size_t)num_shares));
+    return result;
+}
+
+static int mul_const_shares(const mpc_context_t *ctx,
+                            const mpc_share_t *shares_x, uint8_t constant,
+                            mpc_share_t *shares_prod, uint8_t num_shares) {
     // Validate inputs
     if (ctx == NULL || shares_x == NULL || shares_prod == NULL) {
         return -1;
@@ -297,7 +465,7 @@ int mpc_secure_mul_const(const mpc_context_t *ctx, const mpc_share_t *shares_x,
         
         // Initialize output share
         shares_prod[i].party_id = shares_x[i].party_id;
-        shares_prod[i].computation_id = ctx->computation_id;
+        shares_prod[i].session_id = ctx->session_id;
         shares_prod[i].share.index = shares_x[i].share.index;
         shares_prod[i].share.data_len = shares_x[i].share.data_len;
         shares_prod[i].share.threshold = shares_x[i].share.threshold;
@@ -314,15 +482,37 @@ int mpc_secure_mul_const(const mpc_context_t *ctx, const mpc_share_t *shares_x,
     return 0;
 }
 
+int mpc_secure_mul_const(const mpc_context_t *ctx, const mpc_share_t *shares_x,
+                         uint8_t constant, mpc_share_t *shares_prod,
+                         uint8_t num_shares) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_mul_const", 0,
+                    mpc_trace_share_bytes(ctx, num_shares));
+    MPC_MEM_BEGIN(MPC_OP_MUL_CONST);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = mul_const_shares(ctx, shares_x, constant, shares_prod,
+                                  num_shares);
+    mpc_stats_end(ctx, MPC_OP_MUL_CONST, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_mul_const", 0,
+                  mpc_trace_share_bytes(ctx, num_shares));
+    return result;
+}
+
 int mpc_secure_mul(const mpc_context_t *ctx, const mpc_share_t *shares_x,
                    const mpc_share_t *shares_y, mpc_share_t *shares_prod,
                    uint8_t num_shares) {
-    // ====================================================================
-    // Step 1: Validate all inputs
-    // ====================================================================
-    
-    if (ctx == NULL || shares_x == NULL || shares_y == NULL || 
-        shares_prod == NULL) {
+    // A single multiplication is a batch of one
+    return mpc_secure_mul_batch(ctx, &shares_x, &shares_y, &shares_prod,
+                                1, num_shares);
+}
+
+static int validate_batch(const mpc_context_t *ctx,
+                          const mpc_share_t *const *shares_x,
+                          const mpc_share_t *const *shares_y,
+                          mpc_share_t *const *shares_prod,
+                          size_t count,
+                          uint8_t num_shares) {
+    if (count == 0) {
         return -1;
     }
     
@@ -331,126 +521,506 @@ int mpc_secure_mul(const mpc_context_t *ctx, const mpc_share_t *shares_x,
     }
     
     // Validate all input shares
-    for (uint8_t i = 0; i < num_shares; i++) {
-        if (mpc_validate_share(ctx, &shares_x[i]) != 0) {
-            return -1;
-        }
-        if (mpc_validate_share(ctx, &shares_y[i]) != 0) {
+    for (size_t k = 0; k < count; k++) {
+        if (shares_x[k] == NULL || shares_y[k] == NULL ||
+            shares_prod[k] == NULL) {
             return -1;
         }
         
-        // Ensure party IDs match
-        if (shares_x[i].party_id != shares_y[i].party_id) {
-            return -1;
+        for (uint8_t i = 0; i < num_shares; i++) {
+            if (mpc_validate_share(ctx, &shares_x[k][i]) != 0) {
+                return -1;
+            }
+            if (mpc_validate_share(ctx, &shares_y[k][i]) != 0) {
+                return -1;
+            }
+            
+            // Ensure party IDs match
+            if (shares_x[k][i].party_id != shares_y[k][i].party_id) {
+                return -1;
+            }
+            
+            // Ensure data lengths match
+            if (shares_x[k][i].share.data_len != shares_y[k][i].share.data_len) {
+                return -1;
+            }
         }
+    }
+    
+    return 0;
+}
+
+/**
+ * Each party multiplies its shares of x and y element-wise, giving shares
+ * of a degree-2 polynomial in intermediate[k * num_shares]
+ */
+static void local_products(const mpc_context_t *ctx,
+                           const mpc_share_t *const *shares_x,
+                           const mpc_share_t *const *shares_y,
+                           size_t count,
+                           uint8_t num_shares,
+                           mpc_share_t *intermediate) {
+    size_t data_len = ctx->value_size;
+    
+    for (size_t k = 0; k < count; k++) {
+        mpc_share_t *local = &intermediate[k * num_shares];
         
-        // Ensure data lengths match
-        if (shares_x[i].share.data_len != shares_y[i].share.data_len) {
-            return -1;
+        for (uint8_t i = 0; i < num_shares; i++) {
+            // Copy metadata
+            local[i].party_id = shares_x[k][i].party_id;
+            local[i].session_id = ctx->session_id;
+            local[i].share.index = shares_x[k][i].share.index;
+            local[i].share.data_len = data_len;
+            local[i].share.threshold = ctx->threshold;
+            
+            // Multiply each byte in GF(256)
+            // This is the LOCAL computation each party does
+            for (size_t j = 0; j < data_len; j++) {
+                local[i].share.data[j] = gf256_mul(
+                    shares_x[k][i].share.data[j],
+                    shares_y[k][i].share.data[j]
+                );
+            }
         }
     }
+}
+
+/**
+ * Reconstruct every degree-2 product of a batch (the interactive step)
+ */
+static int open_products(const mpc_context_t *ctx,
+                         const mpc_share_t *intermediate,
+                         size_t count,
+                         uint8_t num_shares,
+                         uint8_t *products) {
+    int result = 0;
+    for (size_t k = 0; k < count && result == 0; k++) {
+        result = mpc_reconstruct(ctx, &intermediate[k * num_shares],
+                                 num_shares, &products[k * ctx->value_size]);
+    }
+    return result;
+}
+
+/**
+ * Share every opened product again as a degree-1 polynomial
+ */
+static int reshare_products(const mpc_context_t *ctx, const uint8_t *products,
+                            mpc_share_t *const *shares_prod, size_t count) {
+    int result = 0;
+    for (size_t k = 0; k < count && result == 0; k++) {
+        result = mpc_create_shares(ctx, &products[k * ctx->value_size],
+                                   shares_prod[k]);
+    }
+    return result;
+}
+
+int mpc_mul_local_products(const mpc_context_t *ctx,
+                           const mpc_share_t *const *shares_x,
+                           const mpc_share_t *const *shares_y,
+                           mpc_share_t *const *shares_prod,
+                           size_t count,
+                           uint8_t num_shares,
+                           mpc_share_t *intermediate) {
+    if (ctx == NULL || shares_x == NULL || shares_y == NULL ||
+        shares_prod == NULL || intermediate == NULL ||
+        validate_batch(ctx, shares_x, shares_y, shares_prod, count,
+                       num_shares) != 0) {
+        return -1;
+    }
+    
+    local_products(ctx, shares_x, shares_y, count, num_shares, intermediate);
+    return 0;
+}
+
+int mpc_mul_open_products(const mpc_context_t *ctx,
+                          const mpc_share_t *intermediate,
+                          size_t count,
+                          uint8_t num_shares,
+                          uint8_t *products) {
+    if (ctx == NULL || intermediate == NULL || products == NULL) {
+        return -1;
+    }
+    
+    return open_products(ctx, intermediate, count, num_shares, products);
+}
+
+int mpc_mul_reshare_products(const mpc_context_t *ctx,
+                             const uint8_t *products,
+                             mpc_share_t *const *shares_prod,
+                             size_t count) {
+    if (ctx == NULL || products == NULL || shares_prod == NULL) {
+        return -1;
+    }
+    
+    return reshare_products(ctx, products, shares_prod, count);
+}
+
+static int mul_batch(const mpc_context_t *ctx,
+                     const mpc_share_t *const *shares_x,
+                     const mpc_share_t *const *shares_y,
+                     mpc_share_t *const *shares_prod,
+                     size_t count,
+                     uint8_t num_shares) {
+    // ====================================================================
+    // Step 1: Validate all inputs
+    // ====================================================================
+    
+    if (ctx == NULL || shares_x == NULL || shares_y == NULL || 
+        shares_prod == NULL) {
+        return -1;
+    }
+    
+    MPC_TRACE_BEGIN(ctx, "validate", 0,
+                    mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    int valid = validate_batch(ctx, shares_x, shares_y, shares_prod, count,
+                               num_shares);
+    MPC_TRACE_END(ctx, "validate", 0,
+                  mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    if (valid != 0) {
+        return -1;
+    }
     
-    size_t data_len = shares_x[0].share.data_len;
+    size_t data_len = ctx->value_size;
+    size_t intermediate_size = count * num_shares * sizeof(mpc_share_t);
+    size_t product_size = count * data_len;
     
     // ====================================================================
     // Step 2: Local multiplication - each party multiplies their shares
     // ====================================================================
     
     // Allocate secure memory for intermediate shares
-    mpc_share_t *intermediate = secure_malloc(num_shares * sizeof(mpc_share_t));
+    mpc_share_t *intermediate = mpc_secure_alloc(ctx, intermediate_size);
     if (intermediate == NULL) {
         return -1;
     }
     
     // Lock the intermediate memory
-    secure_lock(intermediate, num_shares * sizeof(mpc_share_t));
+    secure_lock(intermediate, intermediate_size);
     
-    // Each party multiplies their shares element-wise in GF(256)
-    for (uint8_t i = 0; i < num_shares; i++) {
-        // Copy metadata
-        intermediate[i].party_id = shares_x[i].party_id;
-        intermediate[i].computation_id = ctx->computation_id;
-        intermediate[i].share.index = shares_x[i].share.index;
-        intermediate[i].share.data_len = data_len;
-        intermediate[i].share.threshold = ctx->threshold;
-        
-        // Multiply each byte in GF(256)
-        // This is the LOCAL computation each party does
-        for (size_t j = 0; j < data_len; j++) {
-            intermediate[i].share.data[j] = gf256_mul(
-                shares_x[i].share.data[j],
-                shares_y[i].share.data[j]
-            );
-        }
-    }
+    // Each party multiplies their shares element-wise in GF(256).
+    // All products of the batch are formed before any output is written,
+    // so shares_prod may alias shares_x or shares_y.
+    MPC_TRACE_BEGIN(ctx, "compute", 0,
+                    mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    local_products(ctx, shares_x, shares_y, count, num_shares, intermediate);
+    MPC_TRACE_END(ctx, "compute", 0,
+                  mpc_trace_share_bytes(ctx, 2 * count * num_shares));
     
     // Note: At this point, intermediate shares represent points on a
     // degree-2 polynomial (because we multiplied two degree-1 polynomials).
     // We need degree reduction!
     
     // ====================================================================
-    // Step 3: Reconstruct the product
+    // Step 3: Reconstruct the products (one interactive step per batch)
     // ====================================================================
     
-    // Allocate secure memory for the product
-    uint8_t *product = secure_malloc(data_len);
+    // Allocate secure memory for the products
+    uint8_t *product = mpc_secure_alloc(ctx, product_size);
     if (product == NULL) {
-        secure_unlock(intermediate, num_shares * sizeof(mpc_share_t));
-        secure_free(intermediate, num_shares * sizeof(mpc_share_t));
+        secure_unlock(intermediate, intermediate_size);
+        mpc_secure_release(intermediate, intermediate_size);
         return -1;
     }
-    secure_lock(product, data_len);
+    secure_lock(product, product_size);
     
     // Reconstruct using the intermediate shares
     // Note: In production MPC, this step would use Beaver triples
     // to avoid reconstructing the intermediate value.
     // Our simplified version reconstructs here for educational purposes.
-    int recon_result = mpc_reconstruct(ctx, intermediate, num_shares, product);
-    
-    if (recon_result != 0) {
-        // Reconstruction failed - cleanup and return error
-        secure_unlock(product, data_len);
-        secure_free(product, data_len);
-        secure_unlock(intermediate, num_shares * sizeof(mpc_share_t));
-        secure_free(intermediate, num_shares * sizeof(mpc_share_t));
-        return -1;
-    }
+    // Every product in the batch is opened in the same step, so a batch
+    // costs one communication round regardless of its size.
+    MPC_TRACE_BEGIN(ctx, "reconstruct", 0,
+                    mpc_trace_share_bytes(ctx, count * num_shares));
+    int result = open_products(ctx, intermediate, count, num_shares, product);
+    MPC_TRACE_END(ctx, "reconstruct", 0,
+                  mpc_trace_share_bytes(ctx, count * num_shares));
     
     // ====================================================================
-    // Step 4: Reshare the product (Degree Reduction)
+    // Step 4: Reshare the products (Degree Reduction)
     // ====================================================================
     
-    // Create new shares of the product as a degree-1 polynomial
+    // Create new shares of each product as a degree-1 polynomial
     // This is the "degree reduction" step!
-    int reshare_result = mpc_create_shares(ctx, product, shares_prod);
+    MPC_TRACE_BEGIN(ctx, "reshare", 0, product_size);
+    if (result == 0) {
+        result = reshare_products(ctx, product, shares_prod, count);
+    }
+    MPC_TRACE_END(ctx, "reshare", 0, product_size);
     
     // ====================================================================
     // Step 5: Secure cleanup
     // ====================================================================
     
     // Wipe and free intermediate shares
+    MPC_TRACE_BEGIN(ctx, "wipe", 0, intermediate_size + product_size);
+    secure_wipe(intermediate, intermediate_size);
+    secure_unlock(intermediate, intermediate_size);
+    mpc_secure_release(intermediate, intermediate_size);
+    
+    // Wipe and free products
+    secure_unlock(product, product_size);
+    mpc_secure_release(product, product_size);
+    MPC_TRACE_END(ctx, "wipe", 0, intermediate_size + product_size);
+    
+    return (result == 0) ? 0 : -1;
+}
+
+int mpc_secure_mul_batch(const mpc_context_t *ctx,
+                         const mpc_share_t *const *shares_x,
+                         const mpc_share_t *const *shares_y,
+                         mpc_share_t *const *shares_prod,
+                         size_t count,
+                         uint8_t num_shares) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_mul_batch", 0,
+                    mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    MPC_MEM_BEGIN(MPC_OP_MUL);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = mul_batch(ctx, shares_x, shares_y, shares_prod, count,
+                           num_shares);
+    if (result == 0) {
+        mpc_stats_add(ctx, MPC_COUNTER_MULTIPLICATIONS, count);
+        mpc_stats_add(ctx, MPC_COUNTER_RESHARES, count);
+    }
+    mpc_stats_end(ctx, MPC_OP_MUL, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_mul_batch", 0,
+                  mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    return result;
+}
+
+static int validate_matmul(const mpc_context_t *ctx,
+                           const mpc_share_t *const *shares_a,
+                           const mpc_share_t *const *shares_b,
+                           mpc_share_t *const *shares_c,
+                           size_t rows, size_t inner, size_t cols,
+                           uint8_t num_shares) {
+    if (rows == 0 || inner == 0 || cols == 0) {
+        return -1;
+    }
+    
+    if (num_shares == 0 || num_shares < ctx->threshold) {
+        return -1;  // Need at least threshold shares
+    }
+    
+    // Keep the share arrays and the buffers of matmul() addressable
+    size_t limit = SIZE_MAX / 4 / (num_shares * sizeof(mpc_share_t));
+    if (rows > limit / inner || cols > limit / inner || cols > limit / rows) {
+        return -1;
+    }
+    
+    // Every operand is held by the parties of the first one, in order,
+    // since each party multiplies its own shares across operands
+    const mpc_share_t *first = shares_a[0];
+    if (first == NULL) {
+        return -1;
+    }
+    for (size_t k = 0; k < rows * inner + inner * cols; k++) {
+        const mpc_share_t *set = (k < rows * inner)
+                                     ? shares_a[k]
+                                     : shares_b[k - rows * inner];
+        if (set == NULL) {
+            return -1;
+        }
+        for (uint8_t i = 0; i < num_shares; i++) {
+            if (mpc_validate_share(ctx, &set[i]) != 0 ||
+                set[i].party_id != first[i].party_id) {
+                return -1;
+            }
+        }
+    }
+    for (size_t k = 0; k < rows * cols; k++) {
+        if (shares_c[k] == NULL) {
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+static int matmul(const mpc_context_t *ctx,
+                  const mpc_share_t *const *shares_a,
+                  const mpc_share_t *const *shares_b,
+                  mpc_share_t *const *shares_c,
+                  size_t rows, size_t inner, size_t cols,
+                  uint8_t num_shares) {
+    // ====================================================================
+    // Step 1: Validate all inputs
+    // ====================================================================
+    
+    if (ctx == NULL || shares_a == NULL || shares_b == NULL ||
+        shares_c == NULL) {
+        return -1;
+    }
+    
+    MPC_TRACE_BEGIN(ctx, "validate", 0,
+                    mpc_trace_share_bytes(ctx, (rows + cols) * inner *
+                                          num_shares));
+    int valid = validate_matmul(ctx, shares_a, shares_b, shares_c, rows,
+                                inner, cols, num_shares);
+    MPC_TRACE_END(ctx, "validate", 0,
+                  mpc_trace_share_bytes(ctx, (rows + cols) * inner *
+                                        num_shares));
+    if (valid != 0) {
+        return -1;
+    }
+    
+    size_t data_len = ctx->value_size;
+    size_t outputs = rows * cols;
+    size_t intermediate_size = outputs * num_shares * sizeof(mpc_share_t);
+    size_t matrices_size = rows * inner + inner * cols + outputs;
+    size_t product_size = outputs * data_len;
+    
+    // ====================================================================
+    // Step 2: Local matrix products - one GEMM per party and byte
+    // ====================================================================
+    
+    mpc_share_t *intermediate = mpc_secure_alloc(ctx, intermediate_size);
+    uint8_t *matrices = mpc_secure_alloc(ctx, matrices_size);
+    if (intermediate == NULL || matrices == NULL) {
+        mpc_secure_release(intermediate, intermediate_size);
+        mpc_secure_release(matrices, matrices_size);
+        return -1;
+    }
+    secure_lock(intermediate, intermediate_size);
+    secure_lock(matrices, matrices_size);
+    uint8_t *a = matrices;
+    uint8_t *b = a + rows * inner;
+    uint8_t *c = b + inner * cols;
+    
+    // Each byte of a share is an independent value, so a party runs one
+    // matrix product per byte over its own shares. The sums of products
+    // are degree-2 sharings, exactly like a single local product.
+    MPC_TRACE_BEGIN(ctx, "compute", 0,
+                    mpc_trace_share_bytes(ctx, (rows + cols) * inner *
+                                          num_shares));
     for (uint8_t i = 0; i < num_shares; i++) {
-        secure_wipe(&intermediate[i], sizeof(mpc_share_t));
+        for (size_t k = 0; k < outputs; k++) {
+            mpc_share_t *local = &intermediate[k * num_shares + i];
+            local->party_id = shares_a[0][i].party_id;
+            local->session_id = ctx->session_id;
+            local->share.index = shares_a[0][i].share.index;
+            local->share.data_len = data_len;
+            local->share.threshold = ctx->threshold;
+        }
+        
+        for (size_t j = 0; j < data_len; j++) {
+            for (size_t k = 0; k < rows * inner; k++) {
+                a[k] = shares_a[k][i].share.data[j];
+            }
+            for (size_t k = 0; k < inner * cols; k++) {
+                b[k] = shares_b[k][i].share.data[j];
+            }
+            gf256_gemm(rows, inner, cols, a, b, c);
+            for (size_t k = 0; k < outputs; k++) {
+                intermediate[k * num_shares + i].share.data[j] = c[k];
+            }
+        }
+    }
+    MPC_TRACE_END(ctx, "compute", 0,
+                  mpc_trace_share_bytes(ctx, (rows + cols) * inner *
+                                        num_shares));
+    
+    // ====================================================================
+    // Step 3: Reconstruct each output once (one interactive step)
+    // ====================================================================
+    
+    uint8_t *product = mpc_secure_alloc(ctx, product_size);
+    int result = (product != NULL) ? 0 : -1;
+    if (product != NULL) {
+        secure_lock(product, product_size);
+    }
+    
+    // As in mul_batch(), the degree reduction reconstructs and reshares
+    // (educational); it runs once per output, not once per product
+    MPC_TRACE_BEGIN(ctx, "reconstruct", 0,
+                    mpc_trace_share_bytes(ctx, outputs * num_shares));
+    for (size_t k = 0; k < outputs && result == 0; k++) {
+        result = mpc_reconstruct(ctx, &intermediate[k * num_shares],
+                                 num_shares, &product[k * data_len]);
     }
-    secure_unlock(intermediate, num_shares * sizeof(mpc_share_t));
-    secure_free(intermediate, num_shares * sizeof(mpc_share_t));
+    MPC_TRACE_END(ctx, "reconstruct", 0,
+                  mpc_trace_share_bytes(ctx, outputs * num_shares));
     
-    // Wipe and free product
-    secure_unlock(product, data_len);
-    secure_free(product, data_len);
+    // ====================================================================
+    // Step 4: Reshare the outputs (Degree Reduction)
+    // ====================================================================
+    
+    MPC_TRACE_BEGIN(ctx, "reshare", 0, product_size);
+    for (size_t k = 0; k < outputs && result == 0; k++) {
+        result = mpc_create_shares(ctx, &product[k * data_len], shares_c[k]);
+    }
+    MPC_TRACE_END(ctx, "reshare", 0, product_size);
+    
+    // ====================================================================
+    // Step 5: Secure cleanup
+    // ====================================================================
+    
+    MPC_TRACE_BEGIN(ctx, "wipe", 0,
+                    intermediate_size + matrices_size + product_size);
+    secure_wipe(intermediate, intermediate_size);
+    secure_unlock(intermediate, intermediate_size);
+    mpc_secure_release(intermediate, intermediate_size);
+    
+    secure_wipe(matrices, matrices_size);
+    secure_unlock(matrices, matrices_size);
+    mpc_secure_release(matrices, matrices_size);
+    
+    if (product != NULL) {
+        secure_wipe(product, product_size);
+        secure_unlock(product, product_size);
+        mpc_secure_release(product, product_size);
+    }
+    MPC_TRACE_END(ctx, "wipe", 0,
+                  intermediate_size + matrices_size + product_size);
     
-    return reshare_result;
+    return (result == 0) ? 0 : -1;
+}
+
+int mpc_secure_matmul(const mpc_context_t *ctx,
+                      const mpc_share_t *const *shares_a,
+                      const mpc_share_t *const *shares_b,
+                      mpc_share_t *const *shares_c,
+                      size_t rows, size_t inner, size_t cols,
+                      uint8_t num_shares) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_matmul", 0,
+                    mpc_trace_share_bytes(ctx, (rows + cols) * inner *
+                                          num_shares));
+    MPC_MEM_BEGIN(MPC_OP_DOT);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = matmul(ctx, shares_a, shares_b, shares_c, rows, inner, cols,
+                        num_shares);
+    if (result == 0) {
+        mpc_stats_add(ctx, MPC_COUNTER_MULTIPLICATIONS, rows * inner * cols);
+        mpc_stats_add(ctx, MPC_COUNTER_RESHARES, rows * cols);
+    }
+    mpc_stats_end(ctx, MPC_OP_DOT, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_matmul", 0,
+                  mpc_trace_share_bytes(ctx, (rows + cols) * inner *
+                                        num_shares));
+    return result;
+}
+
+int mpc_secure_dot(const mpc_context_t *ctx,
+                   const mpc_share_t *const *shares_x,
+                   const mpc_share_t *const *shares_y,
+                   size_t length,
+                   mpc_share_t *shares_dot,
+                   uint8_t num_shares) {
+    // A row vector times a column vector
+    return mpc_secure_matmul(ctx, shares_x, shares_y, &shares_dot, 1, length,
+                             1, num_shares);
 }
 
 /* ========================================================================
  * High-Level MPC Functions
  * ======================================================================== */
 
-int mpc_secure_sum(const mpc_context_t *ctx, 
-                   const mpc_share_t **share_sets,
-                   uint8_t num_values,
-                   uint8_t num_shares,
-                   mpc_share_t *shares_sum) {
+static int sum_shares(const mpc_context_t *ctx, 
+                      const mpc_share_t **share_sets,
+                      uint8_t num_values,
+                      uint8_t num_shares,
+                      mpc_share_t *shares_sum) {
     // Validate inputs
     if (ctx == NULL || share_sets == NULL || shares_sum == NULL) {
         return -1;
@@ -467,54 +1037,78 @@ int mpc_secure_sum(const mpc_context_t *ctx,
     }
     
     // Add each subsequent value
-    for (uint8_t val = 1; val < num_values; val++) {
+    MPC_TRACE_BEGIN(ctx, "compute", 0,
+                    mpc_trace_share_bytes(ctx, num_values * num_shares));
+    int result = 0;
+    for (uint8_t val = 1; val < num_values && result == 0; val++) {
         mpc_share_t temp[num_shares];
+        MPC_MEM_STACK_PUSH(sizeof(temp));
         
         // Add this value to running sum
-        if (mpc_secure_add(ctx, shares_sum, share_sets[val], 
-                          temp, num_shares) != 0) {
-            return -1;
-        }
+        result = mpc_secure_add(ctx, shares_sum, share_sets[val],
+                                temp, num_shares);
         
         // Copy result back to shares_sum
-        for (uint8_t i = 0; i < num_shares; i++) {
+        for (uint8_t i = 0; i < num_shares && result == 0; i++) {
             shares_sum[i] = temp[i];
         }
+        MPC_MEM_STACK_POP(sizeof(temp));
     }
+    MPC_TRACE_END(ctx, "compute", 0,
+                  mpc_trace_share_bytes(ctx, num_values * num_shares));
     
-    return 0;
+    return (result == 0) ? 0 : -1;
 }
 
-int mpc_secure_average(const mpc_context_t *ctx,
-                       const mpc_share_t **share_sets,
-                       uint8_t num_values,
-                       uint8_t num_shares,
-                       uint8_t *average) {
+int mpc_secure_sum(const mpc_context_t *ctx, 
+                   const mpc_share_t **share_sets,
+                   uint8_t num_values,
+                   uint8_t num_shares,
+                   mpc_share_t *shares_sum) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_sum", 0,
+                    mpc_trace_share_bytes(ctx, num_values * num_shares));
+    MPC_MEM_BEGIN(MPC_OP_SUM);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = sum_shares(ctx, share_sets, num_values, num_shares,
+                            shares_sum);
+    mpc_stats_end(ctx, MPC_OP_SUM, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_sum", 0,
+                  mpc_trace_share_bytes(ctx, num_values * num_shares));
+    return result;
+}
+
+static int average_shares(const mpc_context_t *ctx,
+                          const mpc_share_t **share_sets,
+                          uint8_t num_values,
+                          uint8_t num_shares,
+                          uint8_t *average) {
     // Validate inputs
     if (average == NULL) {
         return -1;
     }
     
     // Allocate shares for sum
-    mpc_share_t *shares_sum = secure_malloc(num_shares * sizeof(mpc_share_t));
+    size_t sum_size = num_shares * sizeof(mpc_share_t);
+    mpc_share_t *shares_sum = mpc_secure_alloc(ctx, sum_size);
     if (shares_sum == NULL) {
         return -1;
     }
-    secure_lock(shares_sum, num_shares * sizeof(mpc_share_t));
+    secure_lock(shares_sum, sum_size);
     
     // Compute sum
     if (mpc_secure_sum(ctx, share_sets, num_values, num_shares, 
                        shares_sum) != 0) {
-        secure_unlock(shares_sum, num_shares * sizeof(mpc_share_t));
-        secure_free(shares_sum, num_shares * sizeof(mpc_share_t));
+        secure_unlock(shares_sum, sum_size);
+        mpc_secure_release(shares_sum, sum_size);
         return -1;
     }
     
     // Reconstruct sum
     uint8_t sum;
     if (mpc_reconstruct(ctx, shares_sum, num_shares, &sum) != 0) {
-        secure_unlock(shares_sum, num_shares * sizeof(mpc_share_t));
-        secure_free(shares_sum, num_shares * sizeof(mpc_share_t));
+        secure_unlock(shares_sum, sum_size);
+        mpc_secure_release(shares_sum, sum_size);
         return -1;
     }
     
@@ -524,18 +1118,36 @@ int mpc_secure_average(const mpc_context_t *ctx,
     *average = sum / num_values;
     
     // Cleanup
-    secure_unlock(shares_sum, num_shares * sizeof(mpc_share_t));
-    secure_free(shares_sum, num_shares * sizeof(mpc_share_t));
+    secure_unlock(shares_sum, sum_size);
+    mpc_secure_release(shares_sum, sum_size);
     
     return 0;
 }
 
-int mpc_secure_max(const mpc_context_t *ctx,
-                   const mpc_share_t **share_sets,
-                   uint8_t num_values,
-                   uint8_t num_shares,
-                   uint8_t *maximum,
-                   uint8_t *max_index) {
+int mpc_secure_average(const mpc_context_t *ctx,
+                       const mpc_share_t **share_sets,
+                       uint8_t num_values,
+                       uint8_t num_shares,
+                       uint8_t *average) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_average", 0,
+                    mpc_trace_share_bytes(ctx, num_values * num_shares));
+    MPC_MEM_BEGIN(MPC_OP_AVERAGE);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = average_shares(ctx, share_sets, num_values, num_shares,
+                                average);
+    mpc_stats_end(ctx, MPC_OP_AVERAGE, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_average", 0,
+                  mpc_trace_share_bytes(ctx, num_values * num_shares));
+    return result;
+}
+
+static int max_shares(const mpc_context_t *ctx,
+                      const mpc_share_t **share_sets,
+                      uint8_t num_values,
+                      uint8_t num_shares,
+                      uint8_t *maximum,
+                      uint8_t *max_index) {
     // Validate inputs
     if (ctx == NULL || share_sets == NULL || maximum == NULL) {
         return -1;
@@ -546,7 +1158,7 @@ int mpc_secure_max(const mpc_context_t *ctx,
     }
     
     // Allocate secure memory for reconstructed values
-    uint8_t *values = secure_malloc(num_values);
+    uint8_t *values = mpc_secure_alloc(ctx, num_values);
     if (values == NULL) {
         return -1;
     }
@@ -554,15 +1166,22 @@ int mpc_secure_max(const mpc_context_t *ctx,
     
     // Reconstruct all values
     // Note: In production, use secure comparison circuits to avoid reconstruction
-    for (uint8_t i = 0; i < num_values; i++) {
-        if (mpc_reconstruct(ctx, share_sets[i], num_shares, &values[i]) != 0) {
-            secure_unlock(values, num_values);
-            secure_free(values, num_values);
-            return -1;
-        }
+    MPC_TRACE_BEGIN(ctx, "reconstruct", 0,
+                    mpc_trace_share_bytes(ctx, num_values * num_shares));
+    int result = 0;
+    for (uint8_t i = 0; i < num_values && result == 0; i++) {
+        result = mpc_reconstruct(ctx, share_sets[i], num_shares, &values[i]);
+    }
+    MPC_TRACE_END(ctx, "reconstruct", 0,
+                  mpc_trace_share_bytes(ctx, num_values * num_shares));
+    if (result != 0) {
+        secure_unlock(values, num_values);
+        mpc_secure_release(values, num_values);
+        return -1;
     }
     
     // Find maximum
+    MPC_TRACE_BEGIN(ctx, "compute", 0, num_values);
     uint8_t max_val = values[0];
     uint8_t max_idx = 0;
     
@@ -572,6 +1191,7 @@ int mpc_secure_max(const mpc_context_t *ctx,
             max_idx = i;
         }
     }
+    MPC_TRACE_END(ctx, "compute", 0, num_values);
     
     *maximum = max_val;
     if (max_index != NULL) {
@@ -579,17 +1199,38 @@ int mpc_secure_max(const mpc_context_t *ctx,
     }
     
     // Cleanup
+    MPC_TRACE_BEGIN(ctx, "wipe", 0, num_values);
     secure_unlock(values, num_values);
-    secure_free(values, num_values);
+    mpc_secure_release(values, num_values);
+    MPC_TRACE_END(ctx, "wipe", 0, num_values);
     
     return 0;
 }
 
-int mpc_secure_greater(const mpc_context_t *ctx,
-                       const mpc_share_t *shares_x,
-                       const mpc_share_t *shares_y,
-                       uint8_t num_shares,
-                       uint8_t *result) {
+int mpc_secure_max(const mpc_context_t *ctx,
+                   const mpc_share_t **share_sets,
+                   uint8_t num_values,
+                   uint8_t num_shares,
+                   uint8_t *maximum,
+                   uint8_t *max_index) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_max", 0,
+                    mpc_trace_share_bytes(ctx, num_values * num_shares));
+    MPC_MEM_BEGIN(MPC_OP_MAX);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = max_shares(ctx, share_sets, num_values, num_shares, maximum,
+                            max_index);
+    mpc_stats_end(ctx, MPC_OP_MAX, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_max", 0,
+                  mpc_trace_share_bytes(ctx, num_values * num_shares));
+    return result;
+}
+
+static int greater_shares(const mpc_context_t *ctx,
+                          const mpc_share_t *shares_x,
+                          const mpc_share_t *shares_y,
+                          uint8_t num_shares,
+                          uint8_t *result) {
     // Validate inputs
     if (ctx == NULL || shares_x == NULL || shares_y == NULL || result == NULL) {
         return -1;
@@ -612,3 +1253,368 @@ int mpc_secure_greater(const mpc_context_t *ctx,
     
     return 0;
 }
+
+int mpc_secure_greater(const mpc_context_t *ctx,
+                       const mpc_share_t *shares_x,
+                       const mpc_share_t *shares_y,
+                       uint8_t num_shares,
+                       uint8_t *result) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_greater", 0,
+                    mpc_trace_share_bytes(ctx, 2 * (size_t)num_shares));
+    MPC_MEM_BEGIN(MPC_OP_GREATER);
+    uint64_t start = mpc_stats_begin(ctx);
+    int status = greater_shares(ctx, shares_x, shares_y, num_shares, result);
+    mpc_stats_end(ctx, MPC_OP_GREATER, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_greater", 0,
+                  mpc_trace_share_bytes(ctx, 2 * (size_t)num_shares));
+    return status;
+}
+
+static int equal_batch(const mpc_context_t *ctx,
+                       const mpc_share_t *const *shares_x,
+                       const mpc_share_t *const *shares_y,
+                       mpc_share_t *const *shares_eq,
+                       size_t count,
+                       uint8_t num_shares) {
+    // ====================================================================
+    // Step 1: Validate all inputs
+    // ====================================================================
+    
+    if (ctx == NULL || shares_x == NULL || shares_y == NULL ||
+        shares_eq == NULL) {
+        return -1;
+    }
+    
+    MPC_TRACE_BEGIN(ctx, "validate", 0,
+                    mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    int valid = validate_batch(ctx, shares_x, shares_y, shares_eq, count,
+                               num_shares);
+    MPC_TRACE_END(ctx, "validate", 0,
+                  mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    if (valid != 0 ||
+        count > SIZE_MAX / (2 * (size_t)ctx->num_parties *
+                            sizeof(mpc_share_t))) {
+        return -1;
+    }
+    
+    // ====================================================================
+    // Step 2: Local differences d = x - y
+    // ====================================================================
+    
+    // Per comparison: d^(2^k - 1) and d^(2^k) on the input parties, and
+    // the num_parties shares each multiplication writes
+    uint8_t n = ctx->num_parties;
+    size_t powers_size = 2 * count * num_shares * sizeof(mpc_share_t);
+    size_t products_size = 2 * count * n * sizeof(mpc_share_t);
+    size_t pointers_size = 6 * count * sizeof(mpc_share_t *);
+    mpc_share_t *powers = mpc_secure_alloc(ctx, powers_size);
+    mpc_share_t *products = mpc_secure_alloc(ctx, products_size);
+    mpc_share_t **pointers = mpc_mem_malloc(pointers_size);
+    if (powers == NULL || products == NULL || pointers == NULL) {
+        mpc_secure_release(powers, powers_size);
+        mpc_secure_release(products, products_size);
+        mpc_mem_free(pointers, pointers_size);
+        return -1;
+    }
+    secure_lock(powers, powers_size);
+    secure_lock(products, products_size);
+    
+    mpc_share_t *odd = powers;                          // d^(2^k - 1)
+    mpc_share_t *even = &powers[count * num_shares];    // d^(2^k)
+    const mpc_share_t **xs = (const mpc_share_t **)pointers;
+    const mpc_share_t **ys = (const mpc_share_t **)&pointers[2 * count];
+    mpc_share_t **outs = &pointers[4 * count];
+    
+    MPC_TRACE_BEGIN(ctx, "compute", 0,
+                    mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    for (size_t k = 0; k < count; k++) {
+        for (uint8_t i = 0; i < num_shares; i++) {
+            mpc_share_t *d = &odd[k * num_shares + i];
+            *d = shares_x[k][i];
+            for (size_t j = 0; j < ctx->value_size; j++) {
+                d->share.data[j] ^= shares_y[k][i].share.data[j];
+            }
+        }
+    }
+    MPC_TRACE_END(ctx, "compute", 0,
+                  mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    
+    // ====================================================================
+    // Step 3: d^255 in MPC_EQUAL_ROUNDS batched rounds
+    // ====================================================================
+    
+    // Round 1 squares d. Rounds 2-7 step (d^(2^k - 1), d^(2^k)) to
+    // (d^(2^(k+1) - 1), d^(2^(k+1))). Round 8 forms d^127 × d^128.
+    int result = 0;
+    for (int round = 1; round <= MPC_EQUAL_ROUNDS && result == 0; round++) {
+        int pairs = (round == 1 || round == MPC_EQUAL_ROUNDS) ? 1 : 2;
+        for (size_t k = 0; k < count; k++) {
+            const mpc_share_t *d_odd = &odd[k * num_shares];
+            const mpc_share_t *d_even = &even[k * num_shares];
+            mpc_share_t *out = &products[2 * k * n];
+            if (round == 1) {
+                xs[k] = d_odd;
+                ys[k] = d_odd;
+                outs[k] = out + n;
+            } else if (round == MPC_EQUAL_ROUNDS) {
+                xs[k] = d_even;
+                ys[k] = d_odd;
+                outs[k] = shares_eq[k];
+            } else {
+                xs[2 * k] = d_even;
+                ys[2 * k] = d_odd;
+                outs[2 * k] = out;
+                xs[2 * k + 1] = d_even;
+                ys[2 * k + 1] = d_even;
+                outs[2 * k + 1] = out + n;
+            }
+        }
+        result = mpc_secure_mul_batch(ctx, xs, ys,
+                                      (mpc_share_t *const *)outs,
+                                      pairs * count, num_shares);
+        
+        // Keep the shares of the input parties for the next round; a
+        // reshare writes the share of party p at index p - 1
+        for (size_t k = 0; k < count && result == 0 &&
+                           round < MPC_EQUAL_ROUNDS; k++) {
+            for (uint8_t i = 0; i < num_shares; i++) {
+                uint8_t party = odd[k * num_shares + i].party_id;
+                if (round > 1) {
+                    odd[k * num_shares + i] = products[2 * k * n + party - 1];
+                }
+                even[k * num_shares + i] =
+                    products[(2 * k + 1) * n + party - 1];
+            }
+        }
+    }
+    
+    // ====================================================================
+    // Step 4: [x == y] = 1 + d^255, adding the public 1 to every share
+    // ====================================================================
+    
+    for (size_t k = 0; k < count && result == 0; k++) {
+        for (uint8_t p = 0; p < n; p++) {
+            for (size_t j = 0; j < ctx->value_size; j++) {
+                shares_eq[k][p].share.data[j] ^= 1;
+            }
+        }
+    }
+    
+    // ====================================================================
+    // Step 5: Secure cleanup
+    // ====================================================================
+    
+    MPC_TRACE_BEGIN(ctx, "wipe", 0, powers_size + products_size);
+    secure_wipe(powers, powers_size);
+    secure_unlock(powers, powers_size);
+    mpc_secure_release(powers, powers_size);
+    secure_wipe(products, products_size);
+    secure_unlock(products, products_size);
+    mpc_secure_release(products, products_size);
+    mpc_mem_free(pointers, pointers_size);
+    MPC_TRACE_END(ctx, "wipe", 0, powers_size + products_size);
+    
+    return (result == 0) ? 0 : -1;
+}
+
+int mpc_secure_equal_batch(const mpc_context_t *ctx,
+                           const mpc_share_t *const *shares_x,
+                           const mpc_share_t *const *shares_y,
+                           mpc_share_t *const *shares_eq,
+                           size_t count,
+                           uint8_t num_shares) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_equal_batch", 0,
+                    mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    MPC_MEM_BEGIN(MPC_OP_EQUAL);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = equal_batch(ctx, shares_x, shares_y, shares_eq, count,
+                             num_shares);
+    mpc_stats_end(ctx, MPC_OP_EQUAL, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_equal_batch", 0,
+                  mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    return result;
+}
+
+int mpc_secure_equal(const mpc_context_t *ctx,
+                     const mpc_share_t *shares_x,
+                     const mpc_share_t *shares_y,
+                     mpc_share_t *shares_eq,
+                     uint8_t num_shares) {
+    // A single comparison is a batch of one
+    return mpc_secure_equal_batch(ctx, &shares_x, &shares_y, &shares_eq, 1,
+                                  num_shares);
+}
+
+static int inv_batch(const mpc_context_t *ctx,
+                     const mpc_share_t *const *shares_x,
+                     mpc_share_t *const *shares_inv,
+                     size_t count,
+                     uint8_t num_shares) {
+    // ====================================================================
+    // Step 1: Validate all inputs
+    // ====================================================================
+    
+    if (ctx == NULL || shares_x == NULL || shares_inv == NULL) {
+        return -1;
+    }
+    
+    MPC_TRACE_BEGIN(ctx, "validate", 0,
+                    mpc_trace_share_bytes(ctx, count * num_shares));
+    int valid = validate_batch(ctx, shares_x, shares_x, shares_inv, count,
+                               num_shares);
+    MPC_TRACE_END(ctx, "validate", 0,
+                  mpc_trace_share_bytes(ctx, count * num_shares));
+    if (valid != 0 ||
+        count > SIZE_MAX / ((size_t)ctx->num_parties * sizeof(mpc_share_t))) {
+        return -1;
+    }
+    
+    uint8_t n = ctx->num_parties;
+    size_t data_len = ctx->value_size;
+    size_t masks_size = count * n * sizeof(mpc_share_t);
+    size_t products_size = count * num_shares * sizeof(mpc_share_t);
+    size_t values_size = 2 * count * data_len;
+    mpc_share_t *masks = mpc_secure_alloc(ctx, masks_size);
+    mpc_share_t *products = mpc_secure_alloc(ctx, products_size);
+    uint8_t *values = mpc_secure_alloc(ctx, values_size);
+    if (masks == NULL || products == NULL || values == NULL) {
+        mpc_secure_release(masks, masks_size);
+        mpc_secure_release(products, products_size);
+        mpc_secure_release(values, values_size);
+        return -1;
+    }
+    secure_lock(masks, masks_size);
+    secure_lock(products, products_size);
+    secure_lock(values, values_size);
+    
+    uint8_t *opened = values;                       // r, then x × r
+    uint8_t *inverses = &values[count * data_len];  // (x × r)⁻¹
+    
+    // ====================================================================
+    // Step 2: Share a random nonzero mask r per value
+    // ====================================================================
+    
+    // Note: In production MPC, the parties would generate r jointly
+    // (each shares a random value and r is their product, checked to be
+    // nonzero). Here one dealer shares it, as for the other
+    // preprocessing of this educational library.
+    int result = 0;
+    MPC_TRACE_BEGIN(ctx, "deal", 0, count * data_len);
+    for (size_t k = 0; k < count && result == 0; k++) {
+        uint8_t *r = &opened[k * data_len];
+        for (size_t j = 0; j < data_len; j++) {
+            r[j] = sss_random_nonzero();
+        }
+        result = mpc_create_shares(ctx, r, &masks[k * n]);
+    }
+    MPC_TRACE_END(ctx, "deal", 0, count * data_len);
+    
+    // ====================================================================
+    // Step 3: Local products x × r, opened in one round for the batch
+    // ====================================================================
+    
+    // Each party multiplies its share of x by its own share of r. The
+    // masks hold the share of party p at index p - 1.
+    MPC_TRACE_BEGIN(ctx, "compute", 0,
+                    mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    for (size_t k = 0; k < count && result == 0; k++) {
+        for (uint8_t i = 0; i < num_shares; i++) {
+            const mpc_share_t *x = &shares_x[k][i];
+            const mpc_share_t *r = &masks[k * n + x->party_id - 1];
+            mpc_share_t *local = &products[k * num_shares + i];
+            *local = *x;
+            local->session_id = ctx->session_id;
+            for (size_t j = 0; j < data_len; j++) {
+                local->share.data[j] = gf256_mul(x->share.data[j],
+                                                 r->share.data[j]);
+            }
+        }
+    }
+    MPC_TRACE_END(ctx, "compute", 0,
+                  mpc_trace_share_bytes(ctx, 2 * count * num_shares));
+    
+    // x × r is uniform over the nonzero bytes when x is nonzero, so
+    // opening it reveals only which bytes of x are zero
+    MPC_TRACE_BEGIN(ctx, "reconstruct", 0,
+                    mpc_trace_share_bytes(ctx, count * num_shares));
+    for (size_t k = 0; k < count && result == 0; k++) {
+        result = mpc_reconstruct(ctx, &products[k * num_shares], num_shares,
+                                 &opened[k * data_len]);
+    }
+    MPC_TRACE_END(ctx, "reconstruct", 0,
+                  mpc_trace_share_bytes(ctx, count * num_shares));
+    
+    // ====================================================================
+    // Step 4: Invert the opened values together, then x⁻¹ = r × (x r)⁻¹
+    // ====================================================================
+    
+    MPC_TRACE_BEGIN(ctx, "invert", 0, count * data_len);
+    if (result == 0) {
+        gf256_inv_batch(opened, inverses, count * data_len);
+    }
+    MPC_TRACE_END(ctx, "invert", 0, count * data_len);
+    
+    // Multiplying by a public value is local, and keeps the degree of r.
+    // Every input has been read, so shares_inv may alias shares_x.
+    MPC_TRACE_BEGIN(ctx, "compute", 0, mpc_trace_share_bytes(ctx, count * n));
+    for (size_t k = 0; k < count && result == 0; k++) {
+        const uint8_t *inverse = &inverses[k * data_len];
+        for (uint8_t p = 0; p < n; p++) {
+            const mpc_share_t *r = &masks[k * n + p];
+            mpc_share_t *out = &shares_inv[k][p];
+            *out = *r;
+            for (size_t j = 0; j < data_len; j++) {
+                out->share.data[j] = gf256_mul(r->share.data[j], inverse[j]);
+            }
+        }
+    }
+    MPC_TRACE_END(ctx, "compute", 0, mpc_trace_share_bytes(ctx, count * n));
+    
+    // ====================================================================
+    // Step 5: Secure cleanup
+    // ====================================================================
+    
+    MPC_TRACE_BEGIN(ctx, "wipe", 0, masks_size + products_size + values_size);
+    secure_wipe(masks, masks_size);
+    secure_unlock(masks, masks_size);
+    mpc_secure_release(masks, masks_size);
+    secure_wipe(products, products_size);
+    secure_unlock(products, products_size);
+    mpc_secure_release(products, products_size);
+    secure_wipe(values, values_size);
+    secure_unlock(values, values_size);
+    mpc_secure_release(values, values_size);
+    MPC_TRACE_END(ctx, "wipe", 0, masks_size + products_size + values_size);
+    
+    return (result == 0) ? 0 : -1;
+}
+
+int mpc_secure_inv_batch(const mpc_context_t *ctx,
+                         const mpc_share_t *const *shares_x,
+                         mpc_share_t *const *shares_inv,
+                         size_t count,
+                         uint8_t num_shares) {
+    MPC_TRACE_BEGIN(ctx, "mpc_secure_inv_batch", 0,
+                    mpc_trace_share_bytes(ctx, count * num_shares));
+    MPC_MEM_BEGIN(MPC_OP_INV);
+    uint64_t start = mpc_stats_begin(ctx);
+    int result = inv_batch(ctx, shares_x, shares_inv, count, num_shares);
+    if (result == 0) {
+        mpc_stats_add(ctx, MPC_COUNTER_MULTIPLICATIONS, count);
+    }
+    mpc_stats_end(ctx, MPC_OP_INV, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_secure_inv_batch", 0,
+                  mpc_trace_share_bytes(ctx, count * num_shares));
+    return result;
+}
+
+int mpc_secure_inv(const mpc_context_t *ctx,
+                   const mpc_share_t *shares_x,
+                   mpc_share_t *shares_inv,
+                   uint8_t num_shares) {
+    // A single inversion is a batch of one
+    return mpc_secure_inv_batch(ctx, &shares_x, &shares_inv, 1, num_shares);
+}
@@ -0,0 +1,62 @@
+#ifndef SSS_CORE_MPC_MUL_INTERNAL_H
+#define SSS_CORE_MPC_MUL_INTERNAL_H
+
+#include "sss/mpc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Phases of a Batched Multiplication
+ *
+ * mpc_secure_mul_batch() in three steps, for callers that spread a large
+ * batch over threads: the local products and the resharing of disjoint
+ * ranges may run concurrently, while the opening is the one interactive
+ * step and is done once for the whole batch. Used by the parallel
+ * circuit evaluator. None of these update the operation counters.
+ * ======================================================================== */
+
+/**
+ * Validate a batch and form the degree-2 local products.
+ *
+ * @param intermediate  Output: count × num_shares shares
+ * @return 0 on success, -1 on failure
+ */
+int mpc_mul_local_products(const mpc_context_t *ctx,
+                           const mpc_share_t *const *shares_x,
+                           const mpc_share_t *const *shares_y,
+                           mpc_share_t *const *shares_prod,
+                           size_t count,
+                           uint8_t num_shares,
+                           mpc_share_t *intermediate);
+
+/**
+ * Open every product of a batch (the degree reduction round).
+ *
+ * @param products  Output: count × value_size bytes
+ * @return 0 on success, -1 on failure
+ */
+int mpc_mul_open_products(const mpc_context_t *ctx,
+                          const mpc_share_t *intermediate,
+                          size_t count,
+                          uint8_t num_shares,
+                          uint8_t *products);
+
+/**
+ * Share opened products again at the context's threshold.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int mpc_mul_reshare_products(const mpc_context_t *ctx,
+                             const uint8_t *products,
+                             mpc_share_t *const *shares_prod,
+                             size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_CORE_MPC_MUL_INTERNAL_H */
@@ -0,0 +1,381 @@
+#include "sss/mpc_net.h"
+#include "core/mpc_net_internal.h"
+#include "core/mpc_stats_internal.h"
+#include "core/trace_internal.h"
+#include "sss/secret_sharing.h"
+#include "sss/field.h"
+#include "utils/secure_memory.h"
+#include <string.h>
+#include <stdlib.h>
+
+/* ========================================================================
+ * Internal Helpers
+ * ======================================================================== */
+
+/**
+ * Check the arguments shared by every networked protocol
+ */
+static int net_check(const mpc_context_t *ctx, const mpc_transport_t *transport) {
+    if (ctx == NULL || transport == NULL) {
+        return -1;
+    }
+
+    if (transport->num_parties != ctx->num_parties) {
+        return -1;
+    }
+
+    // Shares carry at most SSS_SHARE_DATA_SIZE bytes per value
+    if (ctx->value_size > SSS_SHARE_DATA_SIZE) {
+        return -1;
+    }
+
+    return 0;
+}
+
+void mpc_net_share_header(const mpc_context_t *ctx, uint8_t party_id,
+                          mpc_share_t *share) {
+    share->party_id = party_id;
+    share->session_id = ctx->session_id;
+    share->share.index = party_id;
+    share->share.threshold = ctx->threshold;
+    share->share.data_len = ctx->value_size;
+}
+
+void mpc_net_lagrange_at_zero(uint8_t num_parties, uint8_t *lambda) {
+    for (uint8_t i = 1; i <= num_parties; i++) {
+        uint8_t coeff = 1;
+        for (uint8_t j = 1; j <= num_parties; j++) {
+            if (j != i) {
+                coeff = gf256_mul(coeff, gf256_div(j, gf256_sub(j, i)));
+            }
+        }
+        lambda[i - 1] = coeff;
+    }
+}
+
+/**
+ * Receive one share-sized message from a peer
+ */
+static int net_recv_value(const mpc_context_t *ctx, mpc_transport_t *transport,
+                          uint8_t from, uint8_t *data) {
+    size_t len = 0;
+    if (mpc_transport_recv(transport, from, data, SSS_SHARE_DATA_SIZE,
+                           &len) != 0) {
+        return -1;
+    }
+    return (len == ctx->value_size) ? 0 : -1;
+}
+
+/* ========================================================================
+ * Input and Output
+ * ======================================================================== */
+
+static int share_input(const mpc_context_t *ctx, mpc_transport_t *transport,
+                       uint8_t dealer, const uint8_t *secrets,
+                       mpc_share_t *shares, size_t count) {
+    // Validate inputs
+    if (net_check(ctx, transport) != 0 || shares == NULL) {
+        return -1;
+    }
+
+    if (dealer < 1 || dealer > ctx->num_parties) {
+        return -1;
+    }
+
+    uint8_t me = transport->party_id;
+
+    if (me != dealer) {
+        for (size_t k = 0; k < count; k++) {
+            mpc_net_share_header(ctx, me, &shares[k]);
+            if (net_recv_value(ctx, transport, dealer,
+                               shares[k].share.data) != 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    if (secrets == NULL) {
+        return -1;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    // Shares of every secret stay alive until the flush, since the
+    // transport may send straight from them
+    size_t n = ctx->num_parties;
+    size_t all_size = count * n * sizeof(mpc_share_t);
+    mpc_share_t *all = mpc_secure_alloc(ctx, all_size);
+    if (all == NULL) {
+        return -1;
+    }
+    secure_lock(all, all_size);
+
+    int result = 0;
+    for (size_t k = 0; k < count && result == 0; k++) {
+        mpc_share_t *set = &all[k * n];
+        if (mpc_create_shares(ctx, &secrets[k * ctx->value_size], set) != 0) {
+            result = -1;
+            break;
+        }
+
+        for (uint8_t peer = 1; peer <= n; peer++) {
+            if (peer == me) {
+                continue;
+            }
+            if (mpc_transport_send(transport, peer, set[peer - 1].share.data,
+                                   ctx->value_size) != 0) {
+                result = -1;
+                break;
+            }
+        }
+        shares[k] = set[me - 1];
+    }
+
+    if (result == 0) {
+        result = mpc_transport_flush(transport);
+    }
+
+    secure_wipe(all, all_size);
+    secure_unlock(all, all_size);
+    mpc_secure_release(all, all_size);
+    return result;
+}
+
+int mpc_net_share_input(const mpc_context_t *ctx, mpc_transport_t *transport,
+                        uint8_t dealer, const uint8_t *secrets,
+                        mpc_share_t *shares, size_t count) {
+    MPC_TRACE_BEGIN(ctx, "mpc_net_share_input", mpc_trace_party(transport),
+                    mpc_trace_share_bytes(ctx, count));
+    MPC_MEM_BEGIN(MPC_OP_NET_SHARE_INPUT);
+    uint64_t start = mpc_stats_begin(ctx);
+    mpc_transport_stats_t before = {0};
+    if (transport != NULL) {
+        before = transport->stats;
+    }
+
+    int result = share_input(ctx, transport, dealer, secrets, shares, count);
+    mpc_stats_traffic(ctx, transport, &before);
+    mpc_stats_end(ctx, MPC_OP_NET_SHARE_INPUT, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_net_share_input", mpc_trace_party(transport),
+                  mpc_trace_share_bytes(ctx, count));
+    return result;
+}
+
+static int open_values(const mpc_context_t *ctx, mpc_transport_t *transport,
+                       const mpc_share_t *shares, uint8_t *values,
+                       size_t count) {
+    // Validate inputs
+    if (net_check(ctx, transport) != 0 || shares == NULL || values == NULL) {
+        return -1;
+    }
+
+    uint8_t me = transport->party_id;
+
+    // Step 1: Broadcast every share
+    for (size_t k = 0; k < count; k++) {
+        if (mpc_validate_share(ctx, &shares[k]) != 0 ||
+            shares[k].party_id != me) {
+            return -1;
+        }
+        if (mpc_transport_broadcast(transport, shares[k].share.data,
+                                    ctx->value_size) != 0) {
+            return -1;
+        }
+    }
+    if (mpc_transport_flush(transport) != 0) {
+        return -1;
+    }
+
+    // Step 2: Collect every party's share and reconstruct
+    size_t all_size = ctx->num_parties * sizeof(mpc_share_t);
+    mpc_share_t *all = mpc_secure_alloc(ctx, all_size);
+    if (all == NULL) {
+        return -1;
+    }
+    secure_lock(all, all_size);
+
+    int result = 0;
+    for (size_t k = 0; k < count && result == 0; k++) {
+        for (uint8_t peer = 1; peer <= ctx->num_parties; peer++) {
+            if (peer == me) {
+                all[peer - 1] = shares[k];
+                continue;
+            }
+            mpc_net_share_header(ctx, peer, &all[peer - 1]);
+            if (net_recv_value(ctx, transport, peer,
+                               all[peer - 1].share.data) != 0) {
+                result = -1;
+                break;
+            }
+        }
+
+        if (result == 0) {
+            result = mpc_reconstruct(ctx, all, ctx->num_parties,
+                                     &values[k * ctx->value_size]);
+        }
+    }
+
+    secure_wipe(all, all_size);
+    secure_unlock(all, all_size);
+    mpc_secure_release(all, all_size);
+    return result;
+}
+
+int mpc_net_open(const mpc_context_t *ctx, mpc_transport_t *transport,
+                 const mpc_share_t *shares, uint8_t *values, size_t count) {
+    MPC_TRACE_BEGIN(ctx, "mpc_net_open", mpc_trace_party(transport),
+                    mpc_trace_share_bytes(ctx, count));
+    MPC_MEM_BEGIN(MPC_OP_NET_OPEN);
+    uint64_t start = mpc_stats_begin(ctx);
+    mpc_transport_stats_t before = {0};
+    if (transport != NULL) {
+        before = transport->stats;
+    }
+
+    int result = open_values(ctx, transport, shares, values, count);
+    mpc_stats_traffic(ctx, transport, &before);
+    mpc_stats_end(ctx, MPC_OP_NET_OPEN, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_net_open", mpc_trace_party(transport),
+                  mpc_trace_share_bytes(ctx, count));
+    return result;
+}
+
+/* ========================================================================
+ * Multiplication
+ * ======================================================================== */
+
+static int multiply(const mpc_context_t *ctx, mpc_transport_t *transport,
+                    const mpc_share_t *shares_x, const mpc_share_t *shares_y,
+                    mpc_share_t *shares_prod, size_t count) {
+    // Validate inputs
+    if (net_check(ctx, transport) != 0 || shares_x == NULL ||
+        shares_y == NULL || shares_prod == NULL) {
+        return -1;
+    }
+
+    // The degree-2(t-1) products need 2t-1 points to interpolate
+    if (ctx->num_parties < 2 * ctx->threshold - 1) {
+        return -1;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    uint8_t me = transport->party_id;
+    uint8_t n = ctx->num_parties;
+
+    uint8_t lambda[SSS_MAX_SHARES];
+    mpc_net_lagrange_at_zero(n, lambda);
+
+    // Sub-shares of every product stay alive until the flush, since the
+    // transport may send straight from them
+    size_t all_size = count * n * sizeof(mpc_share_t);
+    mpc_share_t *all = mpc_secure_alloc(ctx, all_size);
+    if (all == NULL) {
+        return -1;
+    }
+    secure_lock(all, all_size);
+
+    int result = 0;
+
+    // ====================================================================
+    // Step 1: Local products, reshared to every party
+    // ====================================================================
+    for (size_t k = 0; k < count && result == 0; k++) {
+        if (mpc_validate_share(ctx, &shares_x[k]) != 0 ||
+            mpc_validate_share(ctx, &shares_y[k]) != 0 ||
+            shares_x[k].party_id != me || shares_y[k].party_id != me) {
+            result = -1;
+            break;
+        }
+
+        uint8_t product[SSS_SHARE_DATA_SIZE];
+        for (size_t b = 0; b < ctx->value_size; b++) {
+            product[b] = gf256_mul(shares_x[k].share.data[b],
+                                   shares_y[k].share.data[b]);
+        }
+
+        mpc_share_t *set = &all[k * n];
+        result = mpc_create_shares(ctx, product, set);
+        secure_wipe(product, sizeof(product));
+
+        for (uint8_t peer = 1; peer <= n && result == 0; peer++) {
+            if (peer != me) {
+                result = mpc_transport_send(transport, peer,
+                                            set[peer - 1].share.data,
+                                            ctx->value_size);
+            }
+        }
+    }
+
+    if (result == 0) {
+        result = mpc_transport_flush(transport);
+    }
+
+    // ====================================================================
+    // Step 2: Combine sub-shares with the Lagrange coefficients
+    // ====================================================================
+    for (size_t k = 0; k < count && result == 0; k++) {
+        uint8_t acc[SSS_SHARE_DATA_SIZE] = {0};
+        uint8_t sub[SSS_SHARE_DATA_SIZE];
+
+        for (uint8_t peer = 1; peer <= n && result == 0; peer++) {
+            const uint8_t *from = sub;
+            if (peer == me) {
+                from = all[k * n + me - 1].share.data;
+            } else if (net_recv_value(ctx, transport, peer, sub) != 0) {
+                result = -1;
+                break;
+            }
+
+            for (size_t b = 0; b < ctx->value_size; b++) {
+                acc[b] = gf256_add(acc[b], gf256_mul(lambda[peer - 1], from[b]));
+            }
+        }
+
+        if (result == 0) {
+            memset(&shares_prod[k], 0, sizeof(mpc_share_t));
+            mpc_net_share_header(ctx, me, &shares_prod[k]);
+            memcpy(shares_prod[k].share.data, acc, ctx->value_size);
+        }
+        secure_wipe(acc, sizeof(acc));
+        secure_wipe(sub, sizeof(sub));
+    }
+
+    secure_wipe(all, all_size);
+    secure_unlock(all, all_size);
+    mpc_secure_release(all, all_size);
+    return result;
+}
+
+int mpc_net_mul(const mpc_context_t *ctx, mpc_transport_t *transport,
+                const mpc_share_t *shares_x, const mpc_share_t *shares_y,
+                mpc_share_t *shares_prod, size_t count) {
+    MPC_TRACE_BEGIN(ctx, "mpc_net_mul", mpc_trace_party(transport),
+                    mpc_trace_share_bytes(ctx, count));
+    MPC_MEM_BEGIN(MPC_OP_NET_MUL);
+    uint64_t start = mpc_stats_begin(ctx);
+    mpc_transport_stats_t before = {0};
+    if (transport != NULL) {
+        before = transport->stats;
+    }
+
+    int result = multiply(ctx, transport, shares_x, shares_y, shares_prod,
+                          count);
+    if (result == 0) {
+        mpc_stats_add(ctx, MPC_COUNTER_MULTIPLICATIONS, count);
+        mpc_stats_add(ctx, MPC_COUNTER_RESHARES, count);
+    }
+    mpc_stats_traffic(ctx, transport, &before);
+    mpc_stats_end(ctx, MPC_OP_NET_MUL, start);
+    MPC_MEM_END();
+    MPC_TRACE_END(ctx, "mpc_net_mul", mpc_trace_party(transport),
+                  mpc_trace_share_bytes(ctx, count));
+    return result;
+}
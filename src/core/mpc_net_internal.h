@@ -0,0 +1,36 @@
+#ifndef SSS_CORE_MPC_NET_INTERNAL_H
+#define SSS_CORE_MPC_NET_INTERNAL_H
+
+#include "sss/mpc.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Helpers Shared by the Networked Protocols
+ *
+ * Used by the blocking protocols in mpc_net.c and by the resumable
+ * protocols of the party runtime.
+ * ======================================================================== */
+
+/**
+ * Lagrange coefficients for x = 0 over the points 1..num_parties
+ *
+ * @param num_parties  Number of points
+ * @param lambda       Output: num_parties coefficients
+ */
+void mpc_net_lagrange_at_zero(uint8_t num_parties, uint8_t *lambda);
+
+/**
+ * Fill in the metadata of a share held by party_id (data is untouched)
+ */
+void mpc_net_share_header(const mpc_context_t *ctx, uint8_t party_id,
+                          mpc_share_t *share);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_CORE_MPC_NET_INTERNAL_H */
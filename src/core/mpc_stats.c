@@ -0,0 +1,127 @@
+#define _GNU_SOURCE
+#include "core/mpc_stats_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *const op_names[MPC_OP_COUNT] = {
+    [MPC_OP_CREATE_SHARES]   = "create_shares",
+    [MPC_OP_RECONSTRUCT]     = "reconstruct",
+    [MPC_OP_ADD]             = "add",
+    [MPC_OP_SUB]             = "sub",
+    [MPC_OP_MUL_CONST]       = "mul_const",
+    [MPC_OP_MUL]             = "mul",
+    [MPC_OP_DOT]             = "dot",
+    [MPC_OP_SUM]             = "sum",
+    [MPC_OP_AVERAGE]         = "average",
+    [MPC_OP_MAX]             = "max",
+    [MPC_OP_GREATER]         = "greater",
+    [MPC_OP_EQUAL]           = "equal",
+    [MPC_OP_INV]             = "inv",
+    [MPC_OP_NET_SHARE_INPUT] = "net_share_input",
+    [MPC_OP_NET_OPEN]        = "net_open",
+    [MPC_OP_NET_MUL]         = "net_mul",
+};
+
+uint64_t mpc_stats_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void mpc_counters_retain(struct mpc_counters *counters) {
+    if (counters != NULL) {
+        atomic_fetch_add_explicit(&counters->refs, 1, memory_order_relaxed);
+    }
+}
+
+void mpc_counters_release(struct mpc_counters *counters) {
+    if (counters != NULL &&
+        atomic_fetch_sub_explicit(&counters->refs, 1,
+                                  memory_order_acq_rel) == 1) {
+        free(counters);
+    }
+}
+
+/* ========================================================================
+ * Public API
+ * ======================================================================== */
+
+int mpc_enable_stats(mpc_context_t *ctx) {
+    if (ctx == NULL) {
+        return -1;
+    }
+
+    if (ctx->counters != NULL) {
+        return 0;
+    }
+
+    struct mpc_counters *counters = malloc(sizeof(struct mpc_counters));
+    if (counters == NULL) {
+        return -1;
+    }
+    atomic_init(&counters->refs, 1);
+    for (int i = 0; i < MPC_COUNTER_COUNT; i++) {
+        atomic_init(&counters->counter[i], 0);
+    }
+    for (int i = 0; i < MPC_OP_COUNT; i++) {
+        atomic_init(&counters->calls[i], 0);
+        atomic_init(&counters->time_ns[i], 0);
+    }
+
+    ctx->counters = counters;
+    return 0;
+}
+
+int mpc_get_stats(const mpc_context_t *ctx, mpc_stats_t *stats) {
+    if (ctx == NULL || ctx->counters == NULL || stats == NULL) {
+        return -1;
+    }
+
+    struct mpc_counters *c = ctx->counters;
+    uint64_t value[MPC_COUNTER_COUNT];
+    for (int i = 0; i < MPC_COUNTER_COUNT; i++) {
+        value[i] = atomic_load_explicit(&c->counter[i], memory_order_relaxed);
+    }
+
+    memset(stats, 0, sizeof(mpc_stats_t));
+    stats->multiplications = value[MPC_COUNTER_MULTIPLICATIONS];
+    stats->reconstructions = value[MPC_COUNTER_RECONSTRUCTIONS];
+    stats->values_shared = value[MPC_COUNTER_VALUES_SHARED];
+    stats->reshares = value[MPC_COUNTER_RESHARES];
+    stats->rounds = value[MPC_COUNTER_ROUNDS];
+    stats->bytes_sent = value[MPC_COUNTER_BYTES_SENT];
+    stats->bytes_received = value[MPC_COUNTER_BYTES_RECEIVED];
+    stats->validation_failures = value[MPC_COUNTER_VALIDATION_FAILURES];
+    stats->secure_allocations = value[MPC_COUNTER_SECURE_ALLOCATIONS];
+
+    for (int i = 0; i < MPC_OP_COUNT; i++) {
+        stats->calls[i] = atomic_load_explicit(&c->calls[i],
+                                               memory_order_relaxed);
+        stats->time_ns[i] = atomic_load_explicit(&c->time_ns[i],
+                                                 memory_order_relaxed);
+    }
+    return 0;
+}
+
+void mpc_reset_stats(const mpc_context_t *ctx) {
+    if (ctx == NULL || ctx->counters == NULL) {
+        return;
+    }
+
+    struct mpc_counters *c = ctx->counters;
+    for (int i = 0; i < MPC_COUNTER_COUNT; i++) {
+        atomic_store_explicit(&c->counter[i], 0, memory_order_relaxed);
+    }
+    for (int i = 0; i < MPC_OP_COUNT; i++) {
+        atomic_store_explicit(&c->calls[i], 0, memory_order_relaxed);
+        atomic_store_explicit(&c->time_ns[i], 0, memory_order_relaxed);
+    }
+}
+
+const char *mpc_op_name(mpc_op_t op) {
+    if ((int)op < 0 || op >= MPC_OP_COUNT) {
+        return "unknown";
+    }
+    return op_names[op];
+}
@@ -0,0 +1,129 @@
+#ifndef SSS_CORE_MPC_STATS_INTERNAL_H
+#define SSS_CORE_MPC_STATS_INTERNAL_H
+
+#include "sss/mpc.h"
+#include "sss/transport.h"
+#include "core/mem_profile_internal.h"
+#include "utils/secure_memory.h"
+#include <stdatomic.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Operation Counters
+ *
+ * Maintained by the operations of mpc.c, mpc_net.c and circuit.c for
+ * contexts that have counting enabled. Every helper does nothing when
+ * ctx or its counters are NULL, so callers need no checks of their own.
+ * ======================================================================== */
+
+typedef enum {
+    MPC_COUNTER_MULTIPLICATIONS,
+    MPC_COUNTER_RECONSTRUCTIONS,
+    MPC_COUNTER_VALUES_SHARED,
+    MPC_COUNTER_RESHARES,
+    MPC_COUNTER_ROUNDS,
+    MPC_COUNTER_BYTES_SENT,
+    MPC_COUNTER_BYTES_RECEIVED,
+    MPC_COUNTER_VALIDATION_FAILURES,
+    MPC_COUNTER_SECURE_ALLOCATIONS,
+    MPC_COUNTER_COUNT
+} mpc_counter_t;
+
+struct mpc_counters {
+    _Atomic uint32_t refs;  // Contexts sharing the counters
+    _Atomic uint64_t counter[MPC_COUNTER_COUNT];
+    _Atomic uint64_t calls[MPC_OP_COUNT];
+    _Atomic uint64_t time_ns[MPC_OP_COUNT];
+};
+
+/**
+ * Take a reference to counters (NULL is ignored)
+ */
+void mpc_counters_retain(struct mpc_counters *counters);
+
+/**
+ * Drop a reference to counters, freeing them with the last one
+ */
+void mpc_counters_release(struct mpc_counters *counters);
+
+/**
+ * Monotonic time in nanoseconds
+ */
+uint64_t mpc_stats_now_ns(void);
+
+static inline void mpc_stats_add(const mpc_context_t *ctx,
+                                 mpc_counter_t counter, uint64_t amount) {
+    if (ctx != NULL && ctx->counters != NULL) {
+        atomic_fetch_add_explicit(&ctx->counters->counter[counter], amount,
+                                  memory_order_relaxed);
+    }
+}
+
+/**
+ * Start timing an operation; returns the start time (0 if not counting)
+ */
+static inline uint64_t mpc_stats_begin(const mpc_context_t *ctx) {
+    return (ctx != NULL && ctx->counters != NULL) ? mpc_stats_now_ns() : 0;
+}
+
+/**
+ * Count one call of op and the time since start
+ */
+static inline void mpc_stats_end(const mpc_context_t *ctx, mpc_op_t op,
+                                 uint64_t start) {
+    if (ctx != NULL && ctx->counters != NULL) {
+        uint64_t elapsed = mpc_stats_now_ns() - start;
+        atomic_fetch_add_explicit(&ctx->counters->calls[op], 1,
+                                  memory_order_relaxed);
+        atomic_fetch_add_explicit(&ctx->counters->time_ns[op], elapsed,
+                                  memory_order_relaxed);
+    }
+}
+
+/**
+ * Count the traffic of a transport since the snapshot before
+ */
+static inline void mpc_stats_traffic(const mpc_context_t *ctx,
+                                     const mpc_transport_t *transport,
+                                     const mpc_transport_stats_t *before) {
+    if (ctx != NULL && ctx->counters != NULL && transport != NULL) {
+        mpc_stats_add(ctx, MPC_COUNTER_ROUNDS,
+                      transport->stats.rounds - before->rounds);
+        mpc_stats_add(ctx, MPC_COUNTER_BYTES_SENT,
+                      transport->stats.bytes_sent - before->bytes_sent);
+        mpc_stats_add(ctx, MPC_COUNTER_BYTES_RECEIVED,
+                      transport->stats.bytes_received - before->bytes_received);
+    }
+}
+
+/**
+ * secure_malloc(), counted against ctx
+ */
+static inline void *mpc_secure_alloc(const mpc_context_t *ctx, size_t size) {
+    mpc_stats_add(ctx, MPC_COUNTER_SECURE_ALLOCATIONS, 1);
+    void *ptr = secure_malloc(size);
+    if (ptr != NULL) {
+        MPC_MEM_ALLOC(size, 1);
+    }
+    return ptr;
+}
+
+/**
+ * secure_free() of a buffer from mpc_secure_alloc(size)
+ */
+static inline void mpc_secure_release(void *ptr, size_t size) {
+    if (ptr != NULL) {
+        MPC_MEM_RELEASE(size, 1);
+    }
+    secure_free(ptr, size);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_CORE_MPC_STATS_INTERNAL_H */
@@ -1,5 +1,6 @@
 #include "sss/polynomial.h"
 #include "sss/field.h"
+#include "core/diff_check_internal.h"
 #include <sodium.h>
 #include <string.h>
 
@@ -57,6 +58,10 @@ uint8_t sss_polynomial_evaluate(
         result = gf256_add(result, poly->coefficients[i]);
     }
     
+    SSS_DIFF_CHECK("sss_polynomial_evaluate",
+                   result == polynomial_evaluate_reference(
+                       poly->coefficients, poly->degree, x),
+                   "coefficients not shown");
     return result;
 }
 
@@ -88,6 +93,10 @@ uint8_t sss_polynomial_interpolate(
         secret = gf256_add(secret, gf256_mul(points_y[i], basis));
     }
     
+    SSS_DIFF_CHECK("sss_polynomial_interpolate",
+                   secret == polynomial_interpolate_reference(
+                       points_x, points_y, num_points),
+                   "share values not shown");
     return secret;
 }
 
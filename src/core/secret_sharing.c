@@ -3,6 +3,8 @@
 #include "sss/polynomial.h"
 #include "utils/random.h"
 #include "utils/error.h"
+#include "core/diff_check_internal.h"
+#include "core/mem_profile_internal.h"
 #include <sodium.h>
 #include <string.h>
 #include <stdlib.h>
@@ -26,6 +28,37 @@ int sss_init(void) {
     return SSS_OK;
 }
 
+/* ========================================================================
+ * Differential Check
+ * ======================================================================== */
+
+#ifdef SSS_DIFFERENTIAL_CHECK
+/**
+ * Whether the first num_points shares interpolate, byte by byte, to
+ * secret under the reference interpolation
+ */
+static int shares_encode(const sss_share_t *shares, uint8_t num_points,
+                         const uint8_t *secret, size_t secret_len) {
+    uint8_t points_x[SSS_MAX_SHARES];
+    uint8_t points_y[SSS_MAX_SHARES];
+    int agrees = 1;
+
+    for (uint8_t i = 0; i < num_points; i++) {
+        points_x[i] = shares[i].index;
+    }
+    for (size_t byte_idx = 0; byte_idx < secret_len; byte_idx++) {
+        for (uint8_t i = 0; i < num_points; i++) {
+            points_y[i] = shares[i].data[byte_idx];
+        }
+        agrees &= (polynomial_interpolate_reference(points_x, points_y,
+                                                    num_points) ==
+                   secret[byte_idx]);
+    }
+    sodium_memzero(points_y, sizeof(points_y));
+    return agrees;
+}
+#endif
+
 /* ========================================================================
  * Input Validation
  * ======================================================================== */
@@ -108,10 +141,12 @@ int sss_create_shares(
     /* Process each byte of the secret */
     for (size_t byte_idx = 0; byte_idx < secret_len; byte_idx++) {
         sss_polynomial_t poly;
+        MPC_MEM_STACK_PUSH(sizeof(poly));
         
         /* Create polynomial with this secret byte as constant term */
         /* Degree = threshold - 1 (e.g., threshold=3 needs degree-2 polynomial) */
         if (sss_polynomial_create(&poly, secret[byte_idx], threshold - 1) != 0) {
+            MPC_MEM_STACK_POP(sizeof(poly));
             return SSS_ERR_CRYPTO;
         }
         
@@ -126,8 +161,12 @@ int sss_create_shares(
         
         /* Wipe polynomial from memory */
         sss_polynomial_wipe(&poly);
+        MPC_MEM_STACK_POP(sizeof(poly));
     }
     
+    SSS_DIFF_CHECK("sss_create_shares",
+                   shares_encode(shares, threshold, secret, secret_len),
+                   "shares do not interpolate to the secret");
     return SSS_OK;
 }
 
@@ -191,6 +230,7 @@ int sss_combine_shares(
         /* Collect x and y coordinates for this byte from all shares */
         uint8_t points_x[SSS_MAX_SHARES];
         uint8_t points_y[SSS_MAX_SHARES];
+        MPC_MEM_STACK_PUSH(sizeof(points_x) + sizeof(points_y));
         
         for (uint8_t i = 0; i < num_shares; i++) {
             points_x[i] = shares[i].index;
@@ -199,8 +239,12 @@ int sss_combine_shares(
         
         /* Use Lagrange interpolation to find P(0) = secret byte */
         secret[byte_idx] = sss_polynomial_interpolate(points_x, points_y, num_shares);
+        MPC_MEM_STACK_POP(sizeof(points_x) + sizeof(points_y));
     }
     
+    SSS_DIFF_CHECK("sss_combine_shares",
+                   shares_encode(shares, num_shares, secret, data_len),
+                   "secret does not match the shares");
     *secret_len = data_len;
     return SSS_OK;
 }
@@ -0,0 +1,271 @@
+#include "sss/session.h"
+#include <string.h>
+#include <stdlib.h>
+
+/* Initial number of slots (a power of two) */
+#define TABLE_INITIAL_CAPACITY 64
+
+/* ========================================================================
+ * Internal Types
+ * ======================================================================== */
+
+struct mpc_session_table {
+    mpc_session_t **slots;          // Open-addressed, NULL when empty
+    size_t capacity;
+    mpc_session_table_stats_t stats;
+};
+
+/* ========================================================================
+ * Hashing and Probing
+ * ======================================================================== */
+
+static uint64_t load_u64_le(const uint8_t *in) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+/**
+ * Home slot of an id
+ *
+ * Random ids would need no mixing, but derived ids differ only in their
+ * low bytes, so both halves are folded and mixed.
+ */
+static size_t session_slot(const mpc_session_id_t *id, size_t capacity) {
+    uint64_t h = load_u64_le(id->bytes) ^
+                 (load_u64_le(id->bytes + 8) * 0x9E3779B97F4A7C15ull);
+    h ^= h >> 32;
+    h *= 0xD6E8FEB86659FD93ull;
+    h ^= h >> 32;
+    return (size_t)h & (capacity - 1);
+}
+
+/**
+ * Slot holding an id, or the empty slot where it would go
+ */
+static size_t session_probe(const mpc_session_table_t *table,
+                            const mpc_session_id_t *id) {
+    size_t mask = table->capacity - 1;
+    size_t i = session_slot(id, table->capacity);
+    while (table->slots[i] != NULL &&
+           memcmp(table->slots[i]->id.bytes, id->bytes,
+                  MPC_SESSION_ID_SIZE) != 0) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static int table_grow(mpc_session_table_t *table) {
+    size_t new_capacity = table->capacity * 2;
+    mpc_session_t **grown = calloc(new_capacity, sizeof(mpc_session_t *));
+    if (grown == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        mpc_session_t *session = table->slots[i];
+        if (session == NULL) {
+            continue;
+        }
+        size_t j = session_slot(&session->id, new_capacity);
+        while (grown[j] != NULL) {
+            j = (j + 1) & (new_capacity - 1);
+        }
+        grown[j] = session;
+    }
+
+    free(table->slots);
+    table->slots = grown;
+    table->capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * Empty slot i, moving later entries of its probe run back into the
+ * hole (backward-shift deletion)
+ */
+static void table_delete_slot(mpc_session_table_t *table, size_t i) {
+    size_t mask = table->capacity - 1;
+
+    for (size_t j = (i + 1) & mask; table->slots[j] != NULL;
+         j = (j + 1) & mask) {
+        size_t home = session_slot(&table->slots[j]->id, table->capacity);
+        // Move j back into the hole unless its home lies in (i, j]
+        int stays = (i <= j) ? (home > i && home <= j) : (home > i || home <= j);
+        if (!stays) {
+            table->slots[i] = table->slots[j];
+            i = j;
+        }
+    }
+    table->slots[i] = NULL;
+}
+
+/**
+ * Unlink the session in slot i and free it
+ */
+static void table_drop(mpc_session_table_t *table, size_t i) {
+    mpc_session_t *session = table->slots[i];
+
+    if (session->state == MPC_SESSION_PENDING) {
+        table->stats.pending--;
+    }
+    table->stats.live--;
+    table->stats.removed++;
+
+    table_delete_slot(table, i);
+    free(session);
+}
+
+/* ========================================================================
+ * Table Management
+ * ======================================================================== */
+
+mpc_session_table_t *mpc_session_table_create(void) {
+    mpc_session_table_t *table = calloc(1, sizeof(mpc_session_table_t));
+    if (table == NULL) {
+        return NULL;
+    }
+
+    table->capacity = TABLE_INITIAL_CAPACITY;
+    table->slots = calloc(table->capacity, sizeof(mpc_session_t *));
+    if (table->slots == NULL) {
+        free(table);
+        return NULL;
+    }
+    return table;
+}
+
+void mpc_session_table_destroy(mpc_session_table_t *table,
+                               mpc_session_release_fn release, void *arg) {
+    if (table == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        mpc_session_t *session = table->slots[i];
+        if (session == NULL) {
+            continue;
+        }
+        if (release != NULL) {
+            release(session, arg);
+        }
+        free(session);
+    }
+
+    free(table->slots);
+    free(table);
+}
+
+/* ========================================================================
+ * Session Operations
+ * ======================================================================== */
+
+mpc_session_t *mpc_session_find(const mpc_session_table_t *table,
+                                const mpc_session_id_t *id) {
+    if (table == NULL || id == NULL) {
+        return NULL;
+    }
+    return table->slots[session_probe(table, id)];
+}
+
+mpc_session_t *mpc_session_add(mpc_session_table_t *table,
+                               const mpc_session_id_t *id,
+                               mpc_session_state_t state, void *data) {
+    if (table == NULL || id == NULL) {
+        return NULL;
+    }
+
+    if (table->slots[session_probe(table, id)] != NULL) {
+        return NULL;
+    }
+
+    // Keep the table at most half full
+    if ((table->stats.live + 1) * 2 > table->capacity &&
+        table_grow(table) != 0) {
+        return NULL;
+    }
+
+    mpc_session_t *session = malloc(sizeof(mpc_session_t));
+    if (session == NULL) {
+        return NULL;
+    }
+    session->id = *id;
+    session->state = state;
+    session->last_active = 0;
+    session->data = data;
+
+    table->slots[session_probe(table, id)] = session;
+
+    if (state == MPC_SESSION_PENDING) {
+        table->stats.pending++;
+    }
+    table->stats.live++;
+    table->stats.added++;
+    if (table->stats.live > table->stats.max_live) {
+        table->stats.max_live = table->stats.live;
+    }
+    return session;
+}
+
+void mpc_session_set_state(mpc_session_table_t *table, mpc_session_t *session,
+                           mpc_session_state_t state) {
+    if (table == NULL || session == NULL || session->state == state) {
+        return;
+    }
+
+    if (state == MPC_SESSION_PENDING) {
+        table->stats.pending++;
+    } else if (session->state == MPC_SESSION_PENDING) {
+        table->stats.pending--;
+    }
+    session->state = state;
+}
+
+void mpc_session_remove(mpc_session_table_t *table, mpc_session_t *session) {
+    if (table == NULL || session == NULL) {
+        return;
+    }
+
+    size_t i = session_probe(table, &session->id);
+    if (table->slots[i] == session) {
+        table_drop(table, i);
+    }
+}
+
+size_t mpc_session_table_expire(mpc_session_table_t *table,
+                                mpc_session_state_t state, uint64_t before,
+                                mpc_session_release_fn release, void *arg) {
+    if (table == NULL) {
+        return 0;
+    }
+
+    size_t dropped = 0;
+    size_t i = 0;
+    while (i < table->capacity) {
+        mpc_session_t *session = table->slots[i];
+        if (session == NULL || session->state != state ||
+            session->last_active >= before) {
+            i++;
+            continue;
+        }
+
+        if (release != NULL) {
+            release(session, arg);
+        }
+        table_drop(table, i);
+        table->stats.expired++;
+        dropped++;
+        // Slot i now holds a later entry of the run (or is empty)
+    }
+    return dropped;
+}
+
+void mpc_session_table_get_stats(const mpc_session_table_t *table,
+                                 mpc_session_table_stats_t *stats) {
+    if (table == NULL || stats == NULL) {
+        return;
+    }
+    *stats = table->stats;
+}
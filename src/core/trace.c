@@ -0,0 +1,191 @@
+#define _GNU_SOURCE
+#include "core/trace_internal.h"
+
+#ifdef SSS_TRACE
+#include "core/mpc_stats_internal.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char *name;
+    uint64_t ts_ns;
+    uint64_t bytes;
+    mpc_session_id_t session;
+    uint8_t party;
+    char phase;                     // 'B' (begin) or 'E' (end)
+} trace_event_t;
+
+/*
+ * One per thread. Only the owning thread writes events; head counts the
+ * events written and is published with release order, so a reader that
+ * loads it with acquire sees every event before it.
+ */
+typedef struct trace_ring {
+    struct trace_ring *next;        // All rings, newest first
+    unsigned tid;
+    _Atomic uint64_t head;
+    _Atomic uint64_t start;         // Events before this were cleared
+    trace_event_t events[MPC_TRACE_RING_SIZE];
+} trace_ring_t;
+
+static _Atomic(trace_ring_t *) rings;
+static _Atomic unsigned next_tid = 1;
+static _Thread_local trace_ring_t *ring;
+
+/* ========================================================================
+ * Recording
+ * ======================================================================== */
+
+static trace_ring_t *ring_create(void) {
+    trace_ring_t *r = calloc(1, sizeof(trace_ring_t));
+    if (r == NULL) {
+        return NULL;
+    }
+    r->tid = atomic_fetch_add(&next_tid, 1);
+    atomic_init(&r->head, 0);
+    atomic_init(&r->start, 0);
+
+    // Push onto the list of rings; rings live until the process exits,
+    // so the spans of finished threads can still be dumped
+    trace_ring_t *first = atomic_load(&rings);
+    do {
+        r->next = first;
+    } while (!atomic_compare_exchange_weak(&rings, &first, r));
+    return r;
+}
+
+void mpc_trace_event(char phase, const char *name, const mpc_context_t *ctx,
+                     uint8_t party, uint64_t bytes) {
+    if (ring == NULL && (ring = ring_create()) == NULL) {
+        return;
+    }
+
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    trace_event_t *event = &ring->events[head % MPC_TRACE_RING_SIZE];
+    event->name = name;
+    event->ts_ns = mpc_stats_now_ns();
+    event->bytes = bytes;
+    if (ctx != NULL) {
+        event->session = ctx->session_id;
+    } else {
+        memset(&event->session, 0, sizeof(event->session));
+    }
+    event->party = party;
+    event->phase = phase;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+/* ========================================================================
+ * Chrome Trace Output
+ * ======================================================================== */
+
+/**
+ * First event of a ring still held and not cleared
+ */
+static uint64_t ring_first(trace_ring_t *r, uint64_t head) {
+    uint64_t start = atomic_load_explicit(&r->start, memory_order_relaxed);
+    uint64_t oldest = (head > MPC_TRACE_RING_SIZE)
+                      ? head - MPC_TRACE_RING_SIZE : 0;
+    return start > oldest ? start : oldest;
+}
+
+static void dump_ring(FILE *out, trace_ring_t *r, int *first_event) {
+    uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    unsigned depth = 0;
+
+    for (uint64_t i = ring_first(r, head); i < head; i++) {
+        const trace_event_t *event = &r->events[i % MPC_TRACE_RING_SIZE];
+
+        // An end whose begin was overwritten would confuse the viewer
+        if (event->phase == 'E') {
+            if (depth == 0) {
+                continue;
+            }
+            depth--;
+        } else {
+            depth++;
+        }
+
+        char session[MPC_SESSION_ID_HEX_SIZE];
+        mpc_session_id_to_hex(&event->session, session);
+        fprintf(out,
+                "%s\n    {\"name\": \"%s\", \"cat\": \"mpc\", \"ph\": \"%c\", "
+                "\"ts\": %.3f, \"pid\": %u, \"tid\": %u, "
+                "\"args\": {\"session\": \"%s\", \"bytes\": %llu}}",
+                *first_event ? "" : ",", event->name, event->phase,
+                (double)event->ts_ns / 1e3, event->party, r->tid, session,
+                (unsigned long long)event->bytes);
+        *first_event = 0;
+    }
+}
+
+int mpc_trace_dump(const char *path) {
+    if (path == NULL) {
+        return -1;
+    }
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        return -1;
+    }
+
+    fprintf(out, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+    int first_event = 1;
+    for (trace_ring_t *r = atomic_load(&rings); r != NULL; r = r->next) {
+        dump_ring(out, r, &first_event);
+    }
+    fprintf(out, "\n]}\n");
+
+    int error = ferror(out);
+    error |= (fclose(out) != 0);
+    return error ? -1 : 0;
+}
+
+void mpc_trace_clear(void) {
+    for (trace_ring_t *r = atomic_load(&rings); r != NULL; r = r->next) {
+        atomic_store_explicit(&r->start,
+                              atomic_load_explicit(&r->head,
+                                                   memory_order_acquire),
+                              memory_order_relaxed);
+    }
+}
+
+size_t mpc_trace_dropped(void) {
+    size_t dropped = 0;
+    for (trace_ring_t *r = atomic_load(&rings); r != NULL; r = r->next) {
+        uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+        uint64_t start = atomic_load_explicit(&r->start, memory_order_relaxed);
+        uint64_t first = ring_first(r, head);
+        dropped += (size_t)(first - start);
+    }
+    return dropped;
+}
+
+int mpc_trace_enabled(void) {
+    return 1;
+}
+
+#else
+
+/* ========================================================================
+ * Tracing Not Built In
+ * ======================================================================== */
+
+int mpc_trace_enabled(void) {
+    return 0;
+}
+
+int mpc_trace_dump(const char *path) {
+    (void)path;
+    return -1;
+}
+
+void mpc_trace_clear(void) {
+}
+
+size_t mpc_trace_dropped(void) {
+    return 0;
+}
+
+#endif
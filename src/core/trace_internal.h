@@ -0,0 +1,61 @@
+#ifndef SSS_CORE_TRACE_INTERNAL_H
+#define SSS_CORE_TRACE_INTERNAL_H
+
+#include "sss/mpc.h"
+#include "sss/trace.h"
+#include "sss/transport.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * Trace Hooks
+ *
+ * MPC_TRACE_BEGIN and MPC_TRACE_END bracket a span. Names must be string
+ * literals (only the pointer is recorded), and spans must nest on each
+ * thread. Without SSS_TRACE the hooks compile to nothing, arguments
+ * included.
+ * ======================================================================== */
+
+/**
+ * Bytes of share data in a number of shares of ctx (0 without a context)
+ */
+static inline uint64_t mpc_trace_share_bytes(const mpc_context_t *ctx,
+                                             size_t shares) {
+    return ctx != NULL ? (uint64_t)shares * ctx->value_size : 0;
+}
+
+/**
+ * Party of the spans of a networked operation (0 without a transport)
+ */
+static inline uint8_t mpc_trace_party(const mpc_transport_t *transport) {
+    return transport != NULL ? transport->party_id : 0;
+}
+
+#ifdef SSS_TRACE
+
+/**
+ * Record one event in the ring of the calling thread
+ */
+void mpc_trace_event(char phase, const char *name, const mpc_context_t *ctx,
+                     uint8_t party, uint64_t bytes);
+
+#define MPC_TRACE_BEGIN(ctx, name, party, bytes) \
+    mpc_trace_event('B', (name), (ctx), (party), (bytes))
+#define MPC_TRACE_END(ctx, name, party, bytes) \
+    mpc_trace_event('E', (name), (ctx), (party), (bytes))
+
+#else
+
+#define MPC_TRACE_BEGIN(ctx, name, party, bytes) ((void)0)
+#define MPC_TRACE_END(ctx, name, party, bytes) ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSS_CORE_TRACE_INTERNAL_H */
@@ -0,0 +1,798 @@
+#define _GNU_SOURCE
+#include "sss/runtime.h"
+#include "sss/session.h"
+#include "utils/secure_memory.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* Size of the length prefix in front of every frame */
+#define FRAME_HEADER_SIZE 4
+
+/* Size of the (session id, length) header in front of every record */
+#define RECORD_HEADER_SIZE (MPC_SESSION_ID_SIZE + 4)
+
+/* Largest frame written; bigger passes are split across frames */
+#define MAX_FRAME (64u * 1024u)
+
+/* Bytes requested per read() */
+#define READ_CHUNK (64u * 1024u)
+
+/* Events handled per epoll_wait() call */
+#define MAX_EVENTS 64
+
+/* ========================================================================
+ * Internal Types
+ * ======================================================================== */
+
+typedef struct msg_node {
+    struct msg_node *next;
+    size_t len;
+    uint8_t data[];
+} msg_node_t;
+
+typedef struct {
+    msg_node_t *head;
+    msg_node_t *tail;
+    size_t count;
+} msg_queue_t;
+
+struct mpc_job {
+    mpc_runtime_t *runtime;
+    mpc_session_t *session;         // PENDING until the job is submitted
+    mpc_job_step_fn step;           // NULL until submitted
+    void *arg;
+    mpc_job_t *run_next;
+    int runnable;                   // On the run list
+    msg_queue_t queues[];           // Per-party inbound messages
+};
+
+/* Bytes waiting to be written to a peer */
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t capacity;
+    size_t written;                 // Bytes already written to the socket
+    size_t closed;                  // End of the last complete frame
+    size_t frame_start;             // Start of the open frame
+    int frame_open;
+} out_buffer_t;
+
+/* Bytes read from a peer but not yet parsed */
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t capacity;
+} in_buffer_t;
+
+typedef struct {
+    int fd;                         // -1 for self
+    int saved_flags;                // fcntl() flags to restore on destroy
+    int closed;                     // Peer hung up
+    int want_write;                 // EPOLLOUT is registered
+    out_buffer_t out;
+    in_buffer_t in;
+} peer_t;
+
+struct mpc_runtime {
+    uint8_t party_id;
+    uint8_t num_parties;
+    int epoll_fd;
+    peer_t *peers;                  // One per party (index party - 1)
+    size_t open_peers;
+
+    // Jobs (submitted or waiting to be), keyed by session id
+    mpc_session_table_t *sessions;
+    size_t live_jobs;               // Submitted and not finished
+    uint64_t clock;                 // Scheduling passes since creation
+
+    mpc_job_t *run_head;
+    mpc_job_t *run_tail;
+    int failed;                     // A job failed during the current run
+
+    mpc_runtime_stats_t stats;
+};
+
+/* ========================================================================
+ * Helpers
+ * ======================================================================== */
+
+static void put_u32_le(uint8_t *out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_u32_le(const uint8_t *in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) |
+           ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+/**
+ * Make room for at least need bytes in a growable buffer holding len
+ * bytes. The buffers carry shares, so the old block is wiped rather than
+ * handed to realloc().
+ */
+static int grow_bytes(uint8_t **data, size_t *capacity, size_t len,
+                      size_t need) {
+    if (need <= *capacity) {
+        return 0;
+    }
+
+    size_t new_capacity = (*capacity > 0) ? *capacity : 4096;
+    while (new_capacity < need) {
+        new_capacity *= 2;
+    }
+
+    uint8_t *grown = malloc(new_capacity);
+    if (grown == NULL) {
+        return -1;
+    }
+    if (len > 0) {
+        memcpy(grown, *data, len);
+    }
+    if (*data != NULL) {
+        secure_wipe(*data, *capacity);
+        free(*data);
+    }
+    *data = grown;
+    *capacity = new_capacity;
+    return 0;
+}
+
+static void queue_clear(msg_queue_t *queue) {
+    msg_node_t *node = queue->head;
+    while (node != NULL) {
+        msg_node_t *next = node->next;
+        secure_wipe(node->data, node->len);
+        free(node);
+        node = next;
+    }
+    queue->head = NULL;
+    queue->tail = NULL;
+    queue->count = 0;
+}
+
+static int queue_push(msg_queue_t *queue, const void *data, size_t len) {
+    msg_node_t *node = malloc(sizeof(msg_node_t) + len);
+    if (node == NULL) {
+        return -1;
+    }
+
+    node->next = NULL;
+    node->len = len;
+    if (len > 0) {
+        memcpy(node->data, data, len);
+    }
+
+    if (queue->tail != NULL) {
+        queue->tail->next = node;
+    } else {
+        queue->head = node;
+    }
+    queue->tail = node;
+    queue->count++;
+    return 0;
+}
+
+/* ========================================================================
+ * Job Table
+ * ======================================================================== */
+
+/**
+ * Find a job, creating a not-yet-submitted (PENDING) entry if there is none
+ */
+static mpc_job_t *job_get(mpc_runtime_t *rt, const mpc_session_id_t *id) {
+    mpc_session_t *session = mpc_session_find(rt->sessions, id);
+    if (session != NULL) {
+        return session->data;
+    }
+
+    mpc_job_t *job = calloc(1, sizeof(mpc_job_t) +
+                               rt->num_parties * sizeof(msg_queue_t));
+    if (job == NULL) {
+        return NULL;
+    }
+
+    job->session = mpc_session_add(rt->sessions, id, MPC_SESSION_PENDING, job);
+    if (job->session == NULL) {
+        free(job);
+        return NULL;
+    }
+    job->runtime = rt;
+    job->session->last_active = rt->clock;
+    return job;
+}
+
+static void job_free(mpc_job_t *job) {
+    for (uint8_t i = 0; i < job->runtime->num_parties; i++) {
+        queue_clear(&job->queues[i]);
+    }
+    free(job);
+}
+
+/**
+ * Free the job of a session dropped from the table
+ */
+static void job_release(mpc_session_t *session, void *arg) {
+    (void)arg;
+    job_free(session->data);
+}
+
+/**
+ * Unlink a job from the table and free it
+ */
+static void job_remove(mpc_runtime_t *rt, mpc_job_t *job) {
+    mpc_session_remove(rt->sessions, job->session);
+    job_free(job);
+}
+
+static void job_make_runnable(mpc_runtime_t *rt, mpc_job_t *job) {
+    if (job->runnable || job->step == NULL) {
+        return;
+    }
+
+    job->runnable = 1;
+    job->run_next = NULL;
+    if (rt->run_tail != NULL) {
+        rt->run_tail->run_next = job;
+    } else {
+        rt->run_head = job;
+    }
+    rt->run_tail = job;
+}
+
+/* ========================================================================
+ * Outbound Frames
+ * ======================================================================== */
+
+static void frame_close(mpc_runtime_t *rt, out_buffer_t *out) {
+    if (!out->frame_open) {
+        return;
+    }
+
+    size_t payload = out->len - out->frame_start - FRAME_HEADER_SIZE;
+    put_u32_le(&out->data[out->frame_start], (uint32_t)payload);
+    out->closed = out->len;
+    out->frame_open = 0;
+    rt->stats.frames_sent++;
+}
+
+/**
+ * Append one record to a peer's open frame, starting a new frame when
+ * there is none or the record would make it exceed MAX_FRAME
+ */
+static int frame_append(mpc_runtime_t *rt, peer_t *peer,
+                        const mpc_session_id_t *session,
+                        const void *data, size_t len) {
+    out_buffer_t *out = &peer->out;
+    size_t record = RECORD_HEADER_SIZE + len;
+
+    if (out->frame_open &&
+        out->len - out->frame_start - FRAME_HEADER_SIZE + record > MAX_FRAME) {
+        frame_close(rt, out);
+    }
+
+    size_t need = out->len + record +
+                  (out->frame_open ? 0 : FRAME_HEADER_SIZE);
+    if (grow_bytes(&out->data, &out->capacity, out->len, need) != 0) {
+        return -1;
+    }
+
+    if (!out->frame_open) {
+        out->frame_start = out->len;
+        out->len += FRAME_HEADER_SIZE;
+        out->frame_open = 1;
+    }
+
+    memcpy(&out->data[out->len], session->bytes, MPC_SESSION_ID_SIZE);
+    put_u32_le(&out->data[out->len + MPC_SESSION_ID_SIZE], (uint32_t)len);
+    if (len > 0) {
+        memcpy(&out->data[out->len + RECORD_HEADER_SIZE], data, len);
+    }
+    out->len += record;
+    return 0;
+}
+
+static int peer_watch(mpc_runtime_t *rt, uint8_t party, int want_write) {
+    peer_t *peer = &rt->peers[party - 1];
+    if (peer->want_write == want_write) {
+        return 0;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | (want_write ? EPOLLOUT : 0);
+    ev.data.u32 = party;
+    if (epoll_ctl(rt->epoll_fd, EPOLL_CTL_MOD, peer->fd, &ev) != 0) {
+        return -1;
+    }
+    peer->want_write = want_write;
+    return 0;
+}
+
+/**
+ * Write as many complete frames to a peer as the socket accepts
+ */
+static int peer_write(mpc_runtime_t *rt, uint8_t party) {
+    peer_t *peer = &rt->peers[party - 1];
+    out_buffer_t *out = &peer->out;
+
+    while (out->written < out->closed) {
+        ssize_t n = send(peer->fd, &out->data[out->written],
+                         out->closed - out->written, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return -1;
+        }
+        out->written += (size_t)n;
+        rt->stats.bytes_sent += (uint64_t)n;
+    }
+
+    if (out->written == out->closed && out->written > 0) {
+        // Everything complete is out: move the open frame (if any) down
+        size_t keep = out->len - out->closed;
+        memmove(out->data, &out->data[out->closed], keep);
+        secure_wipe(&out->data[keep], out->len - keep);
+        out->frame_start -= out->closed;
+        out->len = keep;
+        out->written = 0;
+        out->closed = 0;
+    }
+
+    return peer_watch(rt, party, out->written < out->closed);
+}
+
+/**
+ * End the scheduling pass: close every open frame and start writing it
+ */
+static int flush_frames(mpc_runtime_t *rt) {
+    for (uint8_t p = 1; p <= rt->num_parties; p++) {
+        peer_t *peer = &rt->peers[p - 1];
+        if (p == rt->party_id || peer->closed) {
+            continue;
+        }
+
+        frame_close(rt, &peer->out);
+        if (peer->out.written < peer->out.closed && !peer->want_write &&
+            peer_write(rt, p) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int output_pending(const mpc_runtime_t *rt) {
+    for (uint8_t p = 1; p <= rt->num_parties; p++) {
+        const peer_t *peer = &rt->peers[p - 1];
+        if (p != rt->party_id && !peer->closed &&
+            peer->out.written < peer->out.closed) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* ========================================================================
+ * Inbound Frames
+ * ======================================================================== */
+
+/**
+ * Route the records of one frame to their jobs
+ */
+static int deliver_frame(mpc_runtime_t *rt, uint8_t from,
+                         const uint8_t *frame, size_t len) {
+    size_t pos = 0;
+    while (pos < len) {
+        if (len - pos < RECORD_HEADER_SIZE) {
+            return -1;
+        }
+        mpc_session_id_t session;
+        memcpy(session.bytes, &frame[pos], MPC_SESSION_ID_SIZE);
+        size_t record_len = get_u32_le(&frame[pos + MPC_SESSION_ID_SIZE]);
+        pos += RECORD_HEADER_SIZE;
+        if (record_len > len - pos) {
+            return -1;
+        }
+
+        mpc_job_t *job = job_get(rt, &session);
+        if (job == NULL ||
+            queue_push(&job->queues[from - 1], &frame[pos], record_len) != 0) {
+            return -1;
+        }
+        job->session->last_active = rt->clock;
+        job_make_runnable(rt, job);
+
+        pos += record_len;
+        rt->stats.messages_received++;
+    }
+
+    rt->stats.frames_received++;
+    return 0;
+}
+
+/**
+ * Read everything a peer has sent and deliver each complete frame
+ */
+static int peer_read(mpc_runtime_t *rt, uint8_t party) {
+    peer_t *peer = &rt->peers[party - 1];
+    in_buffer_t *in = &peer->in;
+
+    for (;;) {
+        if (grow_bytes(&in->data, &in->capacity, in->len,
+                       in->len + READ_CHUNK) != 0) {
+            return -1;
+        }
+
+        ssize_t n = recv(peer->fd, &in->data[in->len], in->capacity - in->len,
+                         0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return -1;
+        }
+        if (n == 0) {
+            // Hung up: stop watching, but keep what has been received
+            epoll_ctl(rt->epoll_fd, EPOLL_CTL_DEL, peer->fd, NULL);
+            peer->closed = 1;
+            rt->open_peers--;
+            break;
+        }
+        in->len += (size_t)n;
+        rt->stats.bytes_received += (uint64_t)n;
+    }
+
+    // Deliver the complete frames, keeping a partial one for later
+    size_t pos = 0;
+    while (in->len - pos >= FRAME_HEADER_SIZE) {
+        size_t frame_len = get_u32_le(&in->data[pos]);
+        if (frame_len > MPC_TRANSPORT_MAX_MESSAGE) {
+            return -1;
+        }
+        if (in->len - pos - FRAME_HEADER_SIZE < frame_len) {
+            break;
+        }
+        if (deliver_frame(rt, party, &in->data[pos + FRAME_HEADER_SIZE],
+                          frame_len) != 0) {
+            return -1;
+        }
+        pos += FRAME_HEADER_SIZE + frame_len;
+    }
+
+    // Move the partial frame down and wipe the delivered bytes it leaves
+    memmove(in->data, &in->data[pos], in->len - pos);
+    secure_wipe(&in->data[in->len - pos], pos);
+    in->len -= pos;
+
+    // A frame cut short by a hang-up will never complete
+    return (peer->closed && in->len > 0) ? -1 : 0;
+}
+
+/* ========================================================================
+ * Runtime
+ * ======================================================================== */
+
+mpc_runtime_t *mpc_runtime_create(mpc_transport_t *endpoint) {
+    if (endpoint == NULL) {
+        return NULL;
+    }
+
+    mpc_runtime_t *rt = calloc(1, sizeof(mpc_runtime_t));
+    if (rt == NULL) {
+        return NULL;
+    }
+    rt->party_id = endpoint->party_id;
+    rt->num_parties = endpoint->num_parties;
+    rt->epoll_fd = -1;
+
+    rt->peers = calloc(rt->num_parties, sizeof(peer_t));
+    rt->sessions = mpc_session_table_create();
+    if (rt->peers == NULL || rt->sessions == NULL) {
+        mpc_runtime_destroy(rt);
+        return NULL;
+    }
+
+    for (uint8_t p = 1; p <= rt->num_parties; p++) {
+        rt->peers[p - 1].fd = -1;
+    }
+
+    rt->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (rt->epoll_fd < 0) {
+        mpc_runtime_destroy(rt);
+        return NULL;
+    }
+
+    for (uint8_t p = 1; p <= rt->num_parties; p++) {
+        if (p == rt->party_id) {
+            continue;
+        }
+
+        int fd = mpc_transport_socket_fd(endpoint, p);
+        int flags = (fd >= 0) ? fcntl(fd, F_GETFL) : -1;
+        if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+            mpc_runtime_destroy(rt);
+            return NULL;
+        }
+
+        peer_t *peer = &rt->peers[p - 1];
+        peer->fd = fd;
+        peer->saved_flags = flags;
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u32 = p;
+        if (epoll_ctl(rt->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            mpc_runtime_destroy(rt);
+            return NULL;
+        }
+        rt->open_peers++;
+    }
+
+    return rt;
+}
+
+void mpc_runtime_destroy(mpc_runtime_t *runtime) {
+    if (runtime == NULL) {
+        return;
+    }
+
+    mpc_session_table_destroy(runtime->sessions, job_release, NULL);
+
+    if (runtime->peers != NULL) {
+        for (uint8_t p = 1; p <= runtime->num_parties; p++) {
+            peer_t *peer = &runtime->peers[p - 1];
+            if (peer->fd >= 0) {
+                fcntl(peer->fd, F_SETFL, peer->saved_flags);
+            }
+            if (peer->out.data != NULL) {
+                secure_wipe(peer->out.data, peer->out.len);
+            }
+            if (peer->in.data != NULL) {
+                secure_wipe(peer->in.data, peer->in.len);
+            }
+            free(peer->out.data);
+            free(peer->in.data);
+        }
+        free(runtime->peers);
+    }
+
+    if (runtime->epoll_fd >= 0) {
+        close(runtime->epoll_fd);
+    }
+    free(runtime);
+}
+
+int mpc_runtime_submit(mpc_runtime_t *runtime, const mpc_session_id_t *session,
+                       mpc_job_step_fn step, void *arg) {
+    if (runtime == NULL || session == NULL || step == NULL) {
+        return -1;
+    }
+
+    // Messages may already be waiting under this id
+    mpc_job_t *job = job_get(runtime, session);
+    if (job == NULL || job->step != NULL) {
+        return -1;
+    }
+
+    job->step = step;
+    job->arg = arg;
+    mpc_session_set_state(runtime->sessions, job->session, MPC_SESSION_ACTIVE);
+    job->session->last_active = runtime->clock;
+    job_make_runnable(runtime, job);
+
+    runtime->live_jobs++;
+    if (runtime->live_jobs > runtime->stats.max_live_jobs) {
+        runtime->stats.max_live_jobs = runtime->live_jobs;
+    }
+    return 0;
+}
+
+/**
+ * Run every job on the run list once
+ */
+static void run_pass(mpc_runtime_t *rt) {
+    mpc_job_t *job = rt->run_head;
+    rt->run_head = NULL;
+    rt->run_tail = NULL;
+
+    while (job != NULL) {
+        mpc_job_t *next = job->run_next;
+        job->runnable = 0;
+
+        mpc_job_status_t status = job->step(job, job->arg);
+        if (status != MPC_JOB_PENDING) {
+            if (status == MPC_JOB_DONE) {
+                rt->stats.jobs_completed++;
+            } else {
+                rt->stats.jobs_failed++;
+                rt->failed = 1;
+            }
+            rt->live_jobs--;
+            job_remove(rt, job);
+        }
+        job = next;
+    }
+
+    rt->stats.passes++;
+    rt->clock++;
+}
+
+int mpc_runtime_run(mpc_runtime_t *runtime, int timeout_ms) {
+    if (runtime == NULL) {
+        return -1;
+    }
+
+    mpc_runtime_t *rt = runtime;
+    struct epoll_event events[MAX_EVENTS];
+    rt->failed = 0;
+
+    for (;;) {
+        // Step 1: Run the jobs that can make progress, then send their
+        // messages as one frame per peer
+        if (rt->run_head != NULL) {
+            run_pass(rt);
+        }
+        if (flush_frames(rt) != 0) {
+            return -1;
+        }
+
+        int writing = output_pending(rt);
+        if (rt->live_jobs == 0 && !writing) {
+            break;
+        }
+        if (rt->run_head != NULL) {
+            continue;
+        }
+
+        // Nothing can arrive any more for the jobs still waiting
+        if (rt->open_peers == 0) {
+            return -1;
+        }
+
+        // Step 2: Wait for messages or for room to write
+        int n = epoll_wait(rt->epoll_fd, events, MAX_EVENTS, timeout_ms);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (n == 0) {
+            return -1;
+        }
+
+        for (int i = 0; i < n; i++) {
+            uint8_t party = (uint8_t)events[i].data.u32;
+            peer_t *peer = &rt->peers[party - 1];
+
+            if ((events[i].events & EPOLLOUT) && !peer->closed &&
+                peer_write(rt, party) != 0) {
+                return -1;
+            }
+            if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) &&
+                !peer->closed && peer_read(rt, party) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    return rt->failed ? -1 : 0;
+}
+
+size_t mpc_runtime_live_jobs(const mpc_runtime_t *runtime) {
+    return (runtime != NULL) ? runtime->live_jobs : 0;
+}
+
+size_t mpc_runtime_expire(mpc_runtime_t *runtime, uint64_t idle_passes) {
+    if (runtime == NULL || runtime->clock < idle_passes) {
+        return 0;
+    }
+
+    return mpc_session_table_expire(runtime->sessions, MPC_SESSION_PENDING,
+                                    runtime->clock - idle_passes,
+                                    job_release, NULL);
+}
+
+void mpc_runtime_get_stats(const mpc_runtime_t *runtime,
+                           mpc_runtime_stats_t *stats) {
+    if (runtime == NULL || stats == NULL) {
+        return;
+    }
+    *stats = runtime->stats;
+}
+
+void mpc_runtime_reset_stats(mpc_runtime_t *runtime) {
+    if (runtime != NULL) {
+        memset(&runtime->stats, 0, sizeof(runtime->stats));
+    }
+}
+
+/* ========================================================================
+ * Job Messaging
+ * ======================================================================== */
+
+const mpc_session_id_t *mpc_job_session(const mpc_job_t *job) {
+    return &job->session->id;
+}
+
+uint8_t mpc_job_party_id(const mpc_job_t *job) {
+    return job->runtime->party_id;
+}
+
+uint8_t mpc_job_num_parties(const mpc_job_t *job) {
+    return job->runtime->num_parties;
+}
+
+int mpc_job_send(mpc_job_t *job, uint8_t to, const void *data, size_t len) {
+    if (job == NULL || (data == NULL && len > 0)) {
+        return -1;
+    }
+
+    mpc_runtime_t *rt = job->runtime;
+    if (to < 1 || to > rt->num_parties || len > MAX_FRAME - RECORD_HEADER_SIZE) {
+        return -1;
+    }
+
+    if (to == rt->party_id) {
+        return queue_push(&job->queues[to - 1], data, len);
+    }
+
+    if (rt->peers[to - 1].closed ||
+        frame_append(rt, &rt->peers[to - 1], &job->session->id, data,
+                     len) != 0) {
+        return -1;
+    }
+    rt->stats.messages_sent++;
+    return 0;
+}
+
+size_t mpc_job_pending(const mpc_job_t *job, uint8_t from) {
+    if (job == NULL || from < 1 || from > job->runtime->num_parties) {
+        return 0;
+    }
+    return job->queues[from - 1].count;
+}
+
+int mpc_job_recv(mpc_job_t *job, uint8_t from, void *buffer,
+                 size_t capacity, size_t *len) {
+    if (job == NULL || len == NULL || from < 1 ||
+        from > job->runtime->num_parties) {
+        return -1;
+    }
+
+    msg_queue_t *queue = &job->queues[from - 1];
+    msg_node_t *node = queue->head;
+    if (node == NULL || node->len > capacity) {
+        return -1;
+    }
+
+    if (node->len > 0) {
+        memcpy(buffer, node->data, node->len);
+    }
+    *len = node->len;
+
+    queue->head = node->next;
+    if (queue->head == NULL) {
+        queue->tail = NULL;
+    }
+    queue->count--;
+
+    secure_wipe(node->data, node->len);
+    free(node);
+    return 0;
+}
@@ -0,0 +1,279 @@
+#include "sss/runtime.h"
+#include "core/mpc_net_internal.h"
+#include "sss/secret_sharing.h"
+#include "sss/field.h"
+#include "utils/secure_memory.h"
+#include <string.h>
+
+/* ========================================================================
+ * Asynchronous Protocols
+ *
+ * Each protocol has two phases: phase 0 sends this party's messages and
+ * moves on to phase 1, which completes as soon as every message the
+ * protocol needs is queued for the job. Messages from a peer that is
+ * already further ahead stay queued behind them for the next call.
+ * ======================================================================== */
+
+/* Phases of a protocol call */
+#define PHASE_SEND 0
+#define PHASE_WAIT 1
+
+/**
+ * Check the arguments shared by every asynchronous protocol
+ */
+static int async_check(const mpc_job_t *job, const mpc_async_op_t *op,
+                       const mpc_context_t *ctx) {
+    if (job == NULL || op == NULL || ctx == NULL) {
+        return -1;
+    }
+
+    if (mpc_job_num_parties(job) != ctx->num_parties) {
+        return -1;
+    }
+
+    // Shares carry at most SSS_SHARE_DATA_SIZE bytes per value
+    if (ctx->value_size > SSS_SHARE_DATA_SIZE) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Whether count messages from every party but skip (0 = none) are queued
+ */
+static int async_ready(const mpc_job_t *job, uint8_t skip, size_t count) {
+    for (unsigned p = 1; p <= mpc_job_num_parties(job); p++) {
+        if (p != skip && mpc_job_pending(job, p) < count) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Take one share-sized message from a party
+ */
+static int async_recv_value(const mpc_context_t *ctx, mpc_job_t *job,
+                            uint8_t from, uint8_t *data) {
+    size_t len = 0;
+    if (mpc_job_recv(job, from, data, SSS_SHARE_DATA_SIZE, &len) != 0) {
+        return -1;
+    }
+    return (len == ctx->value_size) ? 0 : -1;
+}
+
+/**
+ * Finish a protocol call, readying op for the next one
+ */
+static mpc_job_status_t async_finish(mpc_async_op_t *op, int result) {
+    op->phase = PHASE_SEND;
+    return (result == 0) ? MPC_JOB_DONE : MPC_JOB_FAILED;
+}
+
+/* ========================================================================
+ * Input and Output
+ * ======================================================================== */
+
+mpc_job_status_t mpc_async_share_input(mpc_job_t *job, mpc_async_op_t *op,
+                                       const mpc_context_t *ctx,
+                                       uint8_t dealer, const uint8_t *secrets,
+                                       mpc_share_t *shares, size_t count) {
+    // Validate inputs
+    if (async_check(job, op, ctx) != 0 || shares == NULL) {
+        return MPC_JOB_FAILED;
+    }
+
+    if (dealer < 1 || dealer > ctx->num_parties) {
+        return MPC_JOB_FAILED;
+    }
+
+    uint8_t me = mpc_job_party_id(job);
+
+    if (me == dealer) {
+        if (secrets == NULL && count > 0) {
+            return MPC_JOB_FAILED;
+        }
+
+        // The dealer only sends, so it never waits
+        mpc_share_t set[SSS_MAX_SHARES];
+        int result = 0;
+        for (size_t k = 0; k < count && result == 0; k++) {
+            result = mpc_create_shares(ctx, &secrets[k * ctx->value_size], set);
+            for (uint8_t peer = 1; peer <= ctx->num_parties && result == 0;
+                 peer++) {
+                if (peer != me) {
+                    result = mpc_job_send(job, peer, set[peer - 1].share.data,
+                                          ctx->value_size);
+                }
+            }
+            if (result == 0) {
+                shares[k] = set[me - 1];
+            }
+        }
+        secure_wipe(set, sizeof(set));
+        return async_finish(op, result);
+    }
+
+    // Other parties only receive
+    if (mpc_job_pending(job, dealer) < count) {
+        op->phase = PHASE_WAIT;
+        return MPC_JOB_PENDING;
+    }
+
+    int result = 0;
+    for (size_t k = 0; k < count && result == 0; k++) {
+        mpc_net_share_header(ctx, me, &shares[k]);
+        result = async_recv_value(ctx, job, dealer, shares[k].share.data);
+    }
+    return async_finish(op, result);
+}
+
+mpc_job_status_t mpc_async_open(mpc_job_t *job, mpc_async_op_t *op,
+                                const mpc_context_t *ctx,
+                                const mpc_share_t *shares, uint8_t *values,
+                                size_t count) {
+    // Validate inputs
+    if (async_check(job, op, ctx) != 0 || shares == NULL || values == NULL) {
+        return MPC_JOB_FAILED;
+    }
+
+    uint8_t me = mpc_job_party_id(job);
+    uint8_t n = ctx->num_parties;
+
+    // Phase 0: Broadcast every share
+    if (op->phase == PHASE_SEND) {
+        for (size_t k = 0; k < count; k++) {
+            if (mpc_validate_share(ctx, &shares[k]) != 0 ||
+                shares[k].party_id != me) {
+                return async_finish(op, -1);
+            }
+            for (uint8_t peer = 1; peer <= n; peer++) {
+                if (peer != me &&
+                    mpc_job_send(job, peer, shares[k].share.data,
+                                 ctx->value_size) != 0) {
+                    return async_finish(op, -1);
+                }
+            }
+        }
+        op->phase = PHASE_WAIT;
+    }
+
+    // Phase 1: Reconstruct once every party's shares are here
+    if (!async_ready(job, me, count)) {
+        return MPC_JOB_PENDING;
+    }
+
+    mpc_share_t all[SSS_MAX_SHARES];
+    int result = 0;
+    for (size_t k = 0; k < count && result == 0; k++) {
+        for (uint8_t peer = 1; peer <= n && result == 0; peer++) {
+            if (peer == me) {
+                all[peer - 1] = shares[k];
+            } else {
+                mpc_net_share_header(ctx, peer, &all[peer - 1]);
+                result = async_recv_value(ctx, job, peer,
+                                          all[peer - 1].share.data);
+            }
+        }
+
+        if (result == 0) {
+            result = mpc_reconstruct(ctx, all, n, &values[k * ctx->value_size]);
+        }
+    }
+    secure_wipe(all, sizeof(all));
+    return async_finish(op, result);
+}
+
+/* ========================================================================
+ * Multiplication
+ * ======================================================================== */
+
+mpc_job_status_t mpc_async_mul(mpc_job_t *job, mpc_async_op_t *op,
+                               const mpc_context_t *ctx,
+                               const mpc_share_t *shares_x,
+                               const mpc_share_t *shares_y,
+                               mpc_share_t *shares_prod, size_t count) {
+    // Validate inputs
+    if (async_check(job, op, ctx) != 0 || shares_x == NULL ||
+        shares_y == NULL || shares_prod == NULL) {
+        return MPC_JOB_FAILED;
+    }
+
+    // The degree-2(t-1) products need 2t-1 points to interpolate
+    if (ctx->num_parties < 2 * ctx->threshold - 1) {
+        return MPC_JOB_FAILED;
+    }
+
+    uint8_t me = mpc_job_party_id(job);
+    uint8_t n = ctx->num_parties;
+
+    // ====================================================================
+    // Phase 0: Local products, reshared to every party (self included,
+    // so the own sub-share waits in the job's queue until phase 1)
+    // ====================================================================
+    if (op->phase == PHASE_SEND) {
+        mpc_share_t set[SSS_MAX_SHARES];
+        int result = 0;
+
+        for (size_t k = 0; k < count && result == 0; k++) {
+            if (mpc_validate_share(ctx, &shares_x[k]) != 0 ||
+                mpc_validate_share(ctx, &shares_y[k]) != 0 ||
+                shares_x[k].party_id != me || shares_y[k].party_id != me) {
+                result = -1;
+                break;
+            }
+
+            uint8_t product[SSS_SHARE_DATA_SIZE];
+            for (size_t b = 0; b < ctx->value_size; b++) {
+                product[b] = gf256_mul(shares_x[k].share.data[b],
+                                       shares_y[k].share.data[b]);
+            }
+            result = mpc_create_shares(ctx, product, set);
+            secure_wipe(product, sizeof(product));
+
+            for (uint8_t peer = 1; peer <= n && result == 0; peer++) {
+                result = mpc_job_send(job, peer, set[peer - 1].share.data,
+                                      ctx->value_size);
+            }
+        }
+
+        secure_wipe(set, sizeof(set));
+        if (result != 0) {
+            return async_finish(op, result);
+        }
+        op->phase = PHASE_WAIT;
+    }
+
+    // ====================================================================
+    // Phase 1: Combine sub-shares with the Lagrange coefficients
+    // ====================================================================
+    if (!async_ready(job, 0, count)) {
+        return MPC_JOB_PENDING;
+    }
+
+    uint8_t lambda[SSS_MAX_SHARES];
+    mpc_net_lagrange_at_zero(n, lambda);
+
+    int result = 0;
+    for (size_t k = 0; k < count && result == 0; k++) {
+        uint8_t acc[SSS_SHARE_DATA_SIZE] = {0};
+        uint8_t sub[SSS_SHARE_DATA_SIZE];
+
+        for (uint8_t peer = 1; peer <= n && result == 0; peer++) {
+            result = async_recv_value(ctx, job, peer, sub);
+            for (size_t b = 0; b < ctx->value_size && result == 0; b++) {
+                acc[b] = gf256_add(acc[b], gf256_mul(lambda[peer - 1], sub[b]));
+            }
+        }
+
+        if (result == 0) {
+            memset(&shares_prod[k], 0, sizeof(mpc_share_t));
+            mpc_net_share_header(ctx, me, &shares_prod[k]);
+            memcpy(shares_prod[k].share.data, acc, ctx->value_size);
+        }
+        secure_wipe(acc, sizeof(acc));
+        secure_wipe(sub, sizeof(sub));
+    }
+    return async_finish(op, result);
+}
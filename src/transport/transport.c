@@ -0,0 +1,200 @@
+#include "sss/transport.h"
+#include <string.h>
+#include <stdlib.h>
+
+/* ========================================================================
+ * Internal Helpers
+ * ======================================================================== */
+
+/**
+ * Check that a peer id names another party of the group
+ */
+static int transport_peer_valid(const mpc_transport_t *transport, uint8_t peer) {
+    return peer >= 1 && peer <= transport->num_parties &&
+           peer != transport->party_id;
+}
+
+/* ========================================================================
+ * Generic Operations
+ * ======================================================================== */
+
+mpc_transport_t *mpc_transport_alloc(const mpc_transport_ops_t *ops,
+                                     uint8_t party_id, uint8_t num_parties,
+                                     void *impl) {
+    if (ops == NULL || ops->send == NULL || ops->recv == NULL ||
+        ops->destroy == NULL) {
+        return NULL;
+    }
+
+    if (num_parties < 2 || party_id < 1 || party_id > num_parties) {
+        return NULL;
+    }
+
+    mpc_transport_t *transport = calloc(1, sizeof(mpc_transport_t));
+    if (transport == NULL) {
+        return NULL;
+    }
+
+    transport->ops = ops;
+    transport->party_id = party_id;
+    transport->num_parties = num_parties;
+    transport->impl = impl;
+    return transport;
+}
+
+int mpc_transport_send(mpc_transport_t *transport, uint8_t to,
+                       const void *data, size_t len) {
+    if (transport == NULL || (data == NULL && len > 0)) {
+        return -1;
+    }
+
+    if (!transport_peer_valid(transport, to)) {
+        return -1;
+    }
+
+    if (transport->ops->send(transport, to, data, len) != 0) {
+        return -1;
+    }
+
+    transport->stats.bytes_sent += len;
+    transport->stats.messages_sent++;
+    transport->round_pending = 1;
+    return 0;
+}
+
+int mpc_transport_sendv(mpc_transport_t *transport, uint8_t to,
+                        const mpc_transport_iov_t *parts, size_t num_parts) {
+    if (transport == NULL || (parts == NULL && num_parts > 0)) {
+        return -1;
+    }
+
+    if (!transport_peer_valid(transport, to)) {
+        return -1;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < num_parts; i++) {
+        if (parts[i].base == NULL && parts[i].len > 0) {
+            return -1;
+        }
+        total += parts[i].len;
+    }
+
+    int result;
+    if (transport->ops->sendv != NULL) {
+        result = transport->ops->sendv(transport, to, parts, num_parts, total);
+    } else {
+        // Backend without scatter-gather: gather into one buffer
+        uint8_t *joined = malloc(total > 0 ? total : 1);
+        if (joined == NULL) {
+            return -1;
+        }
+        size_t offset = 0;
+        for (size_t i = 0; i < num_parts; i++) {
+            if (parts[i].len > 0) {
+                memcpy(joined + offset, parts[i].base, parts[i].len);
+                offset += parts[i].len;
+            }
+        }
+        result = transport->ops->send(transport, to, joined, total);
+        free(joined);
+    }
+
+    if (result != 0) {
+        return -1;
+    }
+
+    transport->stats.bytes_sent += total;
+    transport->stats.messages_sent++;
+    transport->round_pending = 1;
+    return 0;
+}
+
+int mpc_transport_recv(mpc_transport_t *transport, uint8_t from,
+                       void *buffer, size_t capacity, size_t *len) {
+    if (transport == NULL || len == NULL || (buffer == NULL && capacity > 0)) {
+        return -1;
+    }
+
+    if (!transport_peer_valid(transport, from)) {
+        return -1;
+    }
+
+    if (transport->ops->recv(transport, from, buffer, capacity, len) != 0) {
+        return -1;
+    }
+
+    transport->stats.bytes_received += *len;
+    transport->stats.messages_received++;
+    return 0;
+}
+
+int mpc_transport_broadcast(mpc_transport_t *transport,
+                            const void *data, size_t len) {
+    if (transport == NULL || (data == NULL && len > 0)) {
+        return -1;
+    }
+
+    if (transport->ops->broadcast != NULL) {
+        if (transport->ops->broadcast(transport, data, len) != 0) {
+            return -1;
+        }
+        uint64_t peers = transport->num_parties - 1;
+        transport->stats.bytes_sent += peers * len;
+        transport->stats.messages_sent += peers;
+        transport->round_pending = 1;
+        return 0;
+    }
+
+    for (uint8_t peer = 1; peer <= transport->num_parties; peer++) {
+        if (peer == transport->party_id) {
+            continue;
+        }
+        if (mpc_transport_send(transport, peer, data, len) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int mpc_transport_flush(mpc_transport_t *transport) {
+    if (transport == NULL) {
+        return -1;
+    }
+
+    if (transport->ops->flush != NULL &&
+        transport->ops->flush(transport) != 0) {
+        return -1;
+    }
+
+    if (transport->round_pending) {
+        transport->stats.rounds++;
+        transport->round_pending = 0;
+    }
+    return 0;
+}
+
+void mpc_transport_destroy(mpc_transport_t *transport) {
+    if (transport == NULL) {
+        return;
+    }
+
+    transport->ops->destroy(transport);
+    free(transport);
+}
+
+void mpc_transport_get_stats(const mpc_transport_t *transport,
+                             mpc_transport_stats_t *stats) {
+    if (transport == NULL || stats == NULL) {
+        return;
+    }
+    *stats = transport->stats;
+}
+
+void mpc_transport_reset_stats(mpc_transport_t *transport) {
+    if (transport == NULL) {
+        return;
+    }
+    memset(&transport->stats, 0, sizeof(mpc_transport_stats_t));
+    transport->round_pending = 0;
+}
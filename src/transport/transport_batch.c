@@ -0,0 +1,481 @@
+#include "sss/transport_batch.h"
+#include "sss/session.h"
+#include "utils/secure_memory.h"
+#include <string.h>
+#include <stdlib.h>
+
+/* Size of the (session id, length) header in front of every record */
+#define RECORD_HEADER_SIZE (MPC_SESSION_ID_SIZE + 4)
+
+/* ========================================================================
+ * Internal Types
+ * ======================================================================== */
+
+/* Outgoing message waiting for the next flush */
+typedef struct {
+    mpc_session_id_t session;
+    size_t first_part;              // Index into the peer's parts
+    size_t num_parts;
+    size_t len;
+} pending_record_t;
+
+/* Everything queued for one peer since the last flush */
+typedef struct {
+    pending_record_t *records;
+    size_t num_records;
+    size_t records_capacity;
+    mpc_transport_iov_t *parts;     // References to caller buffers
+    size_t num_parts;
+    size_t parts_capacity;
+} peer_outbox_t;
+
+/* Received frame, freed when its last record has been delivered */
+typedef struct {
+    size_t refs;
+    size_t len;
+    uint8_t data[];
+} inbound_frame_t;
+
+typedef struct inbound_msg {
+    struct inbound_msg *next;
+    inbound_frame_t *frame;
+    size_t offset;
+    size_t len;
+} inbound_msg_t;
+
+/* Per-channel state, created on open or when a record first arrives */
+typedef struct {
+    mpc_session_t *session;         // Entry in the link's session table
+    mpc_batch_link_t *link;
+    mpc_transport_t *endpoint;      // NULL while the channel is not open
+    inbound_msg_t **head;           // Per-peer receive queues
+    inbound_msg_t **tail;
+} channel_state_t;
+
+struct mpc_batch_link {
+    mpc_transport_t *inner;
+    uint8_t num_parties;
+    peer_outbox_t *outbox;          // One per peer (index party - 1)
+
+    // Channel states, keyed by session id (PENDING until opened)
+    mpc_session_table_t *sessions;
+
+    // Scratch space for building frames on flush. The record headers of
+    // every peer stay in place until the inner flush, as the inner
+    // endpoint may send straight from them.
+    uint8_t (*headers)[RECORD_HEADER_SIZE];
+    size_t headers_capacity;
+    mpc_transport_iov_t *iov;
+    size_t iov_capacity;
+};
+
+/* ========================================================================
+ * Helpers
+ * ======================================================================== */
+
+static void put_u32_le(uint8_t *out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_u32_le(const uint8_t *in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) |
+           ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+/**
+ * Make room for at least need elements in a growable array
+ */
+static int grow_array(void **array, size_t *capacity, size_t need,
+                      size_t elem_size) {
+    if (need <= *capacity) {
+        return 0;
+    }
+
+    size_t new_capacity = (*capacity > 0) ? *capacity : 16;
+    while (new_capacity < need) {
+        new_capacity *= 2;
+    }
+
+    void *grown = realloc(*array, new_capacity * elem_size);
+    if (grown == NULL) {
+        return -1;
+    }
+    *array = grown;
+    *capacity = new_capacity;
+    return 0;
+}
+
+static void frame_release(inbound_frame_t *frame) {
+    if (--frame->refs == 0) {
+        secure_wipe(frame->data, frame->len);
+        free(frame);
+    }
+}
+
+/* ========================================================================
+ * Channel Table
+ * ======================================================================== */
+
+/**
+ * Find a channel's state, creating it if needed
+ */
+static channel_state_t *channel_get(mpc_batch_link_t *link,
+                                    const mpc_session_id_t *id) {
+    mpc_session_t *session = mpc_session_find(link->sessions, id);
+    if (session != NULL) {
+        return session->data;
+    }
+
+    channel_state_t *state = calloc(1, sizeof(channel_state_t) +
+                                       2 * link->num_parties *
+                                       sizeof(inbound_msg_t *));
+    if (state == NULL) {
+        return NULL;
+    }
+
+    state->session = mpc_session_add(link->sessions, id, MPC_SESSION_PENDING,
+                                     state);
+    if (state->session == NULL) {
+        free(state);
+        return NULL;
+    }
+    state->link = link;
+    state->head = (inbound_msg_t **)(state + 1);
+    state->tail = state->head + link->num_parties;
+    return state;
+}
+
+/**
+ * Free a channel's state and its undelivered messages
+ */
+static void channel_free(channel_state_t *state, uint8_t num_parties) {
+    for (uint8_t p = 0; p < num_parties; p++) {
+        inbound_msg_t *msg = state->head[p];
+        while (msg != NULL) {
+            inbound_msg_t *next = msg->next;
+            frame_release(msg->frame);
+            free(msg);
+            msg = next;
+        }
+    }
+    free(state);
+}
+
+/**
+ * Release the state of a session dropped from the table
+ */
+static void channel_release(mpc_session_t *session, void *arg) {
+    const mpc_batch_link_t *link = arg;
+    channel_free(session->data, link->num_parties);
+}
+
+/* ========================================================================
+ * Frames
+ * ======================================================================== */
+
+/**
+ * Receive one frame from a peer and queue its records by channel
+ */
+static int link_pull_frame(mpc_batch_link_t *link, uint8_t from) {
+    inbound_frame_t *frame = malloc(sizeof(inbound_frame_t) +
+                                    MPC_BATCH_MAX_FRAME);
+    if (frame == NULL) {
+        return -1;
+    }
+
+    size_t len = 0;
+    if (mpc_transport_recv(link->inner, from, frame->data,
+                           MPC_BATCH_MAX_FRAME, &len) != 0) {
+        free(frame);
+        return -1;
+    }
+
+    // Give back the unused tail of the buffer
+    inbound_frame_t *shrunk = realloc(frame, sizeof(inbound_frame_t) + len);
+    if (shrunk != NULL) {
+        frame = shrunk;
+    }
+    frame->len = len;
+    frame->refs = 1;                // Held while parsing
+
+    int result = 0;
+    size_t offset = 0;
+    while (offset < len) {
+        if (len - offset < RECORD_HEADER_SIZE) {
+            result = -1;
+            break;
+        }
+        mpc_session_id_t session;
+        memcpy(session.bytes, &frame->data[offset], MPC_SESSION_ID_SIZE);
+        size_t record_len = get_u32_le(&frame->data[offset +
+                                                    MPC_SESSION_ID_SIZE]);
+        offset += RECORD_HEADER_SIZE;
+        if (record_len > len - offset) {
+            result = -1;
+            break;
+        }
+
+        channel_state_t *state = channel_get(link, &session);
+        inbound_msg_t *msg = malloc(sizeof(inbound_msg_t));
+        if (state == NULL || msg == NULL) {
+            free(msg);
+            result = -1;
+            break;
+        }
+        msg->next = NULL;
+        msg->frame = frame;
+        msg->offset = offset;
+        msg->len = record_len;
+        frame->refs++;
+
+        if (state->tail[from - 1] != NULL) {
+            state->tail[from - 1]->next = msg;
+        } else {
+            state->head[from - 1] = msg;
+        }
+        state->tail[from - 1] = msg;
+
+        offset += record_len;
+    }
+
+    frame_release(frame);
+    return result;
+}
+
+int mpc_batch_link_flush(mpc_batch_link_t *link) {
+    if (link == NULL) {
+        return -1;
+    }
+
+    int result = 0;
+
+    size_t total_records = 0;
+    for (uint8_t peer = 1; peer <= link->num_parties; peer++) {
+        total_records += link->outbox[peer - 1].num_records;
+    }
+    if (grow_array((void **)&link->headers, &link->headers_capacity,
+                   total_records, RECORD_HEADER_SIZE) != 0) {
+        result = -1;
+    }
+
+    size_t next_header = 0;
+    for (uint8_t peer = 1; peer <= link->num_parties && result == 0; peer++) {
+        peer_outbox_t *box = &link->outbox[peer - 1];
+        if (box->num_records == 0) {
+            continue;
+        }
+
+        if (grow_array((void **)&link->iov, &link->iov_capacity,
+                       box->num_records + box->num_parts,
+                       sizeof(mpc_transport_iov_t)) != 0) {
+            result = -1;
+            break;
+        }
+
+        // Gather records into frames of at most MPC_BATCH_MAX_FRAME
+        size_t num_iov = 0;
+        size_t frame_len = 0;
+        for (size_t r = 0; r < box->num_records && result == 0; r++) {
+            const pending_record_t *rec = &box->records[r];
+            size_t record_size = RECORD_HEADER_SIZE + rec->len;
+
+            if (frame_len + record_size > MPC_BATCH_MAX_FRAME) {
+                result = mpc_transport_sendv(link->inner, peer, link->iov,
+                                             num_iov);
+                num_iov = 0;
+                frame_len = 0;
+            }
+
+            uint8_t *header = link->headers[next_header++];
+            memcpy(header, rec->session.bytes, MPC_SESSION_ID_SIZE);
+            put_u32_le(header + MPC_SESSION_ID_SIZE, (uint32_t)rec->len);
+            link->iov[num_iov].base = header;
+            link->iov[num_iov].len = RECORD_HEADER_SIZE;
+            num_iov++;
+            for (size_t k = 0; k < rec->num_parts; k++) {
+                link->iov[num_iov++] = box->parts[rec->first_part + k];
+            }
+            frame_len += record_size;
+        }
+        if (result == 0 && num_iov > 0) {
+            result = mpc_transport_sendv(link->inner, peer, link->iov, num_iov);
+        }
+
+        box->num_records = 0;
+        box->num_parts = 0;
+    }
+
+    if (result == 0) {
+        result = mpc_transport_flush(link->inner);
+    }
+    return result;
+}
+
+/* ========================================================================
+ * Channel Operations
+ * ======================================================================== */
+
+static int channel_sendv(mpc_transport_t *transport, uint8_t to,
+                         const mpc_transport_iov_t *parts, size_t num_parts,
+                         size_t total_len) {
+    channel_state_t *state = transport->impl;
+    mpc_batch_link_t *link = state->link;
+    peer_outbox_t *box = &link->outbox[to - 1];
+
+    // Every record must fit in a frame on its own
+    if (total_len > MPC_BATCH_MAX_FRAME - RECORD_HEADER_SIZE) {
+        return -1;
+    }
+
+    if (grow_array((void **)&box->records, &box->records_capacity,
+                   box->num_records + 1, sizeof(pending_record_t)) != 0 ||
+        grow_array((void **)&box->parts, &box->parts_capacity,
+                   box->num_parts + num_parts,
+                   sizeof(mpc_transport_iov_t)) != 0) {
+        return -1;
+    }
+
+    pending_record_t *rec = &box->records[box->num_records++];
+    rec->session = state->session->id;
+    rec->first_part = box->num_parts;
+    rec->num_parts = num_parts;
+    rec->len = total_len;
+
+    memcpy(&box->parts[box->num_parts], parts,
+           num_parts * sizeof(mpc_transport_iov_t));
+    box->num_parts += num_parts;
+    return 0;
+}
+
+static int channel_send(mpc_transport_t *transport, uint8_t to,
+                        const void *data, size_t len) {
+    mpc_transport_iov_t part = {data, len};
+    return channel_sendv(transport, to, &part, (len > 0) ? 1 : 0, len);
+}
+
+static int channel_recv(mpc_transport_t *transport, uint8_t from,
+                        void *buffer, size_t capacity, size_t *len) {
+    channel_state_t *state = transport->impl;
+    mpc_batch_link_t *link = state->link;
+
+    // Frames may carry other channels' records; those are queued
+    while (state->head[from - 1] == NULL) {
+        if (link_pull_frame(link, from) != 0) {
+            return -1;
+        }
+    }
+
+    inbound_msg_t *msg = state->head[from - 1];
+    state->head[from - 1] = msg->next;
+    if (state->head[from - 1] == NULL) {
+        state->tail[from - 1] = NULL;
+    }
+
+    int result = 0;
+    if (msg->len > capacity) {
+        result = -1;
+    } else {
+        if (msg->len > 0) {
+            memcpy(buffer, &msg->frame->data[msg->offset], msg->len);
+        }
+        *len = msg->len;
+    }
+
+    frame_release(msg->frame);
+    free(msg);
+    return result;
+}
+
+static int channel_flush(mpc_transport_t *transport) {
+    channel_state_t *state = transport->impl;
+    return mpc_batch_link_flush(state->link);
+}
+
+static void channel_destroy(mpc_transport_t *transport) {
+    channel_state_t *state = transport->impl;
+    mpc_batch_link_t *link = state->link;
+
+    mpc_session_remove(link->sessions, state->session);
+    channel_free(state, link->num_parties);
+}
+
+static const mpc_transport_ops_t channel_ops = {
+    .name = "batch",
+    .send = channel_send,
+    .sendv = channel_sendv,
+    .recv = channel_recv,
+    .broadcast = NULL,
+    .flush = channel_flush,
+    .destroy = channel_destroy,
+};
+
+/* ========================================================================
+ * Link Management
+ * ======================================================================== */
+
+mpc_batch_link_t *mpc_batch_link_create(mpc_transport_t *inner) {
+    if (inner == NULL) {
+        return NULL;
+    }
+
+    mpc_batch_link_t *link = calloc(1, sizeof(mpc_batch_link_t));
+    if (link == NULL) {
+        return NULL;
+    }
+
+    link->inner = inner;
+    link->num_parties = inner->num_parties;
+    link->outbox = calloc(link->num_parties, sizeof(peer_outbox_t));
+    link->sessions = mpc_session_table_create();
+
+    if (link->outbox == NULL || link->sessions == NULL) {
+        free(link->outbox);
+        mpc_session_table_destroy(link->sessions, NULL, NULL);
+        free(link);
+        return NULL;
+    }
+    return link;
+}
+
+void mpc_batch_link_destroy(mpc_batch_link_t *link) {
+    if (link == NULL) {
+        return;
+    }
+
+    // States of channels that received messages but were never opened
+    mpc_session_table_destroy(link->sessions, channel_release, link);
+
+    for (uint8_t p = 0; p < link->num_parties; p++) {
+        free(link->outbox[p].records);
+        free(link->outbox[p].parts);
+    }
+
+    free(link->outbox);
+    free(link->headers);
+    free(link->iov);
+    free(link);
+}
+
+mpc_transport_t *mpc_batch_channel_open(mpc_batch_link_t *link,
+                                        const mpc_session_id_t *session) {
+    if (link == NULL || session == NULL) {
+        return NULL;
+    }
+
+    channel_state_t *state = channel_get(link, session);
+    if (state == NULL || state->endpoint != NULL) {
+        return NULL;
+    }
+
+    state->endpoint = mpc_transport_alloc(&channel_ops,
+                                          link->inner->party_id,
+                                          link->num_parties, state);
+    if (state->endpoint != NULL) {
+        mpc_session_set_state(link->sessions, state->session,
+                              MPC_SESSION_ACTIVE);
+    }
+    return state->endpoint;
+}
@@ -0,0 +1,202 @@
+#include "sss/transport.h"
+#include "utils/secure_memory.h"
+#include <pthread.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* ========================================================================
+ * Internal Types
+ * ======================================================================== */
+
+typedef struct memory_message {
+    struct memory_message *next;
+    size_t len;
+    uint8_t data[];
+} memory_message_t;
+
+/* FIFO of messages for one directed party pair */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    memory_message_t *head;
+    memory_message_t *tail;
+} memory_queue_t;
+
+/* State shared by all endpoints of a group */
+typedef struct {
+    uint8_t num_parties;
+    pthread_mutex_t lock;
+    unsigned refs;                  // Endpoints not yet destroyed
+    memory_queue_t *queues;         // [from - 1][to - 1]
+} memory_hub_t;
+
+static memory_queue_t *hub_queue(memory_hub_t *hub, uint8_t from, uint8_t to) {
+    return &hub->queues[(size_t)(from - 1) * hub->num_parties + (to - 1)];
+}
+
+static void hub_free(memory_hub_t *hub) {
+    size_t count = (size_t)hub->num_parties * hub->num_parties;
+
+    for (size_t q = 0; q < count; q++) {
+        memory_message_t *msg = hub->queues[q].head;
+        while (msg != NULL) {
+            memory_message_t *next = msg->next;
+            secure_wipe(msg->data, msg->len);
+            free(msg);
+            msg = next;
+        }
+        pthread_cond_destroy(&hub->queues[q].ready);
+        pthread_mutex_destroy(&hub->queues[q].lock);
+    }
+
+    pthread_mutex_destroy(&hub->lock);
+    free(hub->queues);
+    free(hub);
+}
+
+/* ========================================================================
+ * Backend Operations
+ * ======================================================================== */
+
+/**
+ * Append a message to the queue of a directed pair
+ */
+static void memory_enqueue(memory_hub_t *hub, uint8_t from, uint8_t to,
+                           memory_message_t *msg) {
+    memory_queue_t *queue = hub_queue(hub, from, to);
+    pthread_mutex_lock(&queue->lock);
+    if (queue->tail != NULL) {
+        queue->tail->next = msg;
+    } else {
+        queue->head = msg;
+    }
+    queue->tail = msg;
+    pthread_cond_signal(&queue->ready);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static int memory_sendv(mpc_transport_t *transport, uint8_t to,
+                        const mpc_transport_iov_t *parts, size_t num_parts,
+                        size_t total_len) {
+    memory_message_t *msg = malloc(sizeof(memory_message_t) + total_len);
+    if (msg == NULL) {
+        return -1;
+    }
+    msg->next = NULL;
+    msg->len = total_len;
+
+    size_t offset = 0;
+    for (size_t i = 0; i < num_parts; i++) {
+        if (parts[i].len > 0) {
+            memcpy(msg->data + offset, parts[i].base, parts[i].len);
+            offset += parts[i].len;
+        }
+    }
+
+    memory_enqueue(transport->impl, transport->party_id, to, msg);
+    return 0;
+}
+
+static int memory_send(mpc_transport_t *transport, uint8_t to,
+                       const void *data, size_t len) {
+    mpc_transport_iov_t part = {data, len};
+    return memory_sendv(transport, to, &part, 1, len);
+}
+
+static int memory_recv(mpc_transport_t *transport, uint8_t from,
+                       void *buffer, size_t capacity, size_t *len) {
+    memory_hub_t *hub = transport->impl;
+    memory_queue_t *queue = hub_queue(hub, from, transport->party_id);
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->head == NULL) {
+        pthread_cond_wait(&queue->ready, &queue->lock);
+    }
+    memory_message_t *msg = queue->head;
+    queue->head = msg->next;
+    if (queue->head == NULL) {
+        queue->tail = NULL;
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    int result = 0;
+    if (msg->len > capacity) {
+        result = -1;
+    } else {
+        if (msg->len > 0) {
+            memcpy(buffer, msg->data, msg->len);
+        }
+        *len = msg->len;
+    }
+
+    secure_wipe(msg->data, msg->len);
+    free(msg);
+    return result;
+}
+
+static void memory_destroy(mpc_transport_t *transport) {
+    memory_hub_t *hub = transport->impl;
+
+    pthread_mutex_lock(&hub->lock);
+    unsigned refs = --hub->refs;
+    pthread_mutex_unlock(&hub->lock);
+
+    if (refs == 0) {
+        hub_free(hub);
+    }
+}
+
+static const mpc_transport_ops_t memory_ops = {
+    .name = "memory",
+    .send = memory_send,
+    .sendv = memory_sendv,
+    .recv = memory_recv,
+    .broadcast = NULL,
+    .flush = NULL,
+    .destroy = memory_destroy,
+};
+
+/* ========================================================================
+ * Group Construction
+ * ======================================================================== */
+
+int mpc_transport_memory_create(uint8_t num_parties,
+                                mpc_transport_t **endpoints) {
+    if (num_parties < 2 || endpoints == NULL) {
+        return -1;
+    }
+
+    memory_hub_t *hub = calloc(1, sizeof(memory_hub_t));
+    if (hub == NULL) {
+        return -1;
+    }
+
+    size_t count = (size_t)num_parties * num_parties;
+    hub->queues = calloc(count, sizeof(memory_queue_t));
+    if (hub->queues == NULL) {
+        free(hub);
+        return -1;
+    }
+
+    hub->num_parties = num_parties;
+    pthread_mutex_init(&hub->lock, NULL);
+    for (size_t q = 0; q < count; q++) {
+        pthread_mutex_init(&hub->queues[q].lock, NULL);
+        pthread_cond_init(&hub->queues[q].ready, NULL);
+    }
+
+    for (uint8_t i = 0; i < num_parties; i++) {
+        endpoints[i] = mpc_transport_alloc(&memory_ops, i + 1, num_parties, hub);
+        if (endpoints[i] == NULL) {
+            for (uint8_t j = 0; j < i; j++) {
+                free(endpoints[j]);
+                endpoints[j] = NULL;
+            }
+            hub_free(hub);
+            return -1;
+        }
+    }
+    hub->refs = num_parties;
+
+    return 0;
+}
@@ -0,0 +1,461 @@
+#define _GNU_SOURCE
+#include "sss/transport_sim.h"
+#include <math.h>
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* Size of the arrival timestamp in front of every message */
+#define SIM_HEADER_SIZE 8
+
+/* ========================================================================
+ * Internal Types
+ * ======================================================================== */
+
+/* Outgoing link to one peer; only the sending party touches it */
+typedef struct {
+    mpc_sim_link_t model;
+    double busy_until;              // Time the link finishes its last message
+    double last_arrival;            // Keeps arrivals in order
+    uint64_t rng;                   // Jitter state (xorshift64*)
+} sim_link_t;
+
+/* Counters at the start of the running step */
+typedef struct {
+    mpc_transport_stats_t stats;
+    double now_ms;
+    double compute_ms;
+} sim_mark_t;
+
+typedef struct {
+    mpc_transport_t *inner;         // Memory endpoint carrying the messages
+    sim_link_t *links;              // One per peer (index party - 1)
+    size_t overhead_bytes;
+    int count_compute;
+
+    // Simulated clock
+    double now_ms;
+    double compute_ms;              // Part of now_ms spent computing
+    struct timespec cpu_mark;       // Thread CPU time at the last call
+    int cpu_marked;
+
+    // Receive buffer (header + payload)
+    uint8_t *scratch;
+    size_t scratch_capacity;
+
+    // Send parts (header + caller's parts)
+    mpc_transport_iov_t *iov;
+    size_t iov_capacity;
+
+    // Step log
+    int step_running;
+    mpc_sim_step_t current;
+    sim_mark_t mark;
+    mpc_sim_step_t *steps;
+    size_t num_steps;
+    size_t steps_capacity;
+} sim_endpoint_t;
+
+/* ========================================================================
+ * Helpers
+ * ======================================================================== */
+
+static int link_valid(const mpc_sim_link_t *link) {
+    // Written so that NaN fails every comparison
+    return link->latency_ms >= 0.0 && link->jitter_ms >= 0.0 &&
+           link->bandwidth_mbps >= 0.0 && isfinite(link->latency_ms) &&
+           isfinite(link->jitter_ms) && isfinite(link->bandwidth_mbps);
+}
+
+/**
+ * Seed a link's jitter generator from the group seed and the pair
+ * (splitmix64 finalizer, never zero)
+ */
+static uint64_t link_seed(uint64_t seed, uint8_t from, uint8_t to) {
+    uint64_t z = seed + ((uint64_t)from << 8 | to) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (z != 0) ? z : 1;
+}
+
+/**
+ * Uniform double in [0, 1)
+ */
+static double link_uniform(sim_link_t *link) {
+    uint64_t x = link->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    link->rng = x;
+    return (double)((x * 0x2545F4914F6CDD1Dull) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * Arrival time at the peer of a message leaving now
+ */
+static double link_schedule(sim_link_t *link, double now_ms, size_t wire_bytes) {
+    double depart = (now_ms > link->busy_until) ? now_ms : link->busy_until;
+
+    double transmit = 0.0;
+    if (link->model.bandwidth_mbps > 0.0) {
+        // bits / (Mbit/s) = microseconds
+        transmit = (double)wire_bytes * 8.0 / link->model.bandwidth_mbps / 1e3;
+    }
+    link->busy_until = depart + transmit;
+
+    double arrival = link->busy_until + link->model.latency_ms;
+    if (link->model.jitter_ms > 0.0) {
+        arrival += link->model.jitter_ms * link_uniform(link);
+    }
+
+    // A stream never delivers out of order, jitter or not
+    if (arrival < link->last_arrival) {
+        arrival = link->last_arrival;
+    }
+    link->last_arrival = arrival;
+    return arrival;
+}
+
+static void put_f64(uint8_t *out, double value) {
+    memcpy(out, &value, sizeof(double));
+}
+
+static double get_f64(const uint8_t *in) {
+    double value;
+    memcpy(&value, in, sizeof(double));
+    return value;
+}
+
+static int grow(void **buffer, size_t *capacity, size_t needed, size_t item) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+    size_t new_capacity = (*capacity > 0) ? *capacity : 16;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    void *grown = realloc(*buffer, new_capacity * item);
+    if (grown == NULL) {
+        return -1;
+    }
+    *buffer = grown;
+    *capacity = new_capacity;
+    return 0;
+}
+
+/* ========================================================================
+ * Compute Accounting
+ *
+ * The CPU time the party thread used since its last transport call is
+ * local computation, and moves the clock forward. Time spent inside the
+ * transport itself (copying, waiting) is not counted.
+ * ======================================================================== */
+
+static void sim_enter(sim_endpoint_t *sim) {
+    if (!sim->count_compute) {
+        return;
+    }
+
+    struct timespec cpu;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu) != 0) {
+        return;
+    }
+
+    // The first call on the party thread only sets the mark
+    if (sim->cpu_marked) {
+        double used = (double)(cpu.tv_sec - sim->cpu_mark.tv_sec) * 1e3 +
+                      (double)(cpu.tv_nsec - sim->cpu_mark.tv_nsec) / 1e6;
+        if (used > 0.0) {
+            sim->now_ms += used;
+            sim->compute_ms += used;
+        }
+    }
+}
+
+static void sim_leave(sim_endpoint_t *sim) {
+    if (!sim->count_compute) {
+        return;
+    }
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &sim->cpu_mark) == 0) {
+        sim->cpu_marked = 1;
+    }
+}
+
+/* ========================================================================
+ * Backend Operations
+ * ======================================================================== */
+
+static int sim_sendv(mpc_transport_t *transport, uint8_t to,
+                     const mpc_transport_iov_t *parts, size_t num_parts,
+                     size_t total_len) {
+    sim_endpoint_t *sim = transport->impl;
+    sim_enter(sim);
+
+    int result = -1;
+    if (grow((void **)&sim->iov, &sim->iov_capacity, num_parts + 1,
+             sizeof(mpc_transport_iov_t)) == 0) {
+        uint8_t header[SIM_HEADER_SIZE];
+        put_f64(header, link_schedule(&sim->links[to - 1], sim->now_ms,
+                                      total_len + sim->overhead_bytes));
+
+        sim->iov[0].base = header;
+        sim->iov[0].len = SIM_HEADER_SIZE;
+        if (num_parts > 0) {
+            memcpy(&sim->iov[1], parts, num_parts * sizeof(mpc_transport_iov_t));
+        }
+        // The memory backend copies on send, so the header may go now
+        result = mpc_transport_sendv(sim->inner, to, sim->iov, num_parts + 1);
+    }
+
+    sim_leave(sim);
+    return result;
+}
+
+static int sim_send(mpc_transport_t *transport, uint8_t to,
+                    const void *data, size_t len) {
+    mpc_transport_iov_t part = {data, len};
+    return sim_sendv(transport, to, &part, 1, len);
+}
+
+static int sim_recv(mpc_transport_t *transport, uint8_t from,
+                    void *buffer, size_t capacity, size_t *len) {
+    sim_endpoint_t *sim = transport->impl;
+    sim_enter(sim);
+
+    int result = -1;
+    size_t received = 0;
+    if (grow((void **)&sim->scratch, &sim->scratch_capacity,
+             capacity + SIM_HEADER_SIZE, 1) == 0 &&
+        mpc_transport_recv(sim->inner, from, sim->scratch,
+                           capacity + SIM_HEADER_SIZE, &received) == 0 &&
+        received >= SIM_HEADER_SIZE) {
+        // Waiting for the message costs whatever time is left until it lands
+        double arrival = get_f64(sim->scratch);
+        if (arrival > sim->now_ms) {
+            sim->now_ms = arrival;
+        }
+
+        *len = received - SIM_HEADER_SIZE;
+        if (*len > 0) {
+            memcpy(buffer, sim->scratch + SIM_HEADER_SIZE, *len);
+        }
+        result = 0;
+    }
+
+    sim_leave(sim);
+    return result;
+}
+
+static int sim_flush(mpc_transport_t *transport) {
+    sim_endpoint_t *sim = transport->impl;
+    sim_enter(sim);
+    int result = mpc_transport_flush(sim->inner);
+    sim_leave(sim);
+    return result;
+}
+
+static void sim_free(sim_endpoint_t *sim) {
+    mpc_transport_destroy(sim->inner);
+    free(sim->links);
+    free(sim->scratch);
+    free(sim->iov);
+    free(sim->steps);
+    free(sim);
+}
+
+static void sim_destroy(mpc_transport_t *transport) {
+    sim_free(transport->impl);
+}
+
+static const mpc_transport_ops_t sim_ops = {
+    .name = "sim",
+    .send = sim_send,
+    .sendv = sim_sendv,
+    .recv = sim_recv,
+    .destroy = sim_destroy,
+    .flush = sim_flush,
+};
+
+/* ========================================================================
+ * Group Construction
+ * ======================================================================== */
+
+static sim_endpoint_t *sim_endpoint_create(uint8_t party_id,
+                                           uint8_t num_parties,
+                                           const mpc_sim_config_t *config,
+                                           mpc_transport_t *inner) {
+    sim_endpoint_t *sim = calloc(1, sizeof(sim_endpoint_t));
+    if (sim == NULL) {
+        return NULL;
+    }
+
+    sim->links = calloc(num_parties, sizeof(sim_link_t));
+    if (sim->links == NULL) {
+        free(sim);
+        return NULL;
+    }
+
+    for (uint8_t to = 1; to <= num_parties; to++) {
+        sim_link_t *link = &sim->links[to - 1];
+        link->model = (config->links != NULL)
+            ? config->links[(size_t)(party_id - 1) * num_parties + (to - 1)]
+            : config->link;
+        link->rng = link_seed(config->seed, party_id, to);
+    }
+
+    sim->inner = inner;
+    sim->overhead_bytes = config->overhead_bytes;
+    sim->count_compute = config->count_compute;
+    return sim;
+}
+
+int mpc_transport_sim_create(uint8_t num_parties,
+                             const mpc_sim_config_t *config,
+                             mpc_transport_t **endpoints) {
+    if (config == NULL || endpoints == NULL || num_parties < 2) {
+        return -1;
+    }
+
+    // Validate the network model
+    if (config->links != NULL) {
+        for (size_t i = 0; i < (size_t)num_parties * num_parties; i++) {
+            if (!link_valid(&config->links[i])) {
+                return -1;
+            }
+        }
+    } else if (!link_valid(&config->link)) {
+        return -1;
+    }
+
+    // Messages travel through a memory group, wrapped endpoint by endpoint
+    if (mpc_transport_memory_create(num_parties, endpoints) != 0) {
+        return -1;
+    }
+
+    for (uint8_t i = 0; i < num_parties; i++) {
+        mpc_transport_t *inner = endpoints[i];
+        sim_endpoint_t *sim = sim_endpoint_create(i + 1, num_parties, config,
+                                                  inner);
+        endpoints[i] = (sim != NULL)
+            ? mpc_transport_alloc(&sim_ops, i + 1, num_parties, sim)
+            : NULL;
+
+        if (endpoints[i] == NULL) {
+            if (sim != NULL) {
+                sim_free(sim);
+            } else {
+                mpc_transport_destroy(inner);
+            }
+            for (uint8_t j = 0; j < num_parties; j++) {
+                if (j != i) {
+                    mpc_transport_destroy(endpoints[j]);
+                }
+                endpoints[j] = NULL;
+            }
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* ========================================================================
+ * Clock and Steps
+ * ======================================================================== */
+
+static sim_endpoint_t *sim_of(const mpc_transport_t *transport) {
+    if (transport == NULL || transport->ops != &sim_ops) {
+        return NULL;
+    }
+    return transport->impl;
+}
+
+double mpc_sim_now_ms(const mpc_transport_t *transport) {
+    const sim_endpoint_t *sim = sim_of(transport);
+    return (sim != NULL) ? sim->now_ms : -1.0;
+}
+
+static void sim_mark(const mpc_transport_t *transport, sim_mark_t *mark) {
+    const sim_endpoint_t *sim = transport->impl;
+    mark->stats = transport->stats;
+    mark->now_ms = sim->now_ms;
+    mark->compute_ms = sim->compute_ms;
+}
+
+/**
+ * Close the running step and append it to the log
+ */
+static int sim_step_close(mpc_transport_t *transport) {
+    sim_endpoint_t *sim = transport->impl;
+
+    if (grow((void **)&sim->steps, &sim->steps_capacity, sim->num_steps + 1,
+             sizeof(mpc_sim_step_t)) != 0) {
+        return -1;
+    }
+
+    sim_mark_t end;
+    sim_mark(transport, &end);
+
+    mpc_sim_step_t *step = &sim->current;
+    step->rounds = end.stats.rounds - sim->mark.stats.rounds;
+    step->messages_sent = end.stats.messages_sent -
+                          sim->mark.stats.messages_sent;
+    step->bytes_sent = end.stats.bytes_sent - sim->mark.stats.bytes_sent;
+    step->bytes_received = end.stats.bytes_received -
+                           sim->mark.stats.bytes_received;
+    step->elapsed_ms = end.now_ms - sim->mark.now_ms;
+    step->compute_ms = end.compute_ms - sim->mark.compute_ms;
+
+    sim->steps[sim->num_steps++] = *step;
+    sim->step_running = 0;
+    return 0;
+}
+
+int mpc_sim_step_begin(mpc_transport_t *transport, const char *name) {
+    sim_endpoint_t *sim = sim_of(transport);
+    if (sim == NULL || name == NULL) {
+        return -1;
+    }
+
+    sim_enter(sim);
+    int result = 0;
+    if (sim->step_running) {
+        result = sim_step_close(transport);
+    }
+
+    if (result == 0) {
+        memset(&sim->current, 0, sizeof(mpc_sim_step_t));
+        strncpy(sim->current.name, name, MPC_SIM_STEP_NAME_SIZE - 1);
+        sim_mark(transport, &sim->mark);
+        sim->step_running = 1;
+    }
+    sim_leave(sim);
+    return result;
+}
+
+int mpc_sim_step_end(mpc_transport_t *transport) {
+    sim_endpoint_t *sim = sim_of(transport);
+    if (sim == NULL || !sim->step_running) {
+        return -1;
+    }
+
+    sim_enter(sim);
+    int result = sim_step_close(transport);
+    sim_leave(sim);
+    return result;
+}
+
+size_t mpc_sim_get_steps(const mpc_transport_t *transport,
+                         mpc_sim_step_t *steps, size_t max_steps) {
+    const sim_endpoint_t *sim = sim_of(transport);
+    if (sim == NULL) {
+        return 0;
+    }
+
+    if (steps != NULL && sim->num_steps > 0) {
+        size_t n = (sim->num_steps < max_steps) ? sim->num_steps : max_steps;
+        memcpy(steps, sim->steps, n * sizeof(mpc_sim_step_t));
+    }
+    return sim->num_steps;
+}
@@ -0,0 +1,866 @@
+#define _GNU_SOURCE
+#include "sss/transport.h"
+#include "utils/secure_memory.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <limits.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* Size of the length prefix in front of every message */
+#define FRAME_HEADER_SIZE 4
+
+/* Bytes read from a peer per wakeup while a flush waits to write */
+#define DRAIN_CHUNK (64u * 1024u)
+
+/* Buffers per sendmsg() call (IOV_MAX is at least 16 by POSIX) */
+#ifdef IOV_MAX
+#define SEND_IOV_MAX IOV_MAX
+#else
+#define SEND_IOV_MAX 16
+#endif
+
+/* Largest group size (party ids are one byte) */
+#define MAX_PARTIES 255
+
+/* Delay between connection attempts in mpc_transport_tcp_connect() */
+#define CONNECT_RETRY_MS 10
+
+/* ========================================================================
+ * Internal Types
+ * ======================================================================== */
+
+/* Growable byte buffer; data[start, len) is still to be consumed */
+typedef struct {
+    uint8_t *data;
+    size_t start;
+    size_t len;
+    size_t capacity;
+} byte_queue_t;
+
+/* One buffer of a queued message: a frame header, or a caller's part */
+typedef struct {
+    const uint8_t *base;            // Caller's buffer, or NULL for header
+    size_t len;
+    uint8_t header[FRAME_HEADER_SIZE];
+} send_segment_t;
+
+/**
+ * Buffers to write on flush; segments[start, count) are pending, and
+ * the first offset bytes of segments[start] are already written.
+ * Holds only lengths and pointers, never share bytes.
+ */
+typedef struct {
+    send_segment_t *segments;
+    size_t start;
+    size_t count;
+    size_t capacity;
+    size_t offset;
+} send_queue_t;
+
+/**
+ * Connection to one peer.
+ *
+ * Sends are queued in 'out' as references to the caller's buffers and
+ * written with sendmsg() on flush, so share bytes are not copied. While
+ * a flush waits for a peer to take its data, it reads whatever the
+ * other peers have sent into their 'in' queues, which recv() consumes
+ * before the socket. Without this, parties that all send a round larger
+ * than the socket buffers before receiving would block forever.
+ */
+typedef struct {
+    int fd;
+    send_queue_t out;
+    byte_queue_t in;
+} socket_peer_t;
+
+typedef struct {
+    uint8_t num_parties;
+    struct iovec *iov;              // SEND_IOV_MAX entries for flush
+    socket_peer_t peers[];          // Connection to party i at peers[i - 1]
+} socket_impl_t;
+
+/* ========================================================================
+ * Byte Queues
+ * ======================================================================== */
+
+/**
+ * Make room for extra more bytes at the end of a queue.
+ * Buffers are moved rather than realloc()ed, so no copy of the
+ * (secret) contents is left behind unwiped.
+ */
+static int queue_reserve(byte_queue_t *queue, size_t extra) {
+    size_t used = queue->len - queue->start;
+    if (extra > SIZE_MAX / 2 - used) {
+        return -1;
+    }
+    if (queue->len + extra <= queue->capacity) {
+        return 0;
+    }
+
+    size_t capacity = queue->capacity;
+    if (used + extra > capacity) {
+        capacity = (capacity > 0) ? capacity : 4096;
+        while (capacity < used + extra) {
+            capacity *= 2;
+        }
+    }
+
+    uint8_t *data = malloc(capacity);
+    if (data == NULL) {
+        return -1;
+    }
+    if (used > 0) {
+        memcpy(data, queue->data + queue->start, used);
+    }
+    if (queue->data != NULL) {
+        secure_wipe(queue->data, queue->capacity);
+        free(queue->data);
+    }
+    queue->data = data;
+    queue->start = 0;
+    queue->len = used;
+    queue->capacity = capacity;
+    return 0;
+}
+
+/**
+ * Mark bytes as consumed, wiping the buffer once it is empty
+ */
+static void queue_consume(byte_queue_t *queue, size_t len) {
+    queue->start += len;
+    if (queue->start == queue->len) {
+        secure_wipe(queue->data, queue->len);
+        queue->start = 0;
+        queue->len = 0;
+    }
+}
+
+static void queue_free(byte_queue_t *queue) {
+    if (queue->data != NULL) {
+        secure_wipe(queue->data, queue->capacity);
+        free(queue->data);
+    }
+    memset(queue, 0, sizeof(byte_queue_t));
+}
+
+/* ========================================================================
+ * Send Queues
+ * ======================================================================== */
+
+/**
+ * Make room for extra more segments. Segments hold no secrets, so the
+ * array may be realloc()ed.
+ */
+static int send_reserve(send_queue_t *queue, size_t extra) {
+    if (queue->start > 0) {
+        size_t pending = queue->count - queue->start;
+        memmove(queue->segments, queue->segments + queue->start,
+                pending * sizeof(send_segment_t));
+        queue->start = 0;
+        queue->count = pending;
+    }
+    if (queue->count + extra <= queue->capacity) {
+        return 0;
+    }
+
+    size_t capacity = (queue->capacity > 0) ? queue->capacity : 64;
+    while (capacity < queue->count + extra) {
+        if (capacity > SIZE_MAX / 2 / sizeof(send_segment_t)) {
+            return -1;
+        }
+        capacity *= 2;
+    }
+
+    send_segment_t *segments = realloc(queue->segments,
+                                       capacity * sizeof(send_segment_t));
+    if (segments == NULL) {
+        return -1;
+    }
+    queue->segments = segments;
+    queue->capacity = capacity;
+    return 0;
+}
+
+static int send_pending(const send_queue_t *queue) {
+    return queue->start < queue->count;
+}
+
+/**
+ * Mark written bytes as sent, segment by segment
+ */
+static void send_consume(send_queue_t *queue, size_t written) {
+    while (written > 0) {
+        size_t left = queue->segments[queue->start].len - queue->offset;
+        if (written < left) {
+            queue->offset += written;
+            return;
+        }
+        written -= left;
+        queue->start++;
+        queue->offset = 0;
+    }
+    if (queue->start == queue->count) {
+        queue->start = 0;
+        queue->count = 0;
+    }
+}
+
+static void send_discard(send_queue_t *queue) {
+    queue->start = 0;
+    queue->count = 0;
+    queue->offset = 0;
+}
+
+/* ========================================================================
+ * Stream I/O Helpers
+ * ======================================================================== */
+
+/**
+ * Write a whole iovec array, resuming after partial writes
+ */
+static int write_all(int fd, struct iovec *iov, int iovcnt) {
+    while (iovcnt > 0) {
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (size_t)iovcnt;
+
+        ssize_t written = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+
+        // Skip the fully written buffers, then trim the partial one
+        size_t left = (size_t)written;
+        while (iovcnt > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (uint8_t *)iov->iov_base + left;
+            iov->iov_len -= left;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Read exactly len bytes
+ */
+static int read_exact(int fd, void *buffer, size_t len) {
+    uint8_t *p = buffer;
+
+    while (len > 0) {
+        ssize_t got = read(fd, p, len);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (got == 0) {
+            return -1;  // Peer closed the connection
+        }
+        p += got;
+        len -= (size_t)got;
+    }
+    return 0;
+}
+
+/**
+ * Read exactly len bytes from a peer, taking bytes drained by an
+ * earlier flush first
+ */
+static int peer_read(socket_peer_t *peer, void *buffer, size_t len) {
+    uint8_t *p = buffer;
+    size_t queued = peer->in.len - peer->in.start;
+
+    if (queued > 0) {
+        size_t take = (queued < len) ? queued : len;
+        memcpy(p, peer->in.data + peer->in.start, take);
+        queue_consume(&peer->in, take);
+        p += take;
+        len -= take;
+    }
+    return (len > 0) ? read_exact(peer->fd, p, len) : 0;
+}
+
+static void put_u32_le(uint8_t *out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_u32_le(const uint8_t *in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) |
+           ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+static void set_nodelay(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+static int64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* ========================================================================
+ * Backend Operations
+ * ======================================================================== */
+
+static int socket_sendv(mpc_transport_t *transport, uint8_t to,
+                        const mpc_transport_iov_t *parts, size_t num_parts,
+                        size_t total_len) {
+    socket_impl_t *impl = transport->impl;
+    send_queue_t *out = &impl->peers[to - 1].out;
+
+    if (total_len > MPC_TRANSPORT_MAX_MESSAGE) {
+        return -1;
+    }
+
+    if (send_reserve(out, 1 + num_parts) != 0) {
+        return -1;
+    }
+
+    // Only the header is copied; the parts are written from the caller's
+    // buffers on flush
+    send_segment_t *segment = &out->segments[out->count++];
+    segment->base = NULL;
+    segment->len = FRAME_HEADER_SIZE;
+    put_u32_le(segment->header, (uint32_t)total_len);
+    for (size_t i = 0; i < num_parts; i++) {
+        if (parts[i].len > 0) {
+            segment = &out->segments[out->count++];
+            segment->base = parts[i].base;
+            segment->len = parts[i].len;
+        }
+    }
+    return 0;
+}
+
+static int socket_send(mpc_transport_t *transport, uint8_t to,
+                       const void *data, size_t len) {
+    mpc_transport_iov_t part = {data, len};
+    return socket_sendv(transport, to, &part, 1, len);
+}
+
+/**
+ * Write as much of a peer's queued output as the socket takes now,
+ * gathering up to SEND_IOV_MAX buffers per sendmsg()
+ */
+static int flush_write(socket_impl_t *impl, socket_peer_t *peer) {
+    send_queue_t *out = &peer->out;
+
+    while (send_pending(out)) {
+        size_t iovcnt = 0;
+        for (size_t i = out->start;
+             i < out->count && iovcnt < SEND_IOV_MAX; i++) {
+            const send_segment_t *segment = &out->segments[i];
+            const uint8_t *base = (segment->base != NULL) ? segment->base
+                                                          : segment->header;
+            size_t skip = (i == out->start) ? out->offset : 0;
+            impl->iov[iovcnt].iov_base = (void *)(base + skip);
+            impl->iov[iovcnt].iov_len = segment->len - skip;
+            iovcnt++;
+        }
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = impl->iov;
+        msg.msg_iovlen = iovcnt;
+
+        ssize_t written = sendmsg(peer->fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        send_consume(out, (size_t)written);
+    }
+    return 0;
+}
+
+/**
+ * Read what a peer has sent so far into its inbound queue.
+ * Sets *closed when the peer has shut its end of the connection.
+ */
+static int flush_drain(socket_peer_t *peer, int *closed) {
+    if (queue_reserve(&peer->in, DRAIN_CHUNK) != 0) {
+        return -1;
+    }
+
+    ssize_t got;
+    do {
+        got = recv(peer->fd, peer->in.data + peer->in.len, DRAIN_CHUNK,
+                   MSG_DONTWAIT);
+    } while (got < 0 && errno == EINTR);
+
+    if (got < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    if (got == 0) {
+        *closed = 1;
+    }
+    peer->in.len += (size_t)got;
+    return 0;
+}
+
+static int socket_flush(mpc_transport_t *transport) {
+    socket_impl_t *impl = transport->impl;
+    uint8_t n = impl->num_parties;
+    struct pollfd fds[MAX_PARTIES];
+    uint8_t polled[MAX_PARTIES];
+    int closed[MAX_PARTIES] = {0};
+    int result = 0;
+
+    // Most rounds fit in the socket buffers and are written right away
+    size_t waiting = 0;
+    for (uint8_t p = 0; p < n && result == 0; p++) {
+        socket_peer_t *peer = &impl->peers[p];
+        if (peer->fd >= 0 && send_pending(&peer->out)) {
+            result = flush_write(impl, peer);
+            waiting += send_pending(&peer->out);
+        }
+    }
+
+    // Wait for the rest, reading from every peer meanwhile: the peers
+    // may themselves be stuck writing to us
+    while (waiting > 0 && result == 0) {
+        nfds_t count = 0;
+        for (uint8_t p = 0; p < n; p++) {
+            socket_peer_t *peer = &impl->peers[p];
+            int pending = send_pending(&peer->out);
+            if (peer->fd < 0 || (closed[p] && !pending)) {
+                continue;
+            }
+            fds[count].fd = peer->fd;
+            fds[count].events = (short)((closed[p] ? 0 : POLLIN) |
+                                        (pending ? POLLOUT : 0));
+            fds[count].revents = 0;
+            polled[count] = p;
+            count++;
+        }
+
+        if (poll(fds, count, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            result = -1;
+            break;
+        }
+
+        waiting = 0;
+        for (nfds_t i = 0; i < count && result == 0; i++) {
+            socket_peer_t *peer = &impl->peers[polled[i]];
+            short revents = fds[i].revents;
+
+            if ((revents & (POLLIN | POLLHUP | POLLERR)) && !closed[polled[i]]) {
+                result = flush_drain(peer, &closed[polled[i]]);
+            }
+            if (result == 0 && (revents & (POLLOUT | POLLHUP | POLLERR))) {
+                result = flush_write(impl, peer);
+            }
+            if (result == 0 && send_pending(&peer->out)) {
+                // A peer that has gone away will never take the rest
+                result = closed[polled[i]] ? -1 : 0;
+                waiting++;
+            }
+        }
+    }
+
+    if (result != 0) {
+        for (uint8_t p = 0; p < n; p++) {
+            send_discard(&impl->peers[p].out);
+        }
+    }
+    return result;
+}
+
+static int socket_recv(mpc_transport_t *transport, uint8_t from,
+                       void *buffer, size_t capacity, size_t *len) {
+    socket_impl_t *impl = transport->impl;
+    socket_peer_t *peer = &impl->peers[from - 1];
+
+    uint8_t header[FRAME_HEADER_SIZE];
+    if (peer_read(peer, header, sizeof(header)) != 0) {
+        return -1;
+    }
+
+    size_t frame_len = get_u32_le(header);
+    if (frame_len > MPC_TRANSPORT_MAX_MESSAGE) {
+        return -1;
+    }
+
+    if (frame_len > capacity) {
+        // Drain the payload so the stream stays aligned on frames
+        uint8_t scratch[256];
+        while (frame_len > 0) {
+            size_t part = frame_len < sizeof(scratch) ? frame_len : sizeof(scratch);
+            if (peer_read(peer, scratch, part) != 0) {
+                return -1;
+            }
+            frame_len -= part;
+        }
+        return -1;
+    }
+
+    if (frame_len > 0 && peer_read(peer, buffer, frame_len) != 0) {
+        return -1;
+    }
+    *len = frame_len;
+    return 0;
+}
+
+static void socket_destroy(mpc_transport_t *transport) {
+    socket_impl_t *impl = transport->impl;
+
+    for (uint8_t i = 0; i < impl->num_parties; i++) {
+        if (impl->peers[i].fd >= 0) {
+            close(impl->peers[i].fd);
+        }
+        free(impl->peers[i].out.segments);
+        queue_free(&impl->peers[i].in);
+    }
+    free(impl->iov);
+    free(impl);
+}
+
+static const mpc_transport_ops_t socket_ops = {
+    .name = "socket",
+    .send = socket_send,
+    .sendv = socket_sendv,
+    .recv = socket_recv,
+    .broadcast = NULL,
+    .flush = socket_flush,
+    .destroy = socket_destroy,
+};
+
+/* ========================================================================
+ * Endpoint Construction
+ * ======================================================================== */
+
+mpc_transport_t *mpc_transport_socket_wrap(uint8_t party_id,
+                                           uint8_t num_parties,
+                                           const int *fds) {
+    if (fds == NULL || num_parties < 2 || party_id < 1 ||
+        party_id > num_parties) {
+        return NULL;
+    }
+
+    socket_impl_t *impl = calloc(1, sizeof(socket_impl_t) +
+                                    num_parties * sizeof(socket_peer_t));
+    if (impl == NULL) {
+        return NULL;
+    }
+
+    impl->iov = malloc(SEND_IOV_MAX * sizeof(struct iovec));
+    if (impl->iov == NULL) {
+        free(impl);
+        return NULL;
+    }
+
+    impl->num_parties = num_parties;
+    for (uint8_t i = 0; i < num_parties; i++) {
+        impl->peers[i].fd = (i + 1 == party_id) ? -1 : fds[i];
+    }
+
+    mpc_transport_t *transport = mpc_transport_alloc(&socket_ops, party_id,
+                                                     num_parties, impl);
+    if (transport == NULL) {
+        free(impl->iov);
+        free(impl);
+    }
+    return transport;
+}
+
+int mpc_transport_socket_fd(const mpc_transport_t *transport, uint8_t peer) {
+    if (transport == NULL || transport->ops != &socket_ops ||
+        peer < 1 || peer > transport->num_parties) {
+        return -1;
+    }
+
+    // Bytes already taken off the socket, or not yet written to it,
+    // would be lost to a caller reading and writing it directly
+    const socket_impl_t *impl = transport->impl;
+    const socket_peer_t *link = &impl->peers[peer - 1];
+    if (link->in.start < link->in.len || send_pending(&link->out)) {
+        return -1;
+    }
+    return link->fd;
+}
+
+/**
+ * Close every socket in an fd matrix (-1 entries are skipped)
+ */
+static void close_matrix(int *fds, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+        }
+    }
+}
+
+/**
+ * Wrap an fd matrix ([party - 1][peer - 1]) into one endpoint per party.
+ * On failure every socket not yet owned by an endpoint is closed.
+ */
+static int wrap_matrix(uint8_t num_parties, int *fds,
+                       mpc_transport_t **endpoints) {
+    for (uint8_t i = 0; i < num_parties; i++) {
+        int *row = &fds[(size_t)i * num_parties];
+        endpoints[i] = mpc_transport_socket_wrap(i + 1, num_parties, row);
+        if (endpoints[i] == NULL) {
+            for (uint8_t j = 0; j < i; j++) {
+                mpc_transport_destroy(endpoints[j]);
+                endpoints[j] = NULL;
+            }
+            close_matrix(row, (size_t)(num_parties - i) * num_parties);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int mpc_transport_socketpair_create(uint8_t num_parties,
+                                    mpc_transport_t **endpoints) {
+    if (num_parties < 2 || endpoints == NULL) {
+        return -1;
+    }
+
+    size_t count = (size_t)num_parties * num_parties;
+    int *fds = malloc(count * sizeof(int));
+    if (fds == NULL) {
+        return -1;
+    }
+    for (size_t k = 0; k < count; k++) {
+        fds[k] = -1;
+    }
+
+    for (uint8_t i = 0; i < num_parties; i++) {
+        for (uint8_t j = i + 1; j < num_parties; j++) {
+            int pair[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+                close_matrix(fds, count);
+                free(fds);
+                return -1;
+            }
+            fds[(size_t)i * num_parties + j] = pair[0];
+            fds[(size_t)j * num_parties + i] = pair[1];
+        }
+    }
+
+    int result = wrap_matrix(num_parties, fds, endpoints);
+    free(fds);
+    return result;
+}
+
+/**
+ * Open a TCP listener on addr (port 0 picks a free port)
+ */
+static int tcp_listen(const struct sockaddr_in *addr, int backlog) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    if (bind(fd, (const struct sockaddr *)addr, sizeof(*addr)) != 0 ||
+        listen(fd, backlog) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Connect one loopback pair through a temporary listener
+ */
+static int tcp_loopback_pair(int pair[2]) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+
+    int listener = tcp_listen(&addr, 1);
+    if (listener < 0) {
+        return -1;
+    }
+
+    socklen_t addr_len = sizeof(addr);
+    int client = -1;
+    int server = -1;
+
+    if (getsockname(listener, (struct sockaddr *)&addr, &addr_len) == 0) {
+        client = socket(AF_INET, SOCK_STREAM, 0);
+    }
+    if (client >= 0 &&
+        connect(client, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+        server = accept(listener, NULL, NULL);
+    }
+    close(listener);
+
+    if (server < 0) {
+        if (client >= 0) {
+            close(client);
+        }
+        return -1;
+    }
+
+    set_nodelay(client);
+    set_nodelay(server);
+    pair[0] = client;
+    pair[1] = server;
+    return 0;
+}
+
+int mpc_transport_tcp_create(uint8_t num_parties, mpc_transport_t **endpoints) {
+    if (num_parties < 2 || endpoints == NULL) {
+        return -1;
+    }
+
+    size_t count = (size_t)num_parties * num_parties;
+    int *fds = malloc(count * sizeof(int));
+    if (fds == NULL) {
+        return -1;
+    }
+    for (size_t k = 0; k < count; k++) {
+        fds[k] = -1;
+    }
+
+    for (uint8_t i = 0; i < num_parties; i++) {
+        for (uint8_t j = i + 1; j < num_parties; j++) {
+            int pair[2];
+            if (tcp_loopback_pair(pair) != 0) {
+                close_matrix(fds, count);
+                free(fds);
+                return -1;
+            }
+            fds[(size_t)i * num_parties + j] = pair[0];
+            fds[(size_t)j * num_parties + i] = pair[1];
+        }
+    }
+
+    int result = wrap_matrix(num_parties, fds, endpoints);
+    free(fds);
+    return result;
+}
+
+int mpc_transport_tcp_connect(uint8_t party_id, uint8_t num_parties,
+                              const char *host, uint16_t base_port,
+                              int timeout_ms, mpc_transport_t **endpoint) {
+    if (host == NULL || endpoint == NULL || num_parties < 2 ||
+        party_id < 1 || party_id > num_parties ||
+        (uint32_t)base_port + num_parties - 1 > UINT16_MAX) {
+        return -1;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+        return -1;
+    }
+
+    int fds[MAX_PARTIES];
+    for (int i = 0; i < MAX_PARTIES; i++) {
+        fds[i] = -1;
+    }
+
+    addr.sin_port = htons((uint16_t)(base_port + party_id - 1));
+    int listener = tcp_listen(&addr, num_parties);
+    if (listener < 0) {
+        return -1;
+    }
+
+    int64_t deadline = monotonic_ms() + timeout_ms;
+    int result = 0;
+
+    // Connect to every lower party, announcing our id
+    for (uint8_t peer = 1; peer < party_id && result == 0; peer++) {
+        addr.sin_port = htons((uint16_t)(base_port + peer - 1));
+        for (;;) {
+            int fd = socket(AF_INET, SOCK_STREAM, 0);
+            if (fd < 0) {
+                result = -1;
+                break;
+            }
+            if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+                struct iovec iov = {&party_id, 1};
+                if (write_all(fd, &iov, 1) != 0) {
+                    close(fd);
+                    result = -1;
+                    break;
+                }
+                set_nodelay(fd);
+                fds[peer - 1] = fd;
+                break;
+            }
+            close(fd);
+            if (monotonic_ms() >= deadline) {
+                result = -1;
+                break;
+            }
+            usleep(CONNECT_RETRY_MS * 1000);
+        }
+    }
+
+    // Accept every higher party, which identifies itself first
+    for (uint8_t accepted = 0;
+         result == 0 && accepted < num_parties - party_id; ) {
+        int64_t left = deadline - monotonic_ms();
+        struct pollfd pfd = {listener, POLLIN, 0};
+        if (left <= 0 || poll(&pfd, 1, (int)left) <= 0) {
+            result = -1;
+            break;
+        }
+
+        int fd = accept(listener, NULL, NULL);
+        if (fd < 0) {
+            continue;
+        }
+
+        uint8_t peer = 0;
+        if (read_exact(fd, &peer, 1) != 0 || peer <= party_id ||
+            peer > num_parties || fds[peer - 1] >= 0) {
+            close(fd);
+            result = -1;
+            break;
+        }
+        set_nodelay(fd);
+        fds[peer - 1] = fd;
+        accepted++;
+    }
+
+    close(listener);
+
+    if (result == 0) {
+        *endpoint = mpc_transport_socket_wrap(party_id, num_parties, fds);
+        if (*endpoint == NULL) {
+            result = -1;
+        }
+    }
+    if (result != 0) {
+        close_matrix(fds, num_parties);
+    }
+    return result;
+}
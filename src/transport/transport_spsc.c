@@ -0,0 +1,468 @@
+#include "sss/transport.h"
+#include "utils/secure_memory.h"
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* Size of a cache line; producer and consumer indices get one each */
+#define CACHE_LINE_SIZE 64
+
+/* Size of the length prefix in front of every message */
+#define RING_HEADER_SIZE 4
+
+/* Busy-wait iterations before yielding the CPU */
+#define SPIN_LIMIT 128
+
+/* ========================================================================
+ * Internal Types
+ * ======================================================================== */
+
+/**
+ * Byte ring for one directed party pair.
+ *
+ * Positions grow monotonically and are masked on access. The producer
+ * writes messages at 'pending' and makes them visible by storing 'head'
+ * only on flush, so a whole round is published with one release store.
+ * Each side caches the other side's index to avoid touching its cache
+ * line on every message.
+ */
+typedef struct {
+    // Producer side
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t head;  // Published end
+    size_t pending;                                 // Written end
+    size_t cached_tail;
+
+    // Consumer side
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t tail;  // Consumed end
+    size_t cached_head;
+
+    // Read-only after creation
+    _Alignas(CACHE_LINE_SIZE) size_t mask;
+    uint8_t *data;
+} spsc_ring_t;
+
+/* State shared by all endpoints of a group */
+typedef struct {
+    uint8_t num_parties;
+    size_t ring_bytes;
+    atomic_uint refs;               // Endpoints not yet destroyed
+    spsc_ring_t *rings;             // [from - 1][to - 1]
+} spsc_hub_t;
+
+/**
+ * Messages taken off one incoming ring early, oldest first.
+ * data[start, len) holds whole messages, each with its ring header.
+ */
+typedef struct {
+    uint8_t *data;
+    size_t start;
+    size_t len;
+    size_t capacity;
+} spsc_backlog_t;
+
+/**
+ * One party's endpoint.
+ *
+ * A party waiting for room in a full ring takes in everything its peers
+ * have published to it, so parties that all send a round larger than
+ * the rings before receiving keep draining each other instead of
+ * spinning forever. recv() serves those messages before the ring.
+ */
+typedef struct {
+    spsc_hub_t *hub;
+    spsc_backlog_t *backlogs;       // One per peer (index party - 1)
+} spsc_endpoint_t;
+
+static spsc_ring_t *hub_ring(spsc_hub_t *hub, uint8_t from, uint8_t to) {
+    return &hub->rings[(size_t)(from - 1) * hub->num_parties + (to - 1)];
+}
+
+static void hub_free(spsc_hub_t *hub) {
+    size_t count = (size_t)hub->num_parties * hub->num_parties;
+
+    for (size_t r = 0; r < count; r++) {
+        if (hub->rings[r].data != NULL) {
+            secure_wipe(hub->rings[r].data, hub->ring_bytes);
+            free(hub->rings[r].data);
+        }
+    }
+    free(hub->rings);
+    free(hub);
+}
+
+/* ========================================================================
+ * Ring Helpers
+ * ======================================================================== */
+
+static inline void spin_wait(unsigned *spins) {
+    if (++*spins < SPIN_LIMIT) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    } else {
+        *spins = 0;
+        sched_yield();
+    }
+}
+
+/**
+ * Copy into the ring at a position, wrapping around the end
+ */
+static void ring_write(spsc_ring_t *ring, size_t pos, const void *src,
+                       size_t len) {
+    if (len == 0) {
+        return;
+    }
+    size_t offset = pos & ring->mask;
+    size_t first = ring->mask + 1 - offset;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(ring->data + offset, src, first);
+    memcpy(ring->data, (const uint8_t *)src + first, len - first);
+}
+
+/**
+ * Copy out of the ring at a position, wrapping around the end
+ */
+static void ring_read(const spsc_ring_t *ring, size_t pos, void *dst,
+                      size_t len) {
+    if (len == 0) {
+        return;
+    }
+    size_t offset = pos & ring->mask;
+    size_t first = ring->mask + 1 - offset;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(dst, ring->data + offset, first);
+    memcpy((uint8_t *)dst + first, ring->data, len - first);
+}
+
+static void ring_publish(spsc_ring_t *ring) {
+    if (atomic_load_explicit(&ring->head, memory_order_relaxed) != ring->pending) {
+        atomic_store_explicit(&ring->head, ring->pending, memory_order_release);
+    }
+}
+
+static void publish_all(spsc_hub_t *hub, uint8_t me) {
+    for (uint8_t peer = 1; peer <= hub->num_parties; peer++) {
+        if (peer != me) {
+            ring_publish(hub_ring(hub, me, peer));
+        }
+    }
+}
+
+static uint32_t get_u32_le(const uint8_t *in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) |
+           ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+/**
+ * Make room for extra more bytes at the end of a backlog.
+ * The old buffer is wiped rather than realloc()ed, as it holds shares.
+ */
+static int backlog_reserve(spsc_backlog_t *backlog, size_t extra) {
+    size_t used = backlog->len - backlog->start;
+    if (backlog->len + extra <= backlog->capacity) {
+        return 0;
+    }
+
+    size_t capacity = backlog->capacity;
+    if (used + extra > capacity) {
+        capacity = (capacity > 0) ? capacity : 4096;
+        while (capacity < used + extra) {
+            capacity *= 2;
+        }
+    }
+
+    uint8_t *data = malloc(capacity);
+    if (data == NULL) {
+        return -1;
+    }
+    if (used > 0) {
+        memcpy(data, backlog->data + backlog->start, used);
+    }
+    if (backlog->data != NULL) {
+        secure_wipe(backlog->data, backlog->capacity);
+        free(backlog->data);
+    }
+    backlog->data = data;
+    backlog->start = 0;
+    backlog->len = used;
+    backlog->capacity = capacity;
+    return 0;
+}
+
+/**
+ * Move everything the peers have published to this party into the
+ * backlogs, freeing their rings for more
+ */
+static int drain_incoming(spsc_endpoint_t *ep, uint8_t me) {
+    spsc_hub_t *hub = ep->hub;
+
+    for (uint8_t peer = 1; peer <= hub->num_parties; peer++) {
+        if (peer == me) {
+            continue;
+        }
+        spsc_ring_t *ring = hub_ring(hub, peer, me);
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        ring->cached_head = atomic_load_explicit(&ring->head,
+                                                 memory_order_acquire);
+        size_t len = ring->cached_head - tail;
+        if (len == 0) {
+            continue;
+        }
+
+        spsc_backlog_t *backlog = &ep->backlogs[peer - 1];
+        if (backlog_reserve(backlog, len) != 0) {
+            return -1;
+        }
+        ring_read(ring, tail, backlog->data + backlog->len, len);
+        backlog->len += len;
+        atomic_store_explicit(&ring->tail, ring->cached_head,
+                              memory_order_release);
+    }
+    return 0;
+}
+
+/**
+ * Take the oldest backlogged message from a peer
+ */
+static int backlog_recv(spsc_backlog_t *backlog, void *buffer,
+                        size_t capacity, size_t *len) {
+    const uint8_t *msg = backlog->data + backlog->start;
+    size_t msg_len = get_u32_le(msg);
+
+    int result = 0;
+    if (msg_len > capacity) {
+        result = -1;
+    } else {
+        if (msg_len > 0) {
+            memcpy(buffer, msg + RING_HEADER_SIZE, msg_len);
+        }
+        *len = msg_len;
+    }
+
+    backlog->start += RING_HEADER_SIZE + msg_len;
+    if (backlog->start == backlog->len) {
+        secure_wipe(backlog->data, backlog->len);
+        backlog->start = 0;
+        backlog->len = 0;
+    }
+    return result;
+}
+
+/* ========================================================================
+ * Backend Operations
+ * ======================================================================== */
+
+static int spsc_sendv(mpc_transport_t *transport, uint8_t to,
+                      const mpc_transport_iov_t *parts, size_t num_parts,
+                      size_t len) {
+    spsc_endpoint_t *ep = transport->impl;
+    spsc_hub_t *hub = ep->hub;
+    spsc_ring_t *ring = hub_ring(hub, transport->party_id, to);
+    size_t capacity = ring->mask + 1;
+    size_t need = RING_HEADER_SIZE + len;
+
+    if (need > capacity) {
+        return -1;
+    }
+
+    // Wait for room. Publish everything written so far, so no peer
+    // waits on us for it, and take in what the peers have sent, as they
+    // may be waiting for room in their rings to us.
+    unsigned spins = 0;
+    while (ring->pending + need - ring->cached_tail > capacity) {
+        ring->cached_tail = atomic_load_explicit(&ring->tail,
+                                                 memory_order_acquire);
+        if (ring->pending + need - ring->cached_tail > capacity) {
+            publish_all(hub, transport->party_id);
+            if (drain_incoming(ep, transport->party_id) != 0) {
+                return -1;
+            }
+            spin_wait(&spins);
+        }
+    }
+
+    uint8_t header[RING_HEADER_SIZE];
+    header[0] = (uint8_t)len;
+    header[1] = (uint8_t)(len >> 8);
+    header[2] = (uint8_t)(len >> 16);
+    header[3] = (uint8_t)(len >> 24);
+
+    size_t pos = ring->pending;
+    ring_write(ring, pos, header, RING_HEADER_SIZE);
+    pos += RING_HEADER_SIZE;
+    for (size_t i = 0; i < num_parts; i++) {
+        ring_write(ring, pos, parts[i].base, parts[i].len);
+        pos += parts[i].len;
+    }
+    ring->pending = pos;
+
+    return 0;
+}
+
+static int spsc_send(mpc_transport_t *transport, uint8_t to,
+                     const void *data, size_t len) {
+    mpc_transport_iov_t part = {data, len};
+    return spsc_sendv(transport, to, &part, 1, len);
+}
+
+static int spsc_recv(mpc_transport_t *transport, uint8_t from,
+                     void *buffer, size_t capacity, size_t *len) {
+    spsc_endpoint_t *ep = transport->impl;
+    spsc_backlog_t *backlog = &ep->backlogs[from - 1];
+    if (backlog->start < backlog->len) {
+        return backlog_recv(backlog, buffer, capacity, len);
+    }
+
+    spsc_hub_t *hub = ep->hub;
+    spsc_ring_t *ring = hub_ring(hub, from, transport->party_id);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    // Messages are published whole, so a visible header means a
+    // visible payload
+    unsigned spins = 0;
+    while (ring->cached_head == tail) {
+        ring->cached_head = atomic_load_explicit(&ring->head,
+                                                 memory_order_acquire);
+        if (ring->cached_head == tail) {
+            spin_wait(&spins);
+        }
+    }
+
+    uint8_t header[RING_HEADER_SIZE];
+    ring_read(ring, tail, header, RING_HEADER_SIZE);
+    size_t msg_len = get_u32_le(header);
+
+    int result = 0;
+    if (msg_len > capacity) {
+        result = -1;
+    } else {
+        ring_read(ring, tail + RING_HEADER_SIZE, buffer, msg_len);
+        *len = msg_len;
+    }
+
+    atomic_store_explicit(&ring->tail, tail + RING_HEADER_SIZE + msg_len,
+                          memory_order_release);
+    return result;
+}
+
+static int spsc_flush(mpc_transport_t *transport) {
+    spsc_endpoint_t *ep = transport->impl;
+    publish_all(ep->hub, transport->party_id);
+    return 0;
+}
+
+static void endpoint_free(spsc_endpoint_t *ep) {
+    for (uint8_t p = 0; p < ep->hub->num_parties; p++) {
+        if (ep->backlogs[p].data != NULL) {
+            secure_wipe(ep->backlogs[p].data, ep->backlogs[p].capacity);
+            free(ep->backlogs[p].data);
+        }
+    }
+    free(ep);
+}
+
+static void spsc_destroy(mpc_transport_t *transport) {
+    spsc_endpoint_t *ep = transport->impl;
+    spsc_hub_t *hub = ep->hub;
+
+    endpoint_free(ep);
+    if (atomic_fetch_sub_explicit(&hub->refs, 1, memory_order_acq_rel) == 1) {
+        hub_free(hub);
+    }
+}
+
+static const mpc_transport_ops_t spsc_ops = {
+    .name = "spsc",
+    .send = spsc_send,
+    .sendv = spsc_sendv,
+    .recv = spsc_recv,
+    .broadcast = NULL,
+    .flush = spsc_flush,
+    .destroy = spsc_destroy,
+};
+
+/* ========================================================================
+ * Group Construction
+ * ======================================================================== */
+
+int mpc_transport_spsc_create(uint8_t num_parties, size_t ring_bytes,
+                              mpc_transport_t **endpoints) {
+    if (num_parties < 2 || endpoints == NULL) {
+        return -1;
+    }
+
+    if (ring_bytes == 0) {
+        ring_bytes = MPC_TRANSPORT_SPSC_DEFAULT_RING;
+    }
+    if (ring_bytes > MPC_TRANSPORT_MAX_MESSAGE + RING_HEADER_SIZE) {
+        ring_bytes = MPC_TRANSPORT_MAX_MESSAGE + RING_HEADER_SIZE;
+    }
+
+    // Round up to a power of two (at least one cache line)
+    size_t capacity = CACHE_LINE_SIZE;
+    while (capacity < ring_bytes) {
+        capacity <<= 1;
+    }
+
+    spsc_hub_t *hub = calloc(1, sizeof(spsc_hub_t));
+    if (hub == NULL) {
+        return -1;
+    }
+
+    size_t count = (size_t)num_parties * num_parties;
+    hub->num_parties = num_parties;
+    hub->ring_bytes = capacity;
+    hub->rings = aligned_alloc(CACHE_LINE_SIZE, count * sizeof(spsc_ring_t));
+    if (hub->rings == NULL) {
+        free(hub);
+        return -1;
+    }
+    memset(hub->rings, 0, count * sizeof(spsc_ring_t));
+
+    for (uint8_t from = 1; from <= num_parties; from++) {
+        for (uint8_t to = 1; to <= num_parties; to++) {
+            if (from == to) {
+                continue;
+            }
+            spsc_ring_t *ring = hub_ring(hub, from, to);
+            ring->mask = capacity - 1;
+            ring->data = aligned_alloc(CACHE_LINE_SIZE, capacity);
+            if (ring->data == NULL) {
+                hub_free(hub);
+                return -1;
+            }
+            atomic_init(&ring->head, 0);
+            atomic_init(&ring->tail, 0);
+        }
+    }
+
+    for (uint8_t i = 0; i < num_parties; i++) {
+        spsc_endpoint_t *ep = calloc(1, sizeof(spsc_endpoint_t) +
+                                        num_parties * sizeof(spsc_backlog_t));
+        if (ep != NULL) {
+            ep->hub = hub;
+            ep->backlogs = (spsc_backlog_t *)(ep + 1);
+        }
+        endpoints[i] = (ep != NULL)
+            ? mpc_transport_alloc(&spsc_ops, i + 1, num_parties, ep) : NULL;
+        if (endpoints[i] == NULL) {
+            free(ep);
+            for (uint8_t j = 0; j < i; j++) {
+                endpoint_free(endpoints[j]->impl);
+                free(endpoints[j]);
+                endpoints[j] = NULL;
+            }
+            hub_free(hub);
+            return -1;
+        }
+    }
+    atomic_init(&hub->refs, num_parties);
+
+    return 0;
+}
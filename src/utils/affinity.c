@@ -0,0 +1,63 @@
+#define _GNU_SOURCE
+#include "utils/affinity.h"
+
+#ifdef __linux__
+
+#include <pthread.h>
+#include <sched.h>
+
+unsigned sss_num_cpus(void) {
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return 1;
+    }
+
+    int count = CPU_COUNT(&allowed);
+    return (count > 0) ? (unsigned)count : 1;
+}
+
+int sss_pin_thread(unsigned cpu) {
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return -1;
+    }
+
+    int num_allowed = CPU_COUNT(&allowed);
+    if (num_allowed <= 0) {
+        return -1;
+    }
+
+    // Find the (cpu mod num_allowed)-th CPU of the mask
+    int target = (int)(cpu % (unsigned)num_allowed);
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (!CPU_ISSET(c, &allowed)) {
+            continue;
+        }
+        if (target-- == 0) {
+            cpu_set_t one;
+            CPU_ZERO(&one);
+            CPU_SET(c, &one);
+            return pthread_setaffinity_np(pthread_self(), sizeof(one),
+                                          &one) == 0 ? 0 : -1;
+        }
+    }
+    return -1;
+}
+
+#else
+
+#include <unistd.h>
+
+/* No thread affinity API: report the online CPUs and never pin */
+
+unsigned sss_num_cpus(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (unsigned)count : 1;
+}
+
+int sss_pin_thread(unsigned cpu) {
+    (void)cpu;
+    return -1;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,239 @@
+#include "sss/secret_sharing.h"
+#include "sss/field.h"
+#include "sss/polynomial.h"
+#include "sss/mpc.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+/*
+ * In a library built with -DSSS_DIFFERENTIAL_CHECK=ON, every kernel call
+ * below is recomputed by the reference implementations, and any
+ * disagreement aborts the test. In a normal build the same calls run
+ * unchecked and only the results themselves are tested.
+ */
+static int checking = 0;
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+// Test 1: The interval can be set in check builds only
+int test_interval() {
+    printf("\n" COLOR_YELLOW "→ Test 1: Check interval" COLOR_RESET "\n");
+
+    int status = sss_set_check_interval(1);
+    checking = (status == 0);
+    printf("  Library built %s differential checks\n",
+           checking ? "with" : "without");
+
+    // Both builds accept any interval the same way
+    int ok = (status == 0 || status == -1);
+    ok &= (sss_set_check_interval(0) == status);
+    ok &= (sss_set_check_interval(1000) == status);
+    ok &= (sss_set_check_interval(1) == status);
+    return ok;
+}
+
+// Test 2: All products and inverses of the field
+int test_field_exhaustive() {
+    printf("\n" COLOR_YELLOW "→ Test 2: Every product and inverse" COLOR_RESET "\n");
+
+    int ok = 1;
+    for (unsigned a = 0; a < 256; a++) {
+        for (unsigned b = 0; b < 256; b++) {
+            // Commutative and zero-absorbing, whatever the kernel
+            uint8_t p = gf256_mul((uint8_t)a, (uint8_t)b);
+            ok &= (p == gf256_mul((uint8_t)b, (uint8_t)a));
+            ok &= (a != 0 && b != 0) || p == 0;
+        }
+        uint8_t inv = gf256_inv((uint8_t)a);
+        ok &= (a == 0) ? inv == 0 : gf256_mul((uint8_t)a, inv) == 1;
+    }
+
+    // All 256 again through batch inversions, each checked at a random
+    // element
+    uint8_t all[256], inverses[256];
+    for (unsigned a = 0; a < 256; a++) {
+        all[a] = (uint8_t)(a * 151 + 7);
+    }
+    for (int call = 0; call < 64; call++) {
+        gf256_inv_batch(all, inverses, 256);
+    }
+    for (unsigned a = 0; a < 256; a++) {
+        ok &= (inverses[a] == gf256_inv(all[a]));
+    }
+
+    // Non-square products, each checked at a random element
+    uint8_t a[7 * 5], b[5 * 9], c[7 * 9];
+    for (unsigned i = 0; i < sizeof(a); i++) {
+        a[i] = (uint8_t)(i * 29 + 1);
+    }
+    for (unsigned i = 0; i < sizeof(b); i++) {
+        b[i] = (uint8_t)(i * 83 + 5);
+    }
+    for (int call = 0; call < 64; call++) {
+        gf256_gemm(7, 5, 9, a, b, c);
+    }
+    for (unsigned i = 0; i < 7; i++) {
+        for (unsigned j = 0; j < 9; j++) {
+            uint8_t sum = 0;
+            for (unsigned l = 0; l < 5; l++) {
+                sum ^= gf256_mul(a[i * 5 + l], b[l * 9 + j]);
+            }
+            ok &= (c[i * 9 + j] == sum);
+        }
+    }
+    printf("  65536 products, 256 inverses, 64 batches of 256, "
+           "64 7x5 by 5x9 products\n");
+    return ok;
+}
+
+// Test 3: Polynomials and sharing across thresholds and lengths
+int test_sharing() {
+    printf("\n" COLOR_YELLOW "→ Test 3: Split and combine" COLOR_RESET "\n");
+
+    static const uint8_t grid[][2] = {{2, 3}, {3, 5}, {5, 10}, {32, 64},
+                                      {128, 255}};
+    static sss_share_t shares[SSS_MAX_SHARES];
+    uint8_t secret[SSS_SHARE_DATA_SIZE];
+    uint8_t recovered[SSS_SHARE_DATA_SIZE];
+    int ok = 1;
+
+    for (size_t g = 0; g < sizeof(grid) / sizeof(grid[0]); g++) {
+        uint8_t threshold = grid[g][0];
+        uint8_t num_shares = grid[g][1];
+        for (size_t i = 0; i < sizeof(secret); i++) {
+            secret[i] = (uint8_t)(g * 37 + i * 11);
+        }
+
+        ok &= sss_create_shares(secret, sizeof(secret), threshold,
+                                num_shares, shares) == SSS_OK;
+
+        // The last threshold shares as well as all of them
+        size_t len = sizeof(recovered);
+        ok &= sss_combine_shares(shares + (num_shares - threshold), threshold,
+                                 recovered, &len) == SSS_OK;
+        ok &= memcmp(recovered, secret, sizeof(secret)) == 0;
+        len = sizeof(recovered);
+        ok &= sss_combine_shares(shares, num_shares, recovered,
+                                 &len) == SSS_OK;
+        ok &= memcmp(recovered, secret, sizeof(secret)) == 0;
+        printf("  t=%u n=%u: %s\n", threshold, num_shares,
+               ok ? "agree" : "differ");
+    }
+
+    for (size_t i = 0; i < SSS_MAX_SHARES; i++) {
+        sss_wipe_share(&shares[i]);
+    }
+    return ok;
+}
+
+// Test 4: Sampled checking under a protocol workload
+int test_sampled() {
+    printf("\n" COLOR_YELLOW "→ Test 4: Sampled checks" COLOR_RESET "\n");
+
+    // 1 call in 64 is checked; the rest run at full speed
+    sss_set_check_interval(64);
+
+    mpc_context_t ctx;
+    mpc_share_t x[5], y[5], product[5];
+    int ok = mpc_init_context(&ctx, 5, 3, 4) == 0;
+
+    for (unsigned round = 0; round < 200 && ok; round++) {
+        uint8_t a[4] = {(uint8_t)round, 3, 200, 7};
+        uint8_t b[4] = {(uint8_t)(round * 7), 5, 9, 255};
+        uint8_t c[4];
+        ok &= mpc_create_shares(&ctx, a, x) == 0;
+        ok &= mpc_create_shares(&ctx, b, y) == 0;
+        ok &= mpc_secure_mul(&ctx, x, y, product, 5) == 0;
+        ok &= mpc_reconstruct(&ctx, product, 5, c) == 0;
+        for (int i = 0; i < 4; i++) {
+            ok &= (c[i] == gf256_mul(a[i], b[i]));
+        }
+    }
+    printf("  200 secure multiplications %s\n",
+           checking ? "with 1 in 64 kernel calls checked" : "unchecked");
+
+    for (int i = 0; i < 5; i++) {
+        mpc_wipe_share(&x[i]);
+        mpc_wipe_share(&y[i]);
+        mpc_wipe_share(&product[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    sss_set_check_interval(1);
+    return ok;
+}
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Differential Check Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Configuration");
+    TEST_ASSERT(test_interval(), "Interval Settable in Check Builds Only");
+
+    print_header("Kernels");
+    TEST_ASSERT(test_field_exhaustive(), "Field Kernels Over All Operands");
+    TEST_ASSERT(test_sharing(), "Polynomial and Sharing Kernels");
+    TEST_ASSERT(test_sampled(), "Sampled Checks During Multiplications");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}
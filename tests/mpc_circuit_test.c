@@ -0,0 +1,468 @@
+#include "sss/circuit.h"
+#include "sss/mpc.h"
+#include "sss/field.h"
+#include "sss/secret_sharing.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+// Test 1: (a × b) + (c × d) needs a single round
+int test_sum_of_products() {
+    printf("\n" COLOR_YELLOW "→ Test 1: (a × b) + (c × d)" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 1);
+
+    mpc_circuit_t circ;
+    mpc_circuit_init(&circ);
+    mpc_wire_t a = mpc_circuit_input(&circ);
+    mpc_wire_t b = mpc_circuit_input(&circ);
+    mpc_wire_t c = mpc_circuit_input(&circ);
+    mpc_wire_t d = mpc_circuit_input(&circ);
+    mpc_wire_t ab = mpc_circuit_mul(&circ, a, b);
+    mpc_wire_t cd = mpc_circuit_mul(&circ, c, d);
+    mpc_circuit_output(&circ, mpc_circuit_add(&circ, ab, cd));
+
+    uint8_t values[4] = {5, 6, 7, 9};
+    mpc_share_t shares[4][5];
+    for (int i = 0; i < 4; i++) {
+        mpc_create_shares(&ctx, &values[i], shares[i]);
+    }
+
+    const mpc_share_t *inputs[4] = {shares[0], shares[1], shares[2], shares[3]};
+    mpc_share_t result_shares[5];
+    mpc_share_t *outputs[1] = {result_shares};
+    mpc_circuit_stats_t stats;
+
+    int ok = (mpc_circuit_evaluate(&ctx, &circ, inputs, outputs, 5, &stats) == 0);
+
+    uint8_t result = 0;
+    ok = ok && (mpc_reconstruct(&ctx, result_shares, 3, &result) == 0);
+
+    uint8_t expected = gf256_add(gf256_mul(5, 6), gf256_mul(7, 9));
+    printf("  Expected: %d, Actual: %d\n", expected, result);
+    printf("  Depth: %u, Rounds: %u, Multiplications: %u\n",
+           circ.depth, stats.rounds, stats.multiplications);
+
+    int success = ok && result == expected && circ.depth == 1 &&
+                  stats.rounds == 1 && stats.multiplications == 2;
+
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 5; j++) {
+            mpc_wipe_share(&shares[i][j]);
+        }
+    }
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return success;
+}
+
+// Test 2: x^8 by repeated squaring needs three rounds
+int test_repeated_squaring() {
+    printf("\n" COLOR_YELLOW "→ Test 2: x^8 by Repeated Squaring" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 1);
+
+    mpc_circuit_t circ;
+    mpc_circuit_init(&circ);
+    mpc_wire_t x = mpc_circuit_input(&circ);
+    mpc_wire_t x2 = mpc_circuit_mul(&circ, x, x);
+    mpc_wire_t x4 = mpc_circuit_mul(&circ, x2, x2);
+    mpc_wire_t x8 = mpc_circuit_mul(&circ, x4, x4);
+    mpc_circuit_output(&circ, x8);
+
+    uint8_t value = 3;
+    mpc_share_t shares[5];
+    mpc_create_shares(&ctx, &value, shares);
+
+    const mpc_share_t *inputs[1] = {shares};
+    mpc_share_t result_shares[5];
+    mpc_share_t *outputs[1] = {result_shares};
+    mpc_circuit_stats_t stats;
+
+    int ok = (mpc_circuit_evaluate(&ctx, &circ, inputs, outputs, 5, &stats) == 0);
+
+    uint8_t result = 0;
+    ok = ok && (mpc_reconstruct(&ctx, result_shares, 3, &result) == 0);
+
+    uint8_t expected = gf256_pow(3, 8);
+    printf("  Expected: %d, Actual: %d, Rounds: %u\n", expected, result, stats.rounds);
+
+    int success = ok && result == expected && stats.rounds == 3;
+
+    for (int i = 0; i < 5; i++) {
+        mpc_wipe_share(&shares[i]);
+    }
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return success;
+}
+
+// Test 3: Many independent products share one round
+int test_wide_layer() {
+    printf("\n" COLOR_YELLOW "→ Test 3: 16 Independent Products in One Round" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 1);
+
+    mpc_circuit_t circ;
+    mpc_circuit_init(&circ);
+
+    mpc_wire_t in[17];
+    for (int i = 0; i < 17; i++) {
+        in[i] = mpc_circuit_input(&circ);
+    }
+    mpc_wire_t acc = mpc_circuit_mul(&circ, in[0], in[1]);
+    for (int i = 1; i < 16; i++) {
+        acc = mpc_circuit_add(&circ, acc, mpc_circuit_mul(&circ, in[i], in[i + 1]));
+    }
+    mpc_circuit_output(&circ, acc);
+
+    uint8_t values[17];
+    mpc_share_t shares[17][5];
+    const mpc_share_t *inputs[17];
+    uint8_t expected = 0;
+    for (int i = 0; i < 17; i++) {
+        values[i] = (uint8_t)(i * 13 + 1);
+        mpc_create_shares(&ctx, &values[i], shares[i]);
+        inputs[i] = shares[i];
+    }
+    for (int i = 0; i < 16; i++) {
+        expected = gf256_add(expected, gf256_mul(values[i], values[i + 1]));
+    }
+
+    mpc_share_t result_shares[5];
+    mpc_share_t *outputs[1] = {result_shares};
+    mpc_circuit_stats_t stats;
+
+    int ok = (mpc_circuit_evaluate(&ctx, &circ, inputs, outputs, 5, &stats) == 0);
+
+    uint8_t result = 0;
+    ok = ok && (mpc_reconstruct(&ctx, result_shares, 3, &result) == 0);
+
+    printf("  Multiplications: %u, Rounds: %u\n", stats.multiplications, stats.rounds);
+
+    int success = ok && result == expected && stats.rounds == 1 &&
+                  stats.multiplications == 16;
+
+    for (int i = 0; i < 17; i++) {
+        for (int j = 0; j < 5; j++) {
+            mpc_wipe_share(&shares[i][j]);
+        }
+    }
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return success;
+}
+
+// Test 4: Linear circuits need no interaction
+int test_linear_circuit() {
+    printf("\n" COLOR_YELLOW "→ Test 4: ((a + b) × 12) - c Without Interaction" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 4);
+
+    mpc_circuit_t circ;
+    mpc_circuit_init(&circ);
+    mpc_wire_t a = mpc_circuit_input(&circ);
+    mpc_wire_t b = mpc_circuit_input(&circ);
+    mpc_wire_t c = mpc_circuit_input(&circ);
+    mpc_wire_t scaled = mpc_circuit_mul_const(&circ, mpc_circuit_add(&circ, a, b), 12);
+    mpc_circuit_output(&circ, mpc_circuit_sub(&circ, scaled, c));
+
+    uint8_t values[3][4] = {{1, 2, 3, 4}, {10, 20, 30, 40}, {7, 7, 7, 7}};
+    mpc_share_t shares[3][5];
+    for (int i = 0; i < 3; i++) {
+        mpc_create_shares(&ctx, values[i], shares[i]);
+    }
+
+    const mpc_share_t *inputs[3] = {shares[0], shares[1], shares[2]};
+    mpc_share_t result_shares[5];
+    mpc_share_t *outputs[1] = {result_shares};
+    mpc_circuit_stats_t stats;
+
+    int ok = (mpc_circuit_evaluate(&ctx, &circ, inputs, outputs, 5, &stats) == 0);
+
+    uint8_t result[4] = {0};
+    ok = ok && (mpc_reconstruct(&ctx, result_shares, 3, result) == 0);
+
+    int match = 1;
+    for (int j = 0; j < 4; j++) {
+        uint8_t expected = gf256_sub(gf256_mul(gf256_add(values[0][j], values[1][j]), 12),
+                                     values[2][j]);
+        if (result[j] != expected) {
+            match = 0;
+        }
+    }
+    printf("  Rounds: %u, Local gates: %u\n", stats.rounds, stats.local_gates);
+
+    int success = ok && match && circ.depth == 0 && stats.rounds == 0 &&
+                  stats.local_gates == 3;
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 5; j++) {
+            mpc_wipe_share(&shares[i][j]);
+        }
+    }
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return success;
+}
+
+// Test 5: Malformed circuits are rejected at construction time
+int test_invalid_wires() {
+    printf("\n" COLOR_YELLOW "→ Test 5: Invalid Wire Rejection" COLOR_RESET "\n");
+
+    mpc_circuit_t circ;
+    mpc_circuit_init(&circ);
+    mpc_wire_t a = mpc_circuit_input(&circ);
+    mpc_wire_t out = mpc_circuit_output(&circ, a);
+
+    int forward_ref = (mpc_circuit_add(&circ, a, 42) == MPC_WIRE_INVALID);
+    int output_operand = (mpc_circuit_mul(&circ, a, out) == MPC_WIRE_INVALID);
+    int null_circuit = (mpc_circuit_input(NULL) == MPC_WIRE_INVALID);
+
+    printf("  Forward reference rejected: %s\n", forward_ref ? "yes" : "no");
+    printf("  Output used as operand rejected: %s\n", output_operand ? "yes" : "no");
+
+    int success = forward_ref && output_operand && null_circuit &&
+                  circ.num_gates == 2;
+
+    mpc_circuit_free(&circ);
+    return success;
+}
+
+// Helper: evaluate a single-output circuit on 1-byte inputs and open it
+static int eval_single(const mpc_context_t *ctx, const mpc_circuit_t *circ,
+                       const uint8_t *values, uint8_t *result,
+                       mpc_circuit_stats_t *stats) {
+    mpc_share_t shares[16][5];
+    const mpc_share_t *inputs[16];
+    for (uint32_t i = 0; i < circ->num_inputs; i++) {
+        mpc_create_shares(ctx, &values[i], shares[i]);
+        inputs[i] = shares[i];
+    }
+
+    mpc_share_t result_shares[5];
+    mpc_share_t *outputs[1] = {result_shares};
+
+    int ok = (mpc_circuit_evaluate(ctx, circ, inputs, outputs, 5, stats) == 0);
+    ok = ok && (mpc_reconstruct(ctx, result_shares, 3, result) == 0);
+
+    for (uint32_t i = 0; i < circ->num_inputs; i++) {
+        for (int j = 0; j < 5; j++) {
+            mpc_wipe_share(&shares[i][j]);
+        }
+    }
+    return ok;
+}
+
+// Test 6: Product chain is rebalanced into a tree
+int test_optimize_balance() {
+    printf("\n" COLOR_YELLOW "→ Test 6: Rebalance x1 × x2 × ... × x8" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 1);
+
+    mpc_circuit_t circ, fast;
+    mpc_circuit_init(&circ);
+    mpc_wire_t acc = mpc_circuit_input(&circ);
+    for (int i = 1; i < 8; i++) {
+        acc = mpc_circuit_mul(&circ, acc, mpc_circuit_input(&circ));
+    }
+    mpc_circuit_output(&circ, acc);
+
+    mpc_circuit_opt_stats_t opt;
+    int ok = (mpc_circuit_optimize(&circ, &fast, MPC_OPT_ALL, &opt) == 0);
+
+    uint8_t values[8] = {2, 3, 5, 7, 11, 13, 17, 19};
+    uint8_t expected = 1;
+    for (int i = 0; i < 8; i++) {
+        expected = gf256_mul(expected, values[i]);
+    }
+
+    uint8_t result = 0;
+    mpc_circuit_stats_t stats;
+    ok = ok && eval_single(&ctx, &fast, values, &result, &stats);
+
+    printf("  Depth: %u → %u, Rounds: %u\n", opt.depth_before, opt.depth_after,
+           stats.rounds);
+
+    int success = ok && result == expected && opt.depth_before == 7 &&
+                  opt.depth_after == 3 && stats.rounds == 3 &&
+                  opt.muls_after == 7;
+
+    mpc_circuit_free(&fast);
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return success;
+}
+
+// Test 7: Public constants fold into local MUL_CONST gates
+int test_optimize_fold() {
+    printf("\n" COLOR_YELLOW "→ Test 7: Fold ((a × 3) × 5) × (2 + 7)" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 1);
+
+    mpc_circuit_t circ, fast;
+    mpc_circuit_init(&circ);
+    mpc_wire_t a = mpc_circuit_input(&circ);
+    mpc_wire_t scaled = mpc_circuit_mul_const(&circ, mpc_circuit_mul_const(&circ, a, 3), 5);
+    mpc_wire_t k = mpc_circuit_add(&circ, mpc_circuit_const(&circ, 2),
+                                   mpc_circuit_const(&circ, 7));
+    mpc_circuit_output(&circ, mpc_circuit_mul(&circ, scaled, k));
+
+    mpc_circuit_opt_stats_t opt;
+    int ok = (mpc_circuit_optimize(&circ, &fast, MPC_OPT_ALL, &opt) == 0);
+
+    uint8_t values[1] = {42};
+    uint8_t expected = gf256_mul(gf256_mul(gf256_mul(42, 3), 5), gf256_add(2, 7));
+
+    uint8_t before = 0, after = 0;
+    mpc_circuit_stats_t stats_before, stats_after;
+    ok = ok && eval_single(&ctx, &circ, values, &before, &stats_before);
+    ok = ok && eval_single(&ctx, &fast, values, &after, &stats_after);
+
+    printf("  Gates: %u → %u, Rounds: %u → %u\n", opt.gates_before, opt.gates_after,
+           stats_before.rounds, stats_after.rounds);
+
+    // input, one MUL_CONST, output
+    int success = ok && before == expected && after == expected &&
+                  opt.muls_after == 0 && stats_after.rounds == 0 &&
+                  fast.num_gates == 3;
+
+    mpc_circuit_free(&fast);
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return success;
+}
+
+// Test 8: Repeated subexpressions and dead gates are removed
+int test_optimize_cse_dce() {
+    printf("\n" COLOR_YELLOW "→ Test 8: CSE of a × b and b × a, Dead Gate Removal" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 1);
+
+    mpc_circuit_t circ, fast;
+    mpc_circuit_init(&circ);
+    mpc_wire_t a = mpc_circuit_input(&circ);
+    mpc_wire_t b = mpc_circuit_input(&circ);
+    mpc_wire_t c = mpc_circuit_input(&circ);
+    mpc_wire_t ab = mpc_circuit_mul(&circ, a, b);
+    mpc_wire_t ba = mpc_circuit_mul(&circ, b, a);
+    mpc_circuit_mul(&circ, a, c);                   // Never used
+    mpc_wire_t s1 = mpc_circuit_add(&circ, ab, c);
+    mpc_wire_t s2 = mpc_circuit_add(&circ, c, ba);
+    mpc_circuit_output(&circ, mpc_circuit_mul(&circ, s1, s2));
+
+    mpc_circuit_opt_stats_t opt;
+    int ok = (mpc_circuit_optimize(&circ, &fast, MPC_OPT_ALL, &opt) == 0);
+
+    uint8_t values[3] = {9, 10, 11};
+    uint8_t s = gf256_add(gf256_mul(9, 10), 11);
+    uint8_t expected = gf256_mul(s, s);
+
+    uint8_t result = 0;
+    mpc_circuit_stats_t stats;
+    ok = ok && eval_single(&ctx, &fast, values, &result, &stats);
+
+    printf("  Multiplications: %u → %u (Beaver triples saved: %u)\n",
+           opt.muls_before, opt.muls_after, opt.muls_before - opt.muls_after);
+
+    int success = ok && result == expected && opt.muls_before == 4 &&
+                  opt.muls_after == 2 && fast.num_inputs == 3;
+
+    mpc_circuit_free(&fast);
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return success;
+}
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  MPC Circuit Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Layered Evaluation");
+    TEST_ASSERT(test_sum_of_products(), "Sum of Products in One Round");
+    TEST_ASSERT(test_repeated_squaring(), "Rounds Equal Multiplicative Depth");
+    TEST_ASSERT(test_wide_layer(), "Wide Layer Batched Into One Round");
+    TEST_ASSERT(test_linear_circuit(), "Linear Circuit Needs No Rounds");
+
+    print_header("Optimization");
+    TEST_ASSERT(test_optimize_balance(), "Product Chain Rebalanced");
+    TEST_ASSERT(test_optimize_fold(), "Public Constants Folded");
+    TEST_ASSERT(test_optimize_cse_dce(), "CSE and Dead Gate Removal");
+
+    print_header("Robustness Tests");
+    TEST_ASSERT(test_invalid_wires(), "Invalid Wires Rejected");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}
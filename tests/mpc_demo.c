@@ -33,7 +33,9 @@ int main(void) {
     printf("Configuration:\n");
     printf("  - Number of parties: %d\n", ctx.num_parties);
     printf("  - Threshold: %d\n", ctx.threshold);
-    printf("  - Computation ID: 0x%02X\n\n", ctx.computation_id);
+    char session_hex[MPC_SESSION_ID_HEX_SIZE];
+    mpc_session_id_to_hex(&ctx.session_id, session_hex);
+    printf("  - Session ID: %s\n\n", session_hex);
     
     // Alice's secret salary: $75,000 (simplified to 75)
     uint8_t alice_salary = 75;
@@ -52,7 +54,8 @@ int main(void) {
         for (size_t j = 0; j < shares[i].share.data_len; j++) {
             printf("%02X", shares[i].share.data[j]);
         }
-        printf(", computation_id=0x%02X]\n", shares[i].computation_id);
+        mpc_session_id_to_hex(&shares[i].session_id, session_hex);
+        printf(", session_id=%.8s...]\n", session_hex);
     }
     
     // Validate shares
@@ -0,0 +1,428 @@
+#include "sss/mpc.h"
+#include "sss/fixed_point.h"
+#include "sss/secret_sharing.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+/* One unit in the last fractional bit */
+#define ULP (1.0 / (1 << MPC_FX_FRAC_BITS))
+
+static int close_to(double value, double expected, double tolerance) {
+    double diff = value - expected;
+    return diff <= tolerance && diff >= -tolerance;
+}
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+// Test 1: Sharing and reconstruction, including negatives
+int test_roundtrip() {
+    printf("\n" COLOR_YELLOW "→ Test 1: Share and reconstruct" COLOR_RESET "\n");
+
+    const double values[] = {0.0, 1.0, -1.0, 3.25, -1234.5, 52000.75,
+                             1e12, -1e12};
+    mpc_context_t ctx;
+    mpc_fx_share_t shares[5];
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0;
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]) && ok; i++) {
+        double opened = 0.0;
+        ok &= mpc_fx_create_shares(&ctx, values[i], shares) == 0;
+
+        // Any three shares open the value
+        ok &= mpc_fx_reconstruct(&ctx, shares + 2, 3, &opened) == 0;
+        ok &= close_to(opened, values[i], ULP / 2);
+        printf("  %.4f -> %.4f\n", values[i], opened);
+    }
+
+    for (int i = 0; i < 5; i++) {
+        mpc_fx_wipe_share(&shares[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 2: Local addition and subtraction are exact
+int test_add_sub() {
+    printf("\n" COLOR_YELLOW "→ Test 2: Addition and subtraction" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_fx_share_t x[5], y[5], sum[5], diff[5];
+    double s = 0.0, d = 0.0;
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0;
+    ok = ok && mpc_fx_create_shares(&ctx, 10.5, x) == 0;
+    ok = ok && mpc_fx_create_shares(&ctx, -32.25, y) == 0;
+    ok = ok && mpc_fx_add(&ctx, x, y, sum, 5) == 0;
+    ok = ok && mpc_fx_sub(&ctx, x, y, diff, 5) == 0;
+    ok = ok && mpc_fx_reconstruct(&ctx, sum, 5, &s) == 0;
+    ok = ok && mpc_fx_reconstruct(&ctx, diff, 5, &d) == 0;
+    printf("  10.5 + -32.25 = %.4f, 10.5 - -32.25 = %.4f\n", s, d);
+
+    mpc_cleanup_context(&ctx);
+    return ok && s == -21.75 && d == 42.75;
+}
+
+// Test 3: Multiplication with resharing and truncation
+int test_mul() {
+    printf("\n" COLOR_YELLOW "→ Test 3: Multiplication" COLOR_RESET "\n");
+
+    const double pairs[][2] = {
+        {3.5, 2.0}, {-7.25, 4.125}, {1234.5678, -0.001}, {-3e4, -2e4},
+        {0.0, 99.0}
+    };
+    mpc_context_t ctx;
+    mpc_fx_share_t x[5], y[5], product[5];
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0;
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]) && ok; i++) {
+        double a = pairs[i][0], b = pairs[i][1], opened = 0.0;
+        ok &= mpc_fx_create_shares(&ctx, a, x) == 0;
+        ok &= mpc_fx_create_shares(&ctx, b, y) == 0;
+        ok &= mpc_fx_mul(&ctx, x, y, product, 5) == 0;
+
+        // The product is reshared to all parties; any three open it
+        ok &= mpc_fx_reconstruct(&ctx, product, 3, &opened) == 0;
+
+        // Encoding error of both operands plus one bit of truncation
+        double tolerance = ULP * (1.0 + (a < 0 ? -a : a) + (b < 0 ? -b : b));
+        ok &= close_to(opened, a * b, tolerance);
+        printf("  %.4f * %.4f = %.4f\n", a, b, opened);
+    }
+
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 4: Public constants and divisors
+int test_public() {
+    printf("\n" COLOR_YELLOW "→ Test 4: Public multiplier and divisor" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_fx_share_t x[5], out[5];
+    double opened = 0.0;
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0;
+    ok = ok && mpc_fx_create_shares(&ctx, -250.5, x) == 0;
+
+    ok = ok && mpc_fx_mul_public(&ctx, x, 0.3, out, 5) == 0;
+    ok = ok && mpc_fx_reconstruct(&ctx, out, 5, &opened) == 0;
+    printf("  -250.5 * 0.3 = %.4f\n", opened);
+    ok = ok && close_to(opened, -75.15, 300 * ULP);
+
+    // Division needs only threshold shares
+    ok = ok && mpc_fx_div_public(&ctx, x, 7, out, 3) == 0;
+    ok = ok && mpc_fx_reconstruct(&ctx, out, 3, &opened) == 0;
+    printf("  -250.5 / 7 = %.4f\n", opened);
+    ok = ok && close_to(opened, -250.5 / 7, 2 * ULP);
+
+    ok = ok && mpc_fx_div_public(&ctx, x, 1, out, 5) == 0;
+    ok = ok && mpc_fx_reconstruct(&ctx, out, 5, &opened) == 0;
+    ok = ok && close_to(opened, -250.5, 2 * ULP);
+
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 5: Average, weighted mean and variance of 2000 salaries
+int test_statistics() {
+    printf("\n" COLOR_YELLOW "→ Test 5: Salary statistics" COLOR_RESET "\n");
+
+    enum { VALUES = 2000 };
+    mpc_context_t ctx;
+    mpc_fx_share_t (*inputs)[5] = malloc(VALUES * sizeof(*inputs));
+    const mpc_fx_share_t **sets = malloc(VALUES * sizeof(*sets));
+    double *weights = malloc(VALUES * sizeof(double));
+    mpc_fx_share_t avg[5], mean[5], var[5];
+    double sum = 0.0, sum_sq = 0.0, weighted = 0.0, total_weight = 0.0;
+
+    int ok = inputs != NULL && sets != NULL && weights != NULL;
+    ok = ok && mpc_init_context(&ctx, 5, 3, 1) == 0;
+    for (int v = 0; v < VALUES && ok; v++) {
+        double salary = 30000.0 + (double)((v * 7919) % 90000) + 0.25 * (v % 4);
+        weights[v] = 1.0 + (v % 3);
+        sum += salary;
+        sum_sq += salary * salary;
+        weighted += weights[v] * salary;
+        total_weight += weights[v];
+        ok &= mpc_fx_create_shares(&ctx, salary, inputs[v]) == 0;
+        sets[v] = inputs[v];
+    }
+
+    double expected_avg = sum / VALUES;
+    double expected_var = sum_sq / VALUES - expected_avg * expected_avg;
+    double expected_mean = weighted / total_weight;
+    double opened_avg = 0.0, opened_mean = 0.0, opened_var = 0.0;
+
+    ok = ok && mpc_fx_average(&ctx, sets, VALUES, 5, avg) == 0;
+    ok = ok && mpc_fx_reconstruct(&ctx, avg, 5, &opened_avg) == 0;
+    ok = ok && mpc_fx_weighted_mean(&ctx, sets, weights, VALUES, 5,
+                                    mean) == 0;
+    ok = ok && mpc_fx_reconstruct(&ctx, mean, 5, &opened_mean) == 0;
+    ok = ok && mpc_fx_variance(&ctx, sets, VALUES, 5, var) == 0;
+    ok = ok && mpc_fx_reconstruct(&ctx, var, 3, &opened_var) == 0;
+
+    printf("  Average:       %.4f (plaintext %.4f)\n", opened_avg, expected_avg);
+    printf("  Weighted mean: %.4f (plaintext %.4f)\n", opened_mean,
+           expected_mean);
+    printf("  Variance:      %.1f (plaintext %.1f)\n", opened_var,
+           expected_var);
+
+    ok = ok && close_to(opened_avg, expected_avg, 2 * ULP);
+
+    // Weights are rounded relative to the largest
+    ok = ok && close_to(opened_mean, expected_mean, 1e-6 * expected_mean);
+
+    // The mean squared carries the error of the mean
+    ok = ok && close_to(opened_var, expected_var, 1e-6 * expected_var);
+
+    if (inputs != NULL) {
+        mpc_cleanup_context(&ctx);
+    }
+    free(inputs);
+    free(sets);
+    free(weights);
+    return ok;
+}
+
+// Test 6: Invalid inputs are rejected
+int test_errors() {
+    printf("\n" COLOR_YELLOW "→ Test 6: Error handling" COLOR_RESET "\n");
+
+    mpc_context_t ctx, other;
+    mpc_fx_share_t x[5], y[5], out[5];
+    const mpc_fx_share_t *sets[2] = {x, y};
+    const double zero_weights[2] = {1.0, -1.0};
+    double opened;
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0;
+    ok = ok && mpc_init_context(&other, 5, 3, 1) == 0;
+    ok = ok && mpc_fx_create_shares(&ctx, 2.0, x) == 0;
+    ok = ok && mpc_fx_create_shares(&ctx, 3.0, y) == 0;
+
+    // Out of range and not finite
+    ok &= mpc_fx_create_shares(&ctx, 1e15, out) == -1;
+    ok &= mpc_fx_create_shares(&ctx, 1.0 / 0.0, out) == -1;
+
+    // Too few shares to open, and to multiply (needs 2t - 1)
+    ok &= mpc_fx_reconstruct(&ctx, x, 2, &opened) == -1;
+    ok &= mpc_fx_mul(&ctx, x, y, out, 4) == -1;
+    ok &= mpc_fx_variance(&ctx, sets, 2, 4, out) == -1;
+
+    // Shares from another session
+    ok &= mpc_fx_add(&other, x, y, out, 5) == -1;
+    ok &= mpc_fx_reconstruct(&other, x, 5, &opened) == -1;
+
+    // Operands held by different parties
+    ok &= mpc_fx_add(&ctx, x, y + 1, out, 3) == -1;
+
+    // Bad divisors and weights
+    ok &= mpc_fx_div_public(&ctx, x, 0, out, 5) == -1;
+    ok &= mpc_fx_div_public(&ctx, x, (1ull << 40) + 1, out, 5) == -1;
+    ok &= mpc_fx_weighted_mean(&ctx, sets, zero_weights, 2, 5, out) == -1;
+    ok &= mpc_fx_average(&ctx, sets, 0, 5, out) == -1;
+
+    // NULL arguments
+    ok &= mpc_fx_create_shares(NULL, 1.0, out) == -1;
+    ok &= mpc_fx_reconstruct(&ctx, x, 5, NULL) == -1;
+    ok &= mpc_fx_mul(&ctx, x, NULL, out, 5) == -1;
+
+    mpc_cleanup_context(&ctx);
+    mpc_cleanup_context(&other);
+    return ok;
+}
+
+// Test 7: A vector of sums divided by their counts in one batch
+int test_batch_division() {
+    printf("\n" COLOR_YELLOW "→ Test 7: Batched division" COLOR_RESET "\n");
+
+    enum { VALUES = 10000 };
+    mpc_context_t ctx;
+    mpc_fx_share_t (*sums)[5] = malloc(VALUES * sizeof(*sums));
+    mpc_fx_share_t (*quotients)[5] = malloc(VALUES * sizeof(*quotients));
+    const mpc_fx_share_t **in = malloc(VALUES * sizeof(*in));
+    mpc_fx_share_t **out = malloc(VALUES * sizeof(*out));
+    uint64_t *counts = malloc(VALUES * sizeof(uint64_t));
+    double *expected = malloc(VALUES * sizeof(double));
+    mpc_fx_prep_t *prep = NULL;
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0;
+    ok = ok && sums != NULL && quotients != NULL && in != NULL &&
+         out != NULL && counts != NULL && expected != NULL;
+    for (int k = 0; k < VALUES && ok; k++) {
+        double sum = (double)((k * 104729) % 5000000) - 1000000.0 + 0.5;
+        counts[k] = 1 + (uint64_t)(k * 31) % 100000;
+        expected[k] = sum / (double)counts[k];
+        ok &= mpc_fx_create_shares(&ctx, sum, sums[k]) == 0;
+        in[k] = sums[k];
+        out[k] = quotients[k];
+    }
+
+    // Dealt ahead of time, all consumed by one batch
+    prep = ok ? mpc_fx_prep_create(&ctx, VALUES, MPC_FX_DIV_SHIFT(17))
+              : NULL;
+    ok = ok && prep != NULL && mpc_fx_prep_remaining(prep) == VALUES;
+    ok = ok && mpc_fx_div_public_batch(&ctx, prep, in, counts, out, VALUES,
+                                       5) == 0;
+    ok = ok && mpc_fx_prep_remaining(prep) == 0;
+
+    double worst = 0.0;
+    for (int k = 0; k < VALUES && ok; k++) {
+        double opened = 0.0;
+        ok &= mpc_fx_reconstruct(&ctx, quotients[k], 3, &opened) == 0;
+        double error = opened - expected[k];
+        error = error < 0 ? -error : error;
+        worst = error > worst ? error : worst;
+    }
+    printf("  %d quotients, worst error %.2e (%.2f units of 2^-f)\n",
+           VALUES, worst, worst / ULP);
+    ok = ok && worst <= 2 * ULP;
+
+    // The pool is spent
+    ok = ok && mpc_fx_div_public_batch(&ctx, prep, in, counts, out, 1,
+                                       5) == -1;
+
+    mpc_fx_prep_destroy(prep);
+    mpc_cleanup_context(&ctx);
+    free(sums);
+    free(quotients);
+    free(in);
+    free(out);
+    free(counts);
+    free(expected);
+    return ok;
+}
+
+// Test 8: Batched truncation, aliasing and pool checks
+int test_batch_truncation() {
+    printf("\n" COLOR_YELLOW "→ Test 8: Batched truncation" COLOR_RESET "\n");
+
+    mpc_context_t ctx, other;
+    mpc_fx_share_t x[3][5];
+    const mpc_fx_share_t *in[3] = {x[0], x[1], x[2]};
+    mpc_fx_share_t *out[3] = {x[0], x[1], x[2]};
+    const double values[3] = {1000.0, -3.5, 0.75};
+    const uint64_t too_large[3] = {2, 1ull << 40, 3};
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0;
+    ok = ok && mpc_init_context(&other, 5, 3, 1) == 0;
+    for (int k = 0; k < 3 && ok; k++) {
+        ok &= mpc_fx_create_shares(&ctx, values[k], x[k]) == 0;
+    }
+    mpc_fx_prep_t *prep = mpc_fx_prep_create(&ctx, 4, 3);
+    ok = ok && prep != NULL;
+
+    // Pools belong to one context; bad divisors use no masks
+    ok = ok && mpc_fx_trunc_batch(&other, prep, in, out, 3, 5) == -1;
+    ok = ok && mpc_fx_div_public_batch(&ctx, prep, in, too_large, out, 3,
+                                       5) == -1;
+    ok = ok && mpc_fx_trunc_batch(&ctx, prep, in, out, 5, 5) == -1;
+    ok = ok && mpc_fx_prep_remaining(prep) == 4;
+
+    // In place, x / 8 with three shares
+    ok = ok && mpc_fx_trunc_batch(&ctx, prep, in, out, 3, 3) == 0;
+    ok = ok && mpc_fx_prep_remaining(prep) == 1;
+    for (int k = 0; k < 3 && ok; k++) {
+        double opened = 0.0;
+        ok &= mpc_fx_reconstruct(&ctx, x[k], 3, &opened) == 0;
+        printf("  %.4f / 8 = %.4f\n", values[k], opened);
+        ok &= close_to(opened, values[k] / 8, ULP);
+    }
+
+    // Invalid shifts
+    ok = ok && mpc_fx_prep_create(&ctx, 1, 0) == NULL;
+    ok = ok && mpc_fx_prep_create(&ctx, 1, MPC_FX_VALUE_BITS) == NULL;
+    ok = ok && mpc_fx_prep_create(&ctx, 0, 8) == NULL;
+    ok = ok && mpc_fx_prep_remaining(NULL) == 0;
+
+    mpc_fx_prep_destroy(prep);
+    mpc_fx_prep_destroy(NULL);
+    mpc_cleanup_context(&ctx);
+    mpc_cleanup_context(&other);
+    return ok;
+}
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Fixed-Point MPC Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Encoding and Linear Operations");
+    TEST_ASSERT(test_roundtrip(), "Signed Values Round Trip");
+    TEST_ASSERT(test_add_sub(), "Addition and Subtraction Are Exact");
+
+    print_header("Truncation");
+    TEST_ASSERT(test_mul(), "Products Within One Bit");
+    TEST_ASSERT(test_public(), "Public Multipliers and Divisors");
+
+    print_header("Statistics");
+    TEST_ASSERT(test_statistics(), "Average, Weighted Mean and Variance");
+
+    print_header("Error Handling");
+    TEST_ASSERT(test_errors(), "Invalid Inputs Rejected");
+
+    print_header("Batched Truncation and Division");
+    TEST_ASSERT(test_batch_division(), "A Vector of Quotients in One Batch");
+    TEST_ASSERT(test_batch_truncation(), "Masks Checked and Used Once");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}
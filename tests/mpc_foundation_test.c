@@ -147,16 +147,15 @@ int test_share_creation(void) {
     }
     print_test_result("All shares have correct party_id (1-5)", correct_count);
     
-    // Test 3.3: Verify computation_id is set
+    // Test 3.3: Verify session_id is set
     int comp_id_set = 1;
-    uint8_t expected_id = ctx.computation_id;
     for (int i = 0; i < 5; i++) {
-        if (shares[i].computation_id != expected_id) {
+        if (!mpc_session_id_equal(&shares[i].session_id, &ctx.session_id)) {
             comp_id_set = 0;
             break;
         }
     }
-    print_test_result("All shares have correct computation_id", comp_id_set);
+    print_test_result("All shares have correct session_id", comp_id_set);
     
     // Test 3.4: Verify data_len matches value_size
     int correct_len = 1;
@@ -283,11 +282,11 @@ int test_share_validation(void) {
     result = mpc_validate_share(&ctx, &invalid_share);
     print_test_result("Reject share with party_id = 0", result == -1);
     
-    // Test 5.4: Wrong computation_id
+    // Test 5.4: Wrong session_id
     invalid_share = shares[0];
-    invalid_share.computation_id = ctx.computation_id + 1;
+    invalid_share.session_id.bytes[MPC_SESSION_ID_SIZE - 1] ^= 0x01;
     result = mpc_validate_share(&ctx, &invalid_share);
-    print_test_result("Reject share with wrong computation_id", result == -1);
+    print_test_result("Reject share with wrong session_id", result == -1);
     
     // Test 5.5: Wrong data_len
     invalid_share = shares[0];
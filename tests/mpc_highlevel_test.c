@@ -216,9 +216,149 @@ int test_secure_greater() {
     return success;
 }
 
-// Test 5: Real-World - Employee Salary Average
+// Test 5: Secure Equality
+int test_secure_equal() {
+    printf("\n" COLOR_YELLOW "→ Test 5: Secure Equality" COLOR_RESET "\n");
+    
+    mpc_context_t ctx;
+    if (mpc_init_context(&ctx, 5, 3, 2) != 0) {
+        return 0;
+    }
+    
+    // Each byte compares separately: (7, 0) vs (7, 0), (7, 0) vs (7, 1),
+    // (0, 0) vs (0, 0) and (200, 5) vs (5, 200)
+    const uint8_t x[4][2] = {{7, 0}, {7, 0}, {0, 0}, {200, 5}};
+    const uint8_t y[4][2] = {{7, 0}, {7, 1}, {0, 0}, {5, 200}};
+    const uint8_t expected[4][2] = {{1, 1}, {1, 0}, {1, 1}, {0, 0}};
+    
+    int success = 1;
+    for (int k = 0; k < 4; k++) {
+        mpc_share_t shares_x[5], shares_y[5], shares_eq[5];
+        uint8_t result[2] = {0xFF, 0xFF};
+        
+        success &= mpc_create_shares(&ctx, x[k], shares_x) == 0;
+        success &= mpc_create_shares(&ctx, y[k], shares_y) == 0;
+        success &= mpc_secure_equal(&ctx, shares_x, shares_y, shares_eq, 5) == 0;
+        success &= mpc_reconstruct(&ctx, shares_eq, 3, result) == 0;
+        success &= memcmp(result, expected[k], 2) == 0;
+        
+        printf("  (%3d, %3d) == (%3d, %3d)? (%d, %d)\n", x[k][0], x[k][1],
+               y[k][0], y[k][1], result[0], result[1]);
+        
+        for (int i = 0; i < 5; i++) {
+            mpc_wipe_share(&shares_x[i]);
+            mpc_wipe_share(&shares_y[i]);
+            mpc_wipe_share(&shares_eq[i]);
+        }
+    }
+    
+    // Every difference maps to 0 except a zero difference
+    mpc_share_t shares_x[5], shares_y[5];
+    const uint8_t zero[2] = {0, 0};
+    success &= mpc_create_shares(&ctx, zero, shares_y) == 0;
+    for (int v = 1; v < 256 && success; v++) {
+        mpc_share_t shares_eq[5];
+        uint8_t value[2] = {(uint8_t)v, (uint8_t)(256 - v)}, result[2];
+        success &= mpc_create_shares(&ctx, value, shares_x) == 0;
+        success &= mpc_secure_equal(&ctx, shares_x, shares_y, shares_eq, 5) == 0;
+        success &= mpc_reconstruct(&ctx, shares_eq, 3, result) == 0;
+        success &= result[0] == 0 && result[1] == 0;
+    }
+    printf("  Every nonzero difference tests unequal: %s\n",
+           success ? "yes" : "NO");
+    
+    // Too few shares, and a NULL output
+    mpc_share_t shares_eq[5];
+    success &= mpc_secure_equal(&ctx, shares_x, shares_y, shares_eq, 2) == -1;
+    success &= mpc_secure_equal(&ctx, shares_x, shares_y, NULL, 5) == -1;
+    
+    mpc_cleanup_context(&ctx);
+    
+    return success;
+}
+
+// Test 6: Batched Equality in a Fixed Number of Rounds
+int test_secure_equal_batch() {
+    printf("\n" COLOR_YELLOW "→ Test 6: Batched Equality (1000 pairs)" COLOR_RESET "\n");
+    
+    enum { COUNT = 1000 };
+    mpc_context_t ctx;
+    if (mpc_init_context(&ctx, 5, 3, 1) != 0 || mpc_enable_stats(&ctx) != 0) {
+        return 0;
+    }
+    
+    mpc_share_t (*x)[5] = malloc(COUNT * sizeof(*x));
+    mpc_share_t (*y)[5] = malloc(COUNT * sizeof(*y));
+    mpc_share_t (*eq)[5] = malloc(COUNT * sizeof(*eq));
+    const mpc_share_t **xs = malloc(COUNT * sizeof(*xs));
+    const mpc_share_t **ys = malloc(COUNT * sizeof(*ys));
+    mpc_share_t **eqs = malloc(COUNT * sizeof(*eqs));
+    int success = x != NULL && y != NULL && eq != NULL && xs != NULL &&
+                  ys != NULL && eqs != NULL;
+    
+    // Every third pair is equal (k * 7 and k * 11 + 1 never meet), and
+    // the shares come in reverse party order
+    for (int k = 0; k < COUNT && success; k++) {
+        uint8_t a = (uint8_t)(k * 7);
+        uint8_t b = (k % 3 == 0) ? a : (uint8_t)(k * 11 + 1);
+        success &= mpc_create_shares(&ctx, &a, x[k]) == 0;
+        success &= mpc_create_shares(&ctx, &b, y[k]) == 0;
+        for (int i = 0; i < 2; i++) {
+            mpc_share_t swap = x[k][i];
+            x[k][i] = x[k][4 - i];
+            x[k][4 - i] = swap;
+            swap = y[k][i];
+            y[k][i] = y[k][4 - i];
+            y[k][4 - i] = swap;
+        }
+        xs[k] = x[k];
+        ys[k] = y[k];
+        eqs[k] = eq[k];
+    }
+    
+    mpc_stats_t stats;
+    mpc_reset_stats(&ctx);
+    success = success &&
+              mpc_secure_equal_batch(&ctx, xs, ys, eqs, COUNT, 5) == 0;
+    success = success && mpc_get_stats(&ctx, &stats) == 0;
+    
+    int matches = 0;
+    for (int k = 0; k < COUNT && success; k++) {
+        uint8_t result;
+        success &= mpc_reconstruct(&ctx, eq[k], 3, &result) == 0;
+        success &= result == (k % 3 == 0);
+        matches += result;
+    }
+    
+    printf("  Equal pairs found: %d (expected %d)\n", matches, (COUNT + 2) / 3);
+    printf("  Multiplication rounds: %llu (expected %d)\n",
+           (unsigned long long)stats.calls[MPC_OP_MUL], MPC_EQUAL_ROUNDS);
+    printf("  Products: %llu\n", (unsigned long long)stats.multiplications);
+    
+    // The round count does not grow with the batch
+    success = success && stats.calls[MPC_OP_MUL] == MPC_EQUAL_ROUNDS;
+    success = success && stats.calls[MPC_OP_EQUAL] == 1;
+    success = success && stats.multiplications == 14ULL * COUNT;
+    
+    // An empty batch and mismatched parties are rejected
+    success &= mpc_secure_equal_batch(&ctx, xs, ys, eqs, 0, 5) == -1;
+    ys[COUNT - 1] = x[COUNT - 1] + 1;
+    success &= mpc_secure_equal_batch(&ctx, xs, ys, eqs, COUNT, 4) == -1;
+    
+    free(x);
+    free(y);
+    free(eq);
+    free(xs);
+    free(ys);
+    free(eqs);
+    mpc_cleanup_context(&ctx);
+    
+    return success;
+}
+
+// Test 7: Real-World - Employee Salary Average
 int test_salary_average() {
-    printf("\n" COLOR_YELLOW "→ Test 5: Real-World - Employee Salary Average" COLOR_RESET "\n");
+    printf("\n" COLOR_YELLOW "→ Test 7: Real-World - Employee Salary Average" COLOR_RESET "\n");
     
     mpc_context_t ctx;
     mpc_init_context(&ctx, 5, 3, 1);
@@ -280,6 +420,8 @@ int main() {
     TEST_ASSERT(test_secure_average(), "Secure Average");
     TEST_ASSERT(test_secure_maximum(), "Secure Maximum");
     TEST_ASSERT(test_secure_greater(), "Secure Greater Than");
+    TEST_ASSERT(test_secure_equal(), "Secure Equality");
+    TEST_ASSERT(test_secure_equal_batch(), "Batched Equality in Fixed Rounds");
     
     print_header("Real-World Application Tests");
     TEST_ASSERT(test_salary_average(), "Employee Salary Average");
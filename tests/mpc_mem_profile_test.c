@@ -0,0 +1,269 @@
+#include "sss/mpc.h"
+#include "sss/mem_profile.h"
+#include "sss/secret_sharing.h"
+#include "sss/polynomial.h"
+#include "sss/field.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+/*
+ * In a library built with -DSSS_MEMORY_PROFILE=ON the tests below check
+ * the exact accounting of each operation. In a normal build they check
+ * that the same operations run and nothing is reported.
+ */
+static int profiling = 0;
+
+static void print_profile(const char *label, const mpc_mem_profile_t *p) {
+    printf("  %-12s %llu calls, %llu allocs (%llu secure), %llu B, "
+           "peak %llu B heap / %llu B stack / %llu B mapped\n", label,
+           (unsigned long long)p->calls,
+           (unsigned long long)p->allocations,
+           (unsigned long long)p->secure_allocations,
+           (unsigned long long)p->bytes_allocated,
+           (unsigned long long)p->peak_heap_bytes,
+           (unsigned long long)p->peak_stack_bytes,
+           (unsigned long long)p->peak_mapped_bytes);
+}
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+// Test 1: Profiles exist in profiling builds only
+int test_enabled() {
+    printf("\n" COLOR_YELLOW "→ Test 1: Profiling build" COLOR_RESET "\n");
+
+    profiling = mpc_mem_profile_enabled();
+    printf("  Library built %s memory profiling\n",
+           profiling ? "with" : "without");
+
+    mpc_mem_profile_t p;
+    mpc_reset_mem_profile();
+    int ok = (profiling == 0 || profiling == 1);
+    ok &= (mpc_get_mem_profile(MPC_OP_SUM, &p) == (profiling ? 0 : -1));
+    ok &= (mpc_get_mem_profile(MPC_OP_COUNT, &p) == -1);
+    ok &= (mpc_get_mem_profile(MPC_OP_SUM, NULL) == -1);
+    if (profiling) {
+        ok &= (p.calls == 0 && p.peak_bytes == 0);
+    }
+    return ok;
+}
+
+// Test 2: Heap and stack of sharing and reconstruction
+int test_share_reconstruct() {
+    printf("\n" COLOR_YELLOW "→ Test 2: Share and reconstruct" COLOR_RESET "\n");
+
+    enum { CALLS = 10, VALUE_SIZE = 4 };
+    mpc_context_t ctx;
+    mpc_share_t shares[5];
+    uint8_t secret[VALUE_SIZE] = {1, 2, 3, 4};
+    uint8_t opened[VALUE_SIZE];
+
+    mpc_reset_mem_profile();
+    int ok = mpc_init_context(&ctx, 5, 3, VALUE_SIZE) == 0;
+    for (int i = 0; i < CALLS && ok; i++) {
+        ok &= mpc_create_shares(&ctx, secret, shares) == 0;
+        ok &= mpc_reconstruct(&ctx, shares, 5, opened) == 0;
+        ok &= memcmp(opened, secret, VALUE_SIZE) == 0;
+    }
+    if (!profiling) {
+        mpc_cleanup_context(&ctx);
+        return ok;
+    }
+
+    mpc_mem_profile_t create, open;
+    ok &= mpc_get_mem_profile(MPC_OP_CREATE_SHARES, &create) == 0;
+    ok &= mpc_get_mem_profile(MPC_OP_RECONSTRUCT, &open) == 0;
+    print_profile("create", &create);
+    print_profile("reconstruct", &open);
+
+    // One temporary share array per call, one polynomial per byte
+    uint64_t array = 5 * sizeof(sss_share_t);
+    ok &= (create.calls == CALLS && create.allocations == CALLS);
+    ok &= (create.secure_allocations == 0);
+    ok &= (create.bytes_allocated == CALLS * array);
+    ok &= (create.peak_heap_bytes == array);
+    ok &= (create.stack_frames == CALLS * VALUE_SIZE);
+    ok &= (create.peak_stack_bytes == sizeof(sss_polynomial_t));
+    ok &= (create.peak_bytes == array + sizeof(sss_polynomial_t));
+    ok &= (create.peak_mapped_bytes == create.peak_bytes);
+
+    // The interpolation points of each byte live on the stack
+    ok &= (open.calls == CALLS && open.allocations == CALLS);
+    ok &= (open.peak_heap_bytes == array);
+    ok &= (open.stack_frames == CALLS * VALUE_SIZE);
+    ok &= (open.peak_stack_bytes == 2 * SSS_MAX_SHARES);
+
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 3: The variable-length array of mpc_secure_sum
+int test_sum_vla() {
+    printf("\n" COLOR_YELLOW "→ Test 3: Sum temporaries" COLOR_RESET "\n");
+
+    enum { VALUES = 12 };
+    mpc_context_t ctx;
+    mpc_share_t inputs[VALUES][5];
+    const mpc_share_t *sets[VALUES];
+    mpc_share_t sum[5];
+    uint8_t expected = 0;
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0;
+    for (uint8_t v = 0; v < VALUES && ok; v++) {
+        uint8_t value = (uint8_t)(v * 29 + 1);
+        expected ^= value;
+        ok &= mpc_create_shares(&ctx, &value, inputs[v]) == 0;
+        sets[v] = inputs[v];
+    }
+
+    mpc_reset_mem_profile();
+    uint8_t opened = 0;
+    ok = ok && mpc_secure_sum(&ctx, sets, VALUES, 5, sum) == 0;
+    ok = ok && mpc_reconstruct(&ctx, sum, 5, &opened) == 0;
+    ok = ok && opened == expected;
+    if (!profiling) {
+        mpc_cleanup_context(&ctx);
+        return ok;
+    }
+
+    mpc_mem_profile_t p;
+    ok &= mpc_get_mem_profile(MPC_OP_SUM, &p) == 0;
+    print_profile("sum", &p);
+
+    // One temporary per added value, none on the heap
+    ok &= (p.calls == 1 && p.allocations == 0);
+    ok &= (p.stack_frames == VALUES - 1);
+    ok &= (p.peak_stack_bytes == 5 * sizeof(mpc_share_t));
+
+    // The additions inside are not profiled on their own
+    mpc_mem_profile_t add;
+    ok &= mpc_get_mem_profile(MPC_OP_ADD, &add) == 0 && add.calls == 0;
+
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 4: Nested operations count towards the outermost call
+int test_nested() {
+    printf("\n" COLOR_YELLOW "→ Test 4: Multiplication" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_share_t x[5], y[5], product[5];
+    uint8_t a = 7, b = 93, c = 0;
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0;
+    ok = ok && mpc_create_shares(&ctx, &a, x) == 0;
+    ok = ok && mpc_create_shares(&ctx, &b, y) == 0;
+
+    mpc_reset_mem_profile();
+    ok = ok && mpc_secure_mul(&ctx, x, y, product, 5) == 0;
+    ok = ok && mpc_reconstruct(&ctx, product, 5, &c) == 0;
+    ok = ok && c == gf256_mul(a, b);
+    if (!profiling) {
+        mpc_cleanup_context(&ctx);
+        return ok;
+    }
+
+    mpc_mem_profile_t mul, create, open;
+    ok &= mpc_get_mem_profile(MPC_OP_MUL, &mul) == 0;
+    ok &= mpc_get_mem_profile(MPC_OP_CREATE_SHARES, &create) == 0;
+    ok &= mpc_get_mem_profile(MPC_OP_RECONSTRUCT, &open) == 0;
+    print_profile("mul", &mul);
+
+    // Two secure buffers of its own, plus the share arrays of the
+    // reconstruction and resharing inside
+    ok &= (mul.calls == 1 && mul.secure_allocations == 2);
+    ok &= (mul.allocations == 4);
+    ok &= (mul.peak_heap_bytes >= 5 * sizeof(mpc_share_t) + 1);
+    ok &= (mul.peak_stack_bytes == 2 * SSS_MAX_SHARES);
+
+    // Secure buffers take whole pages
+    ok &= (mul.peak_mapped_bytes > mul.peak_bytes + 4096);
+
+    // Only the reconstruction called from here is counted on its own
+    ok &= (create.calls == 0 && open.calls == 1);
+
+    // Reset forgets everything
+    mpc_reset_mem_profile();
+    ok &= mpc_get_mem_profile(MPC_OP_MUL, &mul) == 0;
+    ok &= (mul.calls == 0 && mul.allocations == 0 &&
+           mul.peak_mapped_bytes == 0);
+
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Memory Profile Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Configuration");
+    TEST_ASSERT(test_enabled(), "Profiles Match the Build");
+
+    print_header("Accounting");
+    TEST_ASSERT(test_share_reconstruct(), "Share Arrays and Stack Points");
+    TEST_ASSERT(test_sum_vla(), "Sum Temporaries on the Stack");
+    TEST_ASSERT(test_nested(), "Nested Operations Attributed Outward");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}
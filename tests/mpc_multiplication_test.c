@@ -393,6 +393,256 @@ int test_insufficient_shares() {
     return success;
 }
 
+// Test 10: GF(256) Matrix Product Kernel
+int test_gemm_kernel() {
+    printf("\n" COLOR_YELLOW "→ Test 10: GF(256) Matrix Product Kernel" COLOR_RESET "\n");
+    
+    enum { ROWS = 7, INNER = 33, COLS = 5 };
+    uint8_t a[ROWS * INNER], b[INNER * COLS], c[ROWS * COLS];
+    for (int k = 0; k < ROWS * INNER; k++) {
+        a[k] = (uint8_t)(k * 37 + 11);
+    }
+    for (int k = 0; k < INNER * COLS; k++) {
+        b[k] = (uint8_t)(k * 101 + 200);
+    }
+    
+    gf256_gemm(ROWS, INNER, COLS, a, b, c);
+    
+    // Against one gf256_mul() per term
+    int success = 1;
+    for (int i = 0; i < ROWS; i++) {
+        for (int j = 0; j < COLS; j++) {
+            uint8_t expected = 0;
+            for (int l = 0; l < INNER; l++) {
+                expected ^= gf256_mul(a[i * INNER + l], b[l * COLS + j]);
+            }
+            success &= (c[i * COLS + j] == expected);
+        }
+    }
+    printf("  %d×%d times %d×%d: %s\n", ROWS, INNER, INNER, COLS,
+           success ? "matches gf256_mul" : "MISMATCH");
+    
+    // Every pair of bytes, as 1×1 products
+    for (int x = 0; x < 256 && success; x++) {
+        for (int y = 0; y < 256; y++) {
+            uint8_t ax = (uint8_t)x, by = (uint8_t)y, product;
+            gf256_gemm(1, 1, 1, &ax, &by, &product);
+            success &= (product == gf256_mul(ax, by));
+        }
+    }
+    
+    return success;
+}
+
+// Test 11: Inner Product of 10⁴ Terms With One Reduction
+int test_dot_product() {
+    printf("\n" COLOR_YELLOW "→ Test 11: Inner Product (10⁴ terms)" COLOR_RESET "\n");
+    
+    enum { LENGTH = 10000 };
+    mpc_context_t ctx;
+    if (mpc_init_context(&ctx, 5, 3, 2) != 0 || mpc_enable_stats(&ctx) != 0) {
+        return 0;
+    }
+    
+    mpc_share_t (*x)[5] = malloc(LENGTH * sizeof(*x));
+    mpc_share_t (*y)[5] = malloc(LENGTH * sizeof(*y));
+    const mpc_share_t **xs = malloc(LENGTH * sizeof(*xs));
+    const mpc_share_t **ys = malloc(LENGTH * sizeof(*ys));
+    int success = x != NULL && y != NULL && xs != NULL && ys != NULL;
+    
+    uint8_t expected[2] = {0, 0};
+    for (int l = 0; l < LENGTH && success; l++) {
+        uint8_t a[2] = {(uint8_t)(l * 7 + 1), (uint8_t)(l >> 3)};
+        uint8_t b[2] = {(uint8_t)(l * 13 + 5), (uint8_t)(l * 3 + 77)};
+        expected[0] ^= gf256_mul(a[0], b[0]);
+        expected[1] ^= gf256_mul(a[1], b[1]);
+        success &= mpc_create_shares(&ctx, a, x[l]) == 0;
+        success &= mpc_create_shares(&ctx, b, y[l]) == 0;
+        xs[l] = x[l];
+        ys[l] = y[l];
+    }
+    
+    mpc_share_t dot[5];
+    uint8_t result[2] = {0, 0};
+    mpc_stats_t stats;
+    mpc_reset_stats(&ctx);
+    success = success && mpc_secure_dot(&ctx, xs, ys, LENGTH, dot, 5) == 0;
+    success = success && mpc_get_stats(&ctx, &stats) == 0;
+    success = success && mpc_reconstruct(&ctx, dot, 3, result) == 0;
+    
+    printf("  Expected: %d %d\n", expected[0], expected[1]);
+    printf("  Actual:   %d %d\n", result[0], result[1]);
+    printf("  %llu products, %llu reshare\n",
+           (unsigned long long)stats.multiplications,
+           (unsigned long long)stats.reshares);
+    
+    success = success && memcmp(result, expected, 2) == 0;
+    success = success && stats.multiplications == LENGTH;
+    success = success && stats.reshares == 1;
+    success = success && stats.reconstructions == 1;
+    success = success && stats.calls[MPC_OP_DOT] == 1;
+    
+    free(x);
+    free(y);
+    free(xs);
+    free(ys);
+    mpc_cleanup_context(&ctx);
+    return success;
+}
+
+// Test 12: Matrix Product (3×4 times 4×2)
+int test_matrix_product() {
+    printf("\n" COLOR_YELLOW "→ Test 12: Matrix Product (3×4 × 4×2)" COLOR_RESET "\n");
+    
+    mpc_context_t ctx;
+    if (mpc_init_context(&ctx, 5, 3, 1) != 0) {
+        return 0;
+    }
+    
+    const uint8_t a[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    const uint8_t b[8] = {200, 1, 0, 17, 255, 3, 42, 128};
+    mpc_share_t shares_a[12][5], shares_b[8][5], shares_c[6][5];
+    const mpc_share_t *as[12], *bs[8];
+    mpc_share_t *cs[6];
+    for (int k = 0; k < 12; k++) {
+        mpc_create_shares(&ctx, &a[k], shares_a[k]);
+        as[k] = shares_a[k];
+    }
+    for (int k = 0; k < 8; k++) {
+        mpc_create_shares(&ctx, &b[k], shares_b[k]);
+        bs[k] = shares_b[k];
+    }
+    for (int k = 0; k < 6; k++) {
+        cs[k] = shares_c[k];
+    }
+    
+    uint8_t expected[6];
+    gf256_gemm(3, 4, 2, a, b, expected);
+    
+    const mpc_share_t *as_tail[12], *bs_tail[8];
+    int success = mpc_secure_matmul(&ctx, as, bs, cs, 3, 4, 2, 5) == 0;
+    for (int k = 0; k < 6 && success; k++) {
+        uint8_t value;
+        success &= mpc_reconstruct(&ctx, shares_c[k], 3, &value) == 0;
+        success &= (value == expected[k]);
+        printf("  C[%d][%d] = %3d (expected %3d)\n", k / 2, k % 2, value,
+               expected[k]);
+    }
+    
+    // Fewer shares than the threshold fail cleanly
+    for (int k = 0; k < 12; k++) {
+        as_tail[k] = shares_a[k] + 1;
+    }
+    for (int k = 0; k < 8; k++) {
+        bs_tail[k] = shares_b[k] + 1;
+    }
+    success &= mpc_secure_matmul(&ctx, as_tail, bs_tail, cs, 3, 4, 2, 2) == -1;
+    
+    // Mismatched parties and empty dimensions are rejected
+    bs_tail[0] = shares_b[0];
+    success &= mpc_secure_matmul(&ctx, as_tail, bs_tail, cs, 3, 4, 2, 3) == -1;
+    success &= mpc_secure_matmul(&ctx, as, bs, cs, 3, 0, 2, 5) == -1;
+    success &= mpc_secure_dot(&ctx, as, bs, 4, NULL, 5) == -1;
+    
+    mpc_cleanup_context(&ctx);
+    return success;
+}
+
+// Test 13: Inversion of a Shared Value
+int test_secure_inverse() {
+    printf("\n" COLOR_YELLOW "→ Test 13: Inversion (x × x⁻¹ = 1)" COLOR_RESET "\n");
+    
+    mpc_context_t ctx;
+    if (mpc_init_context(&ctx, 5, 3, 2) != 0) {
+        return 0;
+    }
+    
+    // A zero byte inverts to 0, as with gf256_inv()
+    const uint8_t secret[2] = {83, 0};
+    mpc_share_t shares_x[5], shares_inv[5], shares_one[5];
+    uint8_t inverse[2], one[2];
+    
+    int success = mpc_create_shares(&ctx, secret, shares_x) == 0;
+    success = success && mpc_secure_inv(&ctx, shares_x, shares_inv, 5) == 0;
+    success = success && mpc_reconstruct(&ctx, shares_inv, 3, inverse) == 0;
+    success = success &&
+              mpc_secure_mul(&ctx, shares_x, shares_inv, shares_one, 5) == 0;
+    success = success && mpc_reconstruct(&ctx, shares_one, 3, one) == 0;
+    
+    printf("  %d⁻¹ = %d (expected %d), %d × %d⁻¹ = %d\n", secret[0],
+           inverse[0], gf256_inv(secret[0]), secret[0], secret[0], one[0]);
+    printf("  0⁻¹ = %d (expected 0)\n", inverse[1]);
+    
+    success = success && inverse[0] == gf256_inv(secret[0]) && one[0] == 1;
+    success = success && inverse[1] == 0;
+    
+    // Fewer shares than the threshold fail; the output may replace the input
+    success = success &&
+              mpc_secure_inv(&ctx, shares_x + 3, shares_one, 2) == -1;
+    success = success && mpc_secure_inv(&ctx, shares_inv, shares_inv, 5) == 0;
+    success = success && mpc_reconstruct(&ctx, shares_inv + 2, 3, inverse) == 0;
+    success = success && memcmp(inverse, secret, 2) == 0;
+    
+    for (int i = 0; i < 5; i++) {
+        mpc_wipe_share(&shares_x[i]);
+        mpc_wipe_share(&shares_inv[i]);
+        mpc_wipe_share(&shares_one[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return success;
+}
+
+// Test 14: Batched Inversion in One Opening
+int test_secure_inverse_batch() {
+    printf("\n" COLOR_YELLOW "→ Test 14: Batched Inversion (255 values)" COLOR_RESET "\n");
+    
+    enum { COUNT = 255 };
+    mpc_context_t ctx;
+    if (mpc_init_context(&ctx, 5, 3, 1) != 0 || mpc_enable_stats(&ctx) != 0) {
+        return 0;
+    }
+    
+    static mpc_share_t x[COUNT][5], inv[COUNT][5];
+    const mpc_share_t *xs[COUNT];
+    mpc_share_t *invs[COUNT];
+    int success = 1;
+    for (int k = 0; k < COUNT; k++) {
+        uint8_t value = (uint8_t)(k + 1);
+        success &= mpc_create_shares(&ctx, &value, x[k]) == 0;
+        xs[k] = x[k];
+        invs[k] = inv[k];
+    }
+    
+    mpc_stats_t stats;
+    mpc_reset_stats(&ctx);
+    success = success && mpc_secure_inv_batch(&ctx, xs, invs, COUNT, 5) == 0;
+    success = success && mpc_get_stats(&ctx, &stats) == 0;
+    
+    int correct = 0;
+    for (int k = 0; k < COUNT && success; k++) {
+        uint8_t value;
+        success &= mpc_reconstruct(&ctx, inv[k], 3, &value) == 0;
+        correct += (value == gf256_inv((uint8_t)(k + 1)));
+    }
+    
+    printf("  Correct inverses: %d/%d\n", correct, COUNT);
+    printf("  Openings: %llu, local products: %llu, degree reductions: %llu\n",
+           (unsigned long long)stats.reconstructions,
+           (unsigned long long)stats.multiplications,
+           (unsigned long long)stats.reshares);
+    
+    // One opening per value, all in the same round, and no reshare
+    success = success && correct == COUNT;
+    success = success && stats.calls[MPC_OP_INV] == 1;
+    success = success && stats.calls[MPC_OP_MUL] == 0;
+    success = success && stats.multiplications == COUNT;
+    success = success && stats.reshares == 0;
+    success = success && mpc_secure_inv_batch(&ctx, xs, invs, 0, 5) == -1;
+    
+    mpc_cleanup_context(&ctx);
+    return success;
+}
+
 int main() {
     printf("\n");
     printf(COLOR_MAGENTA "════════════════════════════════════════════════\n");
@@ -431,6 +681,15 @@ int main() {
     TEST_ASSERT(test_different_subsets(), "Different Share Subsets");
     TEST_ASSERT(test_insufficient_shares(), "Error: Insufficient Shares");
     
+    print_header("Inner Products");
+    TEST_ASSERT(test_gemm_kernel(), "GF(256) Matrix Product Kernel");
+    TEST_ASSERT(test_dot_product(), "Inner Product With One Reduction");
+    TEST_ASSERT(test_matrix_product(), "Matrix Product of Shared Matrices");
+    
+    print_header("Inversion");
+    TEST_ASSERT(test_secure_inverse(), "Inversion of a Shared Value");
+    TEST_ASSERT(test_secure_inverse_batch(), "Batched Inversion in One Opening");
+    
     // Summary
     printf("\n");
     print_separator();
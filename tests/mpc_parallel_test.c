@@ -0,0 +1,348 @@
+#include "sss/executor.h"
+#include "sss/circuit.h"
+#include "sss/mpc.h"
+#include "sss/field.h"
+#include "sss/secret_sharing.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+#define COVER_COUNT 10000
+
+typedef struct {
+    atomic_int hits[COVER_COUNT];
+    atomic_uint worker_used[8];
+} cover_state_t;
+
+static void cover_body(void *arg, size_t begin, size_t end, unsigned worker) {
+    cover_state_t *state = arg;
+    for (size_t i = begin; i < end; i++) {
+        atomic_fetch_add(&state->hits[i], 1);
+    }
+    atomic_fetch_add(&state->worker_used[worker % 8], 1);
+}
+
+// Test 1: Every index is visited exactly once
+int test_parallel_for_coverage() {
+    printf("\n" COLOR_YELLOW "→ Test 1: parallel_for covers [0, %d)" COLOR_RESET "\n",
+           COVER_COUNT);
+
+    mpc_executor_t *ex = mpc_executor_create(4, 0);
+    if (ex == NULL) {
+        return 0;
+    }
+
+    cover_state_t *state = calloc(1, sizeof(cover_state_t));
+    int ok = (state != NULL);
+
+    // Odd chunk size so the last chunk is partial
+    ok = ok && (mpc_executor_parallel_for(ex, COVER_COUNT, 7, cover_body,
+                                          state) == 0);
+
+    int exact = ok;
+    for (int i = 0; ok && i < COVER_COUNT; i++) {
+        if (atomic_load(&state->hits[i]) != 1) {
+            exact = 0;
+        }
+    }
+
+    printf("  Threads: %u, chunks per worker:", mpc_executor_num_threads(ex));
+    for (int w = 0; ok && w < 4; w++) {
+        printf(" %u", atomic_load(&state->worker_used[w]));
+    }
+    printf("\n");
+
+    free(state);
+    mpc_executor_destroy(ex);
+
+    return ok && exact;
+}
+
+// Test 2: The executor can be reused for many loops
+int test_executor_reuse() {
+    printf("\n" COLOR_YELLOW "→ Test 2: 500 consecutive loops" COLOR_RESET "\n");
+
+    mpc_executor_t *ex = mpc_executor_create(3, MPC_EXECUTOR_PIN_THREADS);
+    if (ex == NULL) {
+        return 0;
+    }
+
+    cover_state_t *state = calloc(1, sizeof(cover_state_t));
+    int ok = (state != NULL);
+
+    for (int round = 0; ok && round < 500; round++) {
+        size_t count = 1 + (size_t)(round * 37) % 900;
+        ok = (mpc_executor_parallel_for(ex, count, 0, cover_body, state) == 0);
+    }
+
+    // Index 0 is part of every loop
+    int success = ok && atomic_load(&state->hits[0]) == 500;
+    printf("  Index 0 visited %d times\n", ok ? atomic_load(&state->hits[0]) : -1);
+
+    free(state);
+    mpc_executor_destroy(ex);
+
+    return success;
+}
+
+/**
+ * Evaluate a circuit serially and in parallel, and compare the results
+ */
+static int compare_evaluations(const mpc_context_t *ctx,
+                               const mpc_circuit_t *circ,
+                               mpc_executor_t *ex,
+                               mpc_circuit_stats_t *serial_stats,
+                               mpc_circuit_stats_t *parallel_stats) {
+    uint32_t n_in = circ->num_inputs;
+    uint32_t n_out = circ->num_outputs;
+
+    mpc_share_t *in_shares = calloc((size_t)n_in * 5, sizeof(mpc_share_t));
+    mpc_share_t *serial_out = calloc((size_t)n_out * 5, sizeof(mpc_share_t));
+    mpc_share_t *parallel_out = calloc((size_t)n_out * 5, sizeof(mpc_share_t));
+    const mpc_share_t **inputs = calloc(n_in, sizeof(mpc_share_t *));
+    mpc_share_t **outputs_a = calloc(n_out, sizeof(mpc_share_t *));
+    mpc_share_t **outputs_b = calloc(n_out, sizeof(mpc_share_t *));
+
+    int ok = in_shares && serial_out && parallel_out && inputs &&
+             outputs_a && outputs_b;
+
+    for (uint32_t i = 0; ok && i < n_in; i++) {
+        uint8_t value = (uint8_t)(i * 29 + 3);
+        ok = (mpc_create_shares(ctx, &value, &in_shares[i * 5]) == 0);
+        inputs[i] = &in_shares[i * 5];
+    }
+    for (uint32_t i = 0; ok && i < n_out; i++) {
+        outputs_a[i] = &serial_out[i * 5];
+        outputs_b[i] = &parallel_out[i * 5];
+    }
+
+    ok = ok && (mpc_circuit_evaluate(ctx, circ, inputs, outputs_a, 5,
+                                     serial_stats) == 0);
+    ok = ok && (mpc_circuit_evaluate_parallel(ctx, circ, ex, inputs, outputs_b,
+                                              5, parallel_stats) == 0);
+
+    for (uint32_t i = 0; ok && i < n_out; i++) {
+        uint8_t a = 0, b = 0;
+        ok = (mpc_reconstruct(ctx, outputs_a[i], 3, &a) == 0) &&
+             (mpc_reconstruct(ctx, outputs_b[i], 3, &b) == 0) &&
+             a == b;
+    }
+
+    free(outputs_b);
+    free(outputs_a);
+    free(inputs);
+    free(parallel_out);
+    free(serial_out);
+    free(in_shares);
+
+    return ok;
+}
+
+// Test 3: Wide layer of products matches the serial evaluator
+int test_parallel_wide_circuit() {
+    printf("\n" COLOR_YELLOW "→ Test 3: 256 products, pairwise sums" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 1);
+
+    mpc_circuit_t circ;
+    mpc_circuit_init(&circ);
+
+    mpc_wire_t in[512];
+    for (int i = 0; i < 512; i++) {
+        in[i] = mpc_circuit_input(&circ);
+    }
+
+    // One layer of products, then a chain of sums inside the same layer
+    mpc_wire_t acc = MPC_WIRE_INVALID;
+    for (int i = 0; i < 256; i++) {
+        mpc_wire_t p = mpc_circuit_mul(&circ, in[2 * i], in[2 * i + 1]);
+        mpc_circuit_output(&circ, p);
+        acc = (acc == MPC_WIRE_INVALID) ? p : mpc_circuit_add(&circ, acc, p);
+    }
+    mpc_circuit_output(&circ, acc);
+
+    mpc_executor_t *ex = mpc_executor_create(4, 0);
+    mpc_circuit_stats_t s1, s2;
+    int ok = (ex != NULL) && mpc_enable_stats(&ctx) == 0 &&
+             compare_evaluations(&ctx, &circ, ex, &s1, &s2);
+
+    printf("  Serial: %u rounds, %u muls; Parallel: %u rounds, %u muls\n",
+           s1.rounds, s1.multiplications, s2.rounds, s2.multiplications);
+
+    // The layer is opened once by each evaluator, not once per chunk
+    mpc_stats_t counts;
+    ok = ok && mpc_get_stats(&ctx, &counts) == 0;
+    printf("  Degree reductions: %llu for %llu products\n",
+           (unsigned long long)counts.calls[MPC_OP_MUL],
+           (unsigned long long)counts.multiplications);
+
+    int success = ok && s1.rounds == 1 && s2.rounds == 1 &&
+                  s2.multiplications == 256 && s2.local_gates == s1.local_gates &&
+                  counts.calls[MPC_OP_MUL] == 2 && counts.multiplications == 512;
+
+    mpc_executor_destroy(ex);
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return success;
+}
+
+// Test 4: Deep circuit keeps the same round count
+int test_parallel_deep_circuit() {
+    printf("\n" COLOR_YELLOW "→ Test 4: Mixed deep circuit" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 1);
+
+    mpc_circuit_t circ;
+    mpc_circuit_init(&circ);
+
+    mpc_wire_t layer[64];
+    for (int i = 0; i < 64; i++) {
+        layer[i] = mpc_circuit_input(&circ);
+    }
+
+    // Each level: neighbour products, plus a constant and a linear mix
+    mpc_wire_t one = mpc_circuit_const(&circ, 1);
+    for (int depth = 0; depth < 5; depth++) {
+        mpc_wire_t next[64];
+        for (int i = 0; i < 64; i++) {
+            mpc_wire_t p = mpc_circuit_mul(&circ, layer[i], layer[(i + 1) % 64]);
+            mpc_wire_t q = mpc_circuit_mul_const(&circ, p, (uint8_t)(i + 2));
+            next[i] = mpc_circuit_sub(&circ, mpc_circuit_add(&circ, q, one),
+                                      layer[i]);
+        }
+        memcpy(layer, next, sizeof(layer));
+    }
+    for (int i = 0; i < 64; i++) {
+        mpc_circuit_output(&circ, layer[i]);
+    }
+
+    mpc_executor_t *ex = mpc_executor_create(0, MPC_EXECUTOR_PIN_THREADS);
+    mpc_circuit_stats_t s1, s2;
+    int ok = (ex != NULL) && compare_evaluations(&ctx, &circ, ex, &s1, &s2);
+
+    printf("  Depth: %u, Serial rounds: %u, Parallel rounds: %u\n",
+           circ.depth, s1.rounds, s2.rounds);
+
+    int success = ok && s1.rounds == 5 && s2.rounds == 5 &&
+                  s1.multiplications == s2.multiplications;
+
+    mpc_executor_destroy(ex);
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return success;
+}
+
+// Test 5: Invalid arguments
+int test_invalid_arguments() {
+    printf("\n" COLOR_YELLOW "→ Test 5: Invalid arguments" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 5, 3, 1);
+
+    mpc_circuit_t circ;
+    mpc_circuit_init(&circ);
+    mpc_circuit_output(&circ, mpc_circuit_input(&circ));
+
+    mpc_share_t shares[5], out[5];
+    const mpc_share_t *inputs[1] = {shares};
+    mpc_share_t *outputs[1] = {out};
+
+    mpc_executor_t *ex = mpc_executor_create(2, 0);
+
+    int ok = (ex != NULL);
+    ok = ok && mpc_executor_parallel_for(NULL, 10, 1, cover_body, NULL) == -1;
+    ok = ok && mpc_executor_parallel_for(ex, 10, 1, NULL, NULL) == -1;
+    ok = ok && mpc_executor_parallel_for(ex, 0, 1, cover_body, NULL) == 0;
+    ok = ok && mpc_circuit_evaluate_parallel(&ctx, &circ, NULL, inputs,
+                                             outputs, 5, NULL) == -1;
+    ok = ok && mpc_circuit_evaluate_parallel(&ctx, &circ, ex, inputs,
+                                             outputs, 0, NULL) == -1;
+    mpc_executor_destroy(NULL);
+
+    mpc_executor_destroy(ex);
+    mpc_circuit_free(&circ);
+    mpc_cleanup_context(&ctx);
+
+    return ok;
+}
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  MPC Parallel Evaluation Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Work-Stealing Executor");
+    TEST_ASSERT(test_parallel_for_coverage(), "Every Index Visited Once");
+    TEST_ASSERT(test_executor_reuse(), "Executor Reused Across Loops");
+
+    print_header("Parallel Circuit Evaluation");
+    TEST_ASSERT(test_parallel_wide_circuit(), "Wide Layer Matches Serial");
+    TEST_ASSERT(test_parallel_deep_circuit(), "Deep Circuit Matches Serial");
+
+    print_header("Robustness Tests");
+    TEST_ASSERT(test_invalid_arguments(), "Invalid Arguments Rejected");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}
@@ -0,0 +1,470 @@
+#define _GNU_SOURCE
+#include "sss/runtime.h"
+#include "sss/transport.h"
+#include "sss/transport_batch.h"
+#include "sss/mpc_net.h"
+#include "sss/mpc.h"
+#include "sss/field.h"
+#include "sss/secret_sharing.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+#define NUM_PARTIES 3
+#define THRESHOLD 2
+#define NUM_JOBS 2000
+
+/* Longest wait for a peer before a run gives up */
+#define RUN_TIMEOUT_MS 10000
+
+typedef int (*group_create_fn)(uint8_t num_parties, mpc_transport_t **endpoints);
+
+/* ========================================================================
+ * Product Job
+ *
+ * Party 1 inputs a, party 2 inputs b, and every party learns a × b.
+ * ======================================================================== */
+
+typedef struct {
+    const mpc_context_t *ctx;
+    mpc_session_id_t session;
+    uint8_t a;                  // Input of party 1
+    uint8_t b;                  // Input of party 2
+    int stage;
+    mpc_async_op_t op;
+    mpc_share_t share_a;
+    mpc_share_t share_b;
+    mpc_share_t share_ab;
+    uint8_t product;            // Opened a × b
+} product_job_t;
+
+static uint8_t job_input_a(uint32_t id) {
+    return (uint8_t)(id * 7 + 1);
+}
+
+static uint8_t job_input_b(uint32_t id) {
+    return (uint8_t)(id * 13 + 5);
+}
+
+static mpc_job_status_t product_step(mpc_job_t *job, void *arg) {
+    product_job_t *st = arg;
+    uint8_t me = mpc_job_party_id(job);
+    mpc_job_status_t s;
+
+    switch (st->stage) {
+    case 0:
+        s = mpc_async_share_input(job, &st->op, st->ctx, 1,
+                                  (me == 1) ? &st->a : NULL, &st->share_a, 1);
+        if (s != MPC_JOB_DONE) {
+            return s;
+        }
+        st->stage = 1;
+        // fall through
+    case 1:
+        s = mpc_async_share_input(job, &st->op, st->ctx, 2,
+                                  (me == 2) ? &st->b : NULL, &st->share_b, 1);
+        if (s != MPC_JOB_DONE) {
+            return s;
+        }
+        st->stage = 2;
+        // fall through
+    case 2:
+        s = mpc_async_mul(job, &st->op, st->ctx, &st->share_a, &st->share_b,
+                          &st->share_ab, 1);
+        if (s != MPC_JOB_DONE) {
+            return s;
+        }
+        st->stage = 3;
+        // fall through
+    default:
+        return mpc_async_open(job, &st->op, st->ctx, &st->share_ab,
+                              &st->product, 1);
+    }
+}
+
+/* ========================================================================
+ * Party Threads
+ * ======================================================================== */
+
+typedef struct {
+    const mpc_context_t *ctx;
+    mpc_transport_t *transport;
+    int reverse;                // Submit the jobs in reverse order
+    unsigned delay_ms;          // Wait before submitting
+    mpc_runtime_stats_t stats;
+    int ok;
+} party_t;
+
+static void *party_main(void *arg) {
+    party_t *party = arg;
+    party->ok = 0;
+
+    product_job_t *jobs = calloc(NUM_JOBS, sizeof(product_job_t));
+    mpc_runtime_t *rt = mpc_runtime_create(party->transport);
+    if (jobs == NULL || rt == NULL) {
+        free(jobs);
+        mpc_runtime_destroy(rt);
+        return NULL;
+    }
+
+    if (party->delay_ms > 0) {
+        struct timespec delay = {0, (long)party->delay_ms * 1000000L};
+        nanosleep(&delay, NULL);
+    }
+
+    int ok = 1;
+    // Job k runs in a session derived from the context's
+    for (uint32_t i = 0; i < NUM_JOBS && ok; i++) {
+        uint32_t id = party->reverse ? NUM_JOBS - 1 - i : i;
+        jobs[id].ctx = party->ctx;
+        jobs[id].a = job_input_a(id);
+        jobs[id].b = job_input_b(id);
+        mpc_session_id_derive(&party->ctx->session_id, id, &jobs[id].session);
+        ok = mpc_runtime_submit(rt, &jobs[id].session, product_step,
+                                &jobs[id]) == 0;
+    }
+
+    ok = ok && mpc_runtime_run(rt, RUN_TIMEOUT_MS) == 0;
+    for (uint32_t id = 0; id < NUM_JOBS && ok; id++) {
+        ok = jobs[id].product == gf256_mul(job_input_a(id), job_input_b(id));
+    }
+
+    mpc_runtime_get_stats(rt, &party->stats);
+    mpc_runtime_destroy(rt);
+    free(jobs);
+    party->ok = ok;
+    return NULL;
+}
+
+/**
+ * Run NUM_JOBS product jobs on every party of a new group
+ */
+static int run_group(group_create_fn create, party_t *parties) {
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, NUM_PARTIES, THRESHOLD, 1);
+
+    mpc_transport_t *net[NUM_PARTIES];
+    if (create(NUM_PARTIES, net) != 0) {
+        return 0;
+    }
+
+    pthread_t threads[NUM_PARTIES];
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        parties[i].ctx = &ctx;
+        parties[i].transport = net[i];
+        if (pthread_create(&threads[i], NULL, party_main, &parties[i]) != 0) {
+            return 0;
+        }
+    }
+
+    int ok = 1;
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        pthread_join(threads[i], NULL);
+        ok = ok && parties[i].ok;
+        mpc_transport_destroy(net[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+// Test 1: Thousands of computations in flight on one thread per party
+int test_concurrent_jobs() {
+    printf("\n" COLOR_YELLOW "→ Test 1: %d concurrent multiplications" COLOR_RESET "\n",
+           NUM_JOBS);
+
+    party_t parties[NUM_PARTIES];
+    memset(parties, 0, sizeof(parties));
+    int ok = run_group(mpc_transport_socketpair_create, parties);
+
+    // Party 1 sends 6 messages per job: its input, the reshared
+    // product and its opening share, each to 2 peers
+    const mpc_runtime_stats_t *stats = &parties[0].stats;
+    printf("  Party 1: %llu messages in %llu frames over %llu passes\n",
+           (unsigned long long)stats->messages_sent,
+           (unsigned long long)stats->frames_sent,
+           (unsigned long long)stats->passes);
+
+    ok = ok && stats->messages_sent == 6ull * NUM_JOBS &&
+         stats->jobs_completed == NUM_JOBS && stats->jobs_failed == 0 &&
+         stats->max_live_jobs == NUM_JOBS &&
+         stats->frames_sent * 20 < stats->messages_sent;
+    return ok;
+}
+
+// Test 2: Messages for jobs that are not submitted yet are kept
+int test_early_messages() {
+    printf("\n" COLOR_YELLOW "→ Test 2: Out-of-order and late submission" COLOR_RESET "\n");
+
+    party_t parties[NUM_PARTIES];
+    memset(parties, 0, sizeof(parties));
+    parties[1].reverse = 1;
+    parties[2].delay_ms = 50;
+
+    int ok = run_group(mpc_transport_tcp_create, parties);
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        ok = ok && parties[i].stats.jobs_completed == NUM_JOBS;
+    }
+    return ok;
+}
+
+typedef struct {
+    const mpc_context_t *ctx;
+    mpc_transport_t *transport;
+    uint8_t product;
+    int ok;
+} blocking_party_t;
+
+/**
+ * Party 3 of test 3: the product protocol with the blocking mpc_net_*
+ * calls on the batch channel of the context's session
+ */
+static void *blocking_main(void *arg) {
+    blocking_party_t *party = arg;
+    const mpc_context_t *ctx = party->ctx;
+    party->ok = 0;
+
+    mpc_batch_link_t *link = mpc_batch_link_create(party->transport);
+    mpc_transport_t *chan = (link != NULL)
+                            ? mpc_batch_channel_open(link, &ctx->session_id)
+                            : NULL;
+
+    mpc_share_t a, b, ab;
+    int ok = chan != NULL;
+    ok = ok && mpc_net_share_input(ctx, chan, 1, NULL, &a, 1) == 0;
+    ok = ok && mpc_net_share_input(ctx, chan, 2, NULL, &b, 1) == 0;
+    ok = ok && mpc_net_mul(ctx, chan, &a, &b, &ab, 1) == 0;
+    ok = ok && mpc_net_open(ctx, chan, &ab, &party->product, 1) == 0;
+
+    mpc_transport_destroy(chan);
+    mpc_batch_link_destroy(link);
+    party->ok = ok;
+    return NULL;
+}
+
+// Test 3: Runtime parties and batch-link parties share one wire format
+int test_batch_interop() {
+    printf("\n" COLOR_YELLOW "→ Test 3: Runtime and blocking parties together" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, NUM_PARTIES, THRESHOLD, 1);
+
+    mpc_transport_t *net[NUM_PARTIES];
+    if (mpc_transport_socketpair_create(NUM_PARTIES, net) != 0) {
+        return 0;
+    }
+
+    blocking_party_t blocking = {&ctx, net[2], 0, 0};
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, blocking_main, &blocking) != 0) {
+        return 0;
+    }
+
+    // Parties 1 and 2 run the same session on runtimes, driven from
+    // this thread
+    mpc_runtime_t *rt[2];
+    product_job_t jobs[2];
+    memset(jobs, 0, sizeof(jobs));
+    int ok = 1;
+    for (int i = 0; i < 2; i++) {
+        jobs[i].ctx = &ctx;
+        jobs[i].a = 0x57;
+        jobs[i].b = 0x83;
+        rt[i] = mpc_runtime_create(net[i]);
+        ok = ok && rt[i] != NULL &&
+             mpc_runtime_submit(rt[i], &ctx.session_id, product_step,
+                                &jobs[i]) == 0;
+    }
+
+    // Alternate short runs until both jobs are done
+    for (int round = 0; ok && round < 1000; round++) {
+        if (mpc_runtime_live_jobs(rt[0]) == 0 &&
+            mpc_runtime_live_jobs(rt[1]) == 0) {
+            break;
+        }
+        for (int i = 0; i < 2; i++) {
+            if (mpc_runtime_live_jobs(rt[i]) > 0) {
+                mpc_runtime_run(rt[i], 1);
+            }
+        }
+    }
+
+    ok = ok && mpc_runtime_live_jobs(rt[0]) == 0 &&
+         mpc_runtime_live_jobs(rt[1]) == 0;
+    for (int i = 0; i < 2; i++) {
+        mpc_runtime_destroy(rt[i]);
+    }
+    pthread_join(thread, NULL);
+
+    uint8_t expected = gf256_mul(0x57, 0x83);
+    ok = ok && blocking.ok && blocking.product == expected &&
+         jobs[0].product == expected && jobs[1].product == expected;
+
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+static mpc_job_status_t failing_step(mpc_job_t *job, void *arg) {
+    (void)job;
+    (void)arg;
+    return MPC_JOB_FAILED;
+}
+
+static mpc_job_status_t waiting_step(mpc_job_t *job, void *arg) {
+    (void)arg;
+    return (mpc_job_pending(job, 2) > 0) ? MPC_JOB_DONE : MPC_JOB_PENDING;
+}
+
+// Test 4: Invalid arguments, failed jobs and timeouts
+int test_invalid_arguments() {
+    printf("\n" COLOR_YELLOW "→ Test 4: Invalid arguments and failures" COLOR_RESET "\n");
+
+    // Only socket endpoints can be driven by a runtime
+    mpc_transport_t *mem[2];
+    if (mpc_transport_memory_create(2, mem) != 0) {
+        return 0;
+    }
+    int ok = mpc_runtime_create(mem[0]) == NULL;
+    ok = ok && mpc_runtime_create(NULL) == NULL;
+    mpc_transport_destroy(mem[0]);
+    mpc_transport_destroy(mem[1]);
+
+    mpc_transport_t *net[2];
+    if (mpc_transport_socketpair_create(2, net) != 0) {
+        return 0;
+    }
+    mpc_runtime_t *rt = mpc_runtime_create(net[0]);
+    ok = ok && rt != NULL;
+
+    mpc_session_id_t ids[4];
+    mpc_session_id_random(&ids[0]);
+    for (int i = 1; i < 4; i++) {
+        mpc_session_id_derive(&ids[0], (uint64_t)i, &ids[i]);
+    }
+
+    // Duplicate ids are rejected while the job is unfinished
+    ok = ok && mpc_runtime_submit(rt, &ids[1], waiting_step, NULL) == 0;
+    ok = ok && mpc_runtime_submit(rt, &ids[1], waiting_step, NULL) == -1;
+    ok = ok && mpc_runtime_submit(rt, &ids[2], NULL, NULL) == -1;
+    ok = ok && mpc_runtime_submit(rt, NULL, waiting_step, NULL) == -1;
+
+    // Party 2 never answers, so the run times out with the job waiting
+    ok = ok && mpc_runtime_run(rt, 20) == -1 && mpc_runtime_live_jobs(rt) == 1;
+
+    // A stray message for a session party 1 never opens is held...
+    uint8_t stray[MPC_SESSION_ID_SIZE + 5] = {0};
+    memcpy(stray, ids[3].bytes, MPC_SESSION_ID_SIZE);
+    stray[MPC_SESSION_ID_SIZE] = 1;
+    ok = ok && mpc_transport_send(net[1], 1, stray, sizeof(stray)) == 0;
+    ok = ok && mpc_transport_flush(net[1]) == 0;
+    ok = ok && mpc_runtime_run(rt, 20) == -1;
+
+    // ...a failing job fails the run...
+    ok = ok && mpc_runtime_submit(rt, &ids[2], failing_step, NULL) == 0;
+    ok = ok && mpc_runtime_run(rt, 20) == -1;
+
+    // ...and the held message expires once it has been idle for a pass
+    ok = ok && mpc_runtime_expire(rt, 1) == 0;
+    ok = ok && mpc_runtime_expire(rt, 0) == 1;
+
+    mpc_runtime_stats_t stats;
+    mpc_runtime_get_stats(rt, &stats);
+    ok = ok && stats.jobs_failed == 1 && stats.jobs_completed == 0 &&
+         stats.messages_received == 1;
+
+    // Protocol calls need a running job
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 2, 2, 1);
+    mpc_async_op_t op = {0};
+    mpc_share_t s;
+    memset(&s, 0, sizeof(s));
+    ok = ok && mpc_async_mul(NULL, &op, &ctx, &s, &s, &s, 1) == MPC_JOB_FAILED;
+    mpc_cleanup_context(&ctx);
+
+    mpc_runtime_destroy(rt);
+    mpc_runtime_destroy(NULL);
+    mpc_transport_destroy(net[0]);
+    mpc_transport_destroy(net[1]);
+    return ok;
+}
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  MPC Runtime Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Concurrent Jobs");
+    TEST_ASSERT(test_concurrent_jobs(), "Thousands of Jobs Share Frames");
+    TEST_ASSERT(test_early_messages(), "Early Messages Wait for Their Job");
+    TEST_ASSERT(test_batch_interop(), "Wire Format Matches Batch Links");
+
+    print_header("Robustness Tests");
+    TEST_ASSERT(test_invalid_arguments(), "Invalid Arguments and Failures");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}
@@ -0,0 +1,278 @@
+#include "sss/session.h"
+#include "sss/mpc.h"
+#include "sss/secret_sharing.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+#define NUM_SESSIONS 50000
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+// Test 1: Session identifiers
+int test_session_ids() {
+    printf("\n" COLOR_YELLOW "→ Test 1: 128-bit session identifiers" COLOR_RESET "\n");
+
+    mpc_session_id_t a, b, derived, back;
+    int ok = mpc_session_id_random(&a) == 0 && mpc_session_id_random(&b) == 0;
+    ok = ok && !mpc_session_id_equal(&a, &b);
+    ok = ok && mpc_session_id_random(NULL) == -1;
+
+    // Deriving is deterministic, changes the id, and undoes itself
+    mpc_session_id_derive(&a, 12345, &derived);
+    mpc_session_id_derive(&derived, 12345, &back);
+    ok = ok && !mpc_session_id_equal(&a, &derived) &&
+         mpc_session_id_equal(&a, &back);
+    mpc_session_id_derive(&a, 12345, &back);
+    ok = ok && mpc_session_id_equal(&derived, &back);
+
+    mpc_session_id_t fixed;
+    for (int i = 0; i < MPC_SESSION_ID_SIZE; i++) {
+        fixed.bytes[i] = (uint8_t)(i * 17);
+    }
+    char hex[MPC_SESSION_ID_HEX_SIZE];
+    mpc_session_id_to_hex(&fixed, hex);
+    printf("  Session id: %s\n", hex);
+    ok = ok && strcmp(hex, "00112233445566778899aabbccddeeff") == 0;
+
+    // Contexts get fresh ids; shares carry their context's id
+    mpc_context_t ctx1, ctx2;
+    mpc_init_context(&ctx1, 3, 2, 1);
+    mpc_init_context(&ctx2, 3, 2, 1);
+    ok = ok && !mpc_session_id_equal(&ctx1.session_id, &ctx2.session_id);
+
+    uint8_t secret = 42;
+    mpc_share_t shares[3];
+    ok = ok && mpc_create_shares(&ctx1, &secret, shares) == 0;
+    ok = ok && mpc_validate_share(&ctx1, &shares[0]) == 0;
+    ok = ok && mpc_validate_share(&ctx2, &shares[0]) == -1;
+
+    // Joining the session makes the shares valid for ctx2 too
+    ok = ok && mpc_context_set_session(&ctx2, &ctx1.session_id) == 0;
+    ok = ok && mpc_validate_share(&ctx2, &shares[0]) == 0;
+
+    mpc_cleanup_context(&ctx1);
+    mpc_cleanup_context(&ctx2);
+    return ok;
+}
+
+// Test 2: Tens of thousands of live sessions
+int test_many_sessions() {
+    printf("\n" COLOR_YELLOW "→ Test 2: %d live sessions" COLOR_RESET "\n",
+           NUM_SESSIONS);
+
+    mpc_session_table_t *table = mpc_session_table_create();
+    mpc_session_id_t *ids = malloc(NUM_SESSIONS * sizeof(mpc_session_id_t));
+    mpc_session_t **entries = malloc(NUM_SESSIONS * sizeof(mpc_session_t *));
+    if (table == NULL || ids == NULL || entries == NULL) {
+        mpc_session_table_destroy(table, NULL, NULL);
+        free(ids);
+        free(entries);
+        return 0;
+    }
+
+    // Derived ids differ only in their low bytes
+    mpc_session_id_t base;
+    mpc_session_id_random(&base);
+
+    int ok = 1;
+    for (size_t i = 0; i < NUM_SESSIONS && ok; i++) {
+        mpc_session_id_derive(&base, i, &ids[i]);
+        entries[i] = mpc_session_add(table, &ids[i], MPC_SESSION_ACTIVE,
+                                     &ids[i]);
+        ok = entries[i] != NULL;
+    }
+    ok = ok && mpc_session_add(table, &ids[7], MPC_SESSION_ACTIVE, NULL) == NULL;
+
+    for (size_t i = 0; i < NUM_SESSIONS && ok; i++) {
+        mpc_session_t *found = mpc_session_find(table, &ids[i]);
+        ok = found == entries[i] && found->data == &ids[i];
+    }
+
+    // Remove every other session; the rest stay reachable
+    for (size_t i = 0; i < NUM_SESSIONS && ok; i += 2) {
+        mpc_session_remove(table, entries[i]);
+    }
+    for (size_t i = 0; i < NUM_SESSIONS && ok; i++) {
+        mpc_session_t *found = mpc_session_find(table, &ids[i]);
+        ok = (i % 2 == 0) ? found == NULL : found == entries[i];
+    }
+
+    // Ids may be reused once removed
+    ok = ok && mpc_session_add(table, &ids[0], MPC_SESSION_ACTIVE, NULL) != NULL;
+
+    mpc_session_table_stats_t stats;
+    mpc_session_table_get_stats(table, &stats);
+    printf("  %zu live of %zu at most, %llu added, %llu removed\n",
+           stats.live, stats.max_live, (unsigned long long)stats.added,
+           (unsigned long long)stats.removed);
+    ok = ok && stats.live == NUM_SESSIONS / 2 + 1 &&
+         stats.max_live == NUM_SESSIONS && stats.added == NUM_SESSIONS + 1 &&
+         stats.removed == NUM_SESSIONS / 2 && stats.pending == 0;
+
+    mpc_session_table_destroy(table, NULL, NULL);
+    free(ids);
+    free(entries);
+    return ok;
+}
+
+static void count_release(mpc_session_t *session, void *arg) {
+    (void)session;
+    (*(int *)arg)++;
+}
+
+// Test 3: Pending and active sessions, expiry
+int test_lifecycle() {
+    printf("\n" COLOR_YELLOW "→ Test 3: Session lifecycle" COLOR_RESET "\n");
+
+    mpc_session_table_t *table = mpc_session_table_create();
+    if (table == NULL) {
+        return 0;
+    }
+
+    mpc_session_id_t base, id;
+    mpc_session_id_random(&base);
+
+    // Ten sessions known only from traffic, at times 0..9
+    int ok = 1;
+    for (uint64_t i = 0; i < 10 && ok; i++) {
+        mpc_session_id_derive(&base, i, &id);
+        mpc_session_t *s = mpc_session_add(table, &id, MPC_SESSION_PENDING, NULL);
+        ok = s != NULL;
+        if (ok) {
+            s->last_active = i;
+        }
+    }
+
+    // Sessions 0 and 1 get opened here
+    for (uint64_t i = 0; i < 2 && ok; i++) {
+        mpc_session_id_derive(&base, i, &id);
+        mpc_session_set_state(table, mpc_session_find(table, &id),
+                              MPC_SESSION_ACTIVE);
+    }
+
+    mpc_session_table_stats_t stats;
+    mpc_session_table_get_stats(table, &stats);
+    ok = ok && stats.live == 10 && stats.pending == 8;
+
+    // Pending sessions idle since before time 5 are dropped: 2, 3, 4
+    int released = 0;
+    ok = ok && mpc_session_table_expire(table, MPC_SESSION_PENDING, 5,
+                                        count_release, &released) == 3;
+    ok = ok && released == 3;
+
+    mpc_session_id_derive(&base, 0, &id);
+    ok = ok && mpc_session_find(table, &id) != NULL;
+    mpc_session_id_derive(&base, 3, &id);
+    ok = ok && mpc_session_find(table, &id) == NULL;
+
+    mpc_session_table_get_stats(table, &stats);
+    ok = ok && stats.live == 7 && stats.pending == 5 && stats.expired == 3;
+
+    // Destroying the table releases the rest
+    released = 0;
+    mpc_session_table_destroy(table, count_release, &released);
+    ok = ok && released == 7;
+    return ok;
+}
+
+// Test 4: Invalid arguments
+int test_invalid_arguments() {
+    printf("\n" COLOR_YELLOW "→ Test 4: Invalid arguments" COLOR_RESET "\n");
+
+    mpc_session_table_t *table = mpc_session_table_create();
+    mpc_session_id_t id;
+    mpc_session_id_random(&id);
+
+    int ok = table != NULL;
+    ok = ok && mpc_session_add(table, NULL, MPC_SESSION_ACTIVE, NULL) == NULL;
+    ok = ok && mpc_session_add(NULL, &id, MPC_SESSION_ACTIVE, NULL) == NULL;
+    ok = ok && mpc_session_find(table, &id) == NULL;
+    ok = ok && mpc_session_find(NULL, &id) == NULL;
+    ok = ok && mpc_session_table_expire(NULL, MPC_SESSION_PENDING, 1,
+                                        NULL, NULL) == 0;
+    ok = ok && mpc_context_set_session(NULL, &id) == -1;
+    ok = ok && !mpc_session_id_equal(&id, NULL);
+
+    mpc_session_remove(table, NULL);
+    mpc_session_table_destroy(table, NULL, NULL);
+    mpc_session_table_destroy(NULL, NULL, NULL);
+    return ok;
+}
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  MPC Session Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Session Identifiers");
+    TEST_ASSERT(test_session_ids(), "128-bit Ids Name Contexts and Shares");
+
+    print_header("Session Table");
+    TEST_ASSERT(test_many_sessions(), "Tens of Thousands of Live Sessions");
+    TEST_ASSERT(test_lifecycle(), "Pending, Active and Expired Sessions");
+
+    print_header("Robustness Tests");
+    TEST_ASSERT(test_invalid_arguments(), "Invalid Arguments Rejected");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}
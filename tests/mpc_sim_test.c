@@ -0,0 +1,471 @@
+#define _GNU_SOURCE
+#include "sss/transport_sim.h"
+#include "sss/mpc_net.h"
+#include "sss/mpc.h"
+#include "sss/field.h"
+#include "sss/secret_sharing.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+#define NUM_PARTIES 5
+
+static int near(double a, double b) {
+    return fabs(a - b) < 1e-6;
+}
+
+static void destroy_group(mpc_transport_t **net, int count) {
+    for (int i = 0; i < count; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+}
+
+/* ========================================================================
+ * Party Threads
+ * ======================================================================== */
+
+typedef struct {
+    const mpc_context_t *ctx;
+    mpc_transport_t *transport;
+    uint8_t input;
+    uint8_t product;            // Opened product of inputs 1 and 2
+    int status;
+} party_t;
+
+/**
+ * Every party inputs a value, then x1 × x2 is computed and opened,
+ * each protocol step marked
+ */
+static void *party_main(void *arg) {
+    party_t *party = arg;
+    const mpc_context_t *ctx = party->ctx;
+    mpc_transport_t *net = party->transport;
+    uint8_t me = net->party_id;
+
+    mpc_share_t inputs[NUM_PARTIES];
+    mpc_share_t product;
+    party->status = -1;
+
+    mpc_sim_step_begin(net, "inputs");
+    for (uint8_t dealer = 1; dealer <= NUM_PARTIES; dealer++) {
+        const uint8_t *secret = (dealer == me) ? &party->input : NULL;
+        if (mpc_net_share_input(ctx, net, dealer, secret,
+                                &inputs[dealer - 1], 1) != 0) {
+            return NULL;
+        }
+    }
+
+    mpc_sim_step_begin(net, "multiply");
+    if (mpc_net_mul(ctx, net, &inputs[0], &inputs[1], &product, 1) != 0) {
+        return NULL;
+    }
+
+    mpc_sim_step_begin(net, "open");
+    if (mpc_net_open(ctx, net, &product, &party->product, 1) != 0) {
+        return NULL;
+    }
+    mpc_sim_step_end(net);
+
+    party->status = 0;
+    return NULL;
+}
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+// Test 1: Latency alone, with one party answering the other
+int test_round_trips() {
+    mpc_sim_config_t wan = {{40.0, 0.0, 0.0}, NULL, 0, 0, 1};
+    mpc_transport_t *net[2];
+    if (mpc_transport_sim_create(2, &wan, net) != 0) {
+        return 0;
+    }
+
+    // Sends never block, so both parties can run on this thread
+    int ok = 1;
+    uint8_t buf[16];
+    size_t len = 0;
+    for (int i = 0; i < 3; i++) {
+        ok = ok && mpc_transport_send(net[0], 2, "ping", 4) == 0;
+        ok = ok && mpc_transport_flush(net[0]) == 0;
+        ok = ok && mpc_transport_recv(net[1], 1, buf, sizeof(buf), &len) == 0 &&
+             len == 4 && memcmp(buf, "ping", 4) == 0;
+        ok = ok && mpc_transport_send(net[1], 1, "pong", 4) == 0;
+        ok = ok && mpc_transport_flush(net[1]) == 0;
+        ok = ok && mpc_transport_recv(net[0], 2, buf, sizeof(buf), &len) == 0 &&
+             len == 4;
+    }
+
+    // Three round trips of 2 × 40 ms
+    ok = ok && near(mpc_sim_now_ms(net[0]), 240.0);
+    ok = ok && near(mpc_sim_now_ms(net[1]), 200.0);
+
+    // Counters show payload bytes only
+    mpc_transport_stats_t stats;
+    mpc_transport_get_stats(net[0], &stats);
+    ok = ok && stats.bytes_sent == 12 && stats.rounds == 3;
+
+    destroy_group(net, 2);
+    return ok;
+}
+
+// Test 2: Step report of a multiplication protocol on a 40 ms WAN
+int test_protocol_steps() {
+    mpc_sim_config_t wan = {{40.0, 0.0, 0.0}, NULL, 0, 0, 1};
+    mpc_transport_t *net[NUM_PARTIES];
+    if (mpc_transport_sim_create(NUM_PARTIES, &wan, net) != 0) {
+        return 0;
+    }
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, NUM_PARTIES, 3, 1);
+
+    party_t parties[NUM_PARTIES];
+    pthread_t threads[NUM_PARTIES];
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        parties[i].ctx = &ctx;
+        parties[i].transport = net[i];
+        parties[i].input = (uint8_t)(23 * (i + 1));
+        pthread_create(&threads[i], NULL, party_main, &parties[i]);
+    }
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    int ok = 1;
+    uint8_t expected = gf256_mul(parties[0].input, parties[1].input);
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        ok = ok && parties[i].status == 0 && parties[i].product == expected;
+    }
+
+    mpc_sim_step_t steps[4];
+    ok = ok && mpc_sim_get_steps(net[2], steps, 4) == 3;
+    if (ok) {
+        printf("    Party 3 on a 40 ms WAN:\n");
+        for (int s = 0; s < 3; s++) {
+            printf("    %-10s %2llu rounds %4llu bytes out %7.1f ms\n",
+                   steps[s].name, (unsigned long long)steps[s].rounds,
+                   (unsigned long long)steps[s].bytes_sent,
+                   steps[s].elapsed_ms);
+        }
+
+        // Dealers go one after another, each waiting for the one before
+        ok = ok && strcmp(steps[0].name, "inputs") == 0 &&
+             steps[0].rounds == 1 && steps[0].bytes_sent == NUM_PARTIES - 1;
+
+        // Multiplication and opening cost one 40 ms round each
+        ok = ok && strcmp(steps[1].name, "multiply") == 0 &&
+             steps[1].rounds == 1 && steps[1].messages_sent == NUM_PARTIES - 1 &&
+             steps[1].bytes_received == NUM_PARTIES - 1 &&
+             near(steps[1].elapsed_ms, 40.0);
+        ok = ok && strcmp(steps[2].name, "open") == 0 &&
+             steps[2].rounds == 1 && near(steps[2].elapsed_ms, 40.0) &&
+             near(steps[2].compute_ms, 0.0);
+
+        // The last dealer's shares land after five hops
+        double total = steps[0].elapsed_ms + steps[1].elapsed_ms +
+                       steps[2].elapsed_ms;
+        ok = ok && near(total, mpc_sim_now_ms(net[2])) &&
+             near(mpc_sim_now_ms(net[0]), 5 * 40.0 + 80.0);
+    }
+
+    destroy_group(net, NUM_PARTIES);
+    return ok;
+}
+
+// Test 3: Bandwidth and per-message overhead
+int test_bandwidth() {
+    // 8 Mbit/s moves 1000 bytes per millisecond
+    mpc_sim_config_t slow = {{0.0, 0.0, 8.0}, NULL, 0, 0, 1};
+    mpc_transport_t *net[2];
+    if (mpc_transport_sim_create(2, &slow, net) != 0) {
+        return 0;
+    }
+
+    int ok = 1;
+    uint8_t block[1000] = {0};
+    uint8_t buf[1000];
+    size_t len = 0;
+    for (int i = 0; i < 10; i++) {
+        ok = ok && mpc_transport_send(net[0], 2, block, sizeof(block)) == 0;
+    }
+    ok = ok && mpc_transport_recv(net[1], 1, buf, sizeof(buf), &len) == 0 &&
+         near(mpc_sim_now_ms(net[1]), 1.0);
+    for (int i = 1; i < 10; i++) {
+        ok = ok && mpc_transport_recv(net[1], 1, buf, sizeof(buf), &len) == 0;
+    }
+    ok = ok && near(mpc_sim_now_ms(net[1]), 10.0);
+    destroy_group(net, 2);
+
+    // The same transfer with 1000 bytes of framing per message
+    slow.overhead_bytes = 1000;
+    if (mpc_transport_sim_create(2, &slow, net) != 0) {
+        return 0;
+    }
+    for (int i = 0; i < 10; i++) {
+        ok = ok && mpc_transport_send(net[0], 2, block, sizeof(block)) == 0;
+    }
+    for (int i = 0; i < 10; i++) {
+        ok = ok && mpc_transport_recv(net[1], 1, buf, sizeof(buf), &len) == 0;
+    }
+    ok = ok && near(mpc_sim_now_ms(net[1]), 20.0);
+    destroy_group(net, 2);
+    return ok;
+}
+
+/**
+ * Clock of party 2 after each of count messages sent by party 1 at once
+ */
+static int jitter_arrivals(uint64_t seed, double *arrivals, int count) {
+    mpc_sim_config_t noisy = {{10.0, 5.0, 0.0}, NULL, 0, 0, seed};
+    mpc_transport_t *net[2];
+    if (mpc_transport_sim_create(2, &noisy, net) != 0) {
+        return 0;
+    }
+
+    int ok = 1;
+    uint8_t byte = 0;
+    size_t len = 0;
+    for (int i = 0; i < count; i++) {
+        ok = ok && mpc_transport_send(net[0], 2, &byte, 1) == 0;
+    }
+    for (int i = 0; i < count; i++) {
+        ok = ok && mpc_transport_recv(net[1], 1, &byte, 1, &len) == 0;
+        arrivals[i] = mpc_sim_now_ms(net[1]);
+    }
+
+    destroy_group(net, 2);
+    return ok;
+}
+
+// Test 4: Jitter stays in range, keeps order and follows the seed
+int test_jitter() {
+    enum { COUNT = 1000 };
+    static double a[COUNT], b[COUNT], c[COUNT];
+
+    int ok = jitter_arrivals(7, a, COUNT) && jitter_arrivals(7, b, COUNT) &&
+             jitter_arrivals(8, c, COUNT);
+
+    int in_order = 1;
+    for (int i = 0; i < COUNT; i++) {
+        in_order = in_order && a[i] >= 10.0 && a[i] <= 15.0 &&
+                   (i == 0 || a[i] >= a[i - 1]);
+    }
+    ok = ok && in_order;
+    ok = ok && memcmp(a, b, sizeof(a)) == 0;
+    ok = ok && memcmp(a, c, sizeof(a)) != 0;
+    return ok;
+}
+
+// Test 5: Per-link models
+int test_link_matrix() {
+    // Party 1 reaches party 2 in 10 ms and party 3 in 100 ms
+    mpc_sim_link_t links[9];
+    memset(links, 0, sizeof(links));
+    links[0 * 3 + 1].latency_ms = 10.0;
+    links[0 * 3 + 2].latency_ms = 100.0;
+    links[1 * 3 + 2].latency_ms = 5.0;
+
+    mpc_sim_config_t config = {{0.0, 0.0, 0.0}, links, 0, 0, 1};
+    mpc_transport_t *net[3];
+    if (mpc_transport_sim_create(3, &config, net) != 0) {
+        return 0;
+    }
+
+    int ok = 1;
+    uint8_t byte = 0;
+    size_t len = 0;
+    ok = ok && mpc_transport_broadcast(net[0], &byte, 1) == 0;
+    ok = ok && mpc_transport_recv(net[1], 1, &byte, 1, &len) == 0 &&
+         near(mpc_sim_now_ms(net[1]), 10.0);
+
+    // Relaying through party 2 beats the direct link
+    ok = ok && mpc_transport_send(net[1], 3, &byte, 1) == 0;
+    ok = ok && mpc_transport_recv(net[2], 2, &byte, 1, &len) == 0 &&
+         near(mpc_sim_now_ms(net[2]), 15.0);
+    ok = ok && mpc_transport_recv(net[2], 1, &byte, 1, &len) == 0 &&
+         near(mpc_sim_now_ms(net[2]), 100.0);
+
+    destroy_group(net, 3);
+    return ok;
+}
+
+// Test 6: Step log and local computation
+int test_step_log() {
+    mpc_sim_config_t lan = {{0.5, 0.0, 0.0}, NULL, 0, 1, 1};
+    mpc_transport_t *net[2];
+    if (mpc_transport_sim_create(2, &lan, net) != 0) {
+        return 0;
+    }
+
+    int ok = 1;
+    ok = ok && mpc_sim_step_end(net[0]) == -1;
+    ok = ok && mpc_sim_step_begin(net[0],
+                                  "a step name well over thirty-two bytes") == 0;
+
+    // About 20 ms of work on this thread
+    struct timespec start, now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    volatile uint64_t spin = 0;
+    do {
+        for (int i = 0; i < 10000; i++) {
+            spin += (uint64_t)i;
+        }
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    } while ((now.tv_sec - start.tv_sec) * 1000.0 +
+             (now.tv_nsec - start.tv_nsec) / 1e6 < 20.0);
+
+    ok = ok && mpc_sim_step_begin(net[0], "second") == 0;
+    ok = ok && mpc_sim_step_end(net[0]) == 0;
+    ok = ok && mpc_sim_step_end(net[0]) == -1;
+
+    mpc_sim_step_t steps[2];
+    ok = ok && mpc_sim_get_steps(net[0], NULL, 0) == 2;
+    ok = ok && mpc_sim_get_steps(net[0], steps, 1) == 2;
+    ok = ok && strlen(steps[0].name) == MPC_SIM_STEP_NAME_SIZE - 1 &&
+         strncmp(steps[0].name, "a step name", 11) == 0;
+    ok = ok && steps[0].compute_ms >= 19.0 &&
+         near(steps[0].elapsed_ms, steps[0].compute_ms) &&
+         steps[0].rounds == 0 && steps[0].bytes_sent == 0;
+    ok = ok && mpc_sim_now_ms(net[0]) >= steps[0].elapsed_ms;
+
+    // Party 2 did nothing
+    ok = ok && mpc_sim_get_steps(net[1], steps, 2) == 0 &&
+         near(mpc_sim_now_ms(net[1]), 0.0);
+
+    destroy_group(net, 2);
+    return ok;
+}
+
+// Test 7: Invalid arguments
+int test_invalid_arguments() {
+    mpc_transport_t *net[3];
+    mpc_sim_config_t config = {{1.0, 0.0, 0.0}, NULL, 0, 0, 1};
+    int ok = 1;
+
+    ok = ok && mpc_transport_sim_create(1, &config, net) == -1;
+    ok = ok && mpc_transport_sim_create(3, NULL, net) == -1;
+    ok = ok && mpc_transport_sim_create(3, &config, NULL) == -1;
+
+    config.link.latency_ms = -1.0;
+    ok = ok && mpc_transport_sim_create(3, &config, net) == -1;
+    config.link.latency_ms = NAN;
+    ok = ok && mpc_transport_sim_create(3, &config, net) == -1;
+    config.link.latency_ms = 1.0;
+    config.link.bandwidth_mbps = INFINITY;
+    ok = ok && mpc_transport_sim_create(3, &config, net) == -1;
+
+    // Only the per-link models count when given
+    mpc_sim_link_t links[9];
+    memset(links, 0, sizeof(links));
+    links[5].jitter_ms = -2.0;
+    config.links = links;
+    ok = ok && mpc_transport_sim_create(3, &config, net) == -1;
+    links[5].jitter_ms = 2.0;
+    ok = ok && mpc_transport_sim_create(3, &config, net) == 0;
+    destroy_group(net, 3);
+
+    // Simulation calls on other backends
+    ok = ok && mpc_transport_memory_create(2, net) == 0;
+    ok = ok && mpc_sim_now_ms(net[0]) < 0.0;
+    ok = ok && mpc_sim_step_begin(net[0], "x") == -1;
+    ok = ok && mpc_sim_step_end(net[0]) == -1;
+    ok = ok && mpc_sim_get_steps(net[0], NULL, 0) == 0;
+    destroy_group(net, 2);
+
+    ok = ok && mpc_sim_now_ms(NULL) < 0.0;
+    ok = ok && mpc_sim_step_begin(NULL, "x") == -1;
+    return ok;
+}
+
+/* ========================================================================
+ * Main
+ * ======================================================================== */
+
+int main() {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════╗\n");
+    printf("║  MPC Network Simulation Tests                  ║\n");
+    printf("╚════════════════════════════════════════════════╝\n");
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "Failed to initialize library\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Test 1: Round Trips");
+    TEST_ASSERT(test_round_trips(), "Three 40 ms round trips take 240 ms");
+
+    print_header("Test 2: Protocol Steps");
+    TEST_ASSERT(test_protocol_steps(), "Rounds, bytes and times per step");
+
+    print_header("Test 3: Bandwidth");
+    TEST_ASSERT(test_bandwidth(), "Transfers queue behind the link's capacity");
+
+    print_header("Test 4: Jitter");
+    TEST_ASSERT(test_jitter(), "Jitter is bounded, ordered and seeded");
+
+    print_header("Test 5: Per-Link Models");
+    TEST_ASSERT(test_link_matrix(), "Each directed link has its own latency");
+
+    print_header("Test 6: Step Log");
+    TEST_ASSERT(test_step_log(), "Steps record local computation");
+
+    print_header("Test 7: Invalid Arguments");
+    TEST_ASSERT(test_invalid_arguments(), "Invalid arguments are rejected");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_YELLOW "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("  Total tests:  %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    if (tests_failed > 0) {
+        printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    }
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf("\n" COLOR_GREEN "✓ All tests passed!" COLOR_RESET "\n\n");
+        return 0;
+    }
+
+    printf("\n" COLOR_RED "✗ Some tests failed" COLOR_RESET "\n\n");
+    return 1;
+}
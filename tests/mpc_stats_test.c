@@ -0,0 +1,389 @@
+#include "sss/mpc.h"
+#include "sss/mpc_net.h"
+#include "sss/transport.h"
+#include "sss/secret_sharing.h"
+#include "sss/field.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+#define NUM_THREADS 4
+#define ADDS_PER_THREAD 1000
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+// Test 1: Counting is off until enabled
+int test_enable() {
+    printf("\n" COLOR_YELLOW "→ Test 1: Counters are optional" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_stats_t stats;
+    mpc_share_t x[5], sum[5];
+    uint8_t secret = 42;
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0 && ctx.counters == NULL;
+
+    // Operations work and nothing is counted
+    ok = ok && mpc_create_shares(&ctx, &secret, x) == 0;
+    ok = ok && mpc_secure_add(&ctx, x, x, sum, 5) == 0;
+    ok = ok && mpc_get_stats(&ctx, &stats) == -1;
+    mpc_reset_stats(&ctx);
+
+    // Enabled counters start at zero
+    ok = ok && mpc_enable_stats(&ctx) == 0;
+    ok = ok && mpc_get_stats(&ctx, &stats) == 0;
+    ok = ok && stats.values_shared == 0 && stats.calls[MPC_OP_ADD] == 0;
+
+    // Enabling again keeps the counts
+    ok = ok && mpc_secure_add(&ctx, x, x, sum, 5) == 0;
+    ok = ok && mpc_enable_stats(&ctx) == 0;
+    ok = ok && mpc_get_stats(&ctx, &stats) == 0 && stats.calls[MPC_OP_ADD] == 1;
+    printf("  Counts after enabling twice: %llu add\n",
+           (unsigned long long)stats.calls[MPC_OP_ADD]);
+
+    // Cleanup releases the counters and still wipes the context
+    mpc_cleanup_context(&ctx);
+    ok = ok && ctx.counters == NULL && ctx.num_parties == 0;
+    return ok;
+}
+
+// Test 2: Arithmetic, multiplication and reconstruction counts
+int test_operation_counts() {
+    printf("\n" COLOR_YELLOW "→ Test 2: Operation counts" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_stats_t stats;
+    mpc_share_t a[3][5], b[3][5], prod[3][5], tmp[5];
+    uint8_t value;
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0 && mpc_enable_stats(&ctx) == 0;
+
+    for (int k = 0; k < 3 && ok; k++) {
+        uint8_t x = (uint8_t)(k + 2);
+        uint8_t y = (uint8_t)(k + 7);
+        ok = mpc_create_shares(&ctx, &x, a[k]) == 0 &&
+             mpc_create_shares(&ctx, &y, b[k]) == 0;
+    }
+
+    ok = ok && mpc_secure_add(&ctx, a[0], b[0], tmp, 5) == 0;
+    ok = ok && mpc_secure_sub(&ctx, a[0], b[0], tmp, 5) == 0;
+    ok = ok && mpc_secure_mul_const(&ctx, a[0], 3, tmp, 5) == 0;
+
+    const mpc_share_t *xs[3] = {a[0], a[1], a[2]};
+    const mpc_share_t *ys[3] = {b[0], b[1], b[2]};
+    mpc_share_t *outs[3] = {prod[0], prod[1], prod[2]};
+    ok = ok && mpc_secure_mul_batch(&ctx, xs, ys, outs, 3, 5) == 0;
+    ok = ok && mpc_reconstruct(&ctx, prod[2], 5, &value) == 0;
+
+    ok = ok && mpc_get_stats(&ctx, &stats) == 0;
+    printf("  %llu shared, %llu products, %llu reshared, %llu opened, "
+           "%llu secure allocations\n",
+           (unsigned long long)stats.values_shared,
+           (unsigned long long)stats.multiplications,
+           (unsigned long long)stats.reshares,
+           (unsigned long long)stats.reconstructions,
+           (unsigned long long)stats.secure_allocations);
+
+    // 6 inputs + 3 reshared products
+    ok = ok && stats.values_shared == 9;
+    ok = ok && stats.multiplications == 3 && stats.reshares == 3;
+    ok = ok && stats.reconstructions == 4;
+    ok = ok && stats.secure_allocations == 2;
+    ok = ok && stats.calls[MPC_OP_ADD] == 1 && stats.calls[MPC_OP_SUB] == 1 &&
+         stats.calls[MPC_OP_MUL_CONST] == 1 && stats.calls[MPC_OP_MUL] == 1;
+    ok = ok && stats.calls[MPC_OP_RECONSTRUCT] == 4;
+    ok = ok && stats.calls[MPC_OP_CREATE_SHARES] == 9;
+    ok = ok && stats.validation_failures == 0;
+    ok = ok && stats.rounds == 0 && stats.bytes_sent == 0;
+
+    // Every operation was timed
+    ok = ok && stats.time_ns[MPC_OP_MUL] > 0;
+    ok = ok && stats.time_ns[MPC_OP_RECONSTRUCT] > 0;
+    ok = ok && value == gf256_mul(4, 9);
+    printf("  mul: %.1f us, reconstruct: %.1f us\n",
+           stats.time_ns[MPC_OP_MUL] / 1e3,
+           stats.time_ns[MPC_OP_RECONSTRUCT] / 1e3);
+
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 3: Rejected shares
+int test_validation_failures() {
+    printf("\n" COLOR_YELLOW "→ Test 3: Validation failures" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_context_t other;
+    mpc_stats_t stats;
+    mpc_share_t x[5], y[5], sum[5];
+    uint8_t secret = 9;
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0 &&
+             mpc_init_context(&other, 5, 3, 1) == 0 &&
+             mpc_enable_stats(&ctx) == 0;
+    ok = ok && mpc_create_shares(&ctx, &secret, x) == 0;
+    ok = ok && mpc_create_shares(&other, &secret, y) == 0;
+
+    // Shares of another session are rejected, and counted
+    ok = ok && mpc_secure_add(&ctx, x, y, sum, 5) == -1;
+    x[2].party_id = 0;
+    ok = ok && mpc_validate_share(&ctx, &x[2]) == -1;
+    ok = ok && mpc_validate_share(&ctx, &x[1]) == 0;
+
+    ok = ok && mpc_get_stats(&ctx, &stats) == 0;
+    printf("  %llu failures\n", (unsigned long long)stats.validation_failures);
+    ok = ok && stats.validation_failures == 2;
+
+    // Failed calls are still timed
+    ok = ok && stats.calls[MPC_OP_ADD] == 1;
+
+    mpc_cleanup_context(&ctx);
+    mpc_cleanup_context(&other);
+    return ok;
+}
+
+// Test 4: Rounds and bytes of the networked protocols
+int test_network_traffic() {
+    printf("\n" COLOR_YELLOW "→ Test 4: Network traffic" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_stats_t stats;
+    mpc_transport_t *net[4];
+    mpc_share_t shares[4][8];
+    uint8_t secrets[8 * 2];
+
+    for (int i = 0; i < 16; i++) {
+        secrets[i] = (uint8_t)(i * 11);
+    }
+
+    int ok = mpc_init_context(&ctx, 4, 2, 2) == 0 && mpc_enable_stats(&ctx) == 0;
+    ok = ok && mpc_transport_memory_create(4, net) == 0;
+
+    // The memory backend buffers every message, so the dealer can go
+    // first and the other parties collect their shares afterwards
+    for (uint8_t p = 1; p <= 4 && ok; p++) {
+        ok = mpc_net_share_input(&ctx, net[p - 1], 1,
+                                 (p == 1) ? secrets : NULL,
+                                 shares[p - 1], 8) == 0;
+    }
+
+    ok = ok && mpc_get_stats(&ctx, &stats) == 0;
+    printf("  %llu rounds, %llu bytes sent, %llu bytes received\n",
+           (unsigned long long)stats.rounds,
+           (unsigned long long)stats.bytes_sent,
+           (unsigned long long)stats.bytes_received);
+
+    // 8 values of 2 bytes to each of 3 peers, in one round
+    ok = ok && stats.rounds == 1;
+    ok = ok && stats.bytes_sent == 8 * 2 * 3 && stats.bytes_received == 8 * 2 * 3;
+    ok = ok && stats.calls[MPC_OP_NET_SHARE_INPUT] == 4;
+    ok = ok && stats.values_shared == 8 && stats.secure_allocations == 1;
+
+    for (int i = 0; i < 4; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+typedef struct {
+    const mpc_context_t *ctx;
+    const mpc_share_t *x;
+    int status;
+} adder_t;
+
+static void *adder_main(void *arg) {
+    adder_t *adder = arg;
+    mpc_share_t sum[5];
+    adder->status = 0;
+    for (int i = 0; i < ADDS_PER_THREAD; i++) {
+        if (mpc_secure_add(adder->ctx, adder->x, adder->x, sum, 5) != 0) {
+            adder->status = -1;
+        }
+    }
+    return NULL;
+}
+
+// Test 5: Threads sharing a context, and reset
+int test_threads_and_reset() {
+    printf("\n" COLOR_YELLOW "→ Test 5: Concurrent updates and reset" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_stats_t stats;
+    mpc_share_t x[5];
+    uint8_t secret = 77;
+    pthread_t threads[NUM_THREADS];
+    adder_t adders[NUM_THREADS];
+
+    int ok = mpc_init_context(&ctx, 5, 3, 1) == 0 && mpc_enable_stats(&ctx) == 0;
+    ok = ok && mpc_create_shares(&ctx, &secret, x) == 0;
+
+    for (int i = 0; i < NUM_THREADS && ok; i++) {
+        adders[i].ctx = &ctx;
+        adders[i].x = x;
+        pthread_create(&threads[i], NULL, adder_main, &adders[i]);
+    }
+    for (int i = 0; i < NUM_THREADS && ok; i++) {
+        pthread_join(threads[i], NULL);
+        ok = ok && adders[i].status == 0;
+    }
+
+    ok = ok && mpc_get_stats(&ctx, &stats) == 0;
+    printf("  %llu adds from %d threads\n",
+           (unsigned long long)stats.calls[MPC_OP_ADD], NUM_THREADS);
+    ok = ok && stats.calls[MPC_OP_ADD] == NUM_THREADS * ADDS_PER_THREAD;
+
+    // Reset zeroes everything
+    mpc_reset_stats(&ctx);
+    ok = ok && mpc_get_stats(&ctx, &stats) == 0;
+    mpc_stats_t zero;
+    memset(&zero, 0, sizeof(zero));
+    ok = ok && memcmp(&stats, &zero, sizeof(stats)) == 0;
+
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 6: Names and invalid arguments
+int test_invalid_arguments() {
+    printf("\n" COLOR_YELLOW "→ Test 6: Invalid arguments" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_stats_t stats;
+
+    int ok = mpc_init_context(&ctx, 3, 2, 1) == 0;
+    ok = ok && mpc_enable_stats(NULL) == -1;
+    ok = ok && mpc_get_stats(NULL, &stats) == -1;
+    ok = ok && mpc_enable_stats(&ctx) == 0;
+    ok = ok && mpc_get_stats(&ctx, NULL) == -1;
+    mpc_reset_stats(NULL);
+
+    ok = ok && strcmp(mpc_op_name(MPC_OP_MUL), "mul") == 0;
+    ok = ok && strcmp(mpc_op_name(MPC_OP_NET_OPEN), "net_open") == 0;
+    ok = ok && strcmp(mpc_op_name(MPC_OP_COUNT), "unknown") == 0;
+    for (int op = 0; op < MPC_OP_COUNT; op++) {
+        ok = ok && mpc_op_name((mpc_op_t)op) != NULL &&
+             strcmp(mpc_op_name((mpc_op_t)op), "unknown") != 0;
+    }
+
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 7: Cleanup after a failed init, and of copies
+int test_cleanup() {
+    printf("\n" COLOR_YELLOW "→ Test 7: Cleanup" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_stats_t stats;
+    mpc_share_t x[3], sum[3];
+    uint8_t secret = 9;
+
+    // A failed init leaves nothing for cleanup to free
+    memset(&ctx, 0xA5, sizeof(ctx));
+    int ok = mpc_init_context(&ctx, 3, 4, 1) == -1;
+    ok = ok && ctx.counters == NULL;
+    mpc_cleanup_context(&ctx);
+
+    // A copy shares the counters and keeps them after the original goes
+    mpc_context_t copy;
+    ok = ok && mpc_init_context(&ctx, 3, 2, 1) == 0 && mpc_enable_stats(&ctx) == 0;
+    ok = ok && mpc_copy_context(&copy, &ctx) == 0 && copy.counters == ctx.counters;
+    ok = ok && mpc_create_shares(&copy, &secret, x) == 0;
+    ok = ok && mpc_secure_add(&copy, x, x, sum, 3) == 0;
+    mpc_cleanup_context(&ctx);
+    ok = ok && mpc_secure_add(&copy, x, x, sum, 3) == 0;
+    ok = ok && mpc_get_stats(&copy, &stats) == 0 && stats.calls[MPC_OP_ADD] == 2;
+    printf("  Counts after cleaning up the original: %llu add\n",
+           (unsigned long long)stats.calls[MPC_OP_ADD]);
+
+    mpc_cleanup_context(&copy);
+    ok = ok && copy.counters == NULL && ctx.counters == NULL;
+    ok = ok && mpc_copy_context(NULL, &ctx) == -1;
+    return ok;
+}
+
+/* ========================================================================
+ * Main
+ * ======================================================================== */
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  MPC Statistics Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Enabling");
+    TEST_ASSERT(test_enable(), "Counters Are Off Until Enabled");
+
+    print_header("Counters");
+    TEST_ASSERT(test_operation_counts(), "Operations, Products and Openings Counted");
+    TEST_ASSERT(test_validation_failures(), "Rejected Shares Counted");
+    TEST_ASSERT(test_network_traffic(), "Rounds and Bytes of Networked Protocols");
+    TEST_ASSERT(test_threads_and_reset(), "Concurrent Updates Exact, Reset Zeroes");
+
+    print_header("Robustness Tests");
+    TEST_ASSERT(test_invalid_arguments(), "Invalid Arguments Rejected");
+    TEST_ASSERT(test_cleanup(), "Cleanup Safe After Failed Init and in Any Order on Copies");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}
@@ -0,0 +1,299 @@
+#include "sss/mpc.h"
+#include "sss/trace.h"
+#include "sss/secret_sharing.h"
+#include "sss/field.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+/*
+ * In a library built with -DSSS_TRACE=ON the tests below inspect the
+ * dumped trace. In a normal build they check that the functions are
+ * harmless no-ops.
+ */
+#define TRACE_FILE "mpc_trace_test.json"
+
+static int tracing = 0;
+
+/* ========================================================================
+ * Helpers
+ * ======================================================================== */
+
+/**
+ * Dump the trace and read it back (caller frees); NULL on failure
+ */
+static char *dump_trace(void) {
+    if (mpc_trace_dump(TRACE_FILE) != 0) {
+        return NULL;
+    }
+    FILE *in = fopen(TRACE_FILE, "r");
+    if (in == NULL) {
+        return NULL;
+    }
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+
+    char *text = malloc((size_t)size + 1);
+    if (text != NULL) {
+        size_t got = fread(text, 1, (size_t)size, in);
+        text[got] = '\0';
+    }
+    fclose(in);
+    remove(TRACE_FILE);
+    return text;
+}
+
+static size_t count_of(const char *text, const char *needle) {
+    size_t count = 0;
+    for (const char *p = strstr(text, needle); p != NULL;
+         p = strstr(p + 1, needle)) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * One multiplication and reconstruction in a fresh context
+ */
+static int run_protocol(uint8_t seed) {
+    mpc_context_t ctx;
+    mpc_share_t x[5], y[5], product[5];
+    uint8_t a[2] = {seed, 7};
+    uint8_t b[2] = {3, (uint8_t)(seed + 1)};
+    uint8_t c[2];
+
+    int ok = mpc_init_context(&ctx, 5, 3, 2) == 0;
+    ok = ok && mpc_create_shares(&ctx, a, x) == 0;
+    ok = ok && mpc_create_shares(&ctx, b, y) == 0;
+    ok = ok && mpc_secure_mul(&ctx, x, y, product, 5) == 0;
+    ok = ok && mpc_reconstruct(&ctx, product, 5, c) == 0;
+    ok = ok && c[0] == gf256_mul(a[0], b[0]) && c[1] == gf256_mul(a[1], b[1]);
+
+    for (int i = 0; i < 5; i++) {
+        mpc_wipe_share(&x[i]);
+        mpc_wipe_share(&y[i]);
+        mpc_wipe_share(&product[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+// Test 1: Tracing reports whether it is built in
+int test_enabled() {
+    printf("\n" COLOR_YELLOW "→ Test 1: Trace build" COLOR_RESET "\n");
+
+    tracing = mpc_trace_enabled();
+    printf("  Library built %s tracing\n", tracing ? "with" : "without");
+
+    mpc_trace_clear();
+    int ok = (tracing == 0 || tracing == 1);
+    ok &= (mpc_trace_dropped() == 0);
+    if (!tracing) {
+        // Nothing to dump, and no file is written
+        ok &= (mpc_trace_dump(TRACE_FILE) == -1);
+        FILE *written = fopen(TRACE_FILE, "r");
+        ok &= (written == NULL);
+        if (written != NULL) {
+            fclose(written);
+        }
+    }
+    ok &= (mpc_trace_dump(NULL) == -1);
+    return ok;
+}
+
+// Test 2: Operation and phase spans of a multiplication
+int test_spans() {
+    printf("\n" COLOR_YELLOW "→ Test 2: Operation and phase spans" COLOR_RESET "\n");
+
+    mpc_trace_clear();
+    int ok = run_protocol(42);
+    if (!tracing) {
+        return ok;
+    }
+
+    char *text = dump_trace();
+    if (text == NULL) {
+        return 0;
+    }
+
+    static const char *const names[] = {
+        "\"mpc_create_shares\"", "\"mpc_secure_mul_batch\"",
+        "\"mpc_reconstruct\"", "\"validate\"", "\"compute\"",
+        "\"reconstruct\"", "\"reshare\"", "\"wipe\""
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        size_t n = count_of(text, names[i]);
+        printf("  %-24s %zu events\n", names[i], n);
+        ok &= (n > 0 && n % 2 == 0);
+    }
+
+    // Every begin is closed
+    size_t begins = count_of(text, "\"ph\": \"B\"");
+    size_t ends = count_of(text, "\"ph\": \"E\"");
+    printf("  %zu begins, %zu ends\n", begins, ends);
+    ok &= (begins == ends && begins > 0);
+    ok &= (strncmp(text, "{\"displayTimeUnit\"", 18) == 0);
+
+    free(text);
+    return ok;
+}
+
+// Test 3: A full ring drops its oldest events and stays well formed
+int test_wrap() {
+    printf("\n" COLOR_YELLOW "→ Test 3: Ring overflow" COLOR_RESET "\n");
+
+    mpc_trace_clear();
+    int ok = 1;
+    for (int round = 0; round < 400 && ok; round++) {
+        ok &= run_protocol((uint8_t)round);
+    }
+    if (!tracing) {
+        return ok && mpc_trace_dropped() == 0;
+    }
+
+    size_t dropped = mpc_trace_dropped();
+    printf("  %zu events dropped\n", dropped);
+    ok &= (dropped > 0);
+
+    char *text = dump_trace();
+    if (text == NULL) {
+        return 0;
+    }
+    size_t begins = count_of(text, "\"ph\": \"B\"");
+    size_t ends = count_of(text, "\"ph\": \"E\"");
+    printf("  %zu begins, %zu ends kept\n", begins, ends);
+    ok &= (begins == ends && begins + ends <= MPC_TRACE_RING_SIZE);
+    free(text);
+
+    // Clearing forgets everything, drops included
+    mpc_trace_clear();
+    ok &= (mpc_trace_dropped() == 0);
+    text = dump_trace();
+    ok &= (text != NULL && count_of(text, "\"ph\"") == 0);
+    free(text);
+    return ok;
+}
+
+static void *protocol_main(void *arg) {
+    int *ok = arg;
+    for (int round = 0; round < 10; round++) {
+        *ok &= run_protocol((uint8_t)round);
+    }
+    return NULL;
+}
+
+// Test 4: Each thread records into a ring of its own
+int test_threads() {
+    printf("\n" COLOR_YELLOW "→ Test 4: Concurrent threads" COLOR_RESET "\n");
+
+    enum { NUM_THREADS = 4 };
+    pthread_t threads[NUM_THREADS];
+    int thread_ok[NUM_THREADS];
+
+    mpc_trace_clear();
+    for (int i = 0; i < NUM_THREADS; i++) {
+        thread_ok[i] = 1;
+        pthread_create(&threads[i], NULL, protocol_main, &thread_ok[i]);
+    }
+    int ok = 1;
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        ok &= thread_ok[i];
+    }
+    if (!tracing) {
+        return ok;
+    }
+
+    char *text = dump_trace();
+    if (text == NULL) {
+        return 0;
+    }
+
+    // Every thread contributes the same spans
+    size_t muls = count_of(text, "\"mpc_secure_mul_batch\"");
+    printf("  %zu multiplication events from %d threads\n", muls,
+           NUM_THREADS);
+    ok &= (muls == 2 * 10 * NUM_THREADS);
+    ok &= (mpc_trace_dropped() == 0);
+    free(text);
+    return ok;
+}
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Protocol Trace Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Configuration");
+    TEST_ASSERT(test_enabled(), "Trace Functions Match the Build");
+
+    print_header("Recording");
+    TEST_ASSERT(test_spans(), "Operation and Phase Spans Balanced");
+    TEST_ASSERT(test_wrap(), "Full Ring Drops Oldest Events");
+    TEST_ASSERT(test_threads(), "Per-Thread Rings");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}
@@ -0,0 +1,796 @@
+#include "sss/transport.h"
+#include "sss/transport_batch.h"
+#include "sss/mpc_net.h"
+#include "sss/mpc.h"
+#include "sss/field.h"
+#include "sss/secret_sharing.h"
+#include "utils/affinity.h"
+#include <pthread.h>
+#include <sys/socket.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define COLOR_GREEN   "\x1b[32m"
+#define COLOR_RED     "\x1b[31m"
+#define COLOR_BLUE    "\x1b[34m"
+#define COLOR_CYAN    "\x1b[36m"
+#define COLOR_YELLOW  "\x1b[33m"
+#define COLOR_RESET   "\x1b[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, test_name) do { \
+    if (condition) { \
+        printf("  " COLOR_GREEN "✓ PASS: " COLOR_RESET "%s\n", test_name); \
+        tests_passed++; \
+    } else { \
+        printf("  " COLOR_RED "✗ FAIL: " COLOR_RESET "%s\n", test_name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+void print_separator() {
+    printf(COLOR_CYAN "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" COLOR_RESET);
+}
+
+void print_header(const char *title) {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  %s\n" COLOR_RESET, title);
+    print_separator();
+}
+
+#define NUM_PARTIES 5
+
+typedef int (*group_create_fn)(uint8_t num_parties, mpc_transport_t **endpoints);
+
+/* ========================================================================
+ * Party Threads
+ * ======================================================================== */
+
+typedef struct {
+    const mpc_context_t *ctx;
+    mpc_transport_t *transport;
+    uint8_t input;              // This party's private input
+    uint8_t sum;                // Opened sum of all inputs
+    uint8_t product;            // Opened product of inputs 1 and 2
+    int status;
+} party_t;
+
+/**
+ * Every party inputs a value, then the parties compute and open
+ * (x1 + ... + xn) and x1 × x2
+ */
+static void *party_main(void *arg) {
+    party_t *party = arg;
+    const mpc_context_t *ctx = party->ctx;
+    mpc_transport_t *net = party->transport;
+    uint8_t me = net->party_id;
+
+    mpc_share_t inputs[NUM_PARTIES];
+    mpc_share_t results[2];
+    party->status = -1;
+
+    for (uint8_t dealer = 1; dealer <= NUM_PARTIES; dealer++) {
+        const uint8_t *secret = (dealer == me) ? &party->input : NULL;
+        if (mpc_net_share_input(ctx, net, dealer, secret,
+                                &inputs[dealer - 1], 1) != 0) {
+            return NULL;
+        }
+    }
+
+    // Sum is local; the product costs one round
+    results[0] = inputs[0];
+    for (int i = 1; i < NUM_PARTIES; i++) {
+        if (mpc_secure_add(ctx, &results[0], &inputs[i], &results[0], 1) != 0) {
+            return NULL;
+        }
+    }
+    if (mpc_net_mul(ctx, net, &inputs[0], &inputs[1], &results[1], 1) != 0) {
+        return NULL;
+    }
+
+    uint8_t opened[2];
+    if (mpc_net_open(ctx, net, results, opened, 2) != 0) {
+        return NULL;
+    }
+
+    party->sum = opened[0];
+    party->product = opened[1];
+    party->status = 0;
+    return NULL;
+}
+
+/**
+ * Run party_main on one thread per endpoint
+ */
+static int run_parties(const mpc_context_t *ctx, mpc_transport_t **net,
+                       party_t *parties) {
+    pthread_t threads[NUM_PARTIES];
+
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        parties[i].ctx = ctx;
+        parties[i].transport = net[i];
+        parties[i].input = (uint8_t)(17 * (i + 1));
+        if (pthread_create(&threads[i], NULL, party_main, &parties[i]) != 0) {
+            return 0;
+        }
+    }
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    uint8_t expected_sum = 0;
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        expected_sum = gf256_add(expected_sum, parties[i].input);
+    }
+    uint8_t expected_product = gf256_mul(parties[0].input, parties[1].input);
+
+    int ok = 1;
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        ok = ok && parties[i].status == 0 && parties[i].sum == expected_sum &&
+             parties[i].product == expected_product;
+    }
+    return ok;
+}
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+static int spsc_create_default(uint8_t num_parties, mpc_transport_t **endpoints) {
+    return mpc_transport_spsc_create(num_parties, 0, endpoints);
+}
+
+/**
+ * Ordered delivery and counters between parties 1 and 2
+ */
+static int check_point_to_point(group_create_fn create) {
+    mpc_transport_t *net[3];
+    if (create(3, net) != 0) {
+        return 0;
+    }
+
+    int ok = 1;
+    uint8_t msg[300];
+    for (int i = 0; i < 300; i++) {
+        msg[i] = (uint8_t)i;
+    }
+
+    ok = ok && mpc_transport_send(net[0], 2, msg, 1) == 0;
+    ok = ok && mpc_transport_send(net[0], 2, msg, 300) == 0;
+    ok = ok && mpc_transport_send(net[0], 2, NULL, 0) == 0;
+    ok = ok && mpc_transport_flush(net[0]) == 0;
+    ok = ok && mpc_transport_broadcast(net[2], "hi", 2) == 0;
+    ok = ok && mpc_transport_flush(net[2]) == 0;
+
+    uint8_t buf[300];
+    size_t len = 0;
+    ok = ok && mpc_transport_recv(net[1], 1, buf, sizeof(buf), &len) == 0 &&
+         len == 1 && buf[0] == 0;
+    ok = ok && mpc_transport_recv(net[1], 1, buf, sizeof(buf), &len) == 0 &&
+         len == 300 && memcmp(buf, msg, 300) == 0;
+    ok = ok && mpc_transport_recv(net[1], 1, buf, sizeof(buf), &len) == 0 &&
+         len == 0;
+    ok = ok && mpc_transport_recv(net[0], 3, buf, sizeof(buf), &len) == 0 &&
+         len == 2 && memcmp(buf, "hi", 2) == 0;
+
+    // Too small a buffer fails, and the next message is still intact
+    ok = ok && mpc_transport_recv(net[1], 3, buf, 1, &len) == -1;
+    ok = ok && mpc_transport_send(net[2], 2, msg, 3) == 0;
+    ok = ok && mpc_transport_flush(net[2]) == 0;
+    ok = ok && mpc_transport_recv(net[1], 3, buf, sizeof(buf), &len) == 0 &&
+         len == 3 && buf[2] == 2;
+
+    mpc_transport_stats_t stats;
+    mpc_transport_get_stats(net[0], &stats);
+    ok = ok && stats.bytes_sent == 301 && stats.messages_sent == 3 &&
+         stats.bytes_received == 2 && stats.rounds == 1;
+
+    mpc_transport_get_stats(net[2], &stats);
+    ok = ok && stats.messages_sent == 3 && stats.rounds == 2;
+
+    for (int i = 0; i < 3; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+    return ok;
+}
+
+/**
+ * Run the sum/product protocol over a backend and check the counters
+ */
+static int check_protocol(group_create_fn create, const char *name) {
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, NUM_PARTIES, 3, 1);
+
+    mpc_transport_t *net[NUM_PARTIES];
+    if (create(NUM_PARTIES, net) != 0) {
+        return 0;
+    }
+
+    party_t parties[NUM_PARTIES];
+    memset(parties, 0, sizeof(parties));
+    int ok = run_parties(&ctx, net, parties);
+
+    // Each party: its own input, the product and the opening
+    mpc_transport_stats_t stats;
+    mpc_transport_get_stats(net[0], &stats);
+    printf("  %-10s party 1: %llu bytes sent, %llu messages, %llu rounds\n",
+           name, (unsigned long long)stats.bytes_sent,
+           (unsigned long long)stats.messages_sent,
+           (unsigned long long)stats.rounds);
+    ok = ok && stats.rounds == 3 &&
+         stats.bytes_sent == (uint64_t)(NUM_PARTIES - 1) * 4;
+
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 1: Point-to-point delivery on every backend
+int test_point_to_point() {
+    printf("\n" COLOR_YELLOW "→ Test 1: Ordered delivery and counters" COLOR_RESET "\n");
+
+    int ok = check_point_to_point(mpc_transport_memory_create);
+    ok = check_point_to_point(spsc_create_default) && ok;
+    ok = check_point_to_point(mpc_transport_socketpair_create) && ok;
+    ok = check_point_to_point(mpc_transport_tcp_create) && ok;
+    return ok;
+}
+
+// Test 2: The same protocol code over every backend
+int test_protocol_backends() {
+    printf("\n" COLOR_YELLOW "→ Test 2: Sum and product over each backend" COLOR_RESET "\n");
+
+    int ok = check_protocol(mpc_transport_memory_create, "memory");
+    ok = check_protocol(spsc_create_default, "spsc") && ok;
+    ok = check_protocol(mpc_transport_socketpair_create, "socketpair") && ok;
+    ok = check_protocol(mpc_transport_tcp_create, "tcp") && ok;
+    return ok;
+}
+
+#define STREAM_MESSAGES 100000
+
+typedef struct {
+    mpc_transport_t *transport;
+    int ok;
+} stream_arg_t;
+
+/**
+ * Party 1 streams messages of varying length to party 2, flushing
+ * every few messages so the small ring wraps around many times
+ */
+static void *stream_sender(void *arg) {
+    stream_arg_t *a = arg;
+    uint8_t msg[40];
+
+    sss_pin_thread(0);
+    a->ok = 1;
+    for (uint32_t i = 0; i < STREAM_MESSAGES && a->ok; i++) {
+        size_t len = i % sizeof(msg);
+        memset(msg, (int)(i & 0xFF), len);
+        a->ok = mpc_transport_send(a->transport, 2, msg, len) == 0;
+        if (i % 7 == 6) {
+            a->ok = a->ok && mpc_transport_flush(a->transport) == 0;
+        }
+    }
+    a->ok = a->ok && mpc_transport_flush(a->transport) == 0;
+    return NULL;
+}
+
+static void *stream_receiver(void *arg) {
+    stream_arg_t *a = arg;
+    uint8_t msg[40];
+
+    sss_pin_thread(1);
+    a->ok = 1;
+    for (uint32_t i = 0; i < STREAM_MESSAGES && a->ok; i++) {
+        size_t len = 0;
+        a->ok = mpc_transport_recv(a->transport, 1, msg, sizeof(msg), &len) == 0 &&
+                len == i % sizeof(msg) &&
+                (len == 0 || (msg[0] == (uint8_t)i && msg[len - 1] == (uint8_t)i));
+    }
+    return NULL;
+}
+
+// Test 3: SPSC rings stay ordered across wrap-around
+int test_spsc_stream() {
+    printf("\n" COLOR_YELLOW "→ Test 3: %d messages through a 64-byte ring" COLOR_RESET "\n",
+           STREAM_MESSAGES);
+
+    mpc_transport_t *net[2];
+    if (mpc_transport_spsc_create(2, 64, net) != 0) {
+        return 0;
+    }
+
+    // A message that can never fit is rejected up front
+    uint8_t big[64] = {0};
+    int ok = mpc_transport_send(net[0], 2, big, sizeof(big)) == -1;
+
+    stream_arg_t sender = {net[0], 0};
+    stream_arg_t receiver = {net[1], 0};
+    pthread_t threads[2];
+    pthread_create(&threads[0], NULL, stream_sender, &sender);
+    pthread_create(&threads[1], NULL, stream_receiver, &receiver);
+    pthread_join(threads[0], NULL);
+    pthread_join(threads[1], NULL);
+
+    mpc_transport_stats_t stats;
+    mpc_transport_get_stats(net[1], &stats);
+    printf("  Received %llu messages, %llu bytes\n",
+           (unsigned long long)stats.messages_received,
+           (unsigned long long)stats.bytes_received);
+
+    ok = ok && sender.ok && receiver.ok &&
+         stats.messages_received == STREAM_MESSAGES;
+
+    mpc_transport_destroy(net[0]);
+    mpc_transport_destroy(net[1]);
+    return ok;
+}
+
+typedef struct {
+    uint8_t party_id;
+    uint16_t base_port;
+    mpc_transport_t *endpoint;
+} connect_arg_t;
+
+static void *connect_main(void *arg) {
+    connect_arg_t *c = arg;
+    if (mpc_transport_tcp_connect(c->party_id, NUM_PARTIES, "127.0.0.1",
+                                  c->base_port, 5000, &c->endpoint) != 0) {
+        c->endpoint = NULL;
+    }
+    return NULL;
+}
+
+// Test 4: Parties join a TCP group independently
+int test_tcp_connect() {
+    printf("\n" COLOR_YELLOW "→ Test 4: Independent TCP group join" COLOR_RESET "\n");
+
+    uint16_t base_port = (uint16_t)(20000 + (getpid() % 20000));
+    connect_arg_t args[NUM_PARTIES];
+    pthread_t threads[NUM_PARTIES];
+
+    // Start the highest party first to exercise connection retries
+    for (int i = NUM_PARTIES - 1; i >= 0; i--) {
+        args[i].party_id = (uint8_t)(i + 1);
+        args[i].base_port = base_port;
+        args[i].endpoint = NULL;
+        pthread_create(&threads[i], NULL, connect_main, &args[i]);
+    }
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    mpc_transport_t *net[NUM_PARTIES];
+    int ok = 1;
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        net[i] = args[i].endpoint;
+        ok = ok && net[i] != NULL;
+    }
+
+    if (ok) {
+        mpc_context_t ctx;
+        mpc_init_context(&ctx, NUM_PARTIES, 3, 1);
+        party_t parties[NUM_PARTIES];
+        memset(parties, 0, sizeof(parties));
+        ok = run_parties(&ctx, net, parties);
+        mpc_cleanup_context(&ctx);
+    }
+    printf("  Base port %u: %s\n", base_port, ok ? "connected" : "failed");
+
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+    return ok;
+}
+
+// Test 5: Messages of a round are coalesced into one frame per peer
+int test_batch_coalescing() {
+    printf("\n" COLOR_YELLOW "→ Test 5: Two channels, one frame" COLOR_RESET "\n");
+
+    mpc_transport_t *net[3];
+    if (mpc_transport_socketpair_create(3, net) != 0) {
+        return 0;
+    }
+
+    mpc_session_id_t session_a, session_b;
+    mpc_session_id_random(&session_a);
+    mpc_session_id_derive(&session_a, 1, &session_b);
+
+    mpc_batch_link_t *link1 = mpc_batch_link_create(net[0]);
+    mpc_batch_link_t *link2 = mpc_batch_link_create(net[1]);
+    mpc_batch_link_t *link3 = mpc_batch_link_create(net[2]);
+    mpc_transport_t *a1 = mpc_batch_channel_open(link1, &session_a);
+    mpc_transport_t *b1 = mpc_batch_channel_open(link1, &session_b);
+    mpc_transport_t *b2 = mpc_batch_channel_open(link2, &session_b);
+    mpc_transport_t *b3 = mpc_batch_channel_open(link3, &session_b);
+
+    int ok = link1 && link2 && link3 && a1 && b1 && b2 && b3;
+    ok = ok && mpc_batch_channel_open(link1, &session_a) == NULL;  // Already open
+
+    // Interleave two computations' messages within one round
+    uint8_t values[10];
+    for (int i = 0; i < 10; i++) {
+        values[i] = (uint8_t)(100 + i);
+        ok = ok && mpc_transport_send(a1, 2, &values[i], 1) == 0;
+        if (i % 2 == 0) {
+            ok = ok && mpc_transport_send(b1, 2, &values[i], 1) == 0;
+        }
+    }
+
+    // A frame of other records to party 3 in the same round; the socket
+    // sends the record headers of both frames on flush
+    uint8_t pairs[3][2] = {{1, 2}, {3, 4}, {5, 6}};
+    for (int i = 0; i < 3; i++) {
+        ok = ok && mpc_transport_send(b1, 3, pairs[i], 2) == 0;
+    }
+    ok = ok && mpc_transport_flush(b1) == 0;
+
+    // Channel b is read first; channel a is opened only after its
+    // records have arrived
+    uint8_t byte = 0;
+    size_t len = 0;
+    for (int i = 0; ok && i < 10; i += 2) {
+        ok = mpc_transport_recv(b2, 1, &byte, 1, &len) == 0 &&
+             len == 1 && byte == values[i];
+    }
+    mpc_transport_t *a2 = mpc_batch_channel_open(link2, &session_a);
+    for (int i = 0; ok && i < 10; i++) {
+        ok = a2 != NULL && mpc_transport_recv(a2, 1, &byte, 1, &len) == 0 &&
+             len == 1 && byte == values[i];
+    }
+    uint8_t pair[2];
+    for (int i = 0; ok && i < 3; i++) {
+        ok = mpc_transport_recv(b3, 1, pair, sizeof(pair), &len) == 0 &&
+             len == 2 && memcmp(pair, pairs[i], 2) == 0;
+    }
+
+    mpc_transport_stats_t wire, chan;
+    mpc_transport_get_stats(net[0], &wire);
+    mpc_transport_get_stats(a1, &chan);
+    printf("  Channel a: %llu messages; wire: %llu frames, %llu bytes\n",
+           (unsigned long long)chan.messages_sent,
+           (unsigned long long)wire.messages_sent,
+           (unsigned long long)wire.bytes_sent);
+
+    // One frame per peer
+    ok = ok && chan.messages_sent == 10 && wire.messages_sent == 2 &&
+         wire.rounds == 1 &&
+         wire.bytes_sent == 15 * (20 + 1) + 3 * (20 + 2);
+
+    mpc_transport_destroy(a2);
+    mpc_transport_destroy(b3);
+    mpc_transport_destroy(b2);
+    mpc_transport_destroy(b1);
+    mpc_transport_destroy(a1);
+    mpc_batch_link_destroy(link3);
+    mpc_batch_link_destroy(link2);
+    mpc_batch_link_destroy(link1);
+    for (int i = 0; i < 3; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+    return ok;
+}
+
+// Test 6: Networked protocols over batch channels
+int test_batch_protocol() {
+    printf("\n" COLOR_YELLOW "→ Test 6: Sum and product over batch channels" COLOR_RESET "\n");
+
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, NUM_PARTIES, 3, 1);
+
+    mpc_transport_t *net[NUM_PARTIES];
+    if (mpc_transport_tcp_create(NUM_PARTIES, net) != 0) {
+        return 0;
+    }
+
+    mpc_batch_link_t *links[NUM_PARTIES];
+    mpc_transport_t *channels[NUM_PARTIES];
+    int ok = 1;
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        links[i] = mpc_batch_link_create(net[i]);
+        channels[i] = mpc_batch_channel_open(links[i], &ctx.session_id);
+        ok = ok && channels[i] != NULL;
+    }
+
+    party_t parties[NUM_PARTIES];
+    memset(parties, 0, sizeof(parties));
+    ok = ok && run_parties(&ctx, channels, parties);
+
+    // Both opened values share a frame: 16 messages become 12 frames
+    mpc_transport_stats_t wire, chan;
+    mpc_transport_get_stats(net[0], &wire);
+    mpc_transport_get_stats(channels[0], &chan);
+    printf("  Party 1: %llu messages in %llu frames, %llu rounds\n",
+           (unsigned long long)chan.messages_sent,
+           (unsigned long long)wire.messages_sent,
+           (unsigned long long)wire.rounds);
+    ok = ok && chan.messages_sent == 16 && wire.messages_sent == 12 &&
+         wire.rounds == 3 && chan.rounds == 3;
+
+    for (int i = 0; i < NUM_PARTIES; i++) {
+        mpc_transport_destroy(channels[i]);
+        mpc_batch_link_destroy(links[i]);
+        mpc_transport_destroy(net[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+/* One-byte values per round in the large-round tests */
+#define LARGE_ROUND 50000
+
+typedef struct {
+    const mpc_context_t *ctx;
+    mpc_transport_t *transport;
+    const uint8_t *secrets;     // Inputs of party 1
+    mpc_share_t *shares;
+    mpc_share_t *squares;
+    uint8_t *opened;
+    int status;
+} large_party_t;
+
+/**
+ * Party 1 deals LARGE_ROUND values, then every party squares and opens
+ * them: three rounds in which every party sends everything before it
+ * receives anything
+ */
+static void *large_party_main(void *arg) {
+    large_party_t *party = arg;
+    const mpc_context_t *ctx = party->ctx;
+    mpc_transport_t *net = party->transport;
+
+    party->status = -1;
+    if (mpc_net_share_input(ctx, net, 1,
+                            (net->party_id == 1) ? party->secrets : NULL,
+                            party->shares, LARGE_ROUND) != 0 ||
+        mpc_net_mul(ctx, net, party->shares, party->shares, party->squares,
+                    LARGE_ROUND) != 0 ||
+        mpc_net_open(ctx, net, party->squares, party->opened,
+                     LARGE_ROUND) != 0) {
+        return NULL;
+    }
+    party->status = 0;
+    return NULL;
+}
+
+/**
+ * Run large_party_main on three endpoints and check every opened square
+ */
+static int run_large_round(const mpc_context_t *ctx, mpc_transport_t **net) {
+    static uint8_t secrets[LARGE_ROUND];
+    large_party_t parties[3];
+    pthread_t threads[3];
+    int ok = 1;
+
+    for (size_t k = 0; k < LARGE_ROUND; k++) {
+        secrets[k] = (uint8_t)(k * 31 + 7);
+    }
+
+    memset(parties, 0, sizeof(parties));
+    for (int i = 0; i < 3; i++) {
+        parties[i].ctx = ctx;
+        parties[i].transport = net[i];
+        parties[i].secrets = secrets;
+        parties[i].shares = malloc(LARGE_ROUND * sizeof(mpc_share_t));
+        parties[i].squares = malloc(LARGE_ROUND * sizeof(mpc_share_t));
+        parties[i].opened = malloc(LARGE_ROUND);
+        ok = ok && parties[i].shares != NULL && parties[i].squares != NULL &&
+             parties[i].opened != NULL;
+    }
+
+    for (int i = 0; i < 3 && ok; i++) {
+        ok = pthread_create(&threads[i], NULL, large_party_main,
+                            &parties[i]) == 0;
+        if (!ok) {
+            // Parties already started wait for this one forever
+            return 0;
+        }
+    }
+    for (int i = 0; i < 3 && ok; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int i = 0; i < 3 && ok; i++) {
+        ok = parties[i].status == 0;
+        for (size_t k = 0; k < LARGE_ROUND && ok; k++) {
+            ok = parties[i].opened[k] == gf256_mul(secrets[k], secrets[k]);
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        free(parties[i].shares);
+        free(parties[i].squares);
+        free(parties[i].opened);
+    }
+    return ok;
+}
+
+/**
+ * Large rounds over one socket backend, with and without a batch link,
+ * with the socket buffers shrunk to buffer_size
+ */
+static int check_large_round(group_create_fn create, const char *name,
+                             int buffer_size) {
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 3, 2, 1);
+
+    mpc_transport_t *net[3];
+    if (create(3, net) != 0) {
+        return 0;
+    }
+
+    // Shrink the kernel buffers so that a round cannot fit in them
+    int buffers = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t peer = 1; peer <= 3; peer++) {
+            int fd = mpc_transport_socket_fd(net[i], peer);
+            int size = buffer_size;
+            if (fd >= 0) {
+                setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+                setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+            }
+        }
+    }
+    int sndbuf = 0, rcvbuf = 0;
+    socklen_t opt_len = sizeof(int);
+    getsockopt(mpc_transport_socket_fd(net[0], 2), SOL_SOCKET, SO_SNDBUF,
+               &sndbuf, &opt_len);
+    opt_len = sizeof(int);
+    getsockopt(mpc_transport_socket_fd(net[1], 1), SOL_SOCKET, SO_RCVBUF,
+               &rcvbuf, &opt_len);
+    buffers = sndbuf + rcvbuf;
+
+    size_t round_bytes = (size_t)LARGE_ROUND * 5;   // Header + one byte
+    printf("  %-10s %zu-byte rounds per peer, %d bytes of socket buffers\n",
+           name, round_bytes, buffers);
+    int ok = buffers > 0 && round_bytes > 3 * (size_t)buffers;
+
+    ok = ok && run_large_round(&ctx, net);
+
+    // Same rounds as 64 KiB frames of a batch link
+    mpc_batch_link_t *links[3];
+    mpc_transport_t *channels[3];
+    for (int i = 0; i < 3; i++) {
+        links[i] = mpc_batch_link_create(net[i]);
+        channels[i] = mpc_batch_channel_open(links[i], &ctx.session_id);
+        ok = ok && channels[i] != NULL;
+    }
+    ok = ok && run_large_round(&ctx, channels);
+
+    for (int i = 0; i < 3; i++) {
+        mpc_transport_destroy(channels[i]);
+        mpc_batch_link_destroy(links[i]);
+        mpc_transport_destroy(net[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+/**
+ * Large rounds over SPSC rings of ring_bytes (0 = default size)
+ */
+static int check_spsc_large_round(size_t ring_bytes) {
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 3, 2, 1);
+
+    mpc_transport_t *net[3];
+    if (mpc_transport_spsc_create(3, ring_bytes, net) != 0) {
+        return 0;
+    }
+
+    size_t ring = (ring_bytes > 0) ? ring_bytes
+                                   : MPC_TRANSPORT_SPSC_DEFAULT_RING;
+    size_t round_bytes = (size_t)LARGE_ROUND * 5;
+    printf("  %-10s %zu-byte rounds per peer, %zu-byte rings\n",
+           "spsc", round_bytes, ring);
+    int ok = round_bytes > 3 * ring;
+
+    ok = ok && run_large_round(&ctx, net);
+
+    for (int i = 0; i < 3; i++) {
+        mpc_transport_destroy(net[i]);
+    }
+    mpc_cleanup_context(&ctx);
+    return ok;
+}
+
+// Test 7: Rounds far larger than the socket buffers and rings
+int test_large_rounds() {
+    printf("\n" COLOR_YELLOW "→ Test 7: %d values per round" COLOR_RESET "\n",
+           LARGE_ROUND);
+
+    // TCP gets larger buffers: tiny windows stall on delayed ACKs
+    int ok = check_large_round(mpc_transport_socketpair_create, "socketpair",
+                               4096);
+    ok = check_large_round(mpc_transport_tcp_create, "tcp", 16384) && ok;
+    ok = check_spsc_large_round(4096) && ok;
+    ok = check_spsc_large_round(0) && ok;
+    return ok;
+}
+
+// Test 8: Invalid arguments
+int test_invalid_arguments() {
+    printf("\n" COLOR_YELLOW "→ Test 8: Invalid arguments" COLOR_RESET "\n");
+
+    mpc_transport_t *net[2];
+    if (mpc_transport_memory_create(2, net) != 0) {
+        return 0;
+    }
+
+    uint8_t byte = 0;
+    size_t len = 0;
+    int ok = 1;
+    ok = ok && mpc_transport_send(net[0], 1, &byte, 1) == -1;   // Self
+    ok = ok && mpc_transport_send(net[0], 3, &byte, 1) == -1;   // No such party
+    ok = ok && mpc_transport_recv(net[0], 0, &byte, 1, &len) == -1;
+    ok = ok && mpc_transport_memory_create(1, net) == -1;
+
+    // Network protocols need 2t - 1 parties for multiplication
+    mpc_context_t ctx;
+    mpc_init_context(&ctx, 2, 2, 1);
+    mpc_share_t s;
+    memset(&s, 0, sizeof(s));
+    ok = ok && mpc_net_mul(&ctx, net[0], &s, &s, &s, 1) == -1;
+    mpc_cleanup_context(&ctx);
+
+    mpc_transport_destroy(net[0]);
+    mpc_transport_destroy(net[1]);
+    mpc_transport_destroy(NULL);
+    return ok;
+}
+
+int main() {
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  MPC Transport Test Suite\n" COLOR_RESET);
+    print_separator();
+
+    if (sss_init() != 0) {
+        printf(COLOR_RED "✗ Failed to initialize\n" COLOR_RESET);
+        return 1;
+    }
+
+    print_header("Transport Backends");
+    TEST_ASSERT(test_point_to_point(), "Ordered Delivery and Counters");
+    TEST_ASSERT(test_protocol_backends(), "Protocols Run Unchanged on Every Backend");
+    TEST_ASSERT(test_spsc_stream(), "SPSC Ring Wrap-Around");
+    TEST_ASSERT(test_tcp_connect(), "Independent TCP Group Join");
+
+    print_header("Batching and Pipelining");
+    TEST_ASSERT(test_batch_coalescing(), "Round Coalesced Into One Frame per Peer");
+    TEST_ASSERT(test_batch_protocol(), "Protocols Run on Batch Channels");
+    TEST_ASSERT(test_large_rounds(), "Rounds Larger Than Socket Buffers and Rings");
+
+    print_header("Robustness Tests");
+    TEST_ASSERT(test_invalid_arguments(), "Invalid Arguments Rejected");
+
+    // Summary
+    printf("\n");
+    print_separator();
+    printf(COLOR_BLUE "  Test Summary\n" COLOR_RESET);
+    print_separator();
+    printf("\n");
+    printf("  Total tests:   %d\n", tests_passed + tests_failed);
+    printf("  " COLOR_GREEN "Passed:       %d\n" COLOR_RESET, tests_passed);
+    printf("  " COLOR_RED "Failed:       %d\n" COLOR_RESET, tests_failed);
+    printf("\n");
+    print_separator();
+
+    if (tests_failed == 0) {
+        printf(COLOR_GREEN "\n  ✓✓✓ ALL TESTS PASSED! ✓✓✓\n\n" COLOR_RESET);
+        print_separator();
+        return 0;
+    } else {
+        printf(COLOR_RED "\n  ✗✗✗ SOME TESTS FAILED ✗✗✗\n\n" COLOR_RESET);
+        print_separator();
+        return 1;
+    }
+}